@@ -0,0 +1,300 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Shader archive builder.
+//
+// Compiles HLSL shader permutations listed in a manifest file and packs SPIR-V byte code,
+// GLSL source for the OpenGL backend and serialized SPIR-V reflection into a single
+// shader archive (see ShaderArchive.hpp) that can be loaded with IRenderDevice::CreateShaderFromArchive().
+//
+// Every non-empty line of the manifest that does not start with '#' describes one permutation:
+//
+//      <entry name> <vs|ps|gs|hs|ds|cs> <source file> <entry point> [MACRO=VALUE ...]
+//
+// Usage:
+//      ShaderArchiver [-I <search directories>] [--no-inout-locations] <manifest file> <output archive>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+
+#include "ShaderArchive.hpp"
+#include "SPIRVUtils.hpp"
+#include "SPIRVShaderResources.hpp"
+#include "HLSL2GLSLConverterImpl.hpp"
+#include "DefaultShaderSourceStreamFactory.h"
+#include "EngineMemory.h"
+#include "RefCntAutoPtr.hpp"
+#include "DataBlobImpl.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct PermutationInfo
+{
+    std::string Name;
+    SHADER_TYPE ShaderType = SHADER_TYPE_UNKNOWN;
+    std::string FilePath;
+    std::string EntryPoint;
+
+    std::vector<std::pair<std::string, std::string>> Macros;
+};
+
+SHADER_TYPE ParseShaderType(const std::string& Type)
+{
+    if (Type == "vs") return SHADER_TYPE_VERTEX;
+    if (Type == "ps") return SHADER_TYPE_PIXEL;
+    if (Type == "gs") return SHADER_TYPE_GEOMETRY;
+    if (Type == "hs") return SHADER_TYPE_HULL;
+    if (Type == "ds") return SHADER_TYPE_DOMAIN;
+    if (Type == "cs") return SHADER_TYPE_COMPUTE;
+    return SHADER_TYPE_UNKNOWN;
+}
+
+bool ParseManifest(const char* ManifestPath, std::vector<PermutationInfo>& Permutations)
+{
+    std::ifstream Manifest{ManifestPath};
+    if (!Manifest)
+    {
+        printf("Failed to open manifest file %s\n", ManifestPath);
+        return false;
+    }
+
+    std::string Line;
+    int         LineNum = 0;
+    while (std::getline(Manifest, Line))
+    {
+        ++LineNum;
+        std::istringstream LineStream{Line};
+
+        PermutationInfo Permutation;
+        std::string     Type;
+        if (!(LineStream >> Permutation.Name) || Permutation.Name[0] == '#')
+            continue;
+
+        if (!(LineStream >> Type >> Permutation.FilePath >> Permutation.EntryPoint))
+        {
+            printf("%s(%d): expected <entry name> <shader type> <source file> <entry point>\n", ManifestPath, LineNum);
+            return false;
+        }
+
+        Permutation.ShaderType = ParseShaderType(Type);
+        if (Permutation.ShaderType == SHADER_TYPE_UNKNOWN)
+        {
+            printf("%s(%d): unknown shader type '%s'\n", ManifestPath, LineNum, Type.c_str());
+            return false;
+        }
+
+        std::string Macro;
+        while (LineStream >> Macro)
+        {
+            const auto EqPos = Macro.find('=');
+            if (EqPos == std::string::npos)
+                Permutation.Macros.emplace_back(Macro, "1");
+            else
+                Permutation.Macros.emplace_back(Macro.substr(0, EqPos), Macro.substr(EqPos + 1));
+        }
+
+        Permutations.emplace_back(std::move(Permutation));
+    }
+
+    return true;
+}
+
+bool BuildPermutation(const PermutationInfo&           Permutation,
+                      IShaderSourceInputStreamFactory* pStreamFactory,
+                      bool                             UseInOutLocationQualifiers,
+                      ShaderArchiveWriter&             Writer)
+{
+    std::vector<ShaderMacro> Macros;
+    for (const auto& Macro : Permutation.Macros)
+        Macros.emplace_back(Macro.first.c_str(), Macro.second.c_str());
+    Macros.emplace_back(nullptr, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc.Name                  = Permutation.Name.c_str();
+    ShaderCI.Desc.ShaderType            = Permutation.ShaderType;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.FilePath                   = Permutation.FilePath.c_str();
+    ShaderCI.EntryPoint                 = Permutation.EntryPoint.c_str();
+    ShaderCI.Macros                     = Macros.data();
+    ShaderCI.pShaderSourceStreamFactory = pStreamFactory;
+    // OpenGL backend requires combined texture samplers
+    ShaderCI.UseCombinedTextureSamplers = true;
+
+    auto SPIRV = HLSLtoSPIRV(ShaderCI, nullptr);
+    if (SPIRV.empty())
+    {
+        printf("Failed to compile %s to SPIR-V\n", Permutation.Name.c_str());
+        return false;
+    }
+
+    std::vector<Uint8> Resources;
+    {
+        std::string EntryPoint;
+
+        SPIRVShaderResources ShaderResources{GetRawAllocator(), nullptr, SPIRV, ShaderCI.Desc, ShaderCI.CombinedSamplerSuffix,
+                                             Permutation.ShaderType == SHADER_TYPE_VERTEX, EntryPoint};
+        ShaderResources.Serialize(EntryPoint, Resources);
+    }
+
+    std::string GLSL;
+    {
+        // The converter does not expand macros, so they are prepended to the source as #defines
+        // and passed through to the GLSL output. The definitions referenced by the macros are
+        // found by scanning the output, so ConversionAttribs::Macros is intentionally not set.
+        std::string Source;
+        for (const auto& Macro : Permutation.Macros)
+        {
+            Source += "#define ";
+            Source += Macro.first;
+            Source += ' ';
+            Source += Macro.second;
+            Source += '\n';
+        }
+
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        pStreamFactory->CreateInputStream(ShaderCI.FilePath, &pSourceStream);
+        if (!pSourceStream)
+        {
+            printf("Failed to open %s\n", ShaderCI.FilePath);
+            return false;
+        }
+        RefCntAutoPtr<IDataBlob> pSourceData(MakeNewRCObj<DataBlobImpl>()(0));
+        pSourceStream->ReadBlob(pSourceData);
+        Source.append(reinterpret_cast<const char*>(pSourceData->GetDataPtr()), pSourceData->GetSize());
+
+        HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+        Attribs.pSourceStreamFactory       = pStreamFactory;
+        Attribs.HLSLSource                 = Source.c_str();
+        Attribs.NumSymbols                 = Source.length();
+        Attribs.EntryPoint                 = ShaderCI.EntryPoint;
+        Attribs.ShaderType                 = ShaderCI.Desc.ShaderType;
+        Attribs.IncludeDefinitions         = true;
+        Attribs.InputFileName              = ShaderCI.FilePath;
+        Attribs.SamplerSuffix              = ShaderCI.CombinedSamplerSuffix;
+        Attribs.UseInOutLocationQualifiers = UseInOutLocationQualifiers;
+        try
+        {
+            GLSL = HLSL2GLSLConverterImpl::GetInstance().Convert(Attribs);
+        }
+        catch (...)
+        {
+            printf("Failed to convert %s to GLSL\n", Permutation.Name.c_str());
+            return false;
+        }
+    }
+
+    if (!Writer.AddEntry(Permutation.Name.c_str(), Permutation.ShaderType, SPIRV, GLSL, Resources))
+    {
+        printf("Duplicate entry name %s\n", Permutation.Name.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* SearchDirectories          = nullptr;
+    const char* ManifestPath               = nullptr;
+    const char* OutputPath                 = nullptr;
+    bool        UseInOutLocationQualifiers = true;
+    for (int a = 1; a < argc; ++a)
+    {
+        if (strcmp(argv[a], "-I") == 0 && a + 1 < argc)
+            SearchDirectories = argv[++a];
+        else if (strcmp(argv[a], "--no-inout-locations") == 0)
+            UseInOutLocationQualifiers = false;
+        else if (ManifestPath == nullptr)
+            ManifestPath = argv[a];
+        else if (OutputPath == nullptr)
+            OutputPath = argv[a];
+    }
+
+    if (ManifestPath == nullptr || OutputPath == nullptr)
+    {
+        printf("Usage: ShaderArchiver [-I <search directories>] [--no-inout-locations] <manifest file> <output archive>\n"
+               "    -I                   - semicolon-separated list of directories where shader sources are searched\n"
+               "    --no-inout-locations - do not use layout location qualifiers for GLSL shader inputs and outputs.\n"
+               "                           Use this option if the target OpenGL devices do not support separable programs.\n");
+        return -1;
+    }
+
+    std::vector<PermutationInfo> Permutations;
+    if (!ParseManifest(ManifestPath, Permutations))
+        return -1;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pStreamFactory;
+    CreateDefaultShaderSourceStreamFactory(SearchDirectories, &pStreamFactory);
+
+    InitializeGlslang();
+
+    ShaderArchiveWriter Writer;
+    bool                Succeeded = true;
+    for (const auto& Permutation : Permutations)
+    {
+        if (!BuildPermutation(Permutation, pStreamFactory, UseInOutLocationQualifiers, Writer))
+        {
+            Succeeded = false;
+            break;
+        }
+    }
+
+    FinalizeGlslang();
+
+    if (!Succeeded)
+        return -1;
+
+    std::vector<Uint8> ArchiveData;
+    Writer.Write(ArchiveData);
+
+    FILE* pDstFile = fopen(OutputPath, "wb");
+    if (pDstFile == nullptr)
+    {
+        printf("Failed to open destination file %s\n", OutputPath);
+        return -1;
+    }
+    const auto Written = fwrite(ArchiveData.data(), 1, ArchiveData.size(), pDstFile);
+    fclose(pDstFile);
+    if (Written != ArchiveData.size())
+    {
+        printf("Failed to write %s\n", OutputPath);
+        return -1;
+    }
+
+    printf("ShaderArchiver: successfully packed %d shaders into %s\n", static_cast<int>(Permutations.size()), OutputPath);
+
+    return 0;
+}
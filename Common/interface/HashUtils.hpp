@@ -30,7 +30,9 @@
 #include <functional>
 #include <memory>
 #include <cstring>
+#include <type_traits>
 
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/Errors.hpp"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -61,6 +63,67 @@ std::size_t ComputeHash(const ArgsType&... Args)
     return Seed;
 }
 
+/// Computes 64-bit FNV-1a hash of the data.
+
+/// Unlike std::hash, which is only required to produce the same result within a single
+/// execution of a program, the hash is stable and may be stored on disk.
+inline Uint64 ComputeFNV1aHash(const void* pData, size_t Size, Uint64 Hash = 14695981039346656037ull)
+{
+    const auto* pBytes = static_cast<const Uint8*>(pData);
+    for (size_t i = 0; i < Size; ++i)
+        Hash = (Hash ^ pBytes[i]) * 1099511628211ull;
+    return Hash;
+}
+
+/// Computes a 128-bit hash that is stable across executions and platforms and may be used
+/// as a key of a persistent cache.
+
+/// The hasher runs two 64-bit FNV-1a lanes with different offset bases. The first lane
+/// is identical to ComputeFNV1aHash().
+class StableHasher
+{
+public:
+    void Update(const void* pData, size_t Size)
+    {
+        const auto* pBytes = static_cast<const Uint8*>(pData);
+        for (size_t i = 0; i < Size; ++i)
+        {
+            m_Hash0 = (m_Hash0 ^ pBytes[i]) * FNVPrime;
+            m_Hash1 = (m_Hash1 ^ (pBytes[i] ^ 0x5Au)) * FNVPrime;
+        }
+    }
+
+    template <typename T>
+    void Update(const T& Val)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only arithmetic and enum types can be hashed directly");
+        Update(&Val, sizeof(Val));
+    }
+
+    void UpdateStr(const Char* Str, size_t Len)
+    {
+        // Hash the length first so that "ab" + "c" and "a" + "bc" produce different hashes
+        Update(static_cast<Uint64>(Len));
+        Update(Str, Len);
+    }
+
+    void UpdateStr(const Char* Str)
+    {
+        if (Str == nullptr)
+            Str = "";
+        UpdateStr(Str, strlen(Str));
+    }
+
+    Uint64 GetHash0() const { return m_Hash0; }
+    Uint64 GetHash1() const { return m_Hash1; }
+
+private:
+    static constexpr Uint64 FNVPrime = 1099511628211ull;
+
+    Uint64 m_Hash0 = 14695981039346656037ull;
+    Uint64 m_Hash1 = 9650029242287828579ull;
+};
+
 template <typename CharType>
 struct CStringHash
 {
@@ -0,0 +1,334 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::PerfectHashMap and Diligent::PerfectHashSet classes
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/Errors.hpp"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+/// Immutable string-keyed hash map that uses perfect hashing.
+
+/// The map is built once from a set of unique keys, after which it cannot be modified.
+/// Every key is mapped to its own slot using the hash-and-displace scheme: the key's hash
+/// selects a bucket, and the displacement seed stored for the bucket selects a slot that
+/// no other key occupies. A lookup thus hashes the key once and compares it with at most one
+/// stored key. All data lives in a few flat arrays, and lookups never allocate memory,
+/// so the map can be safely accessed by any number of threads.
+///
+/// Lookups take a pointer and a length, so the key does not need to be null-terminated
+/// and a substring of a larger text can be looked up without copying it.
+template <typename ValueType>
+class PerfectHashMap
+{
+public:
+    using EntryType = std::pair<String, ValueType>;
+
+    PerfectHashMap() {}
+
+    /// Builds the map from the list of unique keys and their values
+    explicit PerfectHashMap(std::vector<EntryType> Entries)
+    {
+        Build(std::move(Entries));
+    }
+
+    // clang-format off
+    PerfectHashMap           (const PerfectHashMap&) = default;
+    PerfectHashMap           (PerfectHashMap&&)      = default;
+    PerfectHashMap& operator=(const PerfectHashMap&) = default;
+    PerfectHashMap& operator=(PerfectHashMap&&)      = default;
+    // clang-format on
+
+    /// Returns a pointer to the value of the key, or null if the key is not found
+    const ValueType* Find(const Char* Key, size_t Length) const
+    {
+        if (m_Slots.empty() || Length > m_MaxKeyLength)
+            return nullptr;
+
+        const auto  Hash = ComputeKeyHash(Key, Length);
+        const auto& Slot = m_Slots[GetSlotIndex(Hash, m_Seeds[GetBucketIndex(Hash)])];
+        if (Slot.ValueIdx == InvalidIndex || Slot.Hash != Hash || Slot.KeyLength != Length ||
+            memcmp(&m_KeyChars[Slot.KeyOffset], Key, Length) != 0)
+            return nullptr;
+
+        return &m_Values[Slot.ValueIdx];
+    }
+
+    const ValueType* Find(const Char* Key) const
+    {
+        VERIFY_EXPR(Key != nullptr);
+        return Find(Key, strlen(Key));
+    }
+
+    const ValueType* Find(const String& Key) const
+    {
+        return Find(Key.c_str(), Key.length());
+    }
+
+    /// Returns a pointer to the value of the key whose hash is Hash, or null if there is no such key
+
+    /// The hash must be computed by ComputeKeyHash(). Keys are not compared, so the caller
+    /// must only use hashes of the keys it expects to be in the map. Building the map fails
+    /// if two keys have the same hash, so each hash identifies at most one key.
+    const ValueType* FindByHash(Uint64 Hash) const
+    {
+        if (m_Slots.empty())
+            return nullptr;
+
+        const auto& Slot = m_Slots[GetSlotIndex(Hash, m_Seeds[GetBucketIndex(Hash)])];
+        if (Slot.ValueIdx == InvalidIndex || Slot.Hash != Hash)
+            return nullptr;
+
+        return &m_Values[Slot.ValueIdx];
+    }
+
+    /// Computes the hash of the key that is used by the map, see FindByHash()
+    static Uint64 ComputeKeyHash(const Char* Key, size_t Length)
+    {
+        return ComputeFNV1aHash(Key, Length);
+    }
+
+    size_t size() const { return m_Values.size(); }
+    bool   empty() const { return m_Values.empty(); }
+
+    /// Returns the number of slots, which is always a power of two greater than or equal to size()
+    size_t GetSlotCount() const { return m_Slots.size(); }
+
+private:
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    struct Slot
+    {
+        Uint64 Hash      = 0;
+        Uint32 KeyOffset = 0;
+        Uint32 KeyLength = 0;
+        Uint32 ValueIdx  = InvalidIndex;
+    };
+
+    static Uint64 Mix(Uint64 h)
+    {
+        // MurmurHash3 finalizer
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    size_t GetBucketIndex(Uint64 Hash) const
+    {
+        return static_cast<size_t>(Mix(Hash) & (m_Seeds.size() - 1));
+    }
+
+    size_t GetSlotIndex(Uint64 Hash, Uint32 Seed) const
+    {
+        return static_cast<size_t>(Mix(Hash ^ (Uint64{Seed} * 0x9e3779b97f4a7c15ull)) & (m_Slots.size() - 1));
+    }
+
+    static size_t NextPowerOfTwo(size_t Val)
+    {
+        size_t Pow2 = 1;
+        while (Pow2 < Val)
+            Pow2 <<= 1;
+        return Pow2;
+    }
+
+    void Build(std::vector<EntryType> Entries)
+    {
+        if (Entries.empty())
+            return;
+
+        const auto NumKeys = Entries.size();
+
+        std::vector<Uint64> Hashes(NumKeys);
+        for (size_t i = 0; i < NumKeys; ++i)
+        {
+            const auto& Key = Entries[i].first;
+            Hashes[i]       = ComputeKeyHash(Key.c_str(), Key.length());
+            m_MaxKeyLength  = std::max(m_MaxKeyLength, Key.length());
+        }
+
+        // Every bucket contains two keys on average
+        m_Seeds.resize(NextPowerOfTwo((NumKeys + 1) / 2));
+        std::vector<std::vector<Uint32>> Buckets(m_Seeds.size());
+        for (Uint32 i = 0; i < NumKeys; ++i)
+            Buckets[GetBucketIndex(Hashes[i])].push_back(i);
+
+        // Place the largest buckets first while there are many free slots
+        std::vector<Uint32> BucketOrder(Buckets.size());
+        for (Uint32 b = 0; b < BucketOrder.size(); ++b)
+            BucketOrder[b] = b;
+        std::stable_sort(BucketOrder.begin(), BucketOrder.end(), [&Buckets](Uint32 b0, Uint32 b1) {
+            return Buckets[b0].size() > Buckets[b1].size();
+        });
+
+        // Keep the load factor below 1/2
+        auto NumSlots = NextPowerOfTwo(NumKeys * 2);
+
+        static constexpr Uint32 MaxSeedAttempts = 1u << 16;
+
+        std::vector<size_t> BucketSlots;
+        while (true)
+        {
+            m_Slots.assign(NumSlots, Slot{});
+            std::fill(m_Seeds.begin(), m_Seeds.end(), 0u);
+
+            bool AllPlaced = true;
+            for (auto b : BucketOrder)
+            {
+                const auto& Bucket = Buckets[b];
+                if (Bucket.empty())
+                    break;
+
+                bool Placed = false;
+                for (Uint32 Seed = 0; Seed < MaxSeedAttempts && !Placed; ++Seed)
+                {
+                    BucketSlots.clear();
+                    Placed = true;
+                    for (auto KeyIdx : Bucket)
+                    {
+                        const auto SlotIdx = GetSlotIndex(Hashes[KeyIdx], Seed);
+                        if (m_Slots[SlotIdx].ValueIdx != InvalidIndex ||
+                            std::find(BucketSlots.begin(), BucketSlots.end(), SlotIdx) != BucketSlots.end())
+                        {
+                            Placed = false;
+                            break;
+                        }
+                        BucketSlots.push_back(SlotIdx);
+                    }
+
+                    if (Placed)
+                    {
+                        m_Seeds[b] = Seed;
+                        for (size_t i = 0; i < Bucket.size(); ++i)
+                        {
+                            auto& Slot    = m_Slots[BucketSlots[i]];
+                            Slot.Hash     = Hashes[Bucket[i]];
+                            Slot.ValueIdx = Bucket[i];
+                        }
+                    }
+                }
+
+                if (!Placed)
+                {
+                    AllPlaced = false;
+                    break;
+                }
+            }
+
+            if (AllPlaced)
+                break;
+
+            // Keys in the bucket may have the same hash, which happens for duplicate keys
+            // or (extremely rarely) for hash collisions, or the table is too dense.
+            for (auto b : BucketOrder)
+            {
+                const auto& Bucket = Buckets[b];
+                for (size_t i = 0; i < Bucket.size(); ++i)
+                {
+                    for (size_t j = i + 1; j < Bucket.size(); ++j)
+                    {
+                        if (Hashes[Bucket[i]] == Hashes[Bucket[j]])
+                        {
+                            LOG_ERROR_AND_THROW(Entries[Bucket[i]].first == Entries[Bucket[j]].first ? "Duplicate key '" : "Hash collision for key '",
+                                                Entries[Bucket[j]].first, "'");
+                        }
+                    }
+                }
+            }
+            NumSlots *= 2;
+        }
+
+        // Store keys and values in the order of slots to improve locality
+        m_Values.reserve(NumKeys);
+        for (auto& Slot : m_Slots)
+        {
+            if (Slot.ValueIdx == InvalidIndex)
+                continue;
+
+            auto& Entry    = Entries[Slot.ValueIdx];
+            Slot.KeyOffset = static_cast<Uint32>(m_KeyChars.size());
+            Slot.KeyLength = static_cast<Uint32>(Entry.first.length());
+            m_KeyChars.insert(m_KeyChars.end(), Entry.first.begin(), Entry.first.end());
+            Slot.ValueIdx = static_cast<Uint32>(m_Values.size());
+            m_Values.emplace_back(std::move(Entry.second));
+        }
+    }
+
+    std::vector<Slot>      m_Slots;
+    std::vector<Uint32>    m_Seeds;
+    std::vector<Char>      m_KeyChars;
+    std::vector<ValueType> m_Values;
+    size_t                 m_MaxKeyLength = 0;
+};
+
+/// Immutable string set that uses perfect hashing, see PerfectHashMap
+class PerfectHashSet
+{
+public:
+    PerfectHashSet() {}
+
+    /// Builds the set from the list of unique keys
+    explicit PerfectHashSet(const std::vector<String>& Keys)
+    {
+        std::vector<MapType::EntryType> Entries;
+        Entries.reserve(Keys.size());
+        for (const auto& Key : Keys)
+            Entries.emplace_back(Key, EmptyValue{});
+        m_Map = MapType{std::move(Entries)};
+    }
+
+    bool Contains(const Char* Key, size_t Length) const { return m_Map.Find(Key, Length) != nullptr; }
+    bool Contains(const Char* Key) const { return m_Map.Find(Key) != nullptr; }
+    bool Contains(const String& Key) const { return m_Map.Find(Key) != nullptr; }
+
+    size_t size() const { return m_Map.size(); }
+    bool   empty() const { return m_Map.empty(); }
+
+private:
+    struct EmptyValue
+    {};
+    using MapType = PerfectHashMap<EmptyValue>;
+
+    MapType m_Map;
+};
+
+} // namespace Diligent
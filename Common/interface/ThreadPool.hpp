@@ -0,0 +1,188 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ThreadPool class
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <memory>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Fixed-size pool of worker threads that execute tasks in FIFO order.
+
+/// A task may own the last reference to the object that owns the pool, so the pool may be
+/// destroyed by one of its own worker threads. The state shared with the worker threads is
+/// reference-counted for this reason.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t NumThreads) :
+        m_pState{std::make_shared<State>()}
+    {
+        VERIFY(NumThreads > 0, "The number of threads must not be zero");
+        m_Threads.reserve(NumThreads);
+        for (size_t i = 0; i < NumThreads; ++i)
+            m_Threads.emplace_back(&ThreadPool::WorkerThreadFunc, m_pState);
+    }
+
+    // clang-format off
+    ThreadPool             (const ThreadPool&) = delete;
+    ThreadPool             (ThreadPool&&)      = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
+    ThreadPool& operator = (ThreadPool&&)      = delete;
+    // clang-format on
+
+    /// Executes all pending tasks and stops the worker threads.
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_pState->Mutex};
+            m_pState->Stop = true;
+        }
+        m_pState->TaskCondVar.notify_all();
+        for (auto& Thread : m_Threads)
+        {
+            // A thread cannot join itself. If the pool is destroyed by one of its tasks,
+            // the thread finishes the remaining tasks and exits on its own.
+            if (Thread.get_id() == std::this_thread::get_id())
+                Thread.detach();
+            else
+                Thread.join();
+        }
+    }
+
+    /// Adds the task to the queue. The returned future becomes ready when the task is complete.
+    /// Exceptions thrown by the task are stored in the future.
+    template <typename TaskType>
+    std::future<void> EnqueueTask(TaskType&& Task)
+    {
+        std::packaged_task<void()> PackagedTask{std::forward<TaskType>(Task)};
+
+        auto Future = PackagedTask.get_future();
+        {
+            std::lock_guard<std::mutex> Lock{m_pState->Mutex};
+            VERIFY(!m_pState->Stop, "Enqueuing a task into a thread pool that is being destroyed");
+            m_pState->Tasks.emplace_back(std::move(PackagedTask));
+        }
+        m_pState->TaskCondVar.notify_one();
+        return Future;
+    }
+
+    /// Blocks until the task queue is empty and no task is being executed.
+    void WaitForAllTasks()
+    {
+        auto&                        S = *m_pState;
+        std::unique_lock<std::mutex> Lock{S.Mutex};
+        S.IdleCondVar.wait(Lock, [&S] { return S.Tasks.empty() && S.NumRunningTasks == 0; });
+    }
+
+    size_t GetNumThreads() const
+    {
+        return m_Threads.size();
+    }
+
+    /// Returns true if the calling thread is one of the worker threads of this pool.
+    /// A task that waits for other tasks of the same pool may deadlock the pool.
+    bool IsWorkerThread() const
+    {
+        const auto ThisThreadId = std::this_thread::get_id();
+        for (const auto& Thread : m_Threads)
+        {
+            if (Thread.get_id() == ThisThreadId)
+                return true;
+        }
+        return false;
+    }
+
+    /// Returns the number of tasks that are queued or running.
+    size_t GetNumPendingTasks()
+    {
+        std::lock_guard<std::mutex> Lock{m_pState->Mutex};
+        return m_pState->Tasks.size() + m_pState->NumRunningTasks;
+    }
+
+private:
+    struct State
+    {
+        std::mutex                             Mutex;
+        std::condition_variable                TaskCondVar;
+        std::condition_variable                IdleCondVar;
+        std::deque<std::packaged_task<void()>> Tasks;
+        size_t                                 NumRunningTasks = 0;
+        bool                                   Stop            = false;
+    };
+
+    static void WorkerThreadFunc(std::shared_ptr<State> pState)
+    {
+        auto& S = *pState;
+        for (;;)
+        {
+            std::packaged_task<void()> Task;
+            {
+                std::unique_lock<std::mutex> Lock{S.Mutex};
+                S.TaskCondVar.wait(Lock, [&S] { return S.Stop || !S.Tasks.empty(); });
+                if (S.Tasks.empty())
+                {
+                    // Stop is set and all tasks have been executed
+                    return;
+                }
+                Task = std::move(S.Tasks.front());
+                S.Tasks.pop_front();
+                ++S.NumRunningTasks;
+            }
+
+            Task();
+            // Release the objects owned by the task before it is reported as complete
+            Task = std::packaged_task<void()>{};
+
+            bool IsIdle = false;
+            {
+                std::lock_guard<std::mutex> Lock{S.Mutex};
+                --S.NumRunningTasks;
+                IsIdle = S.Tasks.empty() && S.NumRunningTasks == 0;
+            }
+            if (IsIdle)
+                S.IdleCondVar.notify_all();
+        }
+    }
+
+    std::shared_ptr<State>   m_pState;
+    std::vector<std::thread> m_Threads;
+};
+
+} // namespace Diligent
@@ -99,6 +99,22 @@ public:
                                ResourceType                 _Type,
                                Uint32                       _SamplerOrSepImgInd = InvalidSepSmplrOrImgInd) noexcept;
 
+    // clang-format off
+    SPIRVShaderResourceAttribs(const char*  _Name,
+                               Uint16       _ArraySize,
+                               ResourceType _Type,
+                               Uint32       _SepSmplrOrImgInd,
+                               uint32_t     _BindingDecorationOffset,
+                               uint32_t     _DescriptorSetDecorationOffset) noexcept :
+        Name                          {_Name},
+        ArraySize                     {_ArraySize},
+        Type                          {_Type},
+        SepSmplrOrImgInd              {_SepSmplrOrImgInd},
+        BindingDecorationOffset       {_BindingDecorationOffset},
+        DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset}
+    {}
+    // clang-format on
+
     bool IsValidSepSamplerAssigned() const
     {
         VERIFY_EXPR(Type == SeparateImage);
@@ -135,6 +151,12 @@ public:
         SepSmplrOrImgInd = SepImageInd;
     }
 
+    // Runtime-sized arrays (e.g. Texture2D g_Textures[]) have zero array size
+    bool IsRuntimeArray() const
+    {
+        return ArraySize == 0;
+    }
+
     String GetPrintName(Uint32 ArrayInd) const
     {
         VERIFY_EXPR(ArrayInd < ArraySize);
@@ -188,6 +210,16 @@ public:
                          bool                  LoadShaderStageInputs,
                          std::string&          EntryPoint);
 
+    /// Initializes resources from the data produced by Serialize() without parsing the byte code.
+    /// CombinedSamplerSuffix must be the same as the one used to create serialized resources.
+    /// Throws an exception if the data is malformed.
+    SPIRVShaderResources(IMemoryAllocator& Allocator,
+                         const void*       pSerializedData,
+                         size_t            DataSize,
+                         const ShaderDesc& shaderDesc,
+                         const char*       CombinedSamplerSuffix,
+                         std::string&      EntryPoint);
+
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
     SPIRVShaderResources             (      SPIRVShaderResources&&) = delete;
@@ -318,6 +350,11 @@ public:
 
     std::string DumpResources();
 
+    /// Writes resource attributes, stage inputs and the entry point name into a compact
+    /// binary blob. All names are stored in a single string pool. The shader name and
+    /// combined sampler suffix are not serialized.
+    void Serialize(const std::string& EntryPoint, std::vector<Uint8>& Data) const;
+
     bool IsCompatibleWith(const SPIRVShaderResources& Resources) const;
 
     // clang-format off
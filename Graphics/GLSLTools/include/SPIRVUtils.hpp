@@ -28,8 +28,10 @@
 #pragma once
 
 #include <vector>
+#include <string>
 #include "Shader.h"
 #include "DataBlob.h"
+#include "GraphicsTypes.h"
 
 namespace Diligent
 {
@@ -37,7 +39,31 @@ namespace Diligent
 void InitializeGlslang();
 void FinalizeGlslang();
 
-std::vector<unsigned int> GLSLtoSPIRV(SHADER_TYPE ShaderType, const char* ShaderSource, int SourceCodeLen, IDataBlob** ppCompilerOutput);
-std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& Attribs, IDataBlob** ppCompilerOutput);
+// Compiles the shader and optimizes the resulting byte code as requested by OptimizationFlags.
+// SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO is ignored as debug names are required for reflection.
+// If ppCompilerOutput is not null, the compiler output reports SPIR-V instruction counts
+// before and after optimization.
+std::vector<unsigned int> GLSLtoSPIRV(SHADER_TYPE              ShaderType,
+                                      const char*              ShaderSource,
+                                      int                      SourceCodeLen,
+                                      IDataBlob**              ppCompilerOutput,
+                                      SPIRV_OPTIMIZATION_FLAGS OptimizationFlags = SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+
+std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo&  Attribs,
+                                      IDataBlob**              ppCompilerOutput,
+                                      SPIRV_OPTIMIZATION_FLAGS OptimizationFlags = SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+
+// Returns the number of instructions in the SPIR-V module, not counting the header.
+size_t GetSPIRVInstructionCount(const std::vector<unsigned int>& SPIRV);
+
+// Removes reflection decorations (SPV_GOOGLE_hlsl_functionality1) that must not be passed
+// to vkCreateShaderModule and, if StripDebugInfo is true, debug instructions (OpSource, OpName,
+// OpLine, etc.). Must be called after the shader has been reflected.
+// Returns an empty vector if the optimizer fails.
+std::vector<unsigned int> StripReflection(const std::vector<unsigned int>& OriginalSPIRV, bool StripDebugInfo);
+
+// Returns the string that identifies the compiler configuration. SPIR-V byte code
+// produced by the compilers with different version strings may be different.
+std::string GetSPIRVCompilerVersion();
 
 } // namespace Diligent
\ No newline at end of file
@@ -321,6 +321,7 @@ String BuildGLSLSourceString(const ShaderCreateInfo& CreationAttribs,
         Attribs.IncludeDefinitions   = true;
         Attribs.InputFileName        = CreationAttribs.FilePath;
         Attribs.SamplerSuffix        = CreationAttribs.CombinedSamplerSuffix;
+        Attribs.Macros               = CreationAttribs.Macros;
         // Separate shader objects extension also allows input/output layout qualifiers for
         // all shader stages.
         // https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_separate_shader_objects.txt
@@ -26,6 +26,7 @@
  */
 
 #include <iomanip>
+#include <cstring>
 #include "SPIRVShaderResources.hpp"
 #include "spirv_parser.hpp"
 #include "spirv_cross.hpp"
@@ -47,6 +48,7 @@ Type GetResourceArraySize(const spirv_cross::Compiler& Compiler,
     {
         // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide#querying-array-types
         VERIFY(type.array.size() == 1, "Only one-dimensional arrays are currently supported");
+        // Runtime-sized arrays are reported as arrays of size 0
         arrSize = type.array[0];
     }
     VERIFY(arrSize <= std::numeric_limits<Type>::max(), "Array size exceeds maximum representable value ", std::numeric_limits<Type>::max());
@@ -501,6 +503,237 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
 #endif
 }
 
+namespace
+{
+
+// Increment the version whenever the layout of the serialized data changes
+constexpr Uint32 SerializedResourcesMagic   = 0x52505344; // 'DSPR'
+constexpr Uint32 SerializedResourcesVersion = 1;
+
+// Serialized data layout:
+//
+//  | Header | Resource attribs (TotalResources) | Stage input attribs (NumStageInputs) | String pool |
+//
+// Names are stored as offsets into the string pool of null-terminated strings.
+struct SerializedResourcesHeader
+{
+    Uint32 Magic   = SerializedResourcesMagic;
+    Uint32 Version = SerializedResourcesVersion;
+
+    Uint32 NumUBs         = 0;
+    Uint32 NumSBs         = 0;
+    Uint32 NumImgs        = 0;
+    Uint32 NumSmpldImgs   = 0;
+    Uint32 NumACs         = 0;
+    Uint32 NumSepSmplrs   = 0;
+    Uint32 NumSepImgs     = 0;
+    Uint32 NumStageInputs = 0;
+
+    Uint32 EntryPointOffset = 0;
+    Uint32 StringPoolSize   = 0;
+};
+
+struct SerializedResourceAttribs
+{
+    Uint32 NameOffset                    = 0;
+    Uint32 SepSmplrOrImgInd              = SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd;
+    Uint32 BindingDecorationOffset       = 0;
+    Uint32 DescriptorSetDecorationOffset = 0;
+    Uint16 ArraySize                     = 0;
+    Uint8  Type                          = 0;
+    Uint8  Padding                       = 0;
+};
+static_assert(sizeof(SerializedResourceAttribs) == 20, "Unexpected size of SerializedResourceAttribs, please update serialization version");
+
+struct SerializedStageInputAttribs
+{
+    Uint32 SemanticOffset           = 0;
+    Uint32 LocationDecorationOffset = 0;
+};
+
+} // namespace
+
+void SPIRVShaderResources::Serialize(const std::string& EntryPoint, std::vector<Uint8>& Data) const
+{
+    std::string StringPool;
+
+    auto AddString = [&StringPool](const char* Str) {
+        auto Offset = static_cast<Uint32>(StringPool.length());
+        StringPool.append(Str);
+        StringPool.push_back('\0');
+        return Offset;
+    };
+
+    SerializedResourcesHeader Header;
+    Header.NumUBs           = GetNumUBs();
+    Header.NumSBs           = GetNumSBs();
+    Header.NumImgs          = GetNumImgs();
+    Header.NumSmpldImgs     = GetNumSmpldImgs();
+    Header.NumACs           = GetNumACs();
+    Header.NumSepSmplrs     = GetNumSepSmplrs();
+    Header.NumSepImgs       = GetNumSepImgs();
+    Header.NumStageInputs   = GetNumShaderStageInputs();
+    Header.EntryPointOffset = AddString(EntryPoint.c_str());
+
+    std::vector<SerializedResourceAttribs> Resources(GetTotalResources());
+    ProcessResources(
+        [&](const SPIRVShaderResourceAttribs& Res, Uint32 n) {
+            auto& SerializedRes                         = Resources[n];
+            SerializedRes.NameOffset                    = AddString(Res.Name);
+            SerializedRes.BindingDecorationOffset       = Res.BindingDecorationOffset;
+            SerializedRes.DescriptorSetDecorationOffset = Res.DescriptorSetDecorationOffset;
+            SerializedRes.ArraySize                     = Res.ArraySize;
+            SerializedRes.Type                          = static_cast<Uint8>(Res.Type);
+            if (Res.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage)
+                SerializedRes.SepSmplrOrImgInd = Res.GetAssignedSepSamplerInd();
+            else if (Res.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler)
+                SerializedRes.SepSmplrOrImgInd = Res.GetAssignedSepImageInd();
+        });
+
+    std::vector<SerializedStageInputAttribs> StageInputs(GetNumShaderStageInputs());
+    for (Uint32 i = 0; i < GetNumShaderStageInputs(); ++i)
+    {
+        const auto& Input                       = GetShaderStageInputAttribs(i);
+        StageInputs[i].SemanticOffset           = AddString(Input.Semantic);
+        StageInputs[i].LocationDecorationOffset = Input.LocationDecorationOffset;
+    }
+
+    Header.StringPoolSize = static_cast<Uint32>(StringPool.length());
+
+    const auto ResourcesSize   = Resources.size() * sizeof(SerializedResourceAttribs);
+    const auto StageInputsSize = StageInputs.size() * sizeof(SerializedStageInputAttribs);
+    Data.resize(sizeof(Header) + ResourcesSize + StageInputsSize + StringPool.length());
+
+    auto* pDst = Data.data();
+    memcpy(pDst, &Header, sizeof(Header));
+    pDst += sizeof(Header);
+    if (ResourcesSize != 0)
+        memcpy(pDst, Resources.data(), ResourcesSize);
+    pDst += ResourcesSize;
+    if (StageInputsSize != 0)
+        memcpy(pDst, StageInputs.data(), StageInputsSize);
+    pDst += StageInputsSize;
+    memcpy(pDst, StringPool.data(), StringPool.length());
+}
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator& Allocator,
+                                           const void*       pSerializedData,
+                                           size_t            DataSize,
+                                           const ShaderDesc& shaderDesc,
+                                           const char*       CombinedSamplerSuffix,
+                                           std::string&      EntryPoint) :
+    m_ShaderType{shaderDesc.ShaderType}
+{
+    const auto* pBytes = reinterpret_cast<const Uint8*>(pSerializedData);
+
+    SerializedResourcesHeader Header;
+    if (pBytes == nullptr || DataSize < sizeof(Header))
+        LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' are too small");
+    memcpy(&Header, pBytes, sizeof(Header));
+    if (Header.Magic != SerializedResourcesMagic || Header.Version != SerializedResourcesVersion)
+        LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' have unexpected format");
+
+    ResourceCounters ResCounters;
+    ResCounters.NumUBs       = Header.NumUBs;
+    ResCounters.NumSBs       = Header.NumSBs;
+    ResCounters.NumImgs      = Header.NumImgs;
+    ResCounters.NumSmpldImgs = Header.NumSmpldImgs;
+    ResCounters.NumACs       = Header.NumACs;
+    ResCounters.NumSepSmplrs = Header.NumSepSmplrs;
+    ResCounters.NumSepImgs   = Header.NumSepImgs;
+
+    // Use 64-bit arithmetic to avoid overflows on malformed data
+    const Uint64 TotalResources = Uint64{Header.NumUBs} + Header.NumSBs + Header.NumImgs + Header.NumSmpldImgs +
+        Header.NumACs + Header.NumSepSmplrs + Header.NumSepImgs;
+
+    const Uint64 ExpectedSize = sizeof(Header) +
+        TotalResources * sizeof(SerializedResourceAttribs) +
+        Uint64{Header.NumStageInputs} * sizeof(SerializedStageInputAttribs) +
+        Header.StringPoolSize;
+    if (TotalResources + Header.NumStageInputs > std::numeric_limits<OffsetType>::max() || ExpectedSize != DataSize)
+        LOG_ERROR_AND_THROW("Serialized resources of shader '", shaderDesc.Name, "' are corrupted");
+
+    const auto* pResourcesData   = pBytes + sizeof(Header);
+    const auto* pStageInputsData = pResourcesData + TotalResources * sizeof(SerializedResourceAttribs);
+    const auto* StringPool       = reinterpret_cast<const char*>(pStageInputsData + Header.NumStageInputs * sizeof(SerializedStageInputAttribs));
+    if (Header.StringPoolSize == 0 || StringPool[Header.StringPoolSize - 1] != '\0')
+        LOG_ERROR_AND_THROW("String pool of serialized resources of shader '", shaderDesc.Name, "' is corrupted");
+
+    auto GetString = [&](Uint32 Offset) {
+        if (Offset >= Header.StringPoolSize)
+            LOG_ERROR_AND_THROW("Invalid string offset in serialized resources of shader '", shaderDesc.Name, "'");
+        return StringPool + Offset;
+    };
+
+    // Data may be unaligned, so the attribs are copied one by one
+    auto ReadResource = [pResourcesData](Uint32 n) {
+        SerializedResourceAttribs Res;
+        memcpy(&Res, pResourcesData + n * sizeof(SerializedResourceAttribs), sizeof(Res));
+        return Res;
+    };
+    auto ReadStageInput = [pStageInputsData](Uint32 n) {
+        SerializedStageInputAttribs Input;
+        memcpy(&Input, pStageInputsData + n * sizeof(SerializedStageInputAttribs), sizeof(Input));
+        return Input;
+    };
+
+    // Validate the data before any resource is constructed
+    size_t ResourceNamesPoolSize = 0;
+    for (Uint32 n = 0; n < TotalResources; ++n)
+    {
+        const auto Res = ReadResource(n);
+        ResourceNamesPoolSize += strlen(GetString(Res.NameOffset)) + 1;
+
+        const auto Type = static_cast<SPIRVShaderResourceAttribs::ResourceType>(Res.Type);
+        if (Res.Type >= SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes ||
+            (Res.SepSmplrOrImgInd != SPIRVShaderResourceAttribs::InvalidSepSmplrOrImgInd &&
+             !((Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage && Res.SepSmplrOrImgInd < Header.NumSepSmplrs) ||
+               (Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler && Res.SepSmplrOrImgInd < Header.NumSepImgs))))
+        {
+            LOG_ERROR_AND_THROW("Invalid resource attributes in serialized resources of shader '", shaderDesc.Name, "'");
+        }
+    }
+    for (Uint32 i = 0; i < Header.NumStageInputs; ++i)
+        ResourceNamesPoolSize += strlen(GetString(ReadStageInput(i).SemanticOffset)) + 1;
+    EntryPoint = GetString(Header.EntryPointOffset);
+
+    if (CombinedSamplerSuffix != nullptr)
+        ResourceNamesPoolSize += strlen(CombinedSamplerSuffix) + 1;
+
+    VERIFY_EXPR(shaderDesc.Name != nullptr);
+    ResourceNamesPoolSize += strlen(shaderDesc.Name) + 1;
+
+    Initialize(Allocator, ResCounters, Header.NumStageInputs, ResourceNamesPoolSize);
+
+    for (Uint32 n = 0; n < GetTotalResources(); ++n)
+    {
+        const auto Res = ReadResource(n);
+        new (&GetResource(n))
+            SPIRVShaderResourceAttribs(m_ResourceNames.CopyString(StringPool + Res.NameOffset),
+                                       Res.ArraySize,
+                                       static_cast<SPIRVShaderResourceAttribs::ResourceType>(Res.Type),
+                                       Res.SepSmplrOrImgInd,
+                                       Res.BindingDecorationOffset,
+                                       Res.DescriptorSetDecorationOffset);
+    }
+
+    for (Uint32 i = 0; i < GetNumShaderStageInputs(); ++i)
+    {
+        const auto Input = ReadStageInput(i);
+        new (&GetShaderStageInputAttribs(i))
+            SPIRVShaderStageInputAttribs(m_ResourceNames.CopyString(StringPool + Input.SemanticOffset), Input.LocationDecorationOffset);
+    }
+
+    if (CombinedSamplerSuffix != nullptr)
+    {
+        m_CombinedSamplerSuffix = m_ResourceNames.CopyString(CombinedSamplerSuffix);
+    }
+
+    m_ShaderName = m_ResourceNames.CopyString(shaderDesc.Name);
+
+    VERIFY(m_ResourceNames.GetRemainingSize() == 0, "Names pool must be empty");
+}
+
 void SPIRVShaderResources::Initialize(IMemoryAllocator&       Allocator,
                                       const ResourceCounters& Counters,
                                       Uint32                  NumShaderStageInputs,
@@ -29,6 +29,7 @@
 #include <unordered_map>
 #include <memory>
 #include <array>
+#include <string>
 
 #if (defined(VK_USE_PLATFORM_IOS_MVK) || defined(VK_USE_PLATFORM_MACOS_MVK))
 #    include <MoltenGLSLToSPIRVConverter/GLSLToSPIRVConverter.h>
@@ -41,6 +42,7 @@
 #include "DebugUtilities.hpp"
 #include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "HashUtils.hpp"
 
 #include "spirv-tools/optimizer.hpp"
 
@@ -309,6 +311,22 @@ public:
     }
 };
 
+static void WriteCompilerOutput(const std::string& Log,
+                                const char*        ShaderSource,
+                                size_t             SourceCodeLen,
+                                IDataBlob**        ppCompilerOutput)
+{
+    if (ppCompilerOutput == nullptr)
+        return;
+
+    auto* pOutputDataBlob = MakeNewRCObj<DataBlobImpl>()(SourceCodeLen + 1 + Log.length() + 1);
+    char* DataPtr         = reinterpret_cast<char*>(pOutputDataBlob->GetDataPtr());
+    memcpy(DataPtr, Log.data(), Log.length() + 1);
+    memcpy(DataPtr + Log.length() + 1, ShaderSource, SourceCodeLen);
+    DataPtr[Log.length() + 1 + SourceCodeLen] = '\0';
+    pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppCompilerOutput));
+}
+
 static void LogCompilerError(const char* DebugOutputMessage,
                              const char* InfoLog,
                              const char* InfoDebugLog,
@@ -324,14 +342,7 @@ static void LogCompilerError(const char* DebugOutputMessage,
     }
     LOG_ERROR_MESSAGE(DebugOutputMessage, ErrorLog);
 
-    if (ppCompilerOutput != nullptr)
-    {
-        auto* pOutputDataBlob = MakeNewRCObj<DataBlobImpl>()(SourceCodeLen + 1 + ErrorLog.length() + 1);
-        char* DataPtr         = reinterpret_cast<char*>(pOutputDataBlob->GetDataPtr());
-        memcpy(DataPtr, ErrorLog.data(), ErrorLog.length() + 1);
-        memcpy(DataPtr + ErrorLog.length() + 1, ShaderSource, SourceCodeLen + 1);
-        pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppCompilerOutput));
-    }
+    WriteCompilerOutput(ErrorLog, ShaderSource, SourceCodeLen, ppCompilerOutput);
 }
 
 static std::vector<unsigned int> CompileShaderInternal(glslang::TShader&           Shader,
@@ -372,6 +383,111 @@ static std::vector<unsigned int> CompileShaderInternal(glslang::TShader&
 }
 
 
+size_t GetSPIRVInstructionCount(const std::vector<unsigned int>& SPIRV)
+{
+    // The first five words are the module header
+    constexpr size_t HeaderSize = 5;
+
+    size_t NumInstructions = 0;
+    for (size_t Offset = HeaderSize; Offset < SPIRV.size();)
+    {
+        // High 16 bits of the first instruction word contain the instruction word count
+        const auto WordCount = SPIRV[Offset] >> 16;
+        if (WordCount == 0)
+            break; // Malformed byte code
+        Offset += WordCount;
+        ++NumInstructions;
+    }
+    return NumInstructions;
+}
+
+// Runs legalization (for SPIR-V generated from HLSL) and optimization passes requested by OptimizationFlags.
+// Returns the original byte code if there is nothing to do or if the optimizer fails.
+static std::vector<unsigned int> OptimizeSPIRV(std::vector<unsigned int>&& SPIRV,
+                                               bool                        Legalize,
+                                               SPIRV_OPTIMIZATION_FLAGS    OptimizationFlags,
+                                               const char*                 ShaderSource,
+                                               size_t                      SourceCodeLen,
+                                               IDataBlob**                 ppCompilerOutput)
+{
+    spvtools::Optimizer SpirvOptimizer(SPV_ENV_VULKAN_1_0);
+
+    bool HasPasses = false;
+    if (Legalize)
+    {
+        // SPIR-V bytecode generated from HLSL must be legalized to
+        // turn it into a valid vulkan SPIR-V shader
+        SpirvOptimizer.RegisterLegalizationPasses();
+        HasPasses = true;
+    }
+    if (OptimizationFlags & SPIRV_OPTIMIZATION_FLAG_PERFORMANCE)
+    {
+        SpirvOptimizer.RegisterPerformancePasses();
+        HasPasses = true;
+    }
+    if (OptimizationFlags & SPIRV_OPTIMIZATION_FLAG_SIZE)
+    {
+        SpirvOptimizer.RegisterSizePasses();
+        HasPasses = true;
+    }
+    if (OptimizationFlags & SPIRV_OPTIMIZATION_FLAG_DEAD_CODE_ELIMINATION)
+    {
+        SpirvOptimizer.RegisterPass(spvtools::CreateEliminateDeadFunctionsPass());
+        SpirvOptimizer.RegisterPass(spvtools::CreateDeadBranchElimPass());
+        SpirvOptimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
+        HasPasses = true;
+    }
+    // Debug information can't be stripped here because names are required for
+    // shader reflection. SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO is handled when
+    // shader modules are created.
+
+    if (!HasPasses)
+        return std::move(SPIRV);
+
+    std::vector<unsigned int> OptimizedSPIRV;
+    if (!SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &OptimizedSPIRV))
+    {
+        if (Legalize)
+            LOG_ERROR("Failed to legalize SPIR-V shader generated by HLSL front-end. This may result in undefined behavior.");
+        else
+            LOG_ERROR("Failed to optimize SPIR-V.");
+        return std::move(SPIRV);
+    }
+
+    if (ppCompilerOutput != nullptr)
+    {
+        std::string Log = "SPIR-V instruction count: ";
+        Log += std::to_string(GetSPIRVInstructionCount(SPIRV));
+        Log += " before optimization, ";
+        Log += std::to_string(GetSPIRVInstructionCount(OptimizedSPIRV));
+        Log += " after optimization";
+        WriteCompilerOutput(Log, ShaderSource, SourceCodeLen, ppCompilerOutput);
+    }
+
+    return std::move(OptimizedSPIRV);
+}
+
+std::vector<unsigned int> StripReflection(const std::vector<unsigned int>& OriginalSPIRV, bool StripDebugInfo)
+{
+    std::vector<unsigned int> StrippedSPIRV;
+    spvtools::Optimizer       SpirvOptimizer(SPV_ENV_VULKAN_1_0);
+    // Decorations defined in SPV_GOOGLE_hlsl_functionality1 are the only instructions
+    // removed by strip-reflect-info pass. SPIRV offsets become INVALID after this operation.
+    SpirvOptimizer.RegisterPass(spvtools::CreateStripReflectInfoPass());
+    if (StripDebugInfo)
+    {
+        // Names are not needed anymore as shader resources have already been reflected
+        SpirvOptimizer.RegisterPass(spvtools::CreateStripDebugInfoPass());
+    }
+    auto res = SpirvOptimizer.Run(OriginalSPIRV.data(), OriginalSPIRV.size(), &StrippedSPIRV);
+    if (!res)
+    {
+        // Optimized SPIRV may be invalid
+        StrippedSPIRV.clear();
+    }
+    return StrippedSPIRV;
+}
+
 class IncluderImpl : public glslang::TShader::Includer
 {
 public:
@@ -430,7 +546,9 @@ private:
     std::unordered_map<IncludeResult*, RefCntAutoPtr<IDataBlob>> m_DataBlobs;
 };
 
-std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& Attribs, IDataBlob** ppCompilerOutput)
+std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo&  Attribs,
+                                      IDataBlob**              ppCompilerOutput,
+                                      SPIRV_OPTIMIZATION_FLAGS OptimizationFlags)
 {
     EShLanguage      ShLang = ShaderTypeToShLanguage(Attribs.Desc.ShaderType);
     glslang::TShader Shader{ShLang};
@@ -499,24 +617,30 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& Attribs, IDataBlob
     if (SPIRV.empty())
         return SPIRV;
 
-    // SPIR-V bytecode generated from HLSL must be legalized to
-    // turn it into a valid vulkan SPIR-V shader
-    spvtools::Optimizer SpirvOptimizer(SPV_ENV_VULKAN_1_0);
-    SpirvOptimizer.RegisterLegalizationPasses();
-    SpirvOptimizer.RegisterPerformancePasses();
-    std::vector<uint32_t> LegalizedSPIRV;
-    if (SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &LegalizedSPIRV))
-    {
-        return std::move(LegalizedSPIRV);
-    }
-    else
-    {
-        LOG_ERROR("Failed to legalize SPIR-V shader generated by HLSL front-end. This may result in undefined behavior.");
-        return std::move(SPIRV);
-    }
+    return OptimizeSPIRV(std::move(SPIRV), true, OptimizationFlags, SourceCode, SourceCodeLen, ppCompilerOutput);
 }
 
-std::vector<unsigned int> GLSLtoSPIRV(const SHADER_TYPE ShaderType, const char* ShaderSource, int SourceCodeLen, IDataBlob** ppCompilerOutput)
+std::string GetSPIRVCompilerVersion()
+{
+    std::string Version = "glslang ";
+    Version += GetGlslVersionString();
+#if !(defined(VK_USE_PLATFORM_IOS_MVK) || defined(VK_USE_PLATFORM_MACOS_MVK))
+    Version += "; SPIR-V generator ";
+    Version += std::to_string(glslang::GetSpirvGeneratorVersion());
+#endif
+
+    // HLSL definitions are added to every HLSL shader, so they affect the compilation result
+    Version += "; HLSL definitions ";
+    Version += std::to_string(ComputeFNV1aHash(g_HLSLDefinitions, strlen(g_HLSLDefinitions)));
+
+    return Version;
+}
+
+std::vector<unsigned int> GLSLtoSPIRV(const SHADER_TYPE        ShaderType,
+                                      const char*              ShaderSource,
+                                      int                      SourceCodeLen,
+                                      IDataBlob**              ppCompilerOutput,
+                                      SPIRV_OPTIMIZATION_FLAGS OptimizationFlags)
 {
     EShLanguage      ShLang = ShaderTypeToShLanguage(ShaderType);
     glslang::TShader Shader(ShLang);
@@ -529,18 +653,10 @@ std::vector<unsigned int> GLSLtoSPIRV(const SHADER_TYPE ShaderType, const char*
 
     auto SPIRV = CompileShaderInternal(Shader, messages, nullptr, ShaderSource, SourceCodeLen, ppCompilerOutput);
 
-    spvtools::Optimizer SpirvOptimizer(SPV_ENV_VULKAN_1_0);
-    SpirvOptimizer.RegisterPerformancePasses();
-    std::vector<uint32_t> OptimizedSPIRV;
-    if (SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &OptimizedSPIRV))
-    {
-        return std::move(OptimizedSPIRV);
-    }
-    else
-    {
-        LOG_ERROR("Failed to optimize SPIR-V.");
-        return std::move(SPIRV);
-    }
+    if (SPIRV.empty())
+        return SPIRV;
+
+    return OptimizeSPIRV(std::move(SPIRV), false, OptimizationFlags, ShaderSource, SourceCodeLen, ppCompilerOutput);
 }
 
 } // namespace Diligent
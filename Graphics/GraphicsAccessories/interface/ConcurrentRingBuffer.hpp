@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::ConcurrentRingBuffer class
+
+#include <atomic>
+#include <mutex>
+#include <map>
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+
+namespace Diligent
+{
+/// Implementation of a thread-safe ring buffer.
+
+/// Allocate() is lock-free and may be called from multiple threads simultaneously.
+/// The head and the tail are tracked as monotonically increasing virtual positions;
+/// physical offsets are obtained by wrapping the virtual positions around the buffer size.
+/// Every allocation covers a contiguous virtual range that includes the alignment padding
+/// and the space skipped at the end of the buffer, so that the ranges tile the virtual space.
+/// Allocations may be released in any order by Free(). The tail only moves forward when
+/// the allocation it points to is released; ranges released out of order are kept until
+/// the tail reaches them. Free() is synchronized by a mutex, but never blocks Allocate().
+class ConcurrentRingBuffer
+{
+public:
+    using OffsetType = size_t;
+
+    static constexpr const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+    struct Allocation
+    {
+        // clang-format off
+        Allocation() noexcept {}
+        Allocation(OffsetType offset, OffsetType size, Uint64 vbegin, Uint64 vend) noexcept :
+            UnalignedOffset{offset},
+            Size           {size  },
+            VirtualBegin   {vbegin},
+            VirtualEnd     {vend  }
+        {}
+        // clang-format on
+
+        bool IsValid() const { return UnalignedOffset != InvalidOffset; }
+
+        // Offset of the allocation in the buffer. Unlike VariableSizeAllocationsManager,
+        // the offset is always aligned; the name is kept for compatibility.
+        OffsetType UnalignedOffset = InvalidOffset;
+        OffsetType Size            = 0;
+
+        // Virtual range [VirtualBegin, VirtualEnd) occupied by the allocation
+        Uint64 VirtualBegin = 0;
+        Uint64 VirtualEnd   = 0;
+    };
+
+    ConcurrentRingBuffer(OffsetType MaxSize, IMemoryAllocator& Allocator) noexcept :
+        m_PendingFrees(std::less<Uint64>(), STD_ALLOCATOR_RAW_MEM(PendingFreeElem, Allocator, "Allocator for map<Uint64, Uint64>")),
+        m_MaxSize{MaxSize}
+    {}
+
+    // clang-format off
+    ConcurrentRingBuffer             (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer             (      ConcurrentRingBuffer&&) = delete;
+    ConcurrentRingBuffer& operator = (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer& operator = (      ConcurrentRingBuffer&&) = delete;
+    // clang-format on
+
+    ~ConcurrentRingBuffer()
+    {
+        VERIFY(GetUsedSize() == 0, "All space in the ring buffer must be released");
+    }
+
+    Allocation Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = Align(Size, Alignment);
+        if (Size > m_MaxSize)
+            return Allocation{};
+
+        auto Head = m_Head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto   Offset        = static_cast<OffsetType>(Head % m_MaxSize);
+            auto   AlignedOffset = Align(Offset, Alignment);
+            Uint64 Start         = 0;
+            if (AlignedOffset + Size <= m_MaxSize)
+            {
+                //                     Tail          Head  AlignedOffset
+                //                     |                |  |            MaxSize
+                //  [                  xxxxxxxxxxxxxxxxx...+++++++      ]
+                //
+                Start = Head + (AlignedOffset - Offset);
+            }
+            else
+            {
+                // Skip the remaining space at the end of the buffer and
+                // allocate from the beginning
+                //
+                //   AlignedOffset   Tail          Head               MaxSize
+                //  |                |                |<---skipped--->|
+                //  [+++++++         xxxxxxxxxxxxxxxxx................]
+                //
+                Start         = Head + (m_MaxSize - Offset);
+                AlignedOffset = 0;
+            }
+
+            const auto NewHead = Start + Size;
+            if (NewHead - m_Tail.load(std::memory_order_acquire) > m_MaxSize)
+                return Allocation{};
+
+            // On failure, Head is updated with the current value
+            const auto OldHead = Head;
+            if (m_Head.compare_exchange_weak(Head, NewHead, std::memory_order_acq_rel, std::memory_order_relaxed))
+                return Allocation{AlignedOffset, Size, OldHead, NewHead};
+        }
+    }
+
+    void Free(const Allocation& Alloc)
+    {
+        VERIFY_EXPR(Alloc.IsValid());
+        VERIFY_EXPR(Alloc.VirtualEnd > Alloc.VirtualBegin);
+
+        std::lock_guard<std::mutex> Lock{m_FreeMtx};
+
+        auto Tail = m_Tail.load(std::memory_order_relaxed);
+        VERIFY(Alloc.VirtualBegin >= Tail, "The allocation has already been released");
+        if (Alloc.VirtualBegin != Tail)
+        {
+            // The allocation is not at the tail - keep the range until the tail reaches it
+            VERIFY(m_PendingFrees.find(Alloc.VirtualBegin) == m_PendingFrees.end(), "The allocation has already been released");
+            m_PendingFrees.emplace(Alloc.VirtualBegin, Alloc.VirtualEnd);
+            return;
+        }
+
+        Tail = Alloc.VirtualEnd;
+        // Retire all ranges that were released out of order and are now adjacent to the tail
+        for (auto it = m_PendingFrees.begin(); it != m_PendingFrees.end() && it->first == Tail; it = m_PendingFrees.erase(it))
+            Tail = it->second;
+
+        m_Tail.store(Tail, std::memory_order_release);
+    }
+
+    OffsetType GetUsedSize() const
+    {
+        // The head and the tail are separate atomics. Reading the tail on both sides of the head
+        // makes sure that both values were observed at the same moment when the tail has not moved.
+        // The head never falls behind the tail, so the difference cannot underflow.
+        auto Tail = m_Tail.load(std::memory_order_acquire);
+        for (;;)
+        {
+            const auto Head     = m_Head.load(std::memory_order_acquire);
+            const auto LastTail = Tail;
+            Tail                = m_Tail.load(std::memory_order_acquire);
+            if (Tail == LastTail)
+            {
+                VERIFY_EXPR(Head >= Tail && Head - Tail <= m_MaxSize);
+                return static_cast<OffsetType>(Head - Tail);
+            }
+        }
+    }
+
+    // clang-format off
+    OffsetType GetMaxSize() const { return m_MaxSize; }
+    bool       IsFull()     const { return GetUsedSize() == m_MaxSize; };
+    bool       IsEmpty()    const { return GetUsedSize() == 0; };
+    // clang-format on
+
+private:
+    using PendingFreeElem = std::pair<const Uint64, Uint64>;
+
+    std::mutex m_FreeMtx;
+    // Ranges [first, second) that were released before the tail reached them
+    std::map<Uint64, Uint64, std::less<Uint64>, STDAllocatorRawMem<PendingFreeElem>> m_PendingFrees;
+
+    // Virtual head and tail positions that never wrap around
+    std::atomic<Uint64> m_Head{0};
+    std::atomic<Uint64> m_Tail{0};
+
+    const OffsetType m_MaxSize;
+};
+
+} // namespace Diligent
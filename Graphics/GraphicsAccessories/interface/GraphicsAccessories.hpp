@@ -412,4 +412,10 @@ struct MipLevelProperties
 
 MipLevelProperties GetMipLevelProperties(const TextureDesc& TexDesc, Uint32 MipLevel);
 
+/// Computes the hash of the shader variable name that can be passed to IShaderResourceBinding::GetVariableByHash()
+
+/// Applications that access the same variables every frame may compute the hashes once
+/// and avoid hashing the names in every lookup.
+Uint64 ComputeShaderVariableNameHash(const Char* Name);
+
 } // namespace Diligent
@@ -35,15 +35,125 @@
 
 #include <mutex>
 #include <deque>
+#include <vector>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <cstddef>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
 #include "../../../Common/interface/STDAllocator.hpp"
+#include "../../../Common/interface/DefaultRawMemoryAllocator.hpp"
 #include "../../../Platforms/interface/Atomics.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
 {
 
+/// Pool of fixed-size memory blocks that stale resource objects are allocated from
+
+/// Stale resources are created and destroyed at a high rate (e.g. every released upload page
+/// or descriptor set), so allocating them from the general heap is expensive. The pool keeps
+/// freed blocks in an intrusive list and never returns pages to the system while the pool is alive,
+/// so in a steady state allocating and releasing a stale resource does not touch the heap.
+/// Unlike FixedBlockMemoryAllocator, the pool does not need to look up the page a block belongs to,
+/// which avoids the hash map insertion on every allocation.
+///
+/// \tparam BlockSize - Size of the memory block, must be a multiple of the pointer size.
+template <size_t BlockSize>
+class StaleResourceBlockPool
+{
+public:
+    static_assert(BlockSize >= sizeof(void*) && BlockSize % sizeof(void*) == 0, "Block size must be a multiple of the pointer size");
+
+    static constexpr Uint32 NumBlocksInPage = 64;
+
+    static StaleResourceBlockPool& GetInstance()
+    {
+        static StaleResourceBlockPool Pool;
+        return Pool;
+    }
+
+    StaleResourceBlockPool() = default;
+
+    // clang-format off
+    StaleResourceBlockPool             (const StaleResourceBlockPool&)  = delete;
+    StaleResourceBlockPool             (      StaleResourceBlockPool&&) = delete;
+    StaleResourceBlockPool& operator = (const StaleResourceBlockPool&)  = delete;
+    StaleResourceBlockPool& operator = (      StaleResourceBlockPool&&) = delete;
+    // clang-format on
+
+    ~StaleResourceBlockPool()
+    {
+        // If there are outstanding blocks (e.g. an object that owns stale resources is
+        // destroyed after the pool during static deinitialization), leak the pages rather
+        // than release the memory that is still in use.
+        if (m_NumAllocatedBlocks != 0)
+            return;
+
+        auto& RawAllocator = DefaultRawMemoryAllocator::GetAllocator();
+        while (m_pPages != nullptr)
+        {
+            auto* pNextPage = *reinterpret_cast<void**>(m_pPages);
+            RawAllocator.Free(m_pPages);
+            m_pPages = pNextPage;
+        }
+    }
+
+    void* Allocate()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        if (m_pFreeBlock == nullptr)
+            CreateNewPage();
+
+        auto* pBlock = m_pFreeBlock;
+        m_pFreeBlock = *reinterpret_cast<void**>(pBlock);
+        ++m_NumAllocatedBlocks;
+        return pBlock;
+    }
+
+    void Free(void* pBlock)
+    {
+        VERIFY_EXPR(pBlock != nullptr);
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        VERIFY(m_NumAllocatedBlocks > 0, "There are no allocated blocks - double freeing memory?");
+        *reinterpret_cast<void**>(pBlock) = m_pFreeBlock;
+        m_pFreeBlock                      = pBlock;
+        --m_NumAllocatedBlocks;
+    }
+
+    size_t GetAllocatedBlockCount()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_NumAllocatedBlocks;
+    }
+
+private:
+    void CreateNewPage()
+    {
+        // The first block of the page is used to keep the pointer to the next page
+        auto* pPage = reinterpret_cast<Uint8*>(
+            DefaultRawMemoryAllocator::GetAllocator().Allocate(BlockSize * (NumBlocksInPage + 1), "Stale resource block pool page", __FILE__, __LINE__));
+
+        *reinterpret_cast<void**>(pPage) = m_pPages;
+        m_pPages                         = pPage;
+
+        for (Uint32 b = NumBlocksInPage; b > 0; --b)
+        {
+            auto* pBlock                      = pPage + BlockSize * b;
+            *reinterpret_cast<void**>(pBlock) = m_pFreeBlock;
+            m_pFreeBlock                      = pBlock;
+        }
+    }
+
+    std::mutex m_Mtx;
+    void*      m_pFreeBlock         = nullptr;
+    void*      m_pPages             = nullptr;
+    size_t     m_NumAllocatedBlocks = 0;
+};
+
 /// Helper class that wraps stale resources of different types
 class DynamicStaleResourceWrapper final
 {
@@ -85,7 +195,7 @@ public:
 
             virtual void Release() override final
             {
-                delete this;
+                DeleteStaleResource(this);
             }
 
         private:
@@ -112,7 +222,7 @@ public:
             {
                 if (Atomics::AtomicDecrement(m_RefCounter) == 0)
                 {
-                    delete this;
+                    DeleteStaleResource(this);
                 }
             }
 
@@ -123,8 +233,8 @@ public:
 
         return DynamicStaleResourceWrapper{
             NumReferences == 1 ?
-                static_cast<StaleResourceBase*>(new SpecificStaleResource{std::move(Resource)}) :
-                static_cast<StaleResourceBase*>(new SpecificSharedStaleResource{std::move(Resource), NumReferences})};
+                static_cast<StaleResourceBase*>(NewStaleResource<SpecificStaleResource>(std::move(Resource))) :
+                static_cast<StaleResourceBase*>(NewStaleResource<SpecificSharedStaleResource>(std::move(Resource), NumReferences))};
     }
 
     DynamicStaleResourceWrapper(DynamicStaleResourceWrapper&& rhs) noexcept :
@@ -166,6 +276,54 @@ private:
         m_pStaleResource(pStaleResource)
     {}
 
+    // Stale resource objects up to this size are allocated from the block pools
+    static constexpr size_t MaxPooledStaleResourceSize   = 256;
+    static constexpr size_t StaleResourceSizeGranularity = 32;
+
+    template <typename StaleResourceType>
+    using StaleResourcePoolType = StaleResourceBlockPool<(sizeof(StaleResourceType) + StaleResourceSizeGranularity - 1) / StaleResourceSizeGranularity * StaleResourceSizeGranularity>;
+
+    template <typename StaleResourceType>
+    using IsPooledStaleResource = std::integral_constant<bool, sizeof(StaleResourceType) <= MaxPooledStaleResourceSize && alignof(StaleResourceType) <= alignof(std::max_align_t)>;
+
+    template <typename StaleResourceType, typename... ArgsType>
+    static StaleResourceType* NewStaleResource(ArgsType&&... Args)
+    {
+        return NewStaleResource<StaleResourceType>(IsPooledStaleResource<StaleResourceType>{}, std::forward<ArgsType>(Args)...);
+    }
+
+    template <typename StaleResourceType, typename... ArgsType>
+    static StaleResourceType* NewStaleResource(std::true_type /*Pooled*/, ArgsType&&... Args)
+    {
+        auto* pBlock = StaleResourcePoolType<StaleResourceType>::GetInstance().Allocate();
+        return new (pBlock) StaleResourceType{std::forward<ArgsType>(Args)...};
+    }
+
+    template <typename StaleResourceType, typename... ArgsType>
+    static StaleResourceType* NewStaleResource(std::false_type /*Pooled*/, ArgsType&&... Args)
+    {
+        return new StaleResourceType{std::forward<ArgsType>(Args)...};
+    }
+
+    template <typename StaleResourceType>
+    static void DeleteStaleResource(StaleResourceType* pStaleResource)
+    {
+        DeleteStaleResource(IsPooledStaleResource<StaleResourceType>{}, pStaleResource);
+    }
+
+    template <typename StaleResourceType>
+    static void DeleteStaleResource(std::true_type /*Pooled*/, StaleResourceType* pStaleResource)
+    {
+        pStaleResource->~StaleResourceType();
+        StaleResourcePoolType<StaleResourceType>::GetInstance().Free(pStaleResource);
+    }
+
+    template <typename StaleResourceType>
+    static void DeleteStaleResource(std::false_type /*Pooled*/, StaleResourceType* pStaleResource)
+    {
+        delete pStaleResource;
+    }
+
     StaleResourceBase* m_pStaleResource;
 };
 
@@ -207,6 +365,155 @@ private:
     ResourceType m_StaleResource;
 };
 
+/// Destroys resources on a background thread
+
+/// Destroying large numbers of objects (e.g. after a level unload) may take tens of milliseconds.
+/// When the worker is attached to a release queue, ResourceReleaseQueue::Purge() hands completed
+/// resources to the worker instead of destroying them on the calling thread.
+/// The worker limits the time it spends destroying resources between two consecutive calls to
+/// BeginFrame() by the frame time budget.
+///
+/// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
+template <typename ResourceWrapperType>
+class ResourceDestructionWorker
+{
+public:
+    /// \param [in] Allocator       - Allocator used to allocate memory for the queue.
+    /// \param [in] FrameTimeBudget - Maximum time, in seconds, the worker may spend destroying
+    ///                               resources per frame. Zero means no limit.
+    ResourceDestructionWorker(IMemoryAllocator& Allocator, double FrameTimeBudget) :
+        m_Queue{STD_ALLOCATOR_RAW_MEM(ResourceWrapperType, Allocator, "Allocator for deque<ResourceWrapperType>")},
+        m_FrameTimeBudget{FrameTimeBudget}
+    {
+        m_WorkerThread = std::thread{[this]() { WorkerThreadFunc(); }};
+    }
+
+    // clang-format off
+    ResourceDestructionWorker             (const ResourceDestructionWorker&)  = delete;
+    ResourceDestructionWorker             (      ResourceDestructionWorker&&) = delete;
+    ResourceDestructionWorker& operator = (const ResourceDestructionWorker&)  = delete;
+    ResourceDestructionWorker& operator = (      ResourceDestructionWorker&&) = delete;
+    // clang-format on
+
+    ~ResourceDestructionWorker()
+    {
+        Flush();
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_Stop = true;
+        }
+        m_WakeUpCondVar.notify_one();
+        m_WorkerThread.join();
+    }
+
+    /// Moves all resources from the batch to the destruction queue and clears the batch
+    template <typename BatchType>
+    void Enqueue(BatchType& Batch)
+    {
+        if (Batch.empty())
+            return;
+
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            for (auto& Resource : Batch)
+                m_Queue.emplace_back(std::move(Resource));
+        }
+        Batch.clear();
+        m_WakeUpCondVar.notify_one();
+    }
+
+    /// Resets the time budget of the worker
+    void BeginFrame()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_FrameTimeSpent = 0;
+        }
+        m_WakeUpCondVar.notify_one();
+    }
+
+    /// Destroys all pending resources on the calling thread and waits until
+    /// the worker finishes destroying the resource it is currently working on.
+    void Flush()
+    {
+        std::deque<ResourceWrapperType, STDAllocatorRawMem<ResourceWrapperType>> PendingResources{m_Queue.get_allocator()};
+        {
+            std::unique_lock<std::mutex> Lock{m_Mtx};
+            PendingResources.swap(m_Queue);
+            m_IdleCondVar.wait(Lock, [this]() { return !m_IsBusy; });
+        }
+        // Resources are destroyed when PendingResources goes out of scope
+    }
+
+    /// Waits until the worker destroys all pending resources or exhausts its
+    /// time budget for the current frame. Unlike Flush(), never destroys resources
+    /// on the calling thread.
+    void WaitIdle()
+    {
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        m_IdleCondVar.wait(Lock, [this]() { return !m_IsBusy && (m_Queue.empty() || IsBudgetExhausted()); });
+    }
+
+    /// Returns the number of resources waiting to be destroyed
+    size_t GetPendingResourceCount()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_Queue.size() + (m_IsBusy ? 1 : 0);
+    }
+
+private:
+    // Must be called with m_Mtx locked
+    bool IsBudgetExhausted() const
+    {
+        return m_FrameTimeBudget > 0 && m_FrameTimeSpent >= m_FrameTimeBudget;
+    }
+
+    void WorkerThreadFunc()
+    {
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        for (;;)
+        {
+            m_WakeUpCondVar.wait(Lock, [this]() {
+                return m_Stop || (!m_Queue.empty() && !IsBudgetExhausted());
+            });
+            if (m_Stop)
+                break;
+
+            {
+                ResourceWrapperType Resource{std::move(m_Queue.front())};
+                m_Queue.pop_front();
+                m_IsBusy = true;
+                Lock.unlock();
+
+                auto StartTime = std::chrono::high_resolution_clock::now();
+                {
+                    // Destroy the resource
+                    ResourceWrapperType StaleResource{std::move(Resource)};
+                }
+                auto EndTime = std::chrono::high_resolution_clock::now();
+
+                Lock.lock();
+                m_FrameTimeSpent += std::chrono::duration_cast<std::chrono::duration<double>>(EndTime - StartTime).count();
+                m_IsBusy = false;
+            }
+            m_IdleCondVar.notify_all();
+        }
+    }
+
+    std::mutex              m_Mtx;
+    std::condition_variable m_WakeUpCondVar;
+    std::condition_variable m_IdleCondVar;
+
+    std::deque<ResourceWrapperType, STDAllocatorRawMem<ResourceWrapperType>> m_Queue;
+
+    const double m_FrameTimeBudget;
+    double       m_FrameTimeSpent = 0;
+    bool         m_IsBusy         = false;
+    bool         m_Stop           = false;
+
+    std::thread m_WorkerThread;
+};
+
 /// Facilitates safe resource destruction in D3D12 and Vulkan
 
 /// Resource destruction is a two-stage process:
@@ -223,8 +530,9 @@ class ResourceReleaseQueue
 public:
     // clang-format off
     ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+        m_ReleaseQueue    (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
+        m_PurgedResources (STD_ALLOCATOR_RAW_MEM(ResourceWrapperType,  Allocator, "Allocator for vector<ResourceWrapperType>")),
+        m_StaleResources  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
     {}
     // clang-format on
 
@@ -338,9 +646,20 @@ public:
     }
 
 
+    /// Sets the worker that destroys resources removed from the queue by Purge()
+    /// \param [in] pWorker - Destruction worker. If null, resources are destroyed by Purge() on the calling thread.
+    void SetDestructionWorker(ResourceDestructionWorker<ResourceWrapperType>* pWorker)
+    {
+        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        m_pDestructionWorker = pWorker;
+    }
+
     /// Removes all objects from the release queue whose fence value is
     /// less than or equal to CompletedFenceValue
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
+    ///
+    /// \remarks If the destruction worker is set, the objects are handed over to the worker
+    ///          in a single batch rather than destroyed on the calling thread.
     void Purge(Uint64 CompletedFenceValue)
     {
         std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
@@ -351,10 +670,17 @@ public:
         {
             auto& FirstObj = m_ReleaseQueue.front();
             if (FirstObj.first <= CompletedFenceValue)
+            {
+                if (m_pDestructionWorker != nullptr)
+                    m_PurgedResources.emplace_back(std::move(FirstObj.second));
                 m_ReleaseQueue.pop_front();
+            }
             else
                 break;
         }
+
+        if (m_pDestructionWorker != nullptr)
+            m_pDestructionWorker->Enqueue(m_PurgedResources);
     }
 
     /// Returns the number of stale resources
@@ -374,6 +700,11 @@ private:
     using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
     std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
 
+    // Resources removed from the release queue by Purge() that are handed over to the destruction worker.
+    // The vector is only accessed while m_ReleaseQueueMutex is locked and is kept to reuse its storage.
+    std::vector<ResourceWrapperType, STDAllocatorRawMem<ResourceWrapperType>> m_PurgedResources;
+    ResourceDestructionWorker<ResourceWrapperType>*                          m_pDestructionWorker = nullptr;
+
     std::mutex                                                                 m_StaleObjectsMutex;
     std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
 };
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Definition of the shader archive format and Diligent::ShaderArchiveReader and Diligent::ShaderArchiveWriter classes
+
+#include <vector>
+#include <string>
+
+#include "../../GraphicsEngine/interface/Shader.h"
+
+namespace Diligent
+{
+
+// Shader archive packs precompiled shader permutations into a single file that can be
+// memory-mapped and used in place. For every permutation, the archive stores SPIR-V byte code,
+// GLSL source for the OpenGL backend and serialized SPIR-V reflection (see SPIRVShaderResources::Serialize()).
+// Entries are identified by name and are looked up through the index sorted by the name hash.
+//
+// All offsets are relative to the beginning of the archive, all data ranges are 8-byte aligned:
+//
+//  | Header | Index (NumEntries entries sorted by name hash) | Names, byte code, sources and reflection |
+//
+
+static constexpr Uint32 ShaderArchiveMagic   = 0x41485344; // 'DSHA'
+static constexpr Uint32 ShaderArchiveVersion = 1;
+
+struct ShaderArchiveHeader
+{
+    Uint32 Magic       = ShaderArchiveMagic;
+    Uint32 Version     = ShaderArchiveVersion;
+    Uint32 NumEntries  = 0;
+    Uint32 Reserved    = 0;
+    Uint64 IndexOffset = 0;
+    Uint64 ArchiveSize = 0;
+};
+
+struct ShaderArchiveDataRange
+{
+    Uint64 Offset = 0;
+    Uint64 Size   = 0;
+};
+
+struct ShaderArchiveIndexEntry
+{
+    Uint64 NameHash = 0;
+
+    // Entry name and GLSL source are null-terminated, Size does not include the terminator
+    ShaderArchiveDataRange Name;
+    ShaderArchiveDataRange SPIRV;
+    ShaderArchiveDataRange GLSL;
+    ShaderArchiveDataRange Resources;
+
+    Uint32 ShaderType = SHADER_TYPE_UNKNOWN;
+    Uint32 Reserved   = 0;
+};
+
+/// Computes the hash of the archive entry name. The hash is stored on disk,
+/// so it does not depend on the platform or the standard library implementation.
+Uint64 ComputeShaderArchiveNameHash(const char* Name);
+
+
+/// Provides access to the entries of a shader archive.
+
+/// The reader does not copy the archive data. The data must be 8-byte aligned
+/// and remain valid while the reader and the entries obtained from it are in use.
+class ShaderArchiveReader
+{
+public:
+    struct Entry
+    {
+        const char*     Name          = nullptr;
+        SHADER_TYPE     ShaderType    = SHADER_TYPE_UNKNOWN;
+        const uint32_t* pSPIRV        = nullptr;
+        size_t          SPIRVSize     = 0; ///< Byte code size, in bytes
+        const char*     GLSL          = nullptr;
+        size_t          GLSLLength    = 0;
+        const void*     pResources    = nullptr;
+        size_t          ResourcesSize = 0;
+    };
+
+    ShaderArchiveReader(const void* pData, size_t DataSize);
+
+    /// Returns false if the archive header or the index is malformed
+    bool IsValid() const { return m_IsValid; }
+
+    Uint32 GetNumEntries() const { return m_NumEntries; }
+
+    /// Finds the entry by name. Returns false if the entry is not found or is malformed.
+    bool FindEntry(const char* Name, Entry& FoundEntry) const;
+
+    /// Returns the entry with the given index in the archive index.
+    bool GetEntry(Uint32 Index, Entry& ArchiveEntry) const;
+
+private:
+    bool ReadEntry(const ShaderArchiveIndexEntry& IndexEntry, Entry& ArchiveEntry) const;
+
+    const Uint8*                   m_pData      = nullptr;
+    size_t                         m_DataSize   = 0;
+    const ShaderArchiveIndexEntry* m_pIndex     = nullptr;
+    Uint32                         m_NumEntries = 0;
+    bool                           m_IsValid    = false;
+};
+
+
+/// Builds a shader archive in memory.
+class ShaderArchiveWriter
+{
+public:
+    /// Adds a new entry to the archive. Returns false if an entry with the same name already exists.
+    bool AddEntry(const char*                  Name,
+                  SHADER_TYPE                  ShaderType,
+                  const std::vector<uint32_t>& SPIRV,
+                  const std::string&           GLSL,
+                  const std::vector<Uint8>&    Resources);
+
+    /// Writes the archive to the data buffer.
+    void Write(std::vector<Uint8>& Data) const;
+
+    size_t GetNumEntries() const { return m_Entries.size(); }
+
+private:
+    struct PendingEntry
+    {
+        std::string           Name;
+        Uint64                NameHash   = 0;
+        SHADER_TYPE           ShaderType = SHADER_TYPE_UNKNOWN;
+        std::vector<uint32_t> SPIRV;
+        std::string           GLSL;
+        std::vector<Uint8>    Resources;
+    };
+    std::vector<PendingEntry> m_Entries;
+};
+
+} // namespace Diligent
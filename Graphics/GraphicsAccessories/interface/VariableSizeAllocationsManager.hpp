@@ -31,6 +31,8 @@
 #pragma once
 
 #include <map>
+#include <vector>
+#include <array>
 #include <algorithm>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
@@ -357,6 +359,165 @@ public:
         return m_FreeBlocksByOffset.size();
     }
 
+    OffsetType GetLargestFreeBlockSize() const
+    {
+        return !m_FreeBlocksBySize.empty() ? m_FreeBlocksBySize.rbegin()->first : 0;
+    }
+
+    struct FragmentationStats
+    {
+        static constexpr size_t NumHistogramBins = sizeof(OffsetType) * 8;
+
+        OffsetType FreeSize         = 0;
+        OffsetType LargestFreeBlock = 0;
+        size_t     NumFreeBlocks    = 0;
+
+        // External fragmentation ratio: 1 - LargestFreeBlock / FreeSize.
+        // 0 means that all free space is contiguous, values close to 1 mean
+        // that free space is scattered across many small blocks.
+        double ExternalFragmentation = 0;
+
+        // Free block size histogram. Bin i counts free blocks whose size
+        // is in range [2^i, 2^(i+1)).
+        std::array<size_t, NumHistogramBins> FreeBlockHistogram = {};
+    };
+
+    FragmentationStats GetFragmentationStats() const
+    {
+        FragmentationStats Stats;
+        Stats.FreeSize         = m_FreeSize;
+        Stats.LargestFreeBlock = GetLargestFreeBlockSize();
+        Stats.NumFreeBlocks    = m_FreeBlocksByOffset.size();
+        if (m_FreeSize > 0)
+            Stats.ExternalFragmentation = 1.0 - static_cast<double>(Stats.LargestFreeBlock) / static_cast<double>(m_FreeSize);
+
+        for (const auto& SizeIt : m_FreeBlocksBySize)
+        {
+            size_t Bin = 0;
+            for (auto Size = SizeIt.first; Size > 1; Size >>= 1)
+                ++Bin;
+            ++Stats.FreeBlockHistogram[Bin];
+        }
+
+        return Stats;
+    }
+
+    struct DefragmentationMove
+    {
+        // Index of the allocation in the array passed to PlanDefragmentation()
+        size_t AllocationIndex = 0;
+
+        // Current allocation
+        Allocation SrcAllocation;
+
+        // New allocation that the data should be moved to. The new allocation has
+        // the same size as the source one; its offset is properly aligned.
+        Allocation DstAllocation;
+
+        // Aligned offset of the data in the source allocation
+        OffsetType SrcDataOffset = 0;
+
+        // Number of bytes to copy from SrcDataOffset to DstAllocation.UnalignedOffset
+        OffsetType DataSize = 0;
+    };
+
+    // Proposes moves that slide allocations towards the beginning of the managed space
+    // to coalesce free blocks. The manager does not keep track of allocations, so the
+    // caller must provide all live allocations along with their alignments.
+    // A move is only proposed when the destination range does not overlap the source range,
+    // which allows the data to be copied with a single non-overlapping copy operation.
+    // Moves must be executed in the order they are returned, since the destination
+    // of a move may occupy the space freed by preceding moves.
+    // MaxBytesToMove limits the total amount of data that the plan may move.
+    void PlanDefragmentation(const Allocation*                 pAllocations,
+                             const OffsetType*                 pAlignments,
+                             size_t                            NumAllocations,
+                             OffsetType                        MaxBytesToMove,
+                             std::vector<DefragmentationMove>& Moves) const
+    {
+        std::vector<size_t> SortedAllocs(NumAllocations);
+        for (size_t i = 0; i < NumAllocations; ++i)
+        {
+            VERIFY_EXPR(pAllocations[i].IsValid());
+            SortedAllocs[i] = i;
+        }
+        std::sort(SortedAllocs.begin(), SortedAllocs.end(),
+                  [pAllocations](size_t a0, size_t a1) {
+                      return pAllocations[a0].UnalignedOffset < pAllocations[a1].UnalignedOffset;
+                  });
+
+        OffsetType Cursor     = 0;
+        OffsetType MovedBytes = 0;
+        for (auto AllocIdx : SortedAllocs)
+        {
+            const auto& SrcAlloc  = pAllocations[AllocIdx];
+            const auto  Alignment = pAlignments[AllocIdx];
+            VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+            VERIFY(SrcAlloc.UnalignedOffset >= Cursor, "Overlapping allocations detected");
+
+            //                    Cursor   DstOffset                SrcAlloc.UnalignedOffset
+            //  ~ ~ ~|<--prev alloc-->|  ~ ~ |<-------Size------->| ~ ~ ~ |<-------Size------->|
+            //
+            auto DstOffset = Align(Cursor, Alignment);
+            if (DstOffset + SrcAlloc.Size <= SrcAlloc.UnalignedOffset)
+            {
+                auto SrcDataOffset = Align(SrcAlloc.UnalignedOffset, Alignment);
+                auto DataSize      = SrcAlloc.Size - (SrcDataOffset - SrcAlloc.UnalignedOffset);
+                if (MovedBytes + DataSize <= MaxBytesToMove)
+                {
+                    DefragmentationMove Move;
+                    Move.AllocationIndex = AllocIdx;
+                    Move.SrcAllocation   = SrcAlloc;
+                    Move.DstAllocation   = Allocation{DstOffset, SrcAlloc.Size};
+                    Move.SrcDataOffset   = SrcDataOffset;
+                    Move.DataSize        = DataSize;
+                    Moves.emplace_back(Move);
+
+                    MovedBytes += DataSize;
+                    Cursor = DstOffset + SrcAlloc.Size;
+                    continue;
+                }
+            }
+
+            Cursor = SrcAlloc.UnalignedOffset + SrcAlloc.Size;
+        }
+    }
+
+    // Updates the free block lists to reflect the move: the destination range
+    // is marked as allocated and the source range is released.
+    void ApplyDefragmentationMove(const DefragmentationMove& Move)
+    {
+        const auto& Dst = Move.DstAllocation;
+        VERIFY_EXPR(Dst.Size == Move.SrcAllocation.Size);
+
+        // Find the free block that contains the destination range
+        auto BlockIt = m_FreeBlocksByOffset.upper_bound(Dst.UnalignedOffset);
+        VERIFY(BlockIt != m_FreeBlocksByOffset.begin(), "Destination range is not free");
+        --BlockIt;
+        auto BlockOffset = BlockIt->first;
+        auto BlockSize   = BlockIt->second.Size;
+        VERIFY(BlockOffset <= Dst.UnalignedOffset && Dst.UnalignedOffset + Dst.Size <= BlockOffset + BlockSize,
+               "Destination range is not free");
+
+        //   BlockOffset         Dst.UnalignedOffset
+        //       |                      |
+        //       |<-------LeftSize----->|<-----Dst.Size----->|<----RightSize--->|
+        //
+        m_FreeBlocksBySize.erase(BlockIt->second.OrderBySizeIt);
+        m_FreeBlocksByOffset.erase(BlockIt);
+
+        auto LeftSize  = Dst.UnalignedOffset - BlockOffset;
+        auto RightSize = BlockOffset + BlockSize - (Dst.UnalignedOffset + Dst.Size);
+        if (LeftSize > 0)
+            AddNewBlock(BlockOffset, LeftSize);
+        if (RightSize > 0)
+            AddNewBlock(Dst.UnalignedOffset + Dst.Size, RightSize);
+        m_FreeSize -= Dst.Size;
+
+        // Free() will merge the released range with its neighbors
+        Free(Move.SrcAllocation.UnalignedOffset, Move.SrcAllocation.Size);
+    }
+
 private:
     void AddNewBlock(OffsetType Offset, OffsetType Size)
     {
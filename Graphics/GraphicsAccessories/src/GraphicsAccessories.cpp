@@ -30,6 +30,7 @@
 #include "GraphicsAccessories.hpp"
 #include "DebugUtilities.hpp"
 #include "Align.hpp"
+#include "PerfectHashMap.hpp"
 
 namespace Diligent
 {
@@ -1198,4 +1199,10 @@ MipLevelProperties GetMipLevelProperties(const TextureDesc& TexDesc, Uint32 MipL
     return MipProps;
 }
 
+Uint64 ComputeShaderVariableNameHash(const Char* Name)
+{
+    VERIFY_EXPR(Name != nullptr);
+    return PerfectHashMap<Uint32>::ComputeKeyHash(Name, strlen(Name));
+}
+
 } // namespace Diligent
@@ -0,0 +1,249 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "ShaderArchive.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/HashUtils.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+static constexpr size_t ShaderArchiveAlignment = 8;
+
+Uint64 ComputeShaderArchiveNameHash(const char* Name)
+{
+    return ComputeFNV1aHash(Name, strlen(Name));
+}
+
+ShaderArchiveReader::ShaderArchiveReader(const void* pData, size_t DataSize) :
+    m_pData{static_cast<const Uint8*>(pData)},
+    m_DataSize{DataSize}
+{
+    if (m_pData == nullptr || m_DataSize < sizeof(ShaderArchiveHeader))
+    {
+        LOG_ERROR_MESSAGE("Shader archive data is too small");
+        return;
+    }
+
+    if (reinterpret_cast<size_t>(m_pData) % ShaderArchiveAlignment != 0)
+    {
+        LOG_ERROR_MESSAGE("Shader archive data must be ", ShaderArchiveAlignment, "-byte aligned");
+        return;
+    }
+
+    const auto& Header = *reinterpret_cast<const ShaderArchiveHeader*>(m_pData);
+    if (Header.Magic != ShaderArchiveMagic)
+    {
+        LOG_ERROR_MESSAGE("The data is not a shader archive");
+        return;
+    }
+
+    if (Header.Version != ShaderArchiveVersion)
+    {
+        LOG_ERROR_MESSAGE("Shader archive version (", Header.Version, ") is not supported. Expected version: ", ShaderArchiveVersion);
+        return;
+    }
+
+    if (Header.ArchiveSize != m_DataSize ||
+        Header.IndexOffset % ShaderArchiveAlignment != 0 ||
+        Header.IndexOffset > m_DataSize ||
+        Uint64{Header.NumEntries} * sizeof(ShaderArchiveIndexEntry) > m_DataSize - Header.IndexOffset)
+    {
+        LOG_ERROR_MESSAGE("Shader archive is corrupted");
+        return;
+    }
+
+    m_pIndex     = reinterpret_cast<const ShaderArchiveIndexEntry*>(m_pData + Header.IndexOffset);
+    m_NumEntries = Header.NumEntries;
+    m_IsValid    = true;
+}
+
+bool ShaderArchiveReader::ReadEntry(const ShaderArchiveIndexEntry& IndexEntry, Entry& ArchiveEntry) const
+{
+    auto IsValidRange = [this](const ShaderArchiveDataRange& Range, size_t Alignment) {
+        return Range.Offset % Alignment == 0 && Range.Offset <= m_DataSize && Range.Size <= m_DataSize - Range.Offset;
+    };
+    auto IsValidString = [&](const ShaderArchiveDataRange& Range) {
+        // Strings are null-terminated
+        return IsValidRange(Range, 1) && Range.Size < m_DataSize - Range.Offset && m_pData[Range.Offset + Range.Size] == '\0';
+    };
+
+    if (!IsValidString(IndexEntry.Name) ||
+        !IsValidRange(IndexEntry.SPIRV, sizeof(uint32_t)) || IndexEntry.SPIRV.Size % sizeof(uint32_t) != 0 ||
+        (IndexEntry.GLSL.Size != 0 && !IsValidString(IndexEntry.GLSL)) ||
+        !IsValidRange(IndexEntry.Resources, 1) ||
+        // Every entry contains a single shader stage
+        !IsPowerOfTwo(IndexEntry.ShaderType) || IndexEntry.ShaderType > SHADER_TYPE_COMPUTE)
+    {
+        LOG_ERROR_MESSAGE("Shader archive entry is corrupted");
+        return false;
+    }
+
+    ArchiveEntry.Name          = reinterpret_cast<const char*>(m_pData + IndexEntry.Name.Offset);
+    ArchiveEntry.ShaderType    = static_cast<SHADER_TYPE>(IndexEntry.ShaderType);
+    ArchiveEntry.pSPIRV        = IndexEntry.SPIRV.Size != 0 ? reinterpret_cast<const uint32_t*>(m_pData + IndexEntry.SPIRV.Offset) : nullptr;
+    ArchiveEntry.SPIRVSize     = static_cast<size_t>(IndexEntry.SPIRV.Size);
+    ArchiveEntry.GLSL          = IndexEntry.GLSL.Size != 0 ? reinterpret_cast<const char*>(m_pData + IndexEntry.GLSL.Offset) : nullptr;
+    ArchiveEntry.GLSLLength    = static_cast<size_t>(IndexEntry.GLSL.Size);
+    ArchiveEntry.pResources    = IndexEntry.Resources.Size != 0 ? m_pData + IndexEntry.Resources.Offset : nullptr;
+    ArchiveEntry.ResourcesSize = static_cast<size_t>(IndexEntry.Resources.Size);
+    return true;
+}
+
+bool ShaderArchiveReader::FindEntry(const char* Name, Entry& FoundEntry) const
+{
+    if (!m_IsValid)
+        return false;
+
+    const auto  NameHash = ComputeShaderArchiveNameHash(Name);
+    const auto* pEnd     = m_pIndex + m_NumEntries;
+
+    auto* pIndexEntry = std::lower_bound(m_pIndex, pEnd, NameHash,
+                                         [](const ShaderArchiveIndexEntry& IndexEntry, Uint64 Hash) //
+                                         {
+                                             return IndexEntry.NameHash < Hash;
+                                         });
+    // Entries with colliding hashes are stored next to each other
+    for (; pIndexEntry != pEnd && pIndexEntry->NameHash == NameHash; ++pIndexEntry)
+    {
+        Entry ArchiveEntry;
+        if (ReadEntry(*pIndexEntry, ArchiveEntry) && strcmp(ArchiveEntry.Name, Name) == 0)
+        {
+            FoundEntry = ArchiveEntry;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ShaderArchiveReader::GetEntry(Uint32 Index, Entry& ArchiveEntry) const
+{
+    if (!m_IsValid || Index >= m_NumEntries)
+        return false;
+
+    return ReadEntry(m_pIndex[Index], ArchiveEntry);
+}
+
+
+bool ShaderArchiveWriter::AddEntry(const char*                  Name,
+                                   SHADER_TYPE                  ShaderType,
+                                   const std::vector<uint32_t>& SPIRV,
+                                   const std::string&           GLSL,
+                                   const std::vector<Uint8>&    Resources)
+{
+    VERIFY_EXPR(Name != nullptr && *Name != '\0');
+
+    const auto NameHash = ComputeShaderArchiveNameHash(Name);
+    for (const auto& Entry : m_Entries)
+    {
+        if (Entry.NameHash == NameHash && Entry.Name == Name)
+            return false;
+    }
+
+    m_Entries.emplace_back();
+    auto& Entry      = m_Entries.back();
+    Entry.Name       = Name;
+    Entry.NameHash   = NameHash;
+    Entry.ShaderType = ShaderType;
+    Entry.SPIRV      = SPIRV;
+    Entry.GLSL       = GLSL;
+    Entry.Resources  = Resources;
+    return true;
+}
+
+void ShaderArchiveWriter::Write(std::vector<Uint8>& Data) const
+{
+    std::vector<const PendingEntry*> SortedEntries(m_Entries.size());
+    for (size_t i = 0; i < m_Entries.size(); ++i)
+        SortedEntries[i] = &m_Entries[i];
+    std::sort(SortedEntries.begin(), SortedEntries.end(),
+              [](const PendingEntry* pEntry0, const PendingEntry* pEntry1) //
+              {
+                  return pEntry0->NameHash < pEntry1->NameHash;
+              });
+
+    ShaderArchiveHeader Header;
+    Header.NumEntries  = static_cast<Uint32>(SortedEntries.size());
+    Header.IndexOffset = Align(sizeof(ShaderArchiveHeader), ShaderArchiveAlignment);
+
+    std::vector<ShaderArchiveIndexEntry> Index(SortedEntries.size());
+
+    // Compute data layout
+    Uint64 Offset  = Header.IndexOffset + Index.size() * sizeof(ShaderArchiveIndexEntry);
+    auto   Reserve = [&Offset](Uint64 Size, bool NullTerminated) {
+        ShaderArchiveDataRange Range;
+        if (Size != 0 || NullTerminated)
+        {
+            Range.Offset = Align(Offset, Uint64{ShaderArchiveAlignment});
+            Range.Size   = Size;
+            Offset       = Range.Offset + Size + (NullTerminated ? 1 : 0);
+        }
+        return Range;
+    };
+    for (size_t i = 0; i < SortedEntries.size(); ++i)
+    {
+        const auto& Entry    = *SortedEntries[i];
+        auto&       IdxEntry = Index[i];
+
+        IdxEntry.NameHash   = Entry.NameHash;
+        IdxEntry.ShaderType = static_cast<Uint32>(Entry.ShaderType);
+        IdxEntry.Name       = Reserve(Entry.Name.length(), true);
+        IdxEntry.SPIRV      = Reserve(Entry.SPIRV.size() * sizeof(uint32_t), false);
+        IdxEntry.GLSL       = Reserve(Entry.GLSL.length(), !Entry.GLSL.empty());
+        IdxEntry.Resources  = Reserve(Entry.Resources.size(), false);
+    }
+    Header.ArchiveSize = Align(Offset, Uint64{ShaderArchiveAlignment});
+
+    Data.clear();
+    Data.resize(static_cast<size_t>(Header.ArchiveSize));
+    auto* pDst = Data.data();
+    memcpy(pDst, &Header, sizeof(Header));
+    if (!Index.empty())
+        memcpy(pDst + Header.IndexOffset, Index.data(), Index.size() * sizeof(ShaderArchiveIndexEntry));
+
+    for (size_t i = 0; i < SortedEntries.size(); ++i)
+    {
+        const auto& Entry    = *SortedEntries[i];
+        const auto& IdxEntry = Index[i];
+
+        // Null terminators are already in place as the buffer is zero-initialized
+        memcpy(pDst + IdxEntry.Name.Offset, Entry.Name.data(), Entry.Name.length());
+        if (!Entry.SPIRV.empty())
+            memcpy(pDst + IdxEntry.SPIRV.Offset, Entry.SPIRV.data(), IdxEntry.SPIRV.Size);
+        if (!Entry.GLSL.empty())
+            memcpy(pDst + IdxEntry.GLSL.Offset, Entry.GLSL.data(), Entry.GLSL.length());
+        if (!Entry.Resources.empty())
+            memcpy(pDst + IdxEntry.Resources.Offset, Entry.Resources.data(), Entry.Resources.size());
+    }
+}
+
+} // namespace Diligent
@@ -38,4 +38,10 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 void CreateDefaultShaderSourceStreamFactory(const Char*                       SearchDirectories,
                                             IShaderSourceInputStreamFactory** ppShaderSourceStreamFactory);
 
+/// Creates shader source stream factory that caches file contents in memory
+/// \param [in]  SearchDirectories           - Semicolon-seprated list of search directories.
+/// \param [out] ppShaderSourceStreamFactory - Memory address where pointer to the shader source stream factory will be written.
+void CreateCachingShaderSourceStreamFactory(const Char*                         SearchDirectories,
+                                            ICachingShaderSourceStreamFactory** ppShaderSourceStreamFactory);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
@@ -95,6 +95,12 @@ public:
         Diligent::CreateDefaultShaderSourceStreamFactory(SearchDirectories, ppShaderSourceFactory);
     }
 
+    virtual void DILIGENT_CALL_TYPE CreateCachingShaderSourceStreamFactory(const Char*                         SearchDirectories,
+                                                                           ICachingShaderSourceStreamFactory** ppShaderSourceFactory) const override final
+    {
+        Diligent::CreateCachingShaderSourceStreamFactory(SearchDirectories, ppShaderSourceFactory);
+    }
+
 private:
     class DummyReferenceCounters final : public IReferenceCounters
     {
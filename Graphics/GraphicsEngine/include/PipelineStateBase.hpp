@@ -333,6 +333,25 @@ public:
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_PipelineState, TDeviceObjectBase)
 
+    /// Base implementation of IPipelineState::CreateShaderResourceBindings() that creates
+    /// shader resource binding objects one by one. Backends override it when they can
+    /// create SRBs in a batch more efficiently.
+    virtual void DILIGENT_CALL_TYPE CreateShaderResourceBindings(Uint32                   NumSRBs,
+                                                                 IShaderResourceBinding** ppShaderResourceBindings,
+                                                                 bool                     InitStaticResources) override
+    {
+        DEV_CHECK_ERR(NumSRBs == 0 || ppShaderResourceBindings != nullptr, "ppShaderResourceBindings must not be null");
+        for (Uint32 i = 0; i < NumSRBs; ++i)
+            this->CreateShaderResourceBinding(ppShaderResourceBindings + i, InitStaticResources);
+    }
+
+    /// Base implementation of IPipelineState::GetStatus(). Pipeline states
+    /// are ready as soon as they are created unless the backend overrides this method.
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus() const override
+    {
+        return PIPELINE_STATE_STATUS_READY;
+    }
+
     Uint32 GetBufferStride(Uint32 BufferSlot) const
     {
         return BufferSlot < m_BufferSlotsUsed ? m_pStrides[BufferSlot] : 0;
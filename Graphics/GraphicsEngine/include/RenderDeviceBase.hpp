@@ -40,6 +40,7 @@
 #include "DeviceContext.h"
 #include "SwapChain.h"
 #include "GraphicsAccessories.hpp"
+#include "ShaderArchive.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
 #include "EngineMemory.h"
 #include "STDAllocator.hpp"
@@ -321,6 +322,64 @@ public:
     /// Implementation of IRenderDevice::CreateResourceMapping().
     virtual void DILIGENT_CALL_TYPE CreateResourceMapping(const ResourceMappingDesc& MappingDesc, IResourceMapping** ppMapping) override final;
 
+    /// Base implementation of IRenderDevice::CreateShaders() that creates shaders one by one.
+    /// Backends that can compile shaders in parallel override it.
+    virtual void DILIGENT_CALL_TYPE CreateShaders(const ShaderCreateInfo* pShaderCIs,
+                                                  Uint32                  NumShaders,
+                                                  IShader**               ppShaders) override
+    {
+        DEV_CHECK_ERR(NumShaders == 0 || (pShaderCIs != nullptr && ppShaders != nullptr), "pShaderCIs and ppShaders must not be null");
+        for (Uint32 i = 0; i < NumShaders; ++i)
+            this->CreateShader(pShaderCIs[i], ppShaders + i);
+    }
+
+    /// Base implementation of IRenderDevice::CreateShaderFromArchive() that creates the shader
+    /// from the GLSL source stored in the archive. Backends that can use precompiled byte code override it.
+    virtual void DILIGENT_CALL_TYPE CreateShaderFromArchive(IDataBlob*  pArchive,
+                                                            const Char* EntryName,
+                                                            IShader**   ppShader) override
+    {
+        DEV_CHECK_ERR(pArchive != nullptr && EntryName != nullptr && ppShader != nullptr, "pArchive, EntryName and ppShader must not be null");
+        *ppShader = nullptr;
+
+        if (!m_DeviceCaps.IsGLDevice() && !m_DeviceCaps.IsVulkanDevice())
+        {
+            LOG_ERROR_MESSAGE("Shader archives are not supported by this device");
+            return;
+        }
+
+        ShaderArchiveReader        Reader{pArchive->GetDataPtr(), pArchive->GetSize()};
+        ShaderArchiveReader::Entry Entry;
+        if (!Reader.FindEntry(EntryName, Entry))
+        {
+            LOG_ERROR_MESSAGE("Shader '", EntryName, "' is not found in the archive");
+            return;
+        }
+        if (Entry.GLSL == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Archive entry '", EntryName, "' does not contain GLSL source");
+            return;
+        }
+
+        // GLSL in the archive is converted from HLSL, which requires combined texture samplers
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Desc.Name                  = Entry.Name;
+        ShaderCI.Desc.ShaderType            = Entry.ShaderType;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_GLSL;
+        ShaderCI.Source                     = Entry.GLSL;
+        ShaderCI.UseCombinedTextureSamplers = true;
+        this->CreateShader(ShaderCI, ppShader);
+    }
+
+    /// Base implementation of IRenderDevice::CreatePipelineStateAsync() that creates the
+    /// pipeline synchronously. Backends that support asynchronous creation override it.
+    virtual void DILIGENT_CALL_TYPE CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc,
+                                                             IPipelineState*          pFallbackPSO,
+                                                             IPipelineState**         ppPipelineState) override
+    {
+        this->CreatePipelineState(PipelineDesc, ppPipelineState);
+    }
+
     /// Implementation of IRenderDevice::GetDeviceCaps().
     virtual const DeviceCaps& DILIGENT_CALL_TYPE GetDeviceCaps() const override final
     {
@@ -67,6 +67,18 @@ public:
         return m_pPSO;
     }
 
+    /// Implementation of IShaderResourceBinding::SetVariables() that binds every resource
+    /// through its variable. Backends that can batch descriptor updates override this method.
+    virtual void DILIGENT_CALL_TYPE SetVariables(const ResourceBindDesc* pBindings, Uint32 Count) override
+    {
+        for (Uint32 i = 0; i < Count; ++i)
+        {
+            const auto& Binding = pBindings[i];
+            if (auto* pVar = GetBindingVariable(Binding))
+                pVar->SetArray(&Binding.pObject, Binding.ArrayIndex, 1);
+        }
+    }
+
     template <typename PSOType>
     PSOType* GetPipelineState()
     {
@@ -80,6 +92,22 @@ public:
     }
 
 protected:
+    /// Finds the variable identified by the binding description, returns null if there is no such variable
+    IShaderResourceVariable* GetBindingVariable(const ResourceBindDesc& Binding)
+    {
+        auto* pVar = Binding.VariableIndex != INVALID_SHADER_VARIABLE_INDEX ?
+            this->GetVariableByIndex(Binding.ShaderType, Binding.VariableIndex) :
+            this->GetVariableByHash(Binding.ShaderType, Binding.NameHash);
+        if (pVar == nullptr)
+        {
+            if (Binding.VariableIndex != INVALID_SHADER_VARIABLE_INDEX)
+                LOG_ERROR_MESSAGE("Unable to bind resource: shader variable with index ", Binding.VariableIndex, " is not found in Pipeline State '", m_pPSO->GetDesc().Name, "'");
+            else
+                LOG_ERROR_MESSAGE("Unable to bind resource: shader variable with name hash ", Binding.NameHash, " is not found in Pipeline State '", m_pPSO->GetDesc().Name, "'");
+        }
+        return pVar;
+    }
+
     /// Strong reference to PSO. We must use strong reference, because
     /// shader resource binding uses PSO's memory allocator to allocate
     /// memory for shader resource cache.
@@ -31,11 +31,13 @@
 /// Implementation of the Diligent::ShaderBase template class
 
 #include <vector>
+#include <unordered_set>
 
 #include "ShaderResourceVariable.h"
 #include "PipelineState.h"
 #include "StringTools.hpp"
 #include "GraphicsAccessories.hpp"
+#include "PerfectHashMap.hpp"
 
 namespace Diligent
 {
@@ -325,6 +327,58 @@ inline void VerifyAndCorrectSetArrayArguments(const char* Name, Uint32 ArraySize
     }
 }
 
+/// Immutable map from shader variable names to variable indices
+
+/// A pipeline state builds one map for every shader stage and variable set (static variables
+/// and shader resource binding variables) when it is created. All shader resource binding objects
+/// of the pipeline share the same maps, so that finding a variable by its name takes constant
+/// time regardless of the number of variables.
+class ShaderVariableIndexMap
+{
+public:
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    ShaderVariableIndexMap() {}
+
+    /// Builds the map for NumVariables variables, GetVariableName(i) must return the name of the i-th variable
+    /// or null if the variable should not be found by name. If several variables have the same name,
+    /// the name is mapped to the first one.
+    template <typename TGetVariableName>
+    ShaderVariableIndexMap(Uint32 NumVariables, TGetVariableName GetVariableName)
+    {
+        std::vector<PerfectHashMap<Uint32>::EntryType> Entries;
+        Entries.reserve(NumVariables);
+        std::unordered_set<String> Names;
+        for (Uint32 v = 0; v < NumVariables; ++v)
+        {
+            const Char* Name = GetVariableName(v);
+            if (Name != nullptr && Names.insert(Name).second)
+                Entries.emplace_back(Name, v);
+        }
+        m_Indices = PerfectHashMap<Uint32>{std::move(Entries)};
+    }
+
+    /// Returns the index of the variable with the given name, or InvalidIndex if there is no such variable
+    Uint32 Find(const Char* Name) const
+    {
+        const auto* pIndex = m_Indices.Find(Name);
+        return pIndex != nullptr ? *pIndex : InvalidIndex;
+    }
+
+    /// Returns the index of the variable whose name hash is NameHash (see ComputeShaderVariableNameHash()),
+    /// or InvalidIndex if there is no such variable
+    Uint32 FindByHash(Uint64 NameHash) const
+    {
+        const auto* pIndex = m_Indices.FindByHash(NameHash);
+        return pIndex != nullptr ? *pIndex : InvalidIndex;
+    }
+
+    Uint32 GetSize() const { return static_cast<Uint32>(m_Indices.size()); }
+
+private:
+    PerfectHashMap<Uint32> m_Indices;
+};
+
 struct DefaultShaderVariableIDComparator
 {
     bool operator()(const INTERFACE_ID& IID) const
@@ -43,6 +43,7 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 
 struct ITexture;
 struct IBuffer;
+struct IDataBlob;
 
 /// Value type
 
@@ -1328,6 +1329,13 @@ struct EngineGLCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 
 	/// Native window wrapper
 	NativeWindow Window;
+
+    /// Path to the directory where GLSL sources converted from HLSL are cached.
+
+    /// Converted sources are always cached in memory. If the directory is specified,
+    /// they are also stored on disk and reused by subsequent runs. The directory must exist.
+    /// If null or empty, the disk cache is disabled.
+    const Char* HLSL2GLSLCacheDirectory DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct EngineGLCreateInfo EngineGLCreateInfo;
 
@@ -1543,6 +1551,32 @@ struct VulkanDescriptorPoolSize
 typedef struct VulkanDescriptorPoolSize VulkanDescriptorPoolSize;
 
 
+/// SPIR-V optimization flags
+
+/// The flags control how the Vulkan backend post-processes SPIR-V byte code
+/// produced from shader sources by the glslang compiler.
+DILIGENT_TYPED_ENUM(SPIRV_OPTIMIZATION_FLAGS, Uint8)
+{
+    /// No optimization. SPIR-V generated from HLSL is still legalized.
+    SPIRV_OPTIMIZATION_FLAG_NONE                  = 0x00,
+
+    /// Run SPIRV-Tools performance optimization passes.
+    SPIRV_OPTIMIZATION_FLAG_PERFORMANCE           = 0x01,
+
+    /// Run SPIRV-Tools size optimization passes.
+    SPIRV_OPTIMIZATION_FLAG_SIZE                  = 0x02,
+
+    /// Run aggressive dead code and dead function elimination.
+    SPIRV_OPTIMIZATION_FLAG_DEAD_CODE_ELIMINATION = 0x04,
+
+    /// Strip debug information (names, source and line instructions) from the byte code
+    /// passed to vkCreateShaderModule. Shader reflection is performed before the
+    /// information is removed, so resources can still be accessed by name.
+    SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO      = 0x08
+};
+DEFINE_FLAG_ENUM_OPERATORS(SPIRV_OPTIMIZATION_FLAGS)
+
+
 /// Attributes specific to Vulkan engine
 struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 
@@ -1615,6 +1649,46 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// the global dynamic heap to perform lock-free dynamic suballocations
     Uint32 DynamicHeapPageSize              DEFAULT_INITIALIZER(256 << 10);
 
+    /// Whether to destroy stale resources on a background thread.
+
+    /// When enabled, resources whose release fence has completed are handed over
+    /// to a worker thread instead of being destroyed by the thread that purges the release queues.
+    /// All pending resources are destroyed when the GPU is idled and when the device is destroyed.
+    bool EnableAsyncResourceDestruction     DEFAULT_INITIALIZER(false);
+
+    /// Maximum time, in milliseconds, the resource destruction thread may spend
+    /// destroying resources per frame. Zero means no limit.
+    /// This member is ignored if EnableAsyncResourceDestruction is false.
+    Float32 ResourceDestructionBudgetMs     DEFAULT_INITIALIZER(2.f);
+
+    /// Path to the directory where SPIR-V byte code compiled from shader sources is cached.
+
+    /// When shader is created from source, the engine first looks up the byte code in the cache
+    /// and only runs the compiler if there is no valid entry. The directory must exist.
+    /// If null or empty, the cache is disabled.
+    const Char* SPIRVCacheDirectory         DEFAULT_INITIALIZER(nullptr);
+
+    /// Initial data for the device-wide Vulkan pipeline cache.
+
+    /// The data is typically obtained from IRenderDeviceVk::GetPipelineCacheData()
+    /// in a previous run. The engine validates the cache header against the physical
+    /// device (vendor, device ID and pipeline cache UUID) and ignores the data if
+    /// it does not match. If null, the pipeline cache is created empty.
+    struct IDataBlob* pPipelineCacheData    DEFAULT_INITIALIZER(nullptr);
+
+    /// Number of worker threads used for asynchronous pipeline state creation
+    /// (see IRenderDevice::CreatePipelineStateAsync()) and batched shader compilation
+    /// (see IRenderDevice::CreateShaders()). If zero, the engine uses
+    /// the number of hardware threads minus one. The threads are started on first use.
+    Uint32 NumWorkerThreads                 DEFAULT_INITIALIZER(0);
+
+    /// SPIR-V optimization flags applied to shaders compiled from source, see Diligent::SPIRV_OPTIMIZATION_FLAGS.
+
+    /// Optimized byte code is stored in the SPIR-V cache, so the flags are part of the cache key.
+    /// When ShaderCreateInfo::ppCompilerOutput is not null, the compiler output reports
+    /// SPIR-V instruction counts before and after optimization.
+    SPIRV_OPTIMIZATION_FLAGS SPIRVOptimizationFlags DEFAULT_INITIALIZER(SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[5]
 #if DILIGENT_CPP_INTERFACE
@@ -1627,6 +1701,28 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     }
 #endif
     ;
+
+    /// Whether to create the device-wide bindless resource table.
+
+    /// The table is a single update-after-bind descriptor set (VK_EXT_descriptor_indexing) that holds
+    /// all texture shader resource views, structured and raw buffer views, and samplers created by the
+    /// application. Every such object receives a stable index in the table when it is created (see
+    /// ITextureViewVk::GetBindlessIndex(), IBufferViewVk::GetBindlessIndex(), ISamplerVk::GetBindlessIndex()).
+    /// This costs one descriptor write per object. Internal views created by the engine are not placed
+    /// in the table. Runtime-sized arrays of
+    /// textures, storage buffers and samplers in shaders (e.g. texture2D g_Textures[]) are bound to the
+    /// table, so that shaders can index resources directly.
+    /// The member is ignored if the device does not support the extension.
+    bool EnableBindlessResources            DEFAULT_INITIALIZER(false);
+
+    /// The number of texture slots in the bindless resource table.
+    Uint32 NumBindlessSampledImages         DEFAULT_INITIALIZER(16384);
+
+    /// The number of buffer slots in the bindless resource table.
+    Uint32 NumBindlessStorageBuffers        DEFAULT_INITIALIZER(4096);
+
+    /// The number of sampler slots in the bindless resource table.
+    Uint32 NumBindlessSamplers              DEFAULT_INITIALIZER(256);
 };
 typedef struct EngineVkCreateInfo EngineVkCreateInfo;
 
@@ -250,6 +250,21 @@ struct PipelineStateDesc DILIGENT_DERIVE(DeviceObjectAttribs)
 };
 typedef struct PipelineStateDesc PipelineStateDesc;
 
+
+/// Pipeline state status
+DILIGENT_TYPED_ENUM(PIPELINE_STATE_STATUS, Uint8)
+{
+    /// The pipeline state is being created asynchronously and can't be used for
+    /// draw or dispatch commands yet.
+    PIPELINE_STATE_STATUS_COMPILING = 0,
+
+    /// The pipeline state is ready to be used.
+    PIPELINE_STATE_STATUS_READY,
+
+    /// Asynchronous pipeline state creation failed. The pipeline state can't be used.
+    PIPELINE_STATE_STATUS_FAILED
+};
+
 // {06084AE5-6A71-4FE8-84B9-395DD489A28C}
 static const struct INTERFACE_ID IID_PipelineState =
     {0x6084ae5, 0x6a71, 0x4fe8, {0x84, 0xb9, 0x39, 0x5d, 0xd4, 0x89, 0xa2, 0x8c}};
@@ -333,6 +348,25 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
                                                      bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
 
 
+    /// Creates multiple shader resource binding objects
+
+    /// \param [in]  NumSRBs                  - the number of shader resource binding objects to create.
+    /// \param [out] ppShaderResourceBindings - memory location where pointers to the new shader resource
+    ///                                         binding objects are written. The array must contain
+    ///                                         at least NumSRBs elements.
+    /// \param [in]  InitStaticResources      - if set to true, the method will initialize static resources in
+    ///                                         the created objects, which has the exact same effect as calling
+    ///                                         IShaderResourceBinding::InitializeStaticResources().
+    /// \remarks The method has the same effect as calling CreateShaderResourceBinding() NumSRBs times,
+    ///          but allows the implementation to amortize the cost of creating the objects, e.g.
+    ///          by allocating all descriptor sets at once. Use this method when many SRBs are created
+    ///          for the same pipeline, for instance when loading materials.
+    VIRTUAL void METHOD(CreateShaderResourceBindings)(THIS_
+                                                      Uint32                   NumSRBs,
+                                                      IShaderResourceBinding** ppShaderResourceBindings,
+                                                      bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
+
+
     /// Checks if this pipeline state object is compatible with another PSO
 
     /// If two pipeline state objects are compatible, they can use shader resource binding
@@ -349,6 +383,14 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
     ///             into account vertex shader input layout, number of outputs, etc.
     VIRTUAL bool METHOD(IsCompatibleWith)(THIS_
                                           const struct IPipelineState* pPSO) CONST PURE;
+
+
+    /// Returns the pipeline state status
+
+    /// \remarks  Pipeline states created by IRenderDevice::CreatePipelineState() are always ready.
+    ///           Pipeline states created by IRenderDevice::CreatePipelineStateAsync() are in
+    ///           PIPELINE_STATE_STATUS_COMPILING status until the background creation finishes.
+    VIRTUAL PIPELINE_STATE_STATUS METHOD(GetStatus)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -360,12 +402,14 @@ DILIGENT_END_INTERFACE
 
 #    define IPipelineState_GetDesc(This) (const struct PipelineStateDesc*)IDeviceObject_GetDesc(This)
 
-#    define IPipelineState_BindStaticResources(This, ...)         CALL_IFACE_METHOD(PipelineState, BindStaticResources,         This, __VA_ARGS__)
-#    define IPipelineState_GetStaticVariableCount(This, ...)      CALL_IFACE_METHOD(PipelineState, GetStaticVariableCount,      This, __VA_ARGS__)
-#    define IPipelineState_GetStaticVariableByName(This, ...)     CALL_IFACE_METHOD(PipelineState, GetStaticVariableByName,     This, __VA_ARGS__)
-#    define IPipelineState_GetStaticVariableByIndex(This, ...)    CALL_IFACE_METHOD(PipelineState, GetStaticVariableByIndex,    This, __VA_ARGS__)
-#    define IPipelineState_CreateShaderResourceBinding(This, ...) CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBinding, This, __VA_ARGS__)
-#    define IPipelineState_IsCompatibleWith(This, ...)            CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,            This, __VA_ARGS__)
+#    define IPipelineState_BindStaticResources(This, ...)          CALL_IFACE_METHOD(PipelineState, BindStaticResources,          This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableCount(This, ...)       CALL_IFACE_METHOD(PipelineState, GetStaticVariableCount,       This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableByName(This, ...)      CALL_IFACE_METHOD(PipelineState, GetStaticVariableByName,      This, __VA_ARGS__)
+#    define IPipelineState_GetStaticVariableByIndex(This, ...)     CALL_IFACE_METHOD(PipelineState, GetStaticVariableByIndex,     This, __VA_ARGS__)
+#    define IPipelineState_CreateShaderResourceBinding(This, ...)  CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBinding,  This, __VA_ARGS__)
+#    define IPipelineState_CreateShaderResourceBindings(This, ...) CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBindings, This, __VA_ARGS__)
+#    define IPipelineState_IsCompatibleWith(This, ...)             CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,             This, __VA_ARGS__)
+#    define IPipelineState_GetStatus(This)                         CALL_IFACE_METHOD(PipelineState, GetStatus,                    This)
 
 // clang-format on
 
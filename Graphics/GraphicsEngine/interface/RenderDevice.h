@@ -100,6 +100,45 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
                                       const ShaderCreateInfo REF ShaderCI,
                                       IShader**                   ppShader) PURE;
 
+    /// Creates multiple shader objects
+
+    /// \param [in]  pShaderCIs - Array of NumShaders shader create infos, see Diligent::ShaderCreateInfo for details.
+    /// \param [in]  NumShaders - The number of shaders to create.
+    /// \param [out] ppShaders  - Array of NumShaders memory locations where the pointers to the
+    ///                           shader interfaces will be stored. The function calls AddRef()
+    ///                           for every created object. If a shader fails to compile, the
+    ///                           corresponding element is set to null.
+    ///
+    /// \remarks  The method has the same effect as calling CreateShader() for every element
+    ///           of the array, but allows the implementation to compile the shaders in parallel.
+    ///           Compiler output is written to ShaderCreateInfo::ppCompilerOutput of every element.\n
+    ///           Shader source stream factories referenced by the create infos may be accessed
+    ///           from multiple threads at the same time.
+    VIRTUAL void METHOD(CreateShaders)(THIS_
+                                       const ShaderCreateInfo* pShaderCIs,
+                                       Uint32                  NumShaders,
+                                       IShader**               ppShaders) PURE;
+
+    /// Creates a new shader object from an entry of a shader archive
+
+    /// \param [in]  pArchive  - Data blob that contains the shader archive produced by the
+    ///                          ShaderArchiver build tool (see ShaderArchive.hpp). The blob may wrap
+    ///                          a memory-mapped file; its data must be 8-byte aligned.
+    /// \param [in]  EntryName - Name of the archive entry.
+    /// \param [out] ppShader  - Address of the memory location where the pointer to the
+    ///                          shader interface will be stored.
+    ///                          The function calls AddRef(), so that the new object will contain
+    ///                          one reference.
+    ///
+    /// \remarks  Vulkan backend uses precompiled SPIR-V and serialized reflection from the archive,
+    ///           so neither the compiler nor the reflection runs. OpenGL backend compiles the GLSL
+    ///           source from the archive. Direct3D backends do not support shader archives.\n
+    ///           The archive is not referenced after the method returns.
+    VIRTUAL void METHOD(CreateShaderFromArchive)(THIS_
+                                                 IDataBlob*  pArchive,
+                                                 const Char* EntryName,
+                                                 IShader**   ppShader) PURE;
+
     /// Creates a new texture object
 
     /// \param [in] TexDesc - Texture description, see Diligent::TextureDesc for details.
@@ -164,6 +203,35 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
                                              IPipelineState**            ppPipelineState) PURE;
 
 
+    /// Creates a new pipeline state object asynchronously
+
+    /// \param [in]  PipelineDesc    - Pipeline state description, see Diligent::PipelineStateDesc for details.
+    /// \param [in]  pFallbackPSO    - Optional pipeline state that is used for draw and dispatch commands
+    ///                                while the new pipeline state is being created. The fallback pipeline
+    ///                                must be compatible with the new one (see IPipelineState::IsCompatibleWith()),
+    ///                                so that shader resource bindings of the new pipeline can be committed.
+    ///                                A graphics fallback pipeline must also use the same render target formats,
+    ///                                input layout and primitive topology.
+    ///                                If null, draw and dispatch commands are skipped until the pipeline is ready.
+    /// \param [out] ppPipelineState - Address of the memory location where the pointer to the
+    ///                                pipeline state interface will be stored.
+    ///                                The function calls AddRef(), so that the new object will contain
+    ///                                one reference.
+    ///
+    /// \remarks  The method returns immediately after the resource layout of the pipeline is initialized,
+    ///           so the pipeline can be used to create shader resource bindings and access static variables.
+    ///           Shader modules and the pipeline itself are created by worker threads. Use
+    ///           IPipelineState::GetStatus() to check if the pipeline is ready.
+    ///           Releasing the pipeline state while it is being created does not block: the object is
+    ///           destroyed by the worker thread when the creation is complete.\n
+    ///           Backends that do not support asynchronous pipeline creation create the pipeline
+    ///           synchronously.
+    VIRTUAL void METHOD(CreatePipelineStateAsync)(THIS_
+                                                  const PipelineStateDesc REF PipelineDesc,
+                                                  IPipelineState*             pFallbackPSO,
+                                                  IPipelineState**            ppPipelineState) PURE;
+
+
     /// Creates a new fence object
 
     /// \param [in]  Desc    - Fence description, see Diligent::FenceDesc for details.
@@ -247,20 +315,23 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IRenderDevice_CreateBuffer(This, ...)            CALL_IFACE_METHOD(RenderDevice, CreateBuffer,           This, __VA_ARGS__)
-#    define IRenderDevice_CreateShader(This, ...)            CALL_IFACE_METHOD(RenderDevice, CreateShader,           This, __VA_ARGS__)
-#    define IRenderDevice_CreateTexture(This, ...)           CALL_IFACE_METHOD(RenderDevice, CreateTexture,          This, __VA_ARGS__)
-#    define IRenderDevice_CreateSampler(This, ...)           CALL_IFACE_METHOD(RenderDevice, CreateSampler,          This, __VA_ARGS__)
-#    define IRenderDevice_CreateResourceMapping(This, ...)   CALL_IFACE_METHOD(RenderDevice, CreateResourceMapping,  This, __VA_ARGS__)
-#    define IRenderDevice_CreatePipelineState(This, ...)     CALL_IFACE_METHOD(RenderDevice, CreatePipelineState,    This, __VA_ARGS__)
-#    define IRenderDevice_CreateFence(This, ...)             CALL_IFACE_METHOD(RenderDevice, CreateFence,            This, __VA_ARGS__)
-#    define IRenderDevice_CreateQuery(This, ...)             CALL_IFACE_METHOD(RenderDevice, CreateQuery,            This, __VA_ARGS__)
-#    define IRenderDevice_GetDeviceCaps(This)                CALL_IFACE_METHOD(RenderDevice, GetDeviceCaps,          This)
-#    define IRenderDevice_GetTextureFormatInfo(This, ...)    CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfo,   This, __VA_ARGS__)
-#    define IRenderDevice_GetTextureFormatInfoExt(This, ...) CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfoExt,This, __VA_ARGS__)
-#    define IRenderDevice_ReleaseStaleResources(This, ...)   CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,  This, __VA_ARGS__)
-#    define IRenderDevice_IdleGPU(This)                      CALL_IFACE_METHOD(RenderDevice, IdleGPU,                This)
-#    define IRenderDevice_GetEngineFactory(This)             CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,       This)
+#    define IRenderDevice_CreateBuffer(This, ...)              CALL_IFACE_METHOD(RenderDevice, CreateBuffer,             This, __VA_ARGS__)
+#    define IRenderDevice_CreateShader(This, ...)              CALL_IFACE_METHOD(RenderDevice, CreateShader,             This, __VA_ARGS__)
+#    define IRenderDevice_CreateShaders(This, ...)             CALL_IFACE_METHOD(RenderDevice, CreateShaders,            This, __VA_ARGS__)
+#    define IRenderDevice_CreateShaderFromArchive(This, ...)   CALL_IFACE_METHOD(RenderDevice, CreateShaderFromArchive,  This, __VA_ARGS__)
+#    define IRenderDevice_CreateTexture(This, ...)             CALL_IFACE_METHOD(RenderDevice, CreateTexture,            This, __VA_ARGS__)
+#    define IRenderDevice_CreateSampler(This, ...)             CALL_IFACE_METHOD(RenderDevice, CreateSampler,            This, __VA_ARGS__)
+#    define IRenderDevice_CreateResourceMapping(This, ...)     CALL_IFACE_METHOD(RenderDevice, CreateResourceMapping,    This, __VA_ARGS__)
+#    define IRenderDevice_CreatePipelineState(This, ...)       CALL_IFACE_METHOD(RenderDevice, CreatePipelineState,      This, __VA_ARGS__)
+#    define IRenderDevice_CreatePipelineStateAsync(This, ...)  CALL_IFACE_METHOD(RenderDevice, CreatePipelineStateAsync, This, __VA_ARGS__)
+#    define IRenderDevice_CreateFence(This, ...)               CALL_IFACE_METHOD(RenderDevice, CreateFence,              This, __VA_ARGS__)
+#    define IRenderDevice_CreateQuery(This, ...)               CALL_IFACE_METHOD(RenderDevice, CreateQuery,              This, __VA_ARGS__)
+#    define IRenderDevice_GetDeviceCaps(This)                  CALL_IFACE_METHOD(RenderDevice, GetDeviceCaps,            This)
+#    define IRenderDevice_GetTextureFormatInfo(This, ...)      CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfo,     This, __VA_ARGS__)
+#    define IRenderDevice_GetTextureFormatInfoExt(This, ...)   CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfoExt,  This, __VA_ARGS__)
+#    define IRenderDevice_ReleaseStaleResources(This, ...)     CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,    This, __VA_ARGS__)
+#    define IRenderDevice_IdleGPU(This)                        CALL_IFACE_METHOD(RenderDevice, IdleGPU,                  This)
+#    define IRenderDevice_GetEngineFactory(This)               CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,         This)
 
 // clang-format on
 
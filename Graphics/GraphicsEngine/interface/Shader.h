@@ -111,6 +111,59 @@ DILIGENT_END_INTERFACE
 
 #endif
 
+// {6C2D9B63-3F1A-4A8E-9E0B-5D27C8A14F36}
+static const INTERFACE_ID IID_CachingShaderSourceStreamFactory =
+    {0x6c2d9b63, 0x3f1a, 0x4a8e, {0x9e, 0xb, 0x5d, 0x27, 0xc8, 0xa1, 0x4f, 0x36}};
+
+// clang-format off
+
+#define DILIGENT_INTERFACE_NAME ICachingShaderSourceStreamFactory
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define ICachingShaderSourceStreamFactoryInclusiveMethods \
+    IShaderSourceInputStreamFactoryInclusiveMethods;      \
+    ICachingShaderSourceStreamFactoryMethods CachingShaderSourceStreamFactory
+
+/// Shader source stream factory that keeps file contents in memory
+
+/// Files are read once and are served from memory to all subsequent and concurrent
+/// CreateInputStream() calls. A file is reread only when its modification time or size changes.
+DILIGENT_BEGIN_INTERFACE(ICachingShaderSourceStreamFactory, IShaderSourceInputStreamFactory)
+{
+    /// Computes the hash of the file and all files it includes directly or indirectly.
+
+    /// \param [in] Name - File name, resolved in the same way as by CreateInputStream().
+    /// \return            Hash that changes whenever any file in the include tree changes, or 0
+    ///                    if the file can't be found. The hash can be used as a key of a compiled shader cache.
+    ///
+    /// \note  Include directives are found by a simple text search. Directives in inactive
+    ///        preprocessor branches are also followed, which may only make the hash more conservative.
+    VIRTUAL Uint64 METHOD(ComputeDependencyHash)(THIS_
+                                                 const Char* Name) PURE;
+
+    /// Reads all files in the directory and its subdirectories into the cache.
+
+    /// \param [in] Directory - Directory relative to the search directories. If empty or null,
+    ///                         the search directories themselves are preloaded.
+    /// \return                 The number of files that were loaded. On platforms where the file system
+    ///                         does not support directory search (Android, UWP), nothing is preloaded
+    ///                         and the files are loaded on first use.
+    VIRTUAL Uint32 METHOD(PreloadDirectory)(THIS_
+                                            const Char* Directory) PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format on
+
+#    define ICachingShaderSourceStreamFactory_ComputeDependencyHash(This, ...) CALL_IFACE_METHOD(CachingShaderSourceStreamFactory, ComputeDependencyHash, This, __VA_ARGS__)
+#    define ICachingShaderSourceStreamFactory_PreloadDirectory(This, ...)      CALL_IFACE_METHOD(CachingShaderSourceStreamFactory, PreloadDirectory,      This, __VA_ARGS__)
+
+#endif
+
 
 struct ShaderMacro
 {
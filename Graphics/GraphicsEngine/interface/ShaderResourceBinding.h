@@ -44,6 +44,52 @@ static const INTERFACE_ID IID_ShaderResourceBinding =
     {0x61f8774, 0x9a09, 0x48e8, {0x84, 0x11, 0xb5, 0xbd, 0x20, 0x56, 0x1, 0x4}};
 
 
+// clang-format off
+
+/// Special value of ResourceBindDesc::VariableIndex that indicates that
+/// the variable is identified by the hash of its name.
+static const Uint32 INVALID_SHADER_VARIABLE_INDEX = ~0u;
+
+/// Describes a resource bound by IShaderResourceBinding::SetVariables()
+struct ResourceBindDesc
+{
+    /// Type of the shader that contains the variable. Must be one of Diligent::SHADER_TYPE.
+    SHADER_TYPE           ShaderType    DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// Index of the variable, see IShaderResourceBinding::GetVariableByIndex().
+    /// If the index is Diligent::INVALID_SHADER_VARIABLE_INDEX, the variable
+    /// is identified by NameHash.
+    Uint32                VariableIndex DEFAULT_INITIALIZER(INVALID_SHADER_VARIABLE_INDEX);
+
+    /// Hash of the variable name computed by Diligent::ComputeShaderVariableNameHash().
+    /// The member is only used when VariableIndex is Diligent::INVALID_SHADER_VARIABLE_INDEX.
+    Uint64                NameHash      DEFAULT_INITIALIZER(0);
+
+    /// Object to bind to the variable.
+    IDeviceObject*        pObject       DEFAULT_INITIALIZER(nullptr);
+
+    /// Array element to bind the object to.
+    Uint32                ArrayIndex    DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    ResourceBindDesc()noexcept{}
+
+    /// Initializes the structure to bind the object to the variable with the given index.
+    ResourceBindDesc(SHADER_TYPE    _ShaderType,
+                     Uint32         _VariableIndex,
+                     IDeviceObject* _pObject,
+                     Uint32         _ArrayIndex = 0)noexcept :
+        ShaderType   {_ShaderType   },
+        VariableIndex{_VariableIndex},
+        pObject      {_pObject      },
+        ArrayIndex   {_ArrayIndex   }
+    {}
+#endif
+};
+typedef struct ResourceBindDesc ResourceBindDesc;
+
+// clang-format on
+
 #define DILIGENT_INTERFACE_NAME IShaderResourceBinding
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -85,6 +131,32 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceBinding, IObject)
                                                                SHADER_TYPE ShaderType,
                                                                const char* Name) PURE;
 
+    /// Returns variable using the precomputed hash of its name
+
+    /// \param [in] ShaderType - Type of the shader to look up the variable.
+    ///                          Must be one of Diligent::SHADER_TYPE.
+    /// \param [in] NameHash   - Hash of the variable name computed by Diligent::ComputeShaderVariableNameHash().
+    ///
+    /// \remark The method returns the same variable as IShaderResourceBinding::GetVariableByName(),
+    ///         but neither hashes nor compares the name, so it is the fastest way to find a variable
+    ///         that is accessed every frame. The method returns null if no variable has this name hash.
+    VIRTUAL IShaderResourceVariable* METHOD(GetVariableByHash)(THIS_
+                                                               SHADER_TYPE ShaderType,
+                                                               Uint64      NameHash) PURE;
+
+    /// Binds resources to multiple variables
+
+    /// \param [in] pBindings - Array of Count bindings. Every binding identifies the variable
+    ///                         either by its index or by the hash of its name, see Diligent::ResourceBindDesc.
+    /// \param [in] Count     - Number of elements in pBindings array.
+    ///
+    /// \remark The method is equivalent to finding every variable and calling IShaderResourceVariable::SetArray()
+    ///         for one element, but the bindings are validated once, and backends that write descriptors when
+    ///         resources are bound (Vulkan) update every descriptor set with a single call.
+    VIRTUAL void METHOD(SetVariables)(THIS_
+                                      const ResourceBindDesc* pBindings,
+                                      Uint32                  Count) PURE;
+
     /// Returns the total variable count for the specific shader stage.
 
     /// \param [in] ShaderType - Type of the shader.
@@ -140,6 +212,8 @@ DILIGENT_END_INTERFACE
 #    define IShaderResourceBinding_GetPipelineState(This)               CALL_IFACE_METHOD(ShaderResourceBinding, GetPipelineState,          This)
 #    define IShaderResourceBinding_BindResources(This, ...)             CALL_IFACE_METHOD(ShaderResourceBinding, BindResources,             This, __VA_ARGS__)
 #    define IShaderResourceBinding_GetVariableByName(This, ...)         CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByName,         This, __VA_ARGS__)
+#    define IShaderResourceBinding_GetVariableByHash(This, ...)         CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByHash,         This, __VA_ARGS__)
+#    define IShaderResourceBinding_SetVariables(This, ...)              CALL_IFACE_METHOD(ShaderResourceBinding, SetVariables,              This, __VA_ARGS__)
 #    define IShaderResourceBinding_GetVariableCount(This, ...)          CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableCount,          This, __VA_ARGS__)
 #    define IShaderResourceBinding_GetVariableByIndex(This, ...)        CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByIndex,        This, __VA_ARGS__)
 #    define IShaderResourceBinding_InitializeStaticResources(This, ...) CALL_IFACE_METHOD(ShaderResourceBinding, InitializeStaticResources, This, __VA_ARGS__)
@@ -26,31 +26,36 @@
  */
 
 #include "pch.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#if PLATFORM_WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <Windows.h>
+#endif
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "DefaultShaderSourceStreamFactory.h"
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "EngineMemory.h"
 #include "BasicFileStream.hpp"
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
 
-class DefaultShaderSourceStreamFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
-{
-public:
-    DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories);
-
-    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final;
-
-    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, ObjectBase<IShaderSourceInputStreamFactory>);
-
-private:
-    std::vector<String> m_SearchDirectories;
-};
-
-DefaultShaderSourceStreamFactory::DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories) :
-    ObjectBase<IShaderSourceInputStreamFactory>(pRefCounters)
+static std::vector<String> ParseSearchDirectories(const Char* SearchDirectories)
 {
+    std::vector<String> Directories;
     while (SearchDirectories)
     {
         const char* Semicolon = strchr(SearchDirectories, ';');
@@ -70,10 +75,30 @@ DefaultShaderSourceStreamFactory::DefaultShaderSourceStreamFactory(IReferenceCou
         {
             if (SearchPath.back() != '\\' && SearchPath.back() != '/')
                 SearchPath.push_back('\\');
-            m_SearchDirectories.push_back(SearchPath);
+            Directories.push_back(SearchPath);
         }
     }
-    m_SearchDirectories.push_back("");
+    Directories.push_back("");
+    return Directories;
+}
+
+class DefaultShaderSourceStreamFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories);
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final;
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, ObjectBase<IShaderSourceInputStreamFactory>);
+
+private:
+    std::vector<String> m_SearchDirectories;
+};
+
+DefaultShaderSourceStreamFactory::DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories) :
+    ObjectBase<IShaderSourceInputStreamFactory>(pRefCounters),
+    m_SearchDirectories{ParseSearchDirectories(SearchDirectories)}
+{
 }
 
 void DefaultShaderSourceStreamFactory::CreateInputStream(const Diligent::Char* Name, IFileStream** ppStream)
@@ -107,6 +132,353 @@ void DefaultShaderSourceStreamFactory::CreateInputStream(const Diligent::Char* N
     }
 }
 
+namespace
+{
+
+constexpr Uint64 NanosecondsPerSecond = 1000000000ull;
+
+// Returns the modification time in nanoseconds and the size of the file.
+// Returns false if the file does not exist or its status can't be queried (e.g. Android assets).
+bool GetFileStatus(const String& Path, Uint64& ModificationTime, Uint64& Size)
+{
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    struct _stat64 FileStat;
+    if (_stat64(Path.c_str(), &FileStat) != 0)
+        return false;
+    // Only whole seconds are available
+    ModificationTime = static_cast<Uint64>(FileStat.st_mtime) * NanosecondsPerSecond;
+#else
+    struct stat FileStat;
+    if (stat(Path.c_str(), &FileStat) != 0)
+        return false;
+#    if PLATFORM_MACOS || PLATFORM_IOS
+    const auto& MTime = FileStat.st_mtimespec;
+#    else
+    const auto& MTime = FileStat.st_mtim;
+#    endif
+    ModificationTime = static_cast<Uint64>(MTime.tv_sec) * NanosecondsPerSecond + static_cast<Uint64>(MTime.tv_nsec);
+#endif
+    Size = static_cast<Uint64>(FileStat.st_size);
+    return true;
+}
+
+// Returns true if the path is a symbolic link (or a junction on Windows).
+// The link itself is examined, not the object it points to.
+bool IsSymbolicLink(const String& Path)
+{
+#if PLATFORM_WIN32
+    const auto Attributes = GetFileAttributesA(Path.c_str());
+    return Attributes != INVALID_FILE_ATTRIBUTES && (Attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+#elif PLATFORM_UNIVERSAL_WINDOWS
+    (void)Path;
+    return false;
+#else
+    struct stat FileStat;
+    return lstat(Path.c_str(), &FileStat) == 0 && S_ISLNK(FileStat.st_mode);
+#endif
+}
+
+// File systems store modification time with different granularity (up to 2 seconds for FAT).
+// A file that was modified shortly before it was read may be modified again without changing
+// its modification time and size, so such files are not served from the cache.
+bool IsRecentlyModified(Uint64 ModificationTime)
+{
+    constexpr Uint64 TimestampGranularity = 2 * NanosecondsPerSecond;
+
+    const auto Now = static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::system_clock::now().time_since_epoch())
+                                              .count());
+    return ModificationTime + TimestampGranularity > Now;
+}
+
+// Finds names referenced by #include "..." and #include <...> directives
+void FindIncludes(const char* pSource, size_t Length, std::vector<String>& Includes)
+{
+    const char* const pEnd = pSource + Length;
+
+    const char* pos = pSource;
+    while (pos < pEnd)
+    {
+        const char* LineEnd = std::find(pos, pEnd, '\n');
+
+        while (pos < LineEnd && (*pos == ' ' || *pos == '\t'))
+            ++pos;
+        if (pos < LineEnd && *pos == '#')
+        {
+            ++pos;
+            while (pos < LineEnd && (*pos == ' ' || *pos == '\t'))
+                ++pos;
+
+            static constexpr char   IncludeDirective[] = "include";
+            static constexpr size_t IncludeLen         = sizeof(IncludeDirective) - 1;
+            if (static_cast<size_t>(LineEnd - pos) > IncludeLen && strncmp(pos, IncludeDirective, IncludeLen) == 0)
+            {
+                pos += IncludeLen;
+                while (pos < LineEnd && (*pos == ' ' || *pos == '\t'))
+                    ++pos;
+                if (pos < LineEnd && (*pos == '"' || *pos == '<'))
+                {
+                    const char  ClosingQuote = *pos == '"' ? '"' : '>';
+                    const char* NameStart    = pos + 1;
+                    const char* NameEnd      = std::find(NameStart, LineEnd, ClosingQuote);
+                    if (NameEnd != LineEnd && NameEnd != NameStart)
+                        Includes.emplace_back(NameStart, NameEnd);
+                }
+            }
+        }
+
+        pos = LineEnd + 1;
+    }
+}
+
+} // namespace
+
+class CachingShaderSourceStreamFactory final : public ObjectBase<ICachingShaderSourceStreamFactory>
+{
+public:
+    using TBase = ObjectBase<ICachingShaderSourceStreamFactory>;
+
+    CachingShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories) :
+        TBase{pRefCounters},
+        m_SearchDirectories{ParseSearchDirectories(SearchDirectories)}
+    {
+        for (auto& Dir : m_SearchDirectories)
+            FileSystem::CorrectSlashes(Dir, FileSystem::GetSlashSymbol());
+    }
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
+    {
+        if (ppInterface == nullptr)
+            return;
+
+        *ppInterface = nullptr;
+        if (IID == IID_CachingShaderSourceStreamFactory || IID == IID_IShaderSourceInputStreamFactory)
+        {
+            *ppInterface = this;
+            (*ppInterface)->AddRef();
+        }
+        else
+        {
+            TBase::QueryInterface(IID, ppInterface);
+        }
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final;
+
+    virtual Uint64 DILIGENT_CALL_TYPE ComputeDependencyHash(const Char* Name) override final;
+
+    virtual Uint32 DILIGENT_CALL_TYPE PreloadDirectory(const Char* Directory) override final;
+
+private:
+    struct FileEntry
+    {
+        RefCntAutoPtr<IDataBlob> pData;
+
+        Uint64 ModificationTime = 0;
+        Uint64 FileSize         = 0;
+        Uint64 ContentHash      = 0;
+
+        // The file was modified shortly before it was read, so the modification time and
+        // the size are not sufficient to detect changes and the file must be read again
+        bool ReadAgain = false;
+
+        // Names referenced by include directives
+        std::vector<String> Includes;
+    };
+
+    // Returns the entry for the file, resolving the name against the search directories.
+    // The entry is immutable and may be used without holding the lock.
+    std::shared_ptr<const FileEntry> FindFile(const Char* Name);
+
+    // Returns the cached entry for the full path, reading the file if it is not cached or has been modified
+    std::shared_ptr<const FileEntry> GetFile(const String& FullPath);
+
+    Uint32 PreloadDirectoryRecursive(const String& Directory);
+
+    std::vector<String> m_SearchDirectories;
+
+    std::mutex                                                        m_Mutex;
+    std::unordered_map<String, std::shared_ptr<const FileEntry>> m_Files;
+};
+
+std::shared_ptr<const CachingShaderSourceStreamFactory::FileEntry> CachingShaderSourceStreamFactory::GetFile(const String& FullPath)
+{
+    Uint64     ModificationTime = 0;
+    Uint64     FileSize         = 0;
+    const bool HasStatus        = GetFileStatus(FullPath, ModificationTime, FileSize);
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+
+        auto it = m_Files.find(FullPath);
+        if (it != m_Files.end() && it->second->ModificationTime == ModificationTime && it->second->FileSize == FileSize &&
+            !it->second->ReadAgain)
+            return it->second;
+    }
+
+    if (!HasStatus && !FileSystem::FileExists(FullPath.c_str()))
+        return nullptr;
+
+    // The file is read without holding the lock so that compilations that use other
+    // files are not blocked. If several threads read the same file, the last one wins.
+    RefCntAutoPtr<BasicFileStream> pFileStream{MakeNewRCObj<BasicFileStream>()(FullPath.c_str(), EFileAccessMode::Read)};
+    if (!pFileStream->IsValid())
+        return nullptr;
+
+    auto pEntry = std::make_shared<FileEntry>();
+
+    pEntry->pData = MakeNewRCObj<DataBlobImpl>()(0);
+    pFileStream->ReadBlob(pEntry->pData);
+    pEntry->ModificationTime = ModificationTime;
+    pEntry->FileSize         = FileSize;
+    pEntry->ReadAgain        = HasStatus && IsRecentlyModified(ModificationTime);
+
+    const auto* pSource = static_cast<const char*>(pEntry->pData->GetDataPtr());
+    const auto  Length  = pEntry->pData->GetSize();
+
+    pEntry->ContentHash = ComputeFNV1aHash(pSource, Length);
+    FindIncludes(pSource, Length, pEntry->Includes);
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    m_Files[FullPath] = pEntry;
+    return pEntry;
+}
+
+std::shared_ptr<const CachingShaderSourceStreamFactory::FileEntry> CachingShaderSourceStreamFactory::FindFile(const Char* Name)
+{
+    if (Name[0] == '\\' || Name[0] == '/')
+        ++Name;
+
+    for (const auto& SearchDir : m_SearchDirectories)
+    {
+        String FullPath = SearchDir + Name;
+        FileSystem::CorrectSlashes(FullPath, FileSystem::GetSlashSymbol());
+        if (auto pEntry = GetFile(FullPath))
+            return pEntry;
+    }
+
+    return nullptr;
+}
+
+void CachingShaderSourceStreamFactory::CreateInputStream(const Char* Name, IFileStream** ppStream)
+{
+    *ppStream = nullptr;
+
+    auto pEntry = FindFile(Name);
+    if (!pEntry)
+    {
+        LOG_ERROR("Failed to create input stream for source file ", Name);
+        return;
+    }
+
+    // Streams share the immutable file data and only keep their own read position
+    RefCntAutoPtr<MemoryFileStream> pMemStream{MakeNewRCObj<MemoryFileStream>()(pEntry->pData.RawPtr<IDataBlob>())};
+    pMemStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+}
+
+Uint64 CachingShaderSourceStreamFactory::ComputeDependencyHash(const Char* Name)
+{
+    auto pRoot = FindFile(Name);
+    if (!pRoot)
+        return 0;
+
+    StableHasher Hasher;
+
+    // Files are visited in a deterministic depth-first order. Every file is hashed once,
+    // which also guards against recursive includes.
+    std::unordered_set<String>                                      Visited;
+    std::vector<std::pair<String, std::shared_ptr<const FileEntry>>> Stack;
+    Stack.emplace_back(Name, std::move(pRoot));
+    while (!Stack.empty())
+    {
+        auto Name_Entry = std::move(Stack.back());
+        Stack.pop_back();
+        if (!Visited.insert(Name_Entry.first).second)
+            continue;
+
+        const auto& Entry = *Name_Entry.second;
+        Hasher.Update(Entry.ContentHash);
+        for (auto it = Entry.Includes.rbegin(); it != Entry.Includes.rend(); ++it)
+        {
+            if (Visited.find(*it) != Visited.end())
+                continue;
+
+            if (auto pInclude = FindFile(it->c_str()))
+            {
+                Stack.emplace_back(*it, std::move(pInclude));
+            }
+            else
+            {
+                // Missing files are hashed by name so that adding them later changes the hash
+                Hasher.Update(it->c_str(), it->length());
+            }
+        }
+    }
+
+    return Hasher.GetHash0();
+}
+
+Uint32 CachingShaderSourceStreamFactory::PreloadDirectoryRecursive(const String& Directory)
+{
+    Uint32 NumFiles = 0;
+
+    auto SearchRes = FileSystem::Search((Directory + '*').c_str());
+    for (const auto& FindData : SearchRes)
+    {
+        const auto* Name = FindData->Name();
+        if (strcmp(Name, ".") == 0 || strcmp(Name, "..") == 0)
+            continue;
+
+        if (FindData->IsDirectory())
+        {
+            // Linked directories are not followed: a link that points to one of its parents
+            // would make the recursion infinite, and a link to a sibling would load the same
+            // files twice under different names.
+            if (IsSymbolicLink(Directory + Name))
+                continue;
+
+            NumFiles += PreloadDirectoryRecursive(Directory + Name + FileSystem::GetSlashSymbol());
+        }
+        else if (GetFile(Directory + Name))
+        {
+            ++NumFiles;
+        }
+    }
+
+    return NumFiles;
+}
+
+Uint32 CachingShaderSourceStreamFactory::PreloadDirectory(const Char* Directory)
+{
+#if PLATFORM_ANDROID || PLATFORM_UNIVERSAL_WINDOWS
+    // Directory search is not supported by the file system, files are loaded on first use
+    (void)Directory;
+    return 0;
+#else
+    Uint32 NumFiles = 0;
+    for (const auto& SearchDir : m_SearchDirectories)
+    {
+        String Path = SearchDir;
+        if (Directory != nullptr && *Directory != '\0')
+        {
+            Path += (Directory[0] == '\\' || Directory[0] == '/') ? Directory + 1 : Directory;
+            FileSystem::CorrectSlashes(Path, FileSystem::GetSlashSymbol());
+            if (Path.back() != FileSystem::GetSlashSymbol())
+                Path.push_back(FileSystem::GetSlashSymbol());
+        }
+        else if (SearchDir.empty())
+        {
+            // Do not preload the entire working directory
+            continue;
+        }
+
+        NumFiles += PreloadDirectoryRecursive(Path);
+    }
+
+    return NumFiles;
+#endif
+}
+
 void CreateDefaultShaderSourceStreamFactory(const Char*                       SearchDirectories,
                                             IShaderSourceInputStreamFactory** ppShaderSourceStreamFactory)
 {
@@ -117,4 +489,13 @@ void CreateDefaultShaderSourceStreamFactory(const Char*                       Se
     pStreamFactory->QueryInterface(IID_IShaderSourceInputStreamFactory, reinterpret_cast<IObject**>(ppShaderSourceStreamFactory));
 }
 
+void CreateCachingShaderSourceStreamFactory(const Char*                         SearchDirectories,
+                                            ICachingShaderSourceStreamFactory** ppShaderSourceStreamFactory)
+{
+    auto&                             Allocator = GetRawAllocator();
+    CachingShaderSourceStreamFactory* pStreamFactory =
+        NEW_RC_OBJ(Allocator, "CachingShaderSourceStreamFactory instance", CachingShaderSourceStreamFactory)(SearchDirectories);
+    pStreamFactory->QueryInterface(IID_CachingShaderSourceStreamFactory, reinterpret_cast<IObject**>(ppShaderSourceStreamFactory));
+}
+
 } // namespace Diligent
@@ -121,6 +121,13 @@ public:
         return m_pStaticResourceLayouts[s];
     }
 
+    // Returns the map of the names of mutable and dynamic variables of the shader
+    const ShaderVariableIndexMap& GetSRBVarIndexMap(Uint32 s) const
+    {
+        VERIFY_EXPR(s < m_NumShaders);
+        return m_VarIndexMaps[s];
+    }
+
     ShaderResourceCacheD3D11& GetStaticResourceCache(Uint32 s)
     {
         VERIFY_EXPR(s < m_NumShaders);
@@ -139,6 +146,10 @@ private:
     ShaderResourceCacheD3D11*  m_pStaticResourceCaches  = nullptr;
     ShaderResourceLayoutD3D11* m_pStaticResourceLayouts = nullptr;
 
+    // Variable name maps shared by all SRBs. The first m_NumShaders maps are for SRB variables,
+    // and the remaining ones are for static variables.
+    std::vector<ShaderVariableIndexMap> m_VarIndexMaps;
+
     // SRB memory allocator must be defined before the default shader res binding
     SRBMemoryAllocator m_SRBMemAllocator;
 
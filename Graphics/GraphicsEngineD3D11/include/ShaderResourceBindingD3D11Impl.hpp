@@ -63,6 +63,9 @@ public:
     /// Implementation of IShaderResourceBinding::GetVariableByName() in Direct3D11 backend.
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByName(SHADER_TYPE ShaderType, const char* Name) override final;
 
+    /// Implementation of IShaderResourceBinding::GetVariableByHash() in Direct3D11 backend.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash) override final;
+
     /// Implementation of IShaderResourceBinding::GetVariableCount() in Direct3D11 backend.
     virtual Uint32 DILIGENT_CALL_TYPE GetVariableCount(SHADER_TYPE ShaderType) const override final;
 
@@ -70,6 +70,13 @@ public:
                                         const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
                                         Uint32                               NumAllowedTypes);
 
+    // Creates the map of the names of the variables that a layout initialized with the same
+    // arguments will contain. The pipeline state creates the maps once and all SRBs share them.
+    static ShaderVariableIndexMap CreateVariableIndexMap(const ShaderResourcesD3D11&          SrcResources,
+                                                         const PipelineResourceLayoutDesc&    ResourceLayout,
+                                                         const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                                                         Uint32                               NumAllowedTypes);
+
     void CopyResources(ShaderResourceCacheD3D11& DstCache) const;
 
     using ShaderVariableD3D11Base = ShaderVariableD3DBase<ShaderResourceLayoutD3D11>;
@@ -263,7 +270,9 @@ public:
     bool dvpVerifyBindings() const;
 #endif
 
-    IShaderResourceVariable*  GetShaderVariable(const Char* Name);
+    // The map must be created by CreateVariableIndexMap() with the same arguments as this layout
+    IShaderResourceVariable*  GetShaderVariable(const ShaderVariableIndexMap& VarIndexMap, const Char* Name);
+    IShaderResourceVariable*  GetShaderVariableByHash(const ShaderVariableIndexMap& VarIndexMap, Uint64 NameHash);
     IShaderResourceVariable*  GetShaderVariable(Uint32 Index);
     __forceinline SHADER_TYPE GetShaderType() const { return m_pResources->GetShaderType(); }
 
@@ -351,9 +360,6 @@ private:
         return reinterpret_cast<const ResourceType*>(reinterpret_cast<const Uint8*>(m_ResourceBuffer.get()) + Offset)[ResIndex];
     }
 
-    template <typename ResourceType>
-    IShaderResourceVariable* GetResourceByName(const Char* Name);
-
     template <typename THandleCB,
               typename THandleTexSRV,
               typename THandleTexUAV,
@@ -128,6 +128,7 @@ PipelineStateD3D11Impl::PipelineStateD3D11Impl(IReferenceCounters*      pRefCoun
 
     m_pStaticResourceLayouts = ALLOCATE(GetRawAllocator(), "Raw memory for ShaderResourceLayoutD3D11", ShaderResourceLayoutD3D11, m_NumShaders);
     m_pStaticResourceCaches  = ALLOCATE(GetRawAllocator(), "Raw memory for ShaderResourceCacheD3D11", ShaderResourceCacheD3D11, m_NumShaders);
+    m_VarIndexMaps.resize(m_NumShaders * 2);
 
     const auto& ResourceLayout = m_Desc.ResourceLayout;
 
@@ -187,11 +188,15 @@ PipelineStateD3D11Impl::PipelineStateD3D11Impl(IReferenceCounters*      pRefCoun
         }
         m_StaticSamplerOffsets[s + 1] = static_cast<Uint16>(StaticSamplers.size());
 
+        // Variable names are hashed once here rather than every time a variable is looked up
+        const SHADER_RESOURCE_VARIABLE_TYPE SRBVarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
+        m_VarIndexMaps[s]                                 = ShaderResourceLayoutD3D11::CreateVariableIndexMap(ShaderResources, ResourceLayout, SRBVarTypes, _countof(SRBVarTypes));
+        m_VarIndexMaps[m_NumShaders + s]                  = ShaderResourceLayoutD3D11::CreateVariableIndexMap(ShaderResources, ResourceLayout, StaticVarTypes, _countof(StaticVarTypes));
+
         if (m_Desc.SRBAllocationGranularity > 1)
         {
-            const SHADER_RESOURCE_VARIABLE_TYPE SRBVarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
-            ShaderResLayoutDataSizes[s]                       = ShaderResourceLayoutD3D11::GetRequiredMemorySize(ShaderResources, ResourceLayout, SRBVarTypes, _countof(SRBVarTypes));
-            ShaderResCacheDataSizes[s]                        = ShaderResourceCacheD3D11::GetRequriedMemorySize(ShaderResources);
+            ShaderResLayoutDataSizes[s] = ShaderResourceLayoutD3D11::GetRequiredMemorySize(ShaderResources, ResourceLayout, SRBVarTypes, _countof(SRBVarTypes));
+            ShaderResCacheDataSizes[s]  = ShaderResourceCacheD3D11::GetRequriedMemorySize(ShaderResources);
         }
 
         auto ShaderInd                   = GetShaderTypeIndex(pShader->GetDesc().ShaderType);
@@ -361,7 +366,7 @@ IShaderResourceVariable* PipelineStateD3D11Impl::GetStaticVariableByName(SHADER_
     if (LayoutInd < 0)
         return nullptr;
 
-    return m_pStaticResourceLayouts[LayoutInd].GetShaderVariable(Name);
+    return m_pStaticResourceLayouts[LayoutInd].GetShaderVariable(m_VarIndexMaps[m_NumShaders + LayoutInd], Name);
 }
 
 IShaderResourceVariable* PipelineStateD3D11Impl::GetStaticVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index)
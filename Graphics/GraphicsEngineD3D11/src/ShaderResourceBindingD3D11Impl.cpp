@@ -190,7 +190,25 @@ IShaderResourceVariable* ShaderResourceBindingD3D11Impl::GetVariableByName(SHADE
         return nullptr;
     }
 
-    return m_pResourceLayouts[ResLayoutIndex].GetShaderVariable(Name);
+    const auto* pPSOD3D11 = ValidatedCast<const PipelineStateD3D11Impl>(m_pPSO);
+    return m_pResourceLayouts[ResLayoutIndex].GetShaderVariable(pPSOD3D11->GetSRBVarIndexMap(ResLayoutIndex), Name);
+}
+
+IShaderResourceVariable* ShaderResourceBindingD3D11Impl::GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash)
+{
+    auto Ind = GetShaderTypeIndex(ShaderType);
+    VERIFY_EXPR(Ind >= 0 && Ind < _countof(m_ResourceLayoutIndex));
+    auto ResLayoutIndex = m_ResourceLayoutIndex[Ind];
+    if (ResLayoutIndex < 0)
+    {
+        LOG_WARNING_MESSAGE("Unable to find mutable/dynamic variable by name hash: shader stage ",
+                            GetShaderTypeLiteralName(ShaderType), " is inactive in Pipeline State '",
+                            m_pPSO->GetDesc().Name, "'");
+        return nullptr;
+    }
+
+    const auto* pPSOD3D11 = ValidatedCast<const PipelineStateD3D11Impl>(m_pPSO);
+    return m_pResourceLayouts[ResLayoutIndex].GetShaderVariableByHash(pPSOD3D11->GetSRBVarIndexMap(ResLayoutIndex), NameHash);
 }
 
 Uint32 ShaderResourceBindingD3D11Impl::GetVariableCount(SHADER_TYPE ShaderType) const
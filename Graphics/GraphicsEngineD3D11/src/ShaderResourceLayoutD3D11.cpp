@@ -101,6 +101,48 @@ size_t ShaderResourceLayoutD3D11::GetRequiredMemorySize(const ShaderResourcesD3D
 }
 
 
+ShaderVariableIndexMap ShaderResourceLayoutD3D11::CreateVariableIndexMap(const ShaderResourcesD3D11&          SrcResources,
+                                                                         const PipelineResourceLayoutDesc&    ResourceLayout,
+                                                                         const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                                                                         Uint32                               NumAllowedTypes)
+{
+    const auto AllowedTypeBits = GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes);
+
+    // Resources of every type are enumerated in the same order as they are initialized by the constructor
+    std::vector<const Char*> CBs, TexSRVs, TexUAVs, BufSRVs, BufUAVs, Samplers;
+
+    auto AddName = [&](std::vector<const Char*>& Names, const D3DShaderResourceAttribs& Attribs) //
+    {
+        if (IsAllowedType(SrcResources.FindVariableType(Attribs, ResourceLayout), AllowedTypeBits))
+            Names.push_back(Attribs.Name);
+    };
+
+    SrcResources.ProcessResources(
+        [&](const D3DShaderResourceAttribs& CB, Uint32) { AddName(CBs, CB); },
+        [&](const D3DShaderResourceAttribs& Sampler, Uint32) //
+        {
+            // Static samplers are never created in the resource layout
+            constexpr bool LogStaticSamplerArrayError = false;
+            if (SrcResources.FindStaticSampler(Sampler, ResourceLayout, LogStaticSamplerArrayError) < 0)
+                AddName(Samplers, Sampler);
+        },
+        [&](const D3DShaderResourceAttribs& TexSRV, Uint32) { AddName(TexSRVs, TexSRV); },
+        [&](const D3DShaderResourceAttribs& TexUAV, Uint32) { AddName(TexUAVs, TexUAV); },
+        [&](const D3DShaderResourceAttribs& BufSRV, Uint32) { AddName(BufSRVs, BufSRV); },
+        [&](const D3DShaderResourceAttribs& BufUAV, Uint32) { AddName(BufUAVs, BufUAV); });
+
+    // Variable indices follow the order used by GetShaderVariable(Uint32 Index)
+    std::vector<const Char*> Names;
+    for (const auto* pNames : {&CBs, &TexSRVs, &TexUAVs, &BufSRVs, &BufUAVs})
+        Names.insert(Names.end(), pNames->begin(), pNames->end());
+    // Do not expose sampler variables when using combined texture samplers
+    if (!SrcResources.IsUsingCombinedTextureSamplers())
+        Names.insert(Names.end(), Samplers.begin(), Samplers.end());
+
+    return ShaderVariableIndexMap{static_cast<Uint32>(Names.size()), [&](Uint32 v) { return Names[v]; }};
+}
+
+
 ShaderResourceLayoutD3D11::ShaderResourceLayoutD3D11(IObject&                                    Owner,
                                                      std::shared_ptr<const ShaderResourcesD3D11> pSrcResources,
                                                      const PipelineResourceLayoutDesc&           ResourceLayout,
@@ -698,45 +740,25 @@ void ShaderResourceLayoutD3D11::BindResources(IResourceMapping*               pR
     // clang-format on
 }
 
-template <typename ResourceType>
-IShaderResourceVariable* ShaderResourceLayoutD3D11::GetResourceByName(const Char* Name)
+IShaderResourceVariable* ShaderResourceLayoutD3D11::GetShaderVariable(const ShaderVariableIndexMap& VarIndexMap, const Char* Name)
 {
-    auto NumResources = GetNumResources<ResourceType>();
-    for (Uint32 res = 0; res < NumResources; ++res)
-    {
-        auto& Resource = GetResource<ResourceType>(res);
-        if (strcmp(Resource.m_Attribs.Name, Name) == 0)
-            return &Resource;
-    }
+    auto Index = VarIndexMap.Find(Name);
+    if (Index == ShaderVariableIndexMap::InvalidIndex)
+        return nullptr;
 
-    return nullptr;
+    auto* pVar = GetShaderVariable(Index);
+#ifdef _DEBUG
+    ShaderResourceDesc ResDesc;
+    pVar->GetResourceDesc(ResDesc);
+    VERIFY(strcmp(ResDesc.Name, Name) == 0, "Variable index map is not consistent with this layout");
+#endif
+    return pVar;
 }
 
-IShaderResourceVariable* ShaderResourceLayoutD3D11::GetShaderVariable(const Char* Name)
+IShaderResourceVariable* ShaderResourceLayoutD3D11::GetShaderVariableByHash(const ShaderVariableIndexMap& VarIndexMap, Uint64 NameHash)
 {
-    if (auto* pCB = GetResourceByName<ConstBuffBindInfo>(Name))
-        return pCB;
-
-    if (auto* pTexSRV = GetResourceByName<TexSRVBindInfo>(Name))
-        return pTexSRV;
-
-    if (auto* pTexUAV = GetResourceByName<TexUAVBindInfo>(Name))
-        return pTexUAV;
-
-    if (auto* pBuffSRV = GetResourceByName<BuffSRVBindInfo>(Name))
-        return pBuffSRV;
-
-    if (auto* pBuffUAV = GetResourceByName<BuffUAVBindInfo>(Name))
-        return pBuffUAV;
-
-    if (!m_pResources->IsUsingCombinedTextureSamplers())
-    {
-        // Static samplers are never created in the resource layout
-        if (auto* pSampler = GetResourceByName<SamplerBindInfo>(Name))
-            return pSampler;
-    }
-
-    return nullptr;
+    auto Index = VarIndexMap.FindByHash(NameHash);
+    return Index != ShaderVariableIndexMap::InvalidIndex ? GetShaderVariable(Index) : nullptr;
 }
 
 class ShaderVariableIndexLocator
@@ -105,6 +105,13 @@ public:
         return m_pShaderResourceLayouts[m_NumShaders + ShaderInd];
     }
 
+    // Returns the map of the names of mutable and dynamic variables of the shader
+    const ShaderVariableIndexMap& GetSRBVarIndexMap(Uint32 ShaderInd) const
+    {
+        VERIFY_EXPR(ShaderInd < m_NumShaders);
+        return m_VarIndexMaps[ShaderInd];
+    }
+
     ShaderResourceCacheD3D12& GetStaticShaderResCache(Uint32 ShaderInd) const
     {
         VERIFY_EXPR(ShaderInd < m_NumShaders);
@@ -128,6 +135,11 @@ private:
     ShaderResourceLayoutD3D12*  m_pShaderResourceLayouts = nullptr;
     ShaderResourceCacheD3D12*   m_pStaticResourceCaches  = nullptr;
     ShaderVariableManagerD3D12* m_pStaticVarManagers     = nullptr;
+
+    // Variable name maps shared by all variable managers. Like m_pShaderResourceLayouts, the first
+    // m_NumShaders maps are for SRB variables, and the remaining ones are for static variables.
+    std::vector<ShaderVariableIndexMap> m_VarIndexMaps;
+
     // Resource layout index in m_ResourceLayouts[] array for every shader stage
     Int8 m_ResourceLayoutIndex[6] = {-1, -1, -1, -1, -1, -1};
 };
@@ -59,6 +59,8 @@ public:
 
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByName(SHADER_TYPE ShaderType, const char* Name) override;
 
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash) override final;
+
     virtual Uint32 DILIGENT_CALL_TYPE GetVariableCount(SHADER_TYPE ShaderType) const override final;
 
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index) override final;
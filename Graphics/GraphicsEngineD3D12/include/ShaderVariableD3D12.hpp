@@ -72,12 +72,13 @@ namespace Diligent
 
 class ShaderVariableD3D12Impl;
 
-// sizeof(ShaderVariableManagerD3D12) == 32 (x64, msvc, Release)
+// sizeof(ShaderVariableManagerD3D12) == 40 (x64, msvc, Release)
 class ShaderVariableManagerD3D12
 {
 public:
     ShaderVariableManagerD3D12(IObject&                             Owner,
                                const ShaderResourceLayoutD3D12&     Layout,
+                               const ShaderVariableIndexMap&        VarIndexMap,
                                IMemoryAllocator&                    Allocator,
                                const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
                                Uint32                               NumAllowedTypes,
@@ -87,6 +88,7 @@ public:
     void Destroy(IMemoryAllocator& Allocator);
 
     ShaderVariableD3D12Impl* GetVariable(const Char* Name);
+    ShaderVariableD3D12Impl* GetVariableByHash(Uint64 NameHash);
     ShaderVariableD3D12Impl* GetVariable(Uint32 Index);
 
     void BindResources(IResourceMapping* pResourceMapping, Uint32 Flags);
@@ -96,11 +98,22 @@ public:
                                         Uint32                               NumAllowedTypes,
                                         Uint32&                              NumVariables);
 
+    // Creates the map of the names of the variables that a manager initialized with the same
+    // arguments will contain. The pipeline state creates the maps once and all managers share them.
+    static ShaderVariableIndexMap CreateVariableIndexMap(const ShaderResourceLayoutD3D12&     Layout,
+                                                         const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                                                         Uint32                               NumAllowedTypes);
+
     Uint32 GetVariableCount() const { return m_NumVariables; }
 
 private:
     friend ShaderVariableD3D12Impl;
 
+    template <typename THandler>
+    static void ProcessVariableResources(const ShaderResourceLayoutD3D12& Layout, Uint32 AllowedTypeBits, THandler Handler);
+
+    ShaderVariableD3D12Impl* GetVariableAtMapIndex(Uint32 Index, const Char* Name);
+
     Uint32 GetVariableIndex(const ShaderVariableD3D12Impl& Variable);
 
     // clang-format off
@@ -113,6 +126,9 @@ private:
     // (which the variables reference) are guaranteed to be alive while the manager is alive.
     ShaderResourceCacheD3D12&        m_ResourceCache;
 
+    // The map is owned by the pipeline state and is shared by all managers created for the same layout
+    const ShaderVariableIndexMap&    m_VarIndexMap;
+
     // Memory is allocated through the allocator provided by the pipeline state. If allocation granularity > 1, fixed block
     // memory allocator is used. This ensures that all resources from different shader resource bindings reside in
     // continuous memory. If allocation granularity == 1, raw allocator is used.
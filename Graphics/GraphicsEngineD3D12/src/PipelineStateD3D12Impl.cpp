@@ -91,6 +91,7 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*      pRefCoun
         auto& ShaderVarMgrAllocator = GetRawAllocator();
         m_pStaticVarManagers        = ALLOCATE(ShaderVarMgrAllocator, "Raw memory for ShaderVariableManagerD3D12", ShaderVariableManagerD3D12, m_NumShaders);
     }
+    m_VarIndexMaps.resize(m_NumShaders * 2);
 
 #ifdef DEVELOPMENT
     {
@@ -143,11 +144,17 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*      pRefCoun
                 nullptr //
             };
 
+        // Variable names are hashed once here rather than every time a variable is looked up
+        const SHADER_RESOURCE_VARIABLE_TYPE SRBVarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
+        m_VarIndexMaps[s]                = ShaderVariableManagerD3D12::CreateVariableIndexMap(GetShaderResLayout(s), SRBVarTypes, _countof(SRBVarTypes));
+        m_VarIndexMaps[m_NumShaders + s] = ShaderVariableManagerD3D12::CreateVariableIndexMap(GetStaticShaderResLayout(s), nullptr, 0);
+
         new (m_pStaticVarManagers + s)
             ShaderVariableManagerD3D12 //
             {
                 *this,
                 GetStaticShaderResLayout(s),
+                m_VarIndexMaps[m_NumShaders + s],
                 GetRawAllocator(),
                 nullptr,
                 0,
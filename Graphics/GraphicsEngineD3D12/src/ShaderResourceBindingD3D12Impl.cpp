@@ -73,6 +73,7 @@ ShaderResourceBindingD3D12Impl::ShaderResourceBindingD3D12Impl(IReferenceCounter
             {
                 *this,
                 SrcLayout,
+                pPSO->GetSRBVarIndexMap(s),
                 VarDataAllocator,
                 AllowedVarTypes,
                 _countof(AllowedVarTypes),
@@ -126,6 +127,19 @@ IShaderResourceVariable* ShaderResourceBindingD3D12Impl::GetVariableByName(SHADE
     return m_pShaderVarMgrs[ResLayoutInd].GetVariable(Name);
 }
 
+IShaderResourceVariable* ShaderResourceBindingD3D12Impl::GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash)
+{
+    auto ShaderInd    = GetShaderTypeIndex(ShaderType);
+    auto ResLayoutInd = m_ResourceLayoutIndex[ShaderInd];
+    if (ResLayoutInd < 0)
+    {
+        LOG_WARNING_MESSAGE("Unable to find mutable/dynamic variable by name hash: shader stage ", GetShaderTypeLiteralName(ShaderType),
+                            " is inactive in Pipeline State '", m_pPSO->GetDesc().Name, "'");
+        return nullptr;
+    }
+    return m_pShaderVarMgrs[ResLayoutInd].GetVariableByHash(NameHash);
+}
+
 Uint32 ShaderResourceBindingD3D12Impl::GetVariableCount(SHADER_TYPE ShaderType) const
 {
     auto ShaderInd    = GetShaderTypeIndex(ShaderType);
@@ -33,6 +33,27 @@
 namespace Diligent
 {
 
+template <typename THandler>
+void ShaderVariableManagerD3D12::ProcessVariableResources(const ShaderResourceLayoutD3D12& Layout, Uint32 AllowedTypeBits, THandler Handler)
+{
+    for (SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC; VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES; VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VarType + 1))
+    {
+        if (!IsAllowedType(VarType, AllowedTypeBits))
+            continue;
+
+        Uint32 NumResources = Layout.GetCbvSrvUavCount(VarType);
+        for (Uint32 r = 0; r < NumResources; ++r)
+            Handler(Layout.GetSrvCbvUav(VarType, r));
+
+        if (Layout.IsUsingSeparateSamplers())
+        {
+            Uint32 NumSamplers = Layout.GetSamplerCount(VarType);
+            for (Uint32 r = 0; r < NumSamplers; ++r)
+                Handler(Layout.GetSampler(VarType, r));
+        }
+    }
+}
+
 size_t ShaderVariableManagerD3D12::GetRequiredMemorySize(const ShaderResourceLayoutD3D12&     Layout,
                                                          const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
                                                          Uint32                               NumAllowedTypes,
@@ -53,22 +74,37 @@ size_t ShaderVariableManagerD3D12::GetRequiredMemorySize(const ShaderResourceLay
     return NumVariables * sizeof(ShaderVariableD3D12Impl);
 }
 
+ShaderVariableIndexMap ShaderVariableManagerD3D12::CreateVariableIndexMap(const ShaderResourceLayoutD3D12&     Layout,
+                                                                          const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                                                                          Uint32                               NumAllowedTypes)
+{
+    std::vector<const Char*> Names;
+    ProcessVariableResources(Layout, GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes),
+                             [&](const ShaderResourceLayoutD3D12::D3D12Resource& Res) //
+                             {
+                                 Names.push_back(Res.Attribs.Name);
+                             });
+
+    return ShaderVariableIndexMap{static_cast<Uint32>(Names.size()), [&](Uint32 v) { return Names[v]; }};
+}
+
 // Creates shader variable for every resource from SrcLayout whose type is one AllowedVarTypes
 ShaderVariableManagerD3D12::ShaderVariableManagerD3D12(IObject&                             Owner,
                                                        const ShaderResourceLayoutD3D12&     SrcLayout,
+                                                       const ShaderVariableIndexMap&        VarIndexMap,
                                                        IMemoryAllocator&                    Allocator,
                                                        const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
                                                        Uint32                               NumAllowedTypes,
                                                        ShaderResourceCacheD3D12&            ResourceCache) :
     // clang-format off
     m_Owner         {Owner},
-    m_ResourceCache {ResourceCache}
+    m_ResourceCache {ResourceCache},
+    m_VarIndexMap   {VarIndexMap}
 #ifdef _DEBUG
   , m_DbgAllocator  {Allocator}
 #endif
 // clang-format on
 {
-    const Uint32 AllowedTypeBits = GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes);
     VERIFY_EXPR(m_NumVariables == 0);
     auto MemSize = GetRequiredMemorySize(SrcLayout, AllowedVarTypes, NumAllowedTypes, m_NumVariables);
 
@@ -79,30 +115,12 @@ ShaderVariableManagerD3D12::ShaderVariableManagerD3D12(IObject&
     m_pVariables  = reinterpret_cast<ShaderVariableD3D12Impl*>(pRawMem);
 
     Uint32 VarInd = 0;
-    for (SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC; VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES; VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VarType + 1))
-    {
-        if (!IsAllowedType(VarType, AllowedTypeBits))
-            continue;
-
-        Uint32 NumResources = SrcLayout.GetCbvSrvUavCount(VarType);
-        for (Uint32 r = 0; r < NumResources; ++r)
-        {
-            const auto& SrcRes = SrcLayout.GetSrvCbvUav(VarType, r);
-            ::new (m_pVariables + VarInd) ShaderVariableD3D12Impl{*this, SrcRes};
-            ++VarInd;
-        }
-
-        if (SrcLayout.IsUsingSeparateSamplers())
-        {
-            Uint32 NumSamplers = SrcLayout.GetSamplerCount(VarType);
-            for (Uint32 r = 0; r < NumSamplers; ++r)
-            {
-                const auto& SrcSampler = SrcLayout.GetSampler(VarType, r);
-                ::new (m_pVariables + VarInd) ShaderVariableD3D12Impl{*this, SrcSampler};
-                ++VarInd;
-            }
-        }
-    }
+    ProcessVariableResources(SrcLayout, GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes),
+                             [&](const ShaderResourceLayoutD3D12::D3D12Resource& SrcRes) //
+                             {
+                                 ::new (m_pVariables + VarInd) ShaderVariableD3D12Impl{*this, SrcRes};
+                                 ++VarInd;
+                             });
     VERIFY_EXPR(VarInd == m_NumVariables);
 }
 
@@ -124,21 +142,26 @@ void ShaderVariableManagerD3D12::Destroy(IMemoryAllocator& Allocator)
     }
 }
 
+ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariableAtMapIndex(Uint32 Index, const Char* Name)
+{
+    if (Index == ShaderVariableIndexMap::InvalidIndex)
+        return nullptr;
+
+    VERIFY(Index < m_NumVariables, "Variable index map is not consistent with this manager");
+    auto& Var = m_pVariables[Index];
+    VERIFY(Name == nullptr || strcmp(Var.m_Resource.Attribs.Name, Name) == 0, "Variable index map is not consistent with this manager");
+    return &Var;
+}
+
 ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(const Char* Name)
 {
-    ShaderVariableD3D12Impl* pVar = nullptr;
-    for (Uint32 v = 0; v < m_NumVariables; ++v)
-    {
-        auto& Var = m_pVariables[v];
-        if (strcmp(Var.m_Resource.Attribs.Name, Name) == 0)
-        {
-            pVar = &Var;
-            break;
-        }
-    }
-    return pVar;
+    return GetVariableAtMapIndex(m_VarIndexMap.Find(Name), Name);
 }
 
+ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariableByHash(Uint64 NameHash)
+{
+    return GetVariableAtMapIndex(m_VarIndexMap.FindByHash(NameHash), nullptr);
+}
 
 ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(Uint32 Index)
 {
@@ -52,6 +52,8 @@ public:
 
     virtual IShaderResourceVariable* GetVariableByName(SHADER_TYPE ShaderType, const char* Name) override final;
 
+    virtual IShaderResourceVariable* GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash) override final;
+
     virtual Uint32 GetVariableCount(SHADER_TYPE ShaderType) const override final;
 
     virtual IShaderResourceVariable* GetVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index) override final;
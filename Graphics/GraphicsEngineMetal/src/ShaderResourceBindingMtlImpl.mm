@@ -61,6 +61,12 @@ IShaderResourceVariable* ShaderResourceBindingMtlImpl::GetVariableByName(SHADER_
     return nullptr;
 }
 
+IShaderResourceVariable* ShaderResourceBindingMtlImpl::GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash)
+{
+    LOG_ERROR_MESSAGE("ShaderResourceBindingMtlImpl::GetVariableByHash() is not implemented");
+    return nullptr;
+}
+
 Uint32 ShaderResourceBindingMtlImpl::GetVariableCount(SHADER_TYPE ShaderType) const
 {
     LOG_ERROR_MESSAGE("ShaderResourceBindingMtlImpl::GetVariableCount() is not implemented");
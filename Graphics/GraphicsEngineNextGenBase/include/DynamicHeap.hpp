@@ -35,7 +35,7 @@
 #include <vector>
 #include <atomic>
 #include "VariableSizeAllocationsManager.hpp"
-#include "RingBuffer.hpp"
+#include "ConcurrentRingBuffer.hpp"
 
 namespace Diligent
 {
@@ -46,19 +46,28 @@ namespace DynamicHeap
 
 // Having global ring buffer shared between all contexts is inconvinient because all contexts
 // must share the same frame. Having individual ring bufer per context may result in a lot of unused
-// memory. As a result, ring buffer is not currently used for dynamic memory management.
-// Instead, every dynamic heap allocates pages from the global dynamic memory manager.
+// memory. As a result, every dynamic heap allocates master blocks from the global dynamic memory manager.
+//
+// MasterBlockRingBufferBasedManager allocates master blocks from a lock-free concurrent ring buffer,
+// so that multiple contexts can allocate blocks without serializing on a mutex. Since contexts finish
+// their frames independently, stale blocks are not retired by frames, but are released individually
+// through the device release queues and may be returned in any order. Note that the ring tail only
+// moves past the oldest block, so a block that is held for a long time blocks all allocations behind it.
+// Managers whose blocks have very different lifetimes should use MasterBlockListBasedManager.
 class MasterBlockRingBufferBasedManager
 {
 public:
-    using OffsetType                                = RingBuffer::OffsetType;
-    using MasterBlock                               = RingBuffer::OffsetType;
-    static constexpr const OffsetType InvalidOffset = RingBuffer::InvalidOffset;
+    using OffsetType  = ConcurrentRingBuffer::OffsetType;
+    using MasterBlock = ConcurrentRingBuffer::Allocation;
 
     MasterBlockRingBufferBasedManager(IMemoryAllocator& Allocator,
                                       Uint32            Size) :
         m_RingBuffer{Size, Allocator}
-    {}
+    {
+#ifdef DEVELOPMENT
+        m_MasterBlockCounter = 0;
+#endif
+    }
 
     // clang-format off
     MasterBlockRingBufferBasedManager            (const MasterBlockRingBufferBasedManager&)  = delete;
@@ -67,31 +76,88 @@ public:
     MasterBlockRingBufferBasedManager& operator= (      MasterBlockRingBufferBasedManager&&) = delete;
     // clang-format on
 
-    void DiscardMasterBlocks(std::vector<MasterBlock>& /*Blocks*/, Uint64 FenceValue)
+    ~MasterBlockRingBufferBasedManager()
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
-        m_RingBuffer.FinishCurrentFrame(FenceValue);
+        DEV_CHECK_ERR(m_MasterBlockCounter == 0, m_MasterBlockCounter, " master block(s) have not been returned to the manager");
     }
 
-    void ReleaseStaleBlocks(Uint64 LastCompletedFenceValue)
+    template <typename RenderDeviceImplType>
+    void ReleaseMasterBlocks(std::vector<MasterBlock>& Blocks, RenderDeviceImplType& Device, Uint64 CmdQueueMask)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
-        m_RingBuffer.ReleaseCompletedFrames(LastCompletedFenceValue);
+        struct StaleMasterBlock
+        {
+            MasterBlock                        Block;
+            MasterBlockRingBufferBasedManager* Mgr;
+
+            // clang-format off
+            StaleMasterBlock(const MasterBlock& _Block, MasterBlockRingBufferBasedManager* _Mgr)noexcept :
+                Block {_Block},
+                Mgr   {_Mgr  }
+            {
+            }
+
+            StaleMasterBlock            (const StaleMasterBlock&)  = delete;
+            StaleMasterBlock& operator= (const StaleMasterBlock&)  = delete;
+            StaleMasterBlock& operator= (      StaleMasterBlock&&) = delete;
+
+            StaleMasterBlock(StaleMasterBlock&& rhs)noexcept :
+                Block {rhs.Block},
+                Mgr   {rhs.Mgr  }
+            {
+                rhs.Block = MasterBlock{};
+                rhs.Mgr   = nullptr;
+            }
+            // clang-format on
+
+            ~StaleMasterBlock()
+            {
+                if (Mgr != nullptr)
+                {
+#ifdef DEVELOPMENT
+                    --Mgr->m_MasterBlockCounter;
+#endif
+                    Mgr->m_RingBuffer.Free(Block);
+                }
+            }
+        };
+        for (const auto& Block : Blocks)
+        {
+            DEV_CHECK_ERR(Block.IsValid(), "Attempting to release invalid master block");
+            Device.SafeReleaseDeviceObject(StaleMasterBlock{Block, this}, CmdQueueMask);
+        }
     }
 
-    OffsetType GetSize() const { return m_RingBuffer.GetMaxSize(); }
-    OffsetType GetUsedSize() const { return m_RingBuffer.GetUsedSize(); }
+    // clang-format off
+    OffsetType GetSize()     const { return m_RingBuffer.GetMaxSize(); }
+    OffsetType GetUsedSize() const { return m_RingBuffer.GetUsedSize();}
+    // clang-format on
+
+#ifdef DEVELOPMENT
+    int32_t GetMasterBlockCounter() const
+    {
+        return m_MasterBlockCounter;
+    }
+#endif
 
 protected:
     MasterBlock AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
-        return m_RingBuffer.Allocate(SizeInBytes, Alignment);
+        auto NewBlock = m_RingBuffer.Allocate(SizeInBytes, Alignment);
+#ifdef DEVELOPMENT
+        if (NewBlock.IsValid())
+        {
+            ++m_MasterBlockCounter;
+        }
+#endif
+        return NewBlock;
     }
 
 private:
-    std::mutex m_RingBufferMtx;
-    RingBuffer m_RingBuffer;
+    ConcurrentRingBuffer m_RingBuffer;
+
+#ifdef DEVELOPMENT
+    std::atomic_int32_t m_MasterBlockCounter;
+#endif
 };
 
 
@@ -171,9 +237,14 @@ public:
 
     // clang-format off
     OffsetType GetSize()     const { return m_AllocationsMgr.GetMaxSize(); }
-    OffsetType GetUsedSize() const { return m_AllocationsMgr.GetUsedSize();}
     // clang-format on
 
+    OffsetType GetUsedSize() const
+    {
+        std::lock_guard<std::mutex> Lock{m_AllocationsMgrMtx};
+        return m_AllocationsMgr.GetUsedSize();
+    }
+
 #ifdef DEVELOPMENT
     int32_t GetMasterBlockCounter() const
     {
@@ -196,7 +267,7 @@ protected:
     }
 
 private:
-    std::mutex                     m_AllocationsMgrMtx;
+    mutable std::mutex             m_AllocationsMgrMtx;
     VariableSizeAllocationsManager m_AllocationsMgr;
 
 #ifdef DEVELOPMENT
@@ -29,6 +29,7 @@
 
 #include <vector>
 #include <mutex>
+#include <memory>
 
 #include "EngineFactory.h"
 #include "Atomics.hpp"
@@ -137,6 +138,13 @@ public:
 
     void PurgeReleaseQueues(bool ForceRelease = false)
     {
+        if (m_DestructionWorker)
+        {
+            // Release queues are purged once per frame, so this is where the
+            // destruction worker starts a new time budget.
+            m_DestructionWorker->BeginFrame();
+        }
+
         for (Uint32 q = 0; q < m_CmdQueueCount; ++q)
             PurgeReleaseQueue(q, ForceRelease);
     }
@@ -147,6 +155,25 @@ public:
         auto& Queue               = m_CommandQueues[QueueIndex];
         auto  CompletedFenceValue = ForceRelease ? std::numeric_limits<Uint64>::max() : Queue.CmdQueue->GetCompletedFenceValue();
         Queue.ReleaseQueue.Purge(CompletedFenceValue);
+
+        if (ForceRelease && m_DestructionWorker)
+        {
+            // When release is forced, all resources must be destroyed by the time the function returns
+            m_DestructionWorker->Flush();
+        }
+    }
+
+    /// Starts the background thread that destroys stale resources released by the command queues.
+
+    /// \param [in] FrameTimeBudget - Maximum time, in seconds, the thread may spend destroying
+    ///                               resources between two consecutive calls to PurgeReleaseQueues().
+    ///                               Zero means no limit.
+    void EnableAsyncResourceDestruction(double FrameTimeBudget)
+    {
+        VERIFY(!m_DestructionWorker, "Asynchronous resource destruction has already been enabled");
+        m_DestructionWorker.reset(new ResourceDestructionWorker<DynamicStaleResourceWrapper>{this->m_RawMemAllocator, FrameTimeBudget});
+        for (size_t q = 0; q < m_CmdQueueCount; ++q)
+            m_CommandQueues[q].ReleaseQueue.SetDestructionWorker(m_DestructionWorker.get());
     }
 
     void IdleCommandQueue(size_t QueueIdx, bool ReleaseResources)
@@ -175,6 +202,8 @@ public:
         {
             Queue.ReleaseQueue.DiscardStaleResources(CmdBufferNumber, FenceValue);
             Queue.ReleaseQueue.Purge(Queue.CmdQueue->GetCompletedFenceValue());
+            if (m_DestructionWorker)
+                m_DestructionWorker->Flush();
         }
     }
 
@@ -284,9 +313,13 @@ protected:
     {
         if (m_CommandQueues != nullptr)
         {
+            // Destroy the remaining resources and stop the worker thread
+            m_DestructionWorker.reset();
+
             for (size_t q = 0; q < m_CmdQueueCount; ++q)
             {
                 auto& Queue = m_CommandQueues[q];
+                Queue.ReleaseQueue.SetDestructionWorker(nullptr);
                 DEV_CHECK_ERR(Queue.ReleaseQueue.GetStaleResourceCount() == 0, "All stale resources must be released before destroying a command queue");
                 DEV_CHECK_ERR(Queue.ReleaseQueue.GetPendingReleaseResourceCount() == 0, "All resources must be released before destroying a command queue");
                 Queue.~CommandQueue();
@@ -319,6 +352,8 @@ protected:
     };
     const size_t  m_CmdQueueCount = 0;
     CommandQueue* m_CommandQueues = nullptr;
+
+    std::unique_ptr<ResourceDestructionWorker<DynamicStaleResourceWrapper>> m_DestructionWorker;
 };
 
 } // namespace Diligent
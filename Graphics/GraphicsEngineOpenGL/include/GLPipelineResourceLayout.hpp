@@ -287,7 +287,13 @@ public:
     bool dvpVerifyBindings(const GLProgramResourceCache& ResourceCache) const;
 #endif
 
-    IShaderResourceVariable* GetShaderVariable(SHADER_TYPE ShaderStage, const Char* Name);
+    // Creates the map of the names of the variables of the given shader stage. The pipeline state
+    // creates the maps once for the layouts of every variable set, and all SRBs share them.
+    ShaderVariableIndexMap CreateVariableIndexMap(SHADER_TYPE ShaderStage) const;
+
+    // The map must be created by CreateVariableIndexMap() for the same stage by a layout initialized with the same arguments
+    IShaderResourceVariable* GetShaderVariable(SHADER_TYPE ShaderStage, const ShaderVariableIndexMap& VarIndexMap, const Char* Name);
+    IShaderResourceVariable* GetShaderVariableByHash(SHADER_TYPE ShaderStage, const ShaderVariableIndexMap& VarIndexMap, Uint64 NameHash);
     IShaderResourceVariable* GetShaderVariable(SHADER_TYPE ShaderStage, Uint32 Index);
 
     IObject& GetOwner() { return m_Owner; }
@@ -356,7 +362,7 @@ private:
     }
 
     template <typename ResourceType>
-    IShaderResourceVariable* GetResourceByName(SHADER_TYPE ShaderStage, const Char* Name);
+    void GetVariableNames(SHADER_TYPE ShaderStage, Uint32 StartOffset, Uint32 EndOffset, std::vector<const Char*>& Names) const;
 
     template <typename THandleUB,
               typename THandleSampler,
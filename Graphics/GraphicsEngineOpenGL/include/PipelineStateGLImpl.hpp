@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <array>
 #include "PipelineStateGL.h"
 #include "PipelineStateBase.hpp"
 #include "RenderDevice.h"
@@ -37,6 +38,7 @@
 #include "GLProgramResources.hpp"
 #include "GLPipelineResourceLayout.hpp"
 #include "GLProgramResourceCache.hpp"
+#include "ShaderBase.hpp"
 
 namespace Diligent
 {
@@ -87,6 +89,14 @@ public:
     const GLPipelineResourceLayout& GetStaticResourceLayout() const { return m_StaticResourceLayout; }
     const GLProgramResourceCache&   GetStaticResourceCache() const { return m_StaticResourceCache; }
 
+    // Returns the map of the names of mutable and dynamic variables of the shader stage
+    const ShaderVariableIndexMap& GetSRBVarIndexMap(SHADER_TYPE ShaderType) const
+    {
+        auto ShaderInd = GetShaderTypeIndex(ShaderType);
+        VERIFY_EXPR(ShaderInd >= 0 && ShaderInd < static_cast<Int32>(m_SRBVarIndexMaps.size()));
+        return m_SRBVarIndexMaps[ShaderInd];
+    }
+
 private:
     GLObjectWrappers::GLPipelineObj& GetGLProgramPipeline(GLContext::NativeGLContextType Context);
 
@@ -112,6 +122,11 @@ private:
     // Resource cache for static resource variables only
     GLProgramResourceCache m_StaticResourceCache;
 
+    // Variable name maps for every shader stage shared by all SRBs of this pipeline
+    std::array<ShaderVariableIndexMap, 6> m_SRBVarIndexMaps;
+    // Variable name maps of static variables for every shader stage
+    std::array<ShaderVariableIndexMap, 6> m_StaticVarIndexMaps;
+
     // Program resources for all shader stages in the pipeline
     std::vector<GLProgramResources> m_ProgramResources;
 
@@ -66,6 +66,9 @@ public:
     /// Implementation of IShaderResourceBinding::GetVariableByName() in OpenGL backend.
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByName(SHADER_TYPE ShaderType, const char* Name) override final;
 
+    /// Implementation of IShaderResourceBinding::GetVariableByHash() in OpenGL backend.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash) override final;
+
     /// Implementation of IShaderResourceBinding::GetVariableCount() in OpenGL backend.
     virtual Uint32 DILIGENT_CALL_TYPE GetVariableCount(SHADER_TYPE ShaderType) const override final;
 
@@ -471,35 +471,58 @@ void GLPipelineResourceLayout::BindResources(SHADER_TYPE ShaderStage, IResourceM
 
 
 template <typename ResourceType>
-IShaderResourceVariable* GLPipelineResourceLayout::GetResourceByName(SHADER_TYPE ShaderStage, const Char* Name)
+void GLPipelineResourceLayout::GetVariableNames(SHADER_TYPE ShaderStage, Uint32 StartOffset, Uint32 EndOffset, std::vector<const Char*>& Names) const
 {
-    auto NumResources = GetNumResources<ResourceType>();
-    for (Uint32 res = 0; res < NumResources; ++res)
+    for (Uint32 res = StartOffset; res < EndOffset; ++res)
     {
-        auto& Resource = GetResource<ResourceType>(res);
-        if ((Resource.m_Attribs.ShaderStages & ShaderStage) != 0 && strcmp(Resource.m_Attribs.Name, Name) == 0)
-            return &Resource;
+        const auto& Resource = GetConstResource<ResourceType>(res);
+        // When all stages are linked into one program, variables of other stages can only be accessed by index
+        Names.push_back((Resource.m_Attribs.ShaderStages & ShaderStage) != 0 ? Resource.m_Attribs.Name : nullptr);
     }
-
-    return nullptr;
 }
 
-
-IShaderResourceVariable* GLPipelineResourceLayout::GetShaderVariable(SHADER_TYPE ShaderStage, const Char* Name)
+ShaderVariableIndexMap GLPipelineResourceLayout::CreateVariableIndexMap(SHADER_TYPE ShaderStage) const
 {
-    if (auto* pUB = GetResourceByName<UniformBuffBindInfo>(ShaderStage, Name))
-        return pUB;
+    VERIFY(IsPowerOfTwo(Uint32{ShaderStage}), "Only one shader stage must be specified");
+    auto ShaderInd = GetShaderTypeIndex(ShaderStage);
+    auto ProgIdx   = m_ProgramIndex[ShaderInd];
 
-    if (auto* pSampler = GetResourceByName<SamplerBindInfo>(ShaderStage, Name))
-        return pSampler;
+    if (ProgIdx < 0)
+        return ShaderVariableIndexMap{};
 
-    if (auto* pImage = GetResourceByName<ImageBindInfo>(ShaderStage, Name))
-        return pImage;
+    const auto& VariableEndOffset   = GetProgramVarEndOffsets(ProgIdx);
+    const auto& VariableStartOffset = ProgIdx > 0 ? GetProgramVarEndOffsets(ProgIdx - 1) : GLProgramResources::ResourceCounters{};
 
-    if (auto* pSSBO = GetResourceByName<StorageBufferBindInfo>(ShaderStage, Name))
-        return pSSBO;
+    // Variables are enumerated in the same order as in GetShaderVariable(SHADER_TYPE, Uint32)
+    std::vector<const Char*> Names;
+    GetVariableNames<UniformBuffBindInfo>(ShaderStage, VariableStartOffset.NumUBs, VariableEndOffset.NumUBs, Names);
+    GetVariableNames<SamplerBindInfo>(ShaderStage, VariableStartOffset.NumSamplers, VariableEndOffset.NumSamplers, Names);
+    GetVariableNames<ImageBindInfo>(ShaderStage, VariableStartOffset.NumImages, VariableEndOffset.NumImages, Names);
+    GetVariableNames<StorageBufferBindInfo>(ShaderStage, VariableStartOffset.NumStorageBlocks, VariableEndOffset.NumStorageBlocks, Names);
+    VERIFY_EXPR(Names.size() == GetNumVariables(ShaderStage));
 
-    return nullptr;
+    return ShaderVariableIndexMap{static_cast<Uint32>(Names.size()), [&](Uint32 v) { return Names[v]; }};
+}
+
+IShaderResourceVariable* GLPipelineResourceLayout::GetShaderVariable(SHADER_TYPE ShaderStage, const ShaderVariableIndexMap& VarIndexMap, const Char* Name)
+{
+    auto Index = VarIndexMap.Find(Name);
+    if (Index == ShaderVariableIndexMap::InvalidIndex)
+        return nullptr;
+
+    auto* pVar = GetShaderVariable(ShaderStage, Index);
+#ifdef _DEBUG
+    ShaderResourceDesc ResDesc;
+    pVar->GetResourceDesc(ResDesc);
+    VERIFY(strcmp(ResDesc.Name, Name) == 0, "Variable index map is not consistent with this layout");
+#endif
+    return pVar;
+}
+
+IShaderResourceVariable* GLPipelineResourceLayout::GetShaderVariableByHash(SHADER_TYPE ShaderStage, const ShaderVariableIndexMap& VarIndexMap, Uint64 NameHash)
+{
+    auto Index = VarIndexMap.FindByHash(NameHash);
+    return Index != ShaderVariableIndexMap::InvalidIndex ? GetShaderVariable(ShaderStage, Index) : nullptr;
 }
 
 Uint32 GLPipelineResourceLayout::GetNumVariables(SHADER_TYPE ShaderStage) const
@@ -123,6 +123,19 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*      pRefCounters,
         m_ResourceLayout.Initialize(m_ProgramResources.data(), static_cast<Uint32>(m_GLPrograms.size()), m_Desc.ResourceLayout, nullptr, 0, nullptr);
     }
 
+    {
+        // Variable names are hashed once here rather than every time a variable is looked up in an SRB.
+        // The temporary layout contains the same variables as the layouts of SRBs.
+        const SHADER_RESOURCE_VARIABLE_TYPE SRBVarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
+        GLPipelineResourceLayout            SRBResourceLayout{*this};
+        SRBResourceLayout.Initialize(m_ProgramResources.data(), static_cast<Uint32>(m_GLPrograms.size()), m_Desc.ResourceLayout, SRBVarTypes, _countof(SRBVarTypes), nullptr);
+        for (Uint32 s = 0; s < m_NumShaders; ++s)
+        {
+            const auto ShaderType                            = m_ppShaders[s]->GetDesc().ShaderType;
+            m_SRBVarIndexMaps[GetShaderTypeIndex(ShaderType)] = SRBResourceLayout.CreateVariableIndexMap(ShaderType);
+        }
+    }
+
     m_StaticSamplers.resize(m_Desc.ResourceLayout.NumStaticSamplers);
     for (Uint32 s = 0; s < m_Desc.ResourceLayout.NumStaticSamplers; ++s)
     {
@@ -134,6 +147,12 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*      pRefCounters,
         const SHADER_RESOURCE_VARIABLE_TYPE StaticVars[] = {SHADER_RESOURCE_VARIABLE_TYPE_STATIC};
         m_StaticResourceLayout.Initialize(m_ProgramResources.data(), static_cast<Uint32>(m_GLPrograms.size()), m_Desc.ResourceLayout, StaticVars, _countof(StaticVars), &m_StaticResourceCache);
         InitStaticSamplersInResourceCache(m_StaticResourceLayout, m_StaticResourceCache);
+
+        for (Uint32 s = 0; s < m_NumShaders; ++s)
+        {
+            const auto ShaderType                               = m_ppShaders[s]->GetDesc().ShaderType;
+            m_StaticVarIndexMaps[GetShaderTypeIndex(ShaderType)] = m_StaticResourceLayout.CreateVariableIndexMap(ShaderType);
+        }
     }
 }
 
@@ -259,7 +278,9 @@ Uint32 PipelineStateGLImpl::GetStaticVariableCount(SHADER_TYPE ShaderType) const
 
 IShaderResourceVariable* PipelineStateGLImpl::GetStaticVariableByName(SHADER_TYPE ShaderType, const Char* Name)
 {
-    return m_StaticResourceLayout.GetShaderVariable(ShaderType, Name);
+    auto ShaderInd = GetShaderTypeIndex(ShaderType);
+    VERIFY_EXPR(ShaderInd >= 0 && ShaderInd < static_cast<Int32>(m_StaticVarIndexMaps.size()));
+    return m_StaticResourceLayout.GetShaderVariable(ShaderType, m_StaticVarIndexMaps[ShaderInd], Name);
 }
 
 IShaderResourceVariable* PipelineStateGLImpl::GetStaticVariableByIndex(SHADER_TYPE ShaderType, Uint32 Index)
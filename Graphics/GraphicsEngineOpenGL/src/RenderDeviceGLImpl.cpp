@@ -48,6 +48,7 @@
 #include "QueryGLImpl.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
+#include "HLSL2GLSLConverterImpl.hpp"
 
 namespace Diligent
 {
@@ -82,6 +83,9 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
     m_GLContext{InitAttribs, m_DeviceCaps, pSCDesc}
 // clang-format on
 {
+    if (InitAttribs.HLSL2GLSLCacheDirectory != nullptr && *InitAttribs.HLSL2GLSLCacheDirectory != '\0')
+        HLSL2GLSLConverterImpl::GetInstance().GetConversionCache().SetDirectory(InitAttribs.HLSL2GLSLCacheDirectory);
+
     GLint NumExtensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &NumExtensions);
     CHECK_GL_ERROR("Failed to get the number of extensions");
@@ -70,7 +70,14 @@ void ShaderResourceBindingGLImpl::BindResources(Uint32 ShaderFlags, IResourceMap
 
 IShaderResourceVariable* ShaderResourceBindingGLImpl::GetVariableByName(SHADER_TYPE ShaderType, const char* Name)
 {
-    return m_ResourceLayout.GetShaderVariable(ShaderType, Name);
+    const auto* pPSOGL = ValidatedCast<const PipelineStateGLImpl>(m_pPSO);
+    return m_ResourceLayout.GetShaderVariable(ShaderType, pPSOGL->GetSRBVarIndexMap(ShaderType), Name);
+}
+
+IShaderResourceVariable* ShaderResourceBindingGLImpl::GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash)
+{
+    const auto* pPSOGL = ValidatedCast<const PipelineStateGLImpl>(m_pPSO);
+    return m_ResourceLayout.GetShaderVariableByHash(ShaderType, pPSOGL->GetSRBVarIndexMap(ShaderType), NameHash);
 }
 
 Uint32 ShaderResourceBindingGLImpl::GetVariableCount(SHADER_TYPE ShaderType) const
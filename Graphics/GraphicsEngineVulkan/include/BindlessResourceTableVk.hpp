@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BindlessResourceTableVk class
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include "SPIRVShaderResources.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "VulkanUtilities/VulkanPhysicalDevice.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+// Device-wide table that makes resources accessible to shaders by integer index.
+// The table is a single update-after-bind descriptor set (VK_EXT_descriptor_indexing)
+// with one partially bound array per descriptor type:
+//
+//      binding 0 - sampled images  (texture SRVs)                       texture2D g_Textures[];
+//      binding 1 - storage buffers (structured and raw buffer views)    buffer Buff{...} g_Buffers[];
+//      binding 2 - samplers                                             sampler g_Samplers[];
+//
+// Texture views, buffer views and samplers allocate a slot when they are created and keep it
+// for their lifetime, so the index never changes. When an object is destroyed, its slot is moved
+// into the release queue and is only returned to the free list once all command buffers that may
+// reference the slot have completed.
+// Only objects visible to the application take a slot: internal texture views created by the engine
+// (e.g. mip level views for mipmap generation) are not placed into the table. Allocating a slot costs
+// one single-descriptor vkUpdateDescriptorSets() call under the table mutex, which is paid once per
+// object at creation time, next to the creation of the Vulkan view or sampler itself.
+//
+// Runtime-sized arrays in shaders are mapped to the table by PipelineLayout, which appends the table
+// set after the engine-managed descriptor sets.
+class BindlessResourceTableVk
+{
+public:
+    enum TABLE_BINDING : Uint32
+    {
+        BINDING_SAMPLED_IMAGE = 0,
+        BINDING_STORAGE_BUFFER,
+        BINDING_SAMPLER,
+        BINDING_COUNT
+    };
+
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    // Sizes are clamped to the device update-after-bind limits, less the descriptors reserved for the engine-managed sets
+    BindlessResourceTableVk(RenderDeviceVkImpl&                       DeviceVkImpl,
+                            const std::array<Uint32, BINDING_COUNT>& Sizes);
+    ~BindlessResourceTableVk();
+
+    // clang-format off
+    BindlessResourceTableVk             (const BindlessResourceTableVk&) = delete;
+    BindlessResourceTableVk             (BindlessResourceTableVk&&)      = delete;
+    BindlessResourceTableVk& operator = (const BindlessResourceTableVk&) = delete;
+    BindlessResourceTableVk& operator = (BindlessResourceTableVk&&)      = delete;
+    // clang-format on
+
+    // Returns true if the physical device supports all descriptor indexing features required by the table
+    static bool IsSupported(const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice);
+
+    // Returns the table binding that holds resources of the given type,
+    // or BINDING_COUNT if resources of this type cannot be placed in the table
+    static TABLE_BINDING GetBinding(SPIRVShaderResourceAttribs::ResourceType ResType);
+
+    // Allocate a slot and write the descriptor to it. Return InvalidIndex if the table is full.
+    Uint32 AllocateSampledImage(const VkDescriptorImageInfo& ImageInfo, const char* DbgName);
+    Uint32 AllocateStorageBuffer(const VkDescriptorBufferInfo& BufferInfo, const char* DbgName);
+    Uint32 AllocateSampler(VkSampler vkSampler, const char* DbgName);
+
+    // Moves the slot into the release queues of the command queues specified by the mask
+    void FreeSlot(TABLE_BINDING Binding, Uint32 Index, Uint64 CmdQueueMask);
+
+    VkDescriptorSetLayout GetVkDescriptorSetLayout() const { return m_SetLayout; }
+    VkDescriptorSet       GetVkDescriptorSet() const { return m_vkDescriptorSet; }
+
+    Uint32 GetSize(TABLE_BINDING Binding) const { return m_Slots[Binding].Size; }
+
+    // Returns the number of slots that are currently allocated or waiting in the release queues
+    Uint32 GetAllocatedSlotCount() const;
+
+private:
+    Uint32 AllocateSlot(TABLE_BINDING                 Binding,
+                        const VkDescriptorImageInfo*  pImageInfo,
+                        const VkDescriptorBufferInfo* pBufferInfo,
+                        const char*                   DbgName);
+
+    void ReturnSlot(TABLE_BINDING Binding, Uint32 Index);
+
+    struct BindingSlots
+    {
+        Uint32 Size = 0;
+        // Slots [NextUnusedIndex, Size) have never been allocated
+        Uint32              NextUnusedIndex = 0;
+        std::vector<Uint32> FreeIndices;
+    };
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    VulkanUtilities::DescriptorSetLayoutWrapper m_SetLayout;
+    VulkanUtilities::DescriptorPoolWrapper      m_Pool;
+    VkDescriptorSet                             m_vkDescriptorSet = VK_NULL_HANDLE;
+
+    // Host access to the descriptor set must be externally synchronized, so
+    // descriptors are written while the mutex is locked
+    mutable std::mutex                      m_Mutex;
+    std::array<BindingSlots, BINDING_COUNT> m_Slots;
+};
+
+} // namespace Diligent
@@ -61,11 +61,17 @@ public:
     /// Implementation of IBufferViewVk::GetVkBufferView().
     virtual VkBufferView DILIGENT_CALL_TYPE GetVkBufferView() const override final { return m_BuffView; }
 
+    /// Implementation of IBufferViewVk::GetBindlessIndex().
+    virtual Uint32 DILIGENT_CALL_TYPE GetBindlessIndex() const override final { return m_BindlessIndex; }
+
     const BufferVkImpl* GetBufferVk() const;
     BufferVkImpl*       GetBufferVk();
 
 protected:
     VulkanUtilities::BufferViewWrapper m_BuffView;
+
+    /// Index of the view in the bindless resource table (structured and raw buffer views only)
+    Uint32 m_BindlessIndex = BindlessResourceTableVk::InvalidIndex;
 };
 
 } // namespace Diligent
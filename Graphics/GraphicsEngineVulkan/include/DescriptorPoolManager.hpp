@@ -34,6 +34,8 @@
 #include <deque>
 #include <mutex>
 #include <atomic>
+#include <unordered_map>
+#include "DeviceContextVk.h"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 
 namespace Diligent
@@ -222,6 +224,10 @@ public:
 
     DescriptorSetAllocation Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "");
 
+    // Allocates NumSets descriptor sets with the same layout. The sets are allocated in batches
+    // that take a single vkAllocateDescriptorSets() call each.
+    void Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, Uint32 NumSets, DescriptorSetAllocation* pAllocations, const char* DebugName = "");
+
 #ifdef DEVELOPMENT
     int32_t GetAllocatedDescriptorSetCounter() const
     {
@@ -230,6 +236,9 @@ public:
 #endif
 
 private:
+    // Allocates a single set. The mutex must be locked by the caller.
+    DescriptorSetAllocation AllocateSet(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName);
+
     void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask);
 
 #ifdef DEVELOPMENT
@@ -286,4 +295,45 @@ private:
     size_t                                              m_PeakPoolCount = 0;
 };
 
+// Dynamic descriptor set cache is used by device context to reuse descriptor sets allocated by
+// DynamicDescriptorSetAllocator. A set is identified by its layout and the raw descriptor data it was
+// written with, so the data must not contain uninitialized bytes.
+// Cached sets must be discarded when the allocator releases its pools. They must also be discarded
+// when the context's command buffer is submitted or closed: resources referenced by the sets may be
+// destroyed after that, and their handles may be reused by new objects.
+class DynamicDescriptorSetCache
+{
+public:
+    DynamicDescriptorSetCache() {}
+
+    // clang-format off
+    DynamicDescriptorSetCache             (const DynamicDescriptorSetCache&) = delete;
+    DynamicDescriptorSetCache             (DynamicDescriptorSetCache&&)      = delete;
+    DynamicDescriptorSetCache& operator = (const DynamicDescriptorSetCache&) = delete;
+    DynamicDescriptorSetCache& operator = (DynamicDescriptorSetCache&&)      = delete;
+    // clang-format on
+
+    // Returns the set that was written with the same layout and data, or VK_NULL_HANDLE.
+    // Hash is an output parameter that must be passed to Add() if the set is not found.
+    VkDescriptorSet Find(VkDescriptorSetLayout SetLayout, const void* pData, size_t DataSize, size_t& Hash);
+
+    void Add(VkDescriptorSetLayout SetLayout, const void* pData, size_t DataSize, size_t Hash, VkDescriptorSet Set);
+
+    void Clear();
+
+    const DynamicDescriptorSetCacheStatsVk& GetStats() const { return m_Stats; }
+
+private:
+    struct CachedSet
+    {
+        VkDescriptorSetLayout SetLayout;
+        size_t                DataOffset; // Offset of the descriptor data in m_Data
+        size_t                DataSize;
+        VkDescriptorSet       Set;
+    };
+    std::unordered_multimap<size_t, CachedSet> m_Sets;
+    std::vector<Uint8>                         m_Data;
+    DynamicDescriptorSetCacheStatsVk           m_Stats;
+};
+
 } // namespace Diligent
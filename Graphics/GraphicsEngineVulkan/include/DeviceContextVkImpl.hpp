@@ -327,8 +327,45 @@ public:
         return m_DynamicDescrSetAllocator.Allocate(SetLayout, DebugName);
     }
 
+    // Returns the dynamic descriptor set that has been written with the same descriptors in the current
+    // command buffer, or allocates a new set. In the latter case, IsNewSet is set to true, and the caller
+    // must write the descriptors to the set.
+    VkDescriptorSet AllocateDynamicDescriptorSet(VkDescriptorSetLayout               SetLayout,
+                                                 const DescriptorUpdateTemplateData* pDescriptors,
+                                                 Uint32                              NumDescriptors,
+                                                 bool&                               IsNewSet,
+                                                 const char*                         DebugName = "")
+    {
+        const auto DataSize = sizeof(DescriptorUpdateTemplateData) * NumDescriptors;
+
+        size_t Hash = 0;
+        auto   Set  = m_DynamicDescrSetCache.Find(SetLayout, pDescriptors, DataSize, Hash);
+        IsNewSet    = Set == VK_NULL_HANDLE;
+        if (IsNewSet)
+        {
+            Set = AllocateDynamicDescriptorSet(SetLayout, DebugName);
+            m_DynamicDescrSetCache.Add(SetLayout, pDescriptors, DataSize, Hash, Set);
+        }
+        return Set;
+    }
+
+    /// Implementation of IDeviceContextVk::GetDynamicDescriptorSetCacheStats().
+    virtual const DynamicDescriptorSetCacheStatsVk& DILIGENT_CALL_TYPE GetDynamicDescriptorSetCacheStats() const override final
+    {
+        return m_DynamicDescrSetCache.GetStats();
+    }
+
     VulkanDynamicAllocation AllocateDynamicSpace(Uint32 SizeInBytes, Uint32 Alignment);
 
+    // Returns scratch memory for descriptors written through descriptor update templates.
+    // The memory is only valid until the next call.
+    DescriptorUpdateTemplateData* GetDescriptorUpdateTemplateData(size_t NumDescriptors)
+    {
+        if (m_DescriptorUpdateTemplateData.size() < NumDescriptors)
+            m_DescriptorUpdateTemplateData.resize(NumDescriptors);
+        return m_DescriptorUpdateTemplateData.data();
+    }
+
     virtual void ResetRenderTargets() override final;
 
     Int64 GetContextFrameNumber() const { return m_ContextFrameNumber; }
@@ -408,6 +445,10 @@ private:
     __forceinline BufferVkImpl* PrepareIndirectDrawAttribsBuffer(IBuffer* pAttribsBuffer, RESOURCE_STATE_TRANSITION_MODE TransitonMode);
     __forceinline void          PrepareForDispatchCompute();
 
+    // Binds the Vulkan pipeline of the pending pipeline state or its fallback.
+    // Returns false if neither is ready, in which case the command must be skipped.
+    bool CommitPendingPipelineState();
+
     void DvpLogRenderPass_PSOMismatch();
 
     VulkanUtilities::VulkanCommandBuffer m_CommandBuffer;
@@ -421,6 +462,13 @@ private:
         /// Flag indicating if currently committed index buffer is up to date
         bool CommittedIBUpToDate = false;
 
+        /// Flag indicating if the bound pipeline state is being created asynchronously
+        /// and its Vulkan pipeline has not been bound to the command buffer yet
+        bool PendingPipelineState = false;
+
+        /// Flag indicating if the fallback of the pending pipeline state is bound
+        bool FallbackPipelineBound = false;
+
         Uint32 NumCommands = 0;
     } m_State;
 
@@ -479,6 +527,11 @@ private:
     VulkanUploadHeap                         m_UploadHeap;
     VulkanDynamicHeap                        m_DynamicHeap;
     DynamicDescriptorSetAllocator            m_DynamicDescrSetAllocator;
+    // Sets in the cache are allocated by m_DynamicDescrSetAllocator and are only valid until the
+    // current command buffer is submitted or closed
+    DynamicDescriptorSetCache m_DynamicDescrSetCache;
+
+    std::vector<DescriptorUpdateTemplateData> m_DescriptorUpdateTemplateData;
 
     PipelineLayout::DescriptorSetBindInfo m_DescrSetBindInfo;
     std::shared_ptr<GenerateMipsVkHelper> m_GenerateMipsHelper;
@@ -35,6 +35,7 @@
 #include "ShaderResourceLayoutVk.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
+#include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "VulkanUtilities/VulkanCommandBuffer.hpp"
 
 namespace Diligent
@@ -43,6 +44,8 @@ namespace Diligent
 class RenderDeviceVkImpl;
 class DeviceContextVkImpl;
 class ShaderResourceCacheVk;
+class DescriptorSetAllocation;
+class BindlessResourceTableVk;
 
 /// Implementation of the Diligent::PipelineLayout class
 class PipelineLayout
@@ -52,16 +55,19 @@ public:
 
     PipelineLayout();
     void Release(RenderDeviceVkImpl* pDeviceVkImpl, Uint64 CommandQueueMask);
-    void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+    void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice);
 
     VkPipelineLayout GetVkPipelineLayout() const { return m_LayoutMgr.GetVkPipelineLayout(); }
 
     std::array<Uint32, 2> GetDescriptorSetSizes(Uint32& NumSets) const;
 
-    void InitResourceCache(RenderDeviceVkImpl*    pDeviceVkImpl,
-                           ShaderResourceCacheVk& ResourceCache,
-                           IMemoryAllocator&      CacheMemAllocator,
-                           const char*            DbgPipelineName) const;
+    // Initializes descriptor sets in the resource cache. If pStaticAndMutSetAllocation is not null,
+    // the static/mutable descriptor set is taken from it instead of being allocated.
+    void InitResourceCache(RenderDeviceVkImpl*      pDeviceVkImpl,
+                           ShaderResourceCacheVk&   ResourceCache,
+                           IMemoryAllocator&        CacheMemAllocator,
+                           const char*              DbgPipelineName,
+                           DescriptorSetAllocation* pStaticAndMutSetAllocation = nullptr) const;
 
     void AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResAttribs,
                               SHADER_RESOURCE_VARIABLE_TYPE     VariableType,
@@ -72,6 +78,18 @@ public:
                               Uint32&                           OffsetInCache,
                               std::vector<uint32_t>&            SPIRV);
 
+    // Maps a runtime-sized array to the bindless resource table. Must be called after
+    // all other resources have been allocated, as the table set follows the engine-managed sets.
+    void AllocateBindlessResourceSlot(const BindlessResourceTableVk*    pBindlessTable,
+                                      const SPIRVShaderResourceAttribs& ResAttribs,
+                                      std::vector<uint32_t>&            SPIRV);
+
+    bool UsesBindlessResourceTable() const { return m_LayoutMgr.GetBindlessSetIndex() >= 0; }
+
+    // If the bindless resource table is the only descriptor set in the layout, no resources are ever
+    // committed through the resource cache, so the table is bound by this method when the pipeline is set.
+    void BindStandaloneBindlessResourceTable(VulkanUtilities::VulkanCommandBuffer& CmdBuffer, VkPipelineBindPoint BindPoint) const;
+
     Uint32 GetTotalDescriptors(SHADER_RESOURCE_VARIABLE_TYPE VarType) const
     {
         VERIFY_EXPR(VarType >= 0 && VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES);
@@ -92,16 +110,42 @@ public:
         return m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).VkLayout;
     }
 
+    // Returns true if dynamic resource descriptors are pushed directly into the command buffer
+    // (VK_KHR_push_descriptor) rather than written to a descriptor set allocated at every commit
+    bool IsDynamicDescriptorSetPushed() const
+    {
+        return m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).IsPushDescriptorSet;
+    }
+
+    Uint32 GetDynamicDescriptorSetIndex() const
+    {
+        const auto& DynamicSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+        VERIFY_EXPR(DynamicSet.SetIndex >= 0);
+        return static_cast<Uint32>(DynamicSet.SetIndex);
+    }
+
+    // Returns VK_NULL_HANDLE if the layout does not have static/mutable descriptor set
+    VkDescriptorSetLayout GetStaticAndMutableDescriptorSetVkLayout() const
+    {
+        const auto& StaticAndMutSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+        return StaticAndMutSet.SetIndex >= 0 ? static_cast<VkDescriptorSetLayout>(StaticAndMutSet.VkLayout) : VK_NULL_HANDLE;
+    }
+
     struct DescriptorSetBindInfo
     {
         std::vector<VkDescriptorSet> vkSets;
         std::vector<uint32_t>        DynamicOffsets;
         const ShaderResourceCacheVk* pResourceCache          = nullptr;
         VkPipelineBindPoint          BindPoint               = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        Uint32                       FirstSet                = 0;
         Uint32                       SetCout                 = 0;
         Uint32                       DynamicOffsetCount      = 0;
         bool                         DynamicBuffersPresent   = false;
         bool                         DynamicDescriptorsBound = false;
+
+        // Non-null if dynamic resource descriptors must be pushed after the sets are bound at draw time
+        VkDescriptorUpdateTemplate                PushDescriptorTemplate = VK_NULL_HANDLE;
+        std::vector<DescriptorUpdateTemplateData> PushDescriptorData;
 #ifdef _DEBUG
         const PipelineLayout* pDbgPipelineLayout = nullptr;
 #endif
@@ -117,10 +161,12 @@ public:
         {
             pResourceCache          = nullptr;
             BindPoint               = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+            FirstSet                = 0;
             SetCout                 = 0;
             DynamicOffsetCount      = 0;
             DynamicBuffersPresent   = false;
             DynamicDescriptorsBound = false;
+            PushDescriptorTemplate  = VK_NULL_HANDLE;
 
 #ifdef _DEBUG
             // In release mode, do not clear vectors as this causes unnecessary work
@@ -136,12 +182,24 @@ public:
     // may not be possible until draw command time because dynamic offsets are
     // set by the same Vulkan command. If there are no dynamic descriptors, this
     // function also binds descriptor sets rightaway.
+    // If the dynamic descriptor set is a push descriptor set, VkDynamicDescrSet must be null,
+    // and only the static/mutable set is bound.
     void PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkImpl,
                                bool                         IsCompute,
                                const ShaderResourceCacheVk& ResourceCache,
                                DescriptorSetBindInfo&       BindInfo,
                                VkDescriptorSet              VkDynamicDescrSet) const;
 
+    // Pushes dynamic resource descriptors into the command buffer. Binding a lower-numbered set with a layout
+    // that is not compatible with the one it was previously bound with disturbs all higher sets (13.2.9),
+    // so the descriptors must be pushed after the static/mutable set has been bound. If the set is only
+    // bound at draw time, the descriptors are copied into BindInfo and pushed by BindDescriptorSetsWithDynamicOffsets().
+    void PushDynamicDescriptors(DeviceContextVkImpl*                pCtxVkImpl,
+                                VkDescriptorUpdateTemplate          PushTemplate,
+                                const DescriptorUpdateTemplateData* pData,
+                                Uint32                              NumDescriptors,
+                                DescriptorSetBindInfo&              BindInfo) const;
+
     // Computes dynamic offsets and binds descriptor sets
     __forceinline void BindDescriptorSetsWithDynamicOffsets(VulkanUtilities::VulkanCommandBuffer& CmdBuffer,
                                                             Uint32                                CtxId,
@@ -166,6 +224,7 @@ private:
             int8_t                                      SetIndex              = -1;
             uint8_t                                     NumDynamicDescriptors = 0; // Total number of uniform and storage buffers, counting all array elements
             uint16_t                                    NumLayoutBindings     = 0;
+            bool                                        IsPushDescriptorSet   = false;
             VkDescriptorSetLayoutBinding*               pBindings             = nullptr;
             VulkanUtilities::DescriptorSetLayoutWrapper VkLayout;
 
@@ -193,7 +252,7 @@ private:
         DescriptorSetLayoutManager& operator= (DescriptorSetLayoutManager&&)      = delete;
         // clang-format on
 
-        void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+        void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice);
         void Release(RenderDeviceVkImpl* pRenderDeviceVk, Uint64 CommandQueueMask);
 
         DescriptorSetLayout&       GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE VarType) { return m_DescriptorSetLayouts[VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC ? 1 : 0]; }
@@ -212,12 +271,21 @@ private:
                                   Uint32&                           Binding,
                                   Uint32&                           OffsetInCache);
 
+        Uint32 AllocateBindlessResourceSlot(const BindlessResourceTableVk* pBindlessTable);
+
+        const BindlessResourceTableVk* GetBindlessTable() const { return m_pBindlessTable; }
+        int8_t                         GetBindlessSetIndex() const { return m_BindlessSetIndex; }
+
     private:
         IMemoryAllocator&                                                                           m_MemAllocator;
         VulkanUtilities::PipelineLayoutWrapper                                                      m_VkPipelineLayout;
         std::array<DescriptorSetLayout, 2>                                                          m_DescriptorSetLayouts;
         std::vector<VkDescriptorSetLayoutBinding, STDAllocatorRawMem<VkDescriptorSetLayoutBinding>> m_LayoutBindings;
         uint8_t                                                                                     m_ActiveSets = 0;
+
+        // Bindless resource table set always follows the engine-managed sets
+        const BindlessResourceTableVk* m_pBindlessTable   = nullptr;
+        int8_t                         m_BindlessSetIndex = -1;
     };
 
     IMemoryAllocator&          m_MemAllocator;
@@ -259,13 +327,21 @@ __forceinline void PipelineLayout::BindDescriptorSetsWithDynamicOffsets(VulkanUt
     // applied via these sets are no longer valid (13.2.5)
     CmdBuffer.BindDescriptorSets(BindInfo.BindPoint,
                                  m_LayoutMgr.GetVkPipelineLayout(),
-                                 0, // First set
+                                 BindInfo.FirstSet,
                                  BindInfo.SetCout,
                                  BindInfo.vkSets.data(), // BindInfo.vkSets is never empty
                                  // dynamicOffsetCount must equal the total number of dynamic descriptors in the sets being bound (13.2.5)
                                  BindInfo.DynamicOffsetCount,
                                  BindInfo.DynamicOffsets.data());
 
+    if (BindInfo.PushDescriptorTemplate != VK_NULL_HANDLE)
+    {
+        // Rebinding the static/mutable set with the same layout later does not disturb the pushed set,
+        // so the descriptors are only pushed once
+        PushDynamicDescriptors(pCtxVkImpl, BindInfo.PushDescriptorTemplate, BindInfo.PushDescriptorData.data(),
+                               static_cast<Uint32>(BindInfo.PushDescriptorData.size()), BindInfo);
+    }
+
     BindInfo.DynamicDescriptorsBound = true;
 }
 
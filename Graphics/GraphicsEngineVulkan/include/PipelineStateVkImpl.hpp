@@ -31,6 +31,7 @@
 /// Declaration of Diligent::PipelineStateVkImpl class
 
 #include <array>
+#include <atomic>
 
 #include "RenderDeviceVk.h"
 #include "PipelineStateVk.h"
@@ -57,7 +58,11 @@ class PipelineStateVkImpl final : public PipelineStateBase<IPipelineStateVk, Ren
 public:
     using TPipelineStateBase = PipelineStateBase<IPipelineStateVk, RenderDeviceVkImpl>;
 
-    PipelineStateVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pDeviceVk, const PipelineStateDesc& PipelineDesc);
+    PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
+                        RenderDeviceVkImpl*      pDeviceVk,
+                        const PipelineStateDesc& PipelineDesc,
+                        bool                     CreateAsync  = false,
+                        PipelineStateVkImpl*     pFallbackPSO = nullptr);
     ~PipelineStateVkImpl();
 
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
@@ -65,6 +70,9 @@ public:
     /// Implementation of IPipelineState::CreateShaderResourceBinding() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources) override final;
 
+    /// Implementation of IPipelineState::CreateShaderResourceBindings() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreateShaderResourceBindings(Uint32 NumSRBs, IShaderResourceBinding** ppShaderResourceBindings, bool InitStaticResources) override final;
+
     /// Implementation of IPipelineState::IsCompatibleWith() in Vulkan backend.
     virtual bool DILIGENT_CALL_TYPE IsCompatibleWith(const IPipelineState* pPSO) const override final;
 
@@ -72,7 +80,26 @@ public:
     virtual VkRenderPass DILIGENT_CALL_TYPE GetVkRenderPass() const override final { return m_RenderPass; }
 
     /// Implementation of IPipelineStateVk::GetVkPipeline().
-    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final { return m_Pipeline; }
+    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final
+    {
+        return m_Status == PIPELINE_STATE_STATUS_READY ? static_cast<VkPipeline>(m_Pipeline) : VK_NULL_HANDLE;
+    }
+
+    /// Implementation of IPipelineState::GetStatus() in Vulkan backend.
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus() const override final { return m_Status; }
+
+    /// Returns the pipeline state that is used by draw and dispatch commands while this
+    /// pipeline is being created asynchronously.
+    const PipelineStateVkImpl* GetFallbackPSO() const { return m_pFallbackPSO; }
+
+    /// Enqueues the creation of the Vulkan pipeline into the device's worker thread pool.
+    /// Must be called once after a pipeline state has been constructed with CreateAsync == true
+    /// and a reference to it has been obtained.
+    void StartAsyncCreation();
+
+    /// Makes the asynchronous creation task fail. Must be called before the task starts.
+    /// Used by tests to exercise the handling of pipelines that could not be created.
+    void SimulateAsyncCreationFailure() { m_SimulateAsyncCreationFailure = true; }
 
     /// Implementation of IPipelineState::BindStaticResources() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE BindStaticResources(Uint32 ShaderFlags, IResourceMapping* pResourceMapping, Uint32 Flags) override final;
@@ -108,6 +135,13 @@ public:
         return m_ShaderResourceLayouts[ShaderInd];
     }
 
+    // Returns the map of the names of mutable and dynamic variables of the shader
+    const ShaderVariableIndexMap& GetSRBVarIndexMap(Uint32 ShaderInd) const
+    {
+        VERIFY_EXPR(ShaderInd < m_NumShaders);
+        return m_VarIndexMaps[ShaderInd];
+    }
+
     SRBMemoryAllocator& GetSRBMemoryAllocator()
     {
         return m_SRBMemAllocator;
@@ -125,6 +159,14 @@ public:
     void InitializeStaticSRBResources(ShaderResourceCacheVk& ResourceCache) const;
 
 private:
+    void CreateVkPipeline(const std::array<std::vector<uint32_t>, MAX_SHADERS_IN_PIPELINE>& ShaderSPIRVs);
+    void ReleaseShaderModules();
+    void CreateDynamicDescrSetUpdateTemplate();
+    bool IsValidFallbackPSO(const PipelineStateVkImpl& FallbackPSO) const;
+
+    const DescriptorUpdateTemplateData* PackDynamicResourceDescriptors(const ShaderResourceCacheVk& ResourceCache,
+                                                                       DeviceContextVkImpl*         pCtxVkImpl) const;
+
     const ShaderResourceLayoutVk& GetStaticShaderResLayout(Uint32 ShaderInd) const
     {
         VERIFY_EXPR(ShaderInd < m_NumShaders);
@@ -147,18 +189,37 @@ private:
     ShaderResourceCacheVk*   m_StaticResCaches       = nullptr;
     ShaderVariableManagerVk* m_StaticVarsMgrs        = nullptr;
 
+    // Variable name maps shared by all variable managers. Like m_ShaderResourceLayouts, the first
+    // m_NumShaders maps are for SRB variables, and the remaining ones are for static variables.
+    std::vector<ShaderVariableIndexMap> m_VarIndexMaps;
+
     // SRB memory allocator must be declared before m_pDefaultShaderResBinding
     SRBMemoryAllocator m_SRBMemAllocator;
 
-    std::array<VulkanUtilities::ShaderModuleWrapper, MAX_SHADERS_IN_PIPELINE> m_ShaderModules;
+    // Shader modules are shared between pipeline states and are managed by the render device
+    std::array<VkShaderModule, MAX_SHADERS_IN_PIPELINE> m_ShaderModules = {};
 
     VkRenderPass                     m_RenderPass = VK_NULL_HANDLE; // Render passes are managed by the render device
     VulkanUtilities::PipelineWrapper m_Pipeline;
     PipelineLayout                   m_PipelineLayout;
 
+    // Writes all descriptors of the dynamic descriptor set from the packed array of
+    // m_NumDynamicDescriptors elements. Null if the device does not support update templates.
+    // If the dynamic set is a push descriptor set, this is a push descriptor template.
+    // The packed array is also the key of the context's dynamic descriptor set cache.
+    VulkanUtilities::DescriptorUpdateTemplateWrapper m_DynamicDescrSetUpdateTemplate;
+    Uint32                                           m_NumDynamicDescriptors = 0;
+
     Int8 m_ResourceLayoutIndex[6] = {-1, -1, -1, -1, -1, -1};
     bool m_HasStaticResources     = false;
     bool m_HasNonStaticResources  = false;
+
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_READY};
+
+    // Members used by asynchronous pipeline creation
+    RefCntAutoPtr<PipelineStateVkImpl>                         m_pFallbackPSO;
+    std::array<std::vector<uint32_t>, MAX_SHADERS_IN_PIPELINE> m_AsyncSPIRVs;
+    bool                                                       m_SimulateAsyncCreationFailure = false;
 };
 
 } // namespace Diligent
@@ -30,11 +30,13 @@
 /// \file
 /// Declaration of Diligent::RenderDeviceVkImpl class
 #include <memory>
+#include <mutex>
 
 #include "RenderDeviceVk.h"
 #include "RenderDeviceBase.hpp"
 #include "RenderDeviceNextGenBase.hpp"
 #include "DescriptorPoolManager.hpp"
+#include "BindlessResourceTableVk.hpp"
 #include "VulkanDynamicHeap.hpp"
 #include "Atomics.hpp"
 #include "CommandQueueVk.h"
@@ -48,6 +50,9 @@
 #include "FramebufferCache.hpp"
 #include "RenderPassCache.hpp"
 #include "CommandPoolManager.hpp"
+#include "SPIRVCache.hpp"
+#include "ShaderModuleCache.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -74,6 +79,11 @@ public:
     /// Implementation of IRenderDevice::CreatePipelineState() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreatePipelineState(const PipelineStateDesc& PipelineDesc, IPipelineState** ppPipelineState) override final;
 
+    /// Implementation of IRenderDevice::CreatePipelineStateAsync() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc,
+                                                             IPipelineState*          pFallbackPSO,
+                                                             IPipelineState**         ppPipelineState) override final;
+
     /// Implementation of IRenderDevice::CreateBuffer() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateBuffer(const BufferDesc& BuffDesc,
                                                  const BufferData* pBuffData,
@@ -82,6 +92,12 @@ public:
     /// Implementation of IRenderDevice::CreateShader() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateShader(const ShaderCreateInfo& ShaderCreateInfo, IShader** ppShader) override final;
 
+    /// Implementation of IRenderDevice::CreateShaders() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreateShaders(const ShaderCreateInfo* pShaderCIs, Uint32 NumShaders, IShader** ppShaders) override final;
+
+    /// Implementation of IRenderDevice::CreateShaderFromArchive() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreateShaderFromArchive(IDataBlob* pArchive, const Char* EntryName, IShader** ppShader) override final;
+
     /// Implementation of IRenderDevice::CreateTexture() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateTexture(const TextureDesc& TexDesc,
                                                   const TextureData* pData,
@@ -119,6 +135,9 @@ public:
                                                                    RESOURCE_STATE    InitialState,
                                                                    IBuffer**         ppBuffer) override final;
 
+    /// Implementation of IRenderDeviceVk::GetPipelineCacheData().
+    virtual void DILIGENT_CALL_TYPE GetPipelineCacheData(IDataBlob** ppData) override final;
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
@@ -136,15 +155,23 @@ public:
     {
         return m_DescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
     }
+    void AllocateDescriptorSets(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, Uint32 NumSets, DescriptorSetAllocation* pAllocations, const char* DebugName = "")
+    {
+        m_DescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, NumSets, pAllocations, DebugName);
+    }
     DescriptorPoolManager& GetDynamicDescriptorPool() { return m_DynamicDescriptorPool; }
 
+    // Returns null if the bindless resource table is not enabled
+    BindlessResourceTableVk* GetBindlessResourceTable() { return m_pBindlessResourceTable.get(); }
+
     std::shared_ptr<const VulkanUtilities::VulkanInstance> GetVulkanInstance() const { return m_VulkanInstance; }
 
     const VulkanUtilities::VulkanPhysicalDevice& GetPhysicalDevice() const { return *m_PhysicalDevice; }
     const VulkanUtilities::VulkanLogicalDevice&  GetLogicalDevice() { return *m_LogicalVkDevice; }
 
-    FramebufferCache& GetFramebufferCache() { return m_FramebufferCache; }
-    RenderPassCache&  GetRenderPassCache() { return m_RenderPassCache; }
+    FramebufferCache&  GetFramebufferCache() { return m_FramebufferCache; }
+    RenderPassCache&   GetRenderPassCache() { return m_RenderPassCache; }
+    ShaderModuleCache& GetShaderModuleCache() { return m_ShaderModuleCache; }
 
     VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties)
     {
@@ -154,6 +181,20 @@ public:
 
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
+    SPIRVCache& GetSPIRVCache() { return m_SPIRVCache; }
+
+    SPIRV_OPTIMIZATION_FLAGS GetSPIRVOptimizationFlags() const { return m_EngineAttribs.SPIRVOptimizationFlags; }
+
+    VkPipelineCache GetVkPipelineCache() const { return m_PipelineCache; }
+
+    // Checks that the pipeline cache data header was produced by the device with the given properties
+    static bool IsPipelineCacheDataCompatible(const void* pData, size_t DataSize, const VkPhysicalDeviceProperties& DeviceProps);
+
+    // Returns the pool of threads that perform asynchronous work such as pipeline creation
+    // and batched shader compilation.
+    // The pool is created on first use.
+    ThreadPool& GetWorkerThreadPool();
+
     void FlushStaleResources(Uint32 CmdQueueIndex);
 
 private:
@@ -166,6 +207,10 @@ private:
     //      * SubmittedFenceValue    - fence value associated with the submitted command buffer
     void SubmitCommandBuffer(Uint32 QueueIndex, const VkSubmitInfo& SubmitInfo, Uint64& SubmittedCmdBuffNumber, Uint64& SubmittedFenceValue, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pFences);
 
+    // Creates the device-wide pipeline cache, seeding it with the initial data if the data
+    // was produced by the same physical device.
+    void CreatePipelineCache(IDataBlob* pInitialData);
+
     std::shared_ptr<VulkanUtilities::VulkanInstance>       m_VulkanInstance;
     std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> m_PhysicalDevice;
     std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  m_LogicalVkDevice;
@@ -174,6 +219,7 @@ private:
 
     FramebufferCache       m_FramebufferCache;
     RenderPassCache        m_RenderPassCache;
+    ShaderModuleCache      m_ShaderModuleCache;
     DescriptorSetAllocator m_DescriptorSetAllocator;
     DescriptorPoolManager  m_DynamicDescriptorPool;
 
@@ -185,6 +231,15 @@ private:
     VulkanUtilities::VulkanMemoryManager m_MemoryMgr;
 
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
+
+    SPIRVCache m_SPIRVCache;
+
+    VulkanUtilities::PipelineCacheWrapper m_PipelineCache;
+
+    std::mutex                  m_WorkerThreadPoolMtx;
+    std::unique_ptr<ThreadPool> m_pWorkerThreadPool;
+
+    std::unique_ptr<BindlessResourceTableVk> m_pBindlessResourceTable;
 };
 
 } // namespace Diligent
@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::SPIRVCache class
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+#include "Shader.h"
+
+namespace Diligent
+{
+
+/// Persistent content-addressed cache of SPIR-V byte code produced from shader sources.
+
+/// Entries are kept in memory and in separate files in the cache directory. The name of the file is
+/// derived from the hash of everything that affects the compilation result: the source code
+/// (including all files it includes), macros, entry point, shader type, source language and
+/// compiler version. A second, independent hash of the same data is stored in the file header
+/// to detect name collisions, and the hash of the byte code is stored to detect corrupted entries.
+/// An entry may also contain serialized shader resources (see SPIRVShaderResources::Serialize()),
+/// which allows skipping reflection when the byte code is loaded from the cache.
+/// Entries are written to a temporary file first and then renamed, so other processes
+/// never observe a partially written entry. All methods are thread-safe.
+class SPIRVCache
+{
+public:
+    /// 128-bit key of the cache entry
+    struct Key
+    {
+        Uint64 Hash0 = 0;
+        Uint64 Hash1 = 0;
+
+        bool operator==(const Key& rhs) const { return Hash0 == rhs.Hash0 && Hash1 == rhs.Hash1; }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& K) const { return static_cast<size_t>(K.Hash0); }
+        };
+    };
+
+    struct Stats
+    {
+        Uint32 MemoryHits = 0;
+        Uint32 DiskHits   = 0;
+        Uint32 Misses     = 0;
+    };
+
+    /// \param [in] CacheDirectory - Path to the directory where cache entries are stored.
+    ///                              The directory must exist. If the path is null or empty,
+    ///                              the cache is disabled.
+    /// \param [in] MaxMemorySize  - Maximum total size, in bytes, of the entries kept in memory.
+    ///                              When the limit is exceeded, the oldest entries are evicted.
+    explicit SPIRVCache(const char* CacheDirectory, size_t MaxMemorySize = DefaultMaxMemorySize);
+
+    // clang-format off
+    SPIRVCache             (const SPIRVCache&)  = delete;
+    SPIRVCache             (      SPIRVCache&&) = delete;
+    SPIRVCache& operator = (const SPIRVCache&)  = delete;
+    SPIRVCache& operator = (      SPIRVCache&&) = delete;
+    // clang-format on
+
+    bool IsEnabled() const { return !m_Directory.empty(); }
+
+    /// Computes the key for the shader compiled from HLSL source. The source of every file
+    /// referenced by an #include directive is read through the shader source stream factory
+    /// and contributes to the key.
+    static Key ComputeHLSLKey(const ShaderCreateInfo& ShaderCI, const char* CompilerVersion);
+
+    /// Computes the key for the shader compiled from the fully expanded GLSL source.
+    static Key ComputeGLSLKey(SHADER_TYPE ShaderType, const std::string& GLSLSource, const char* CompilerVersion);
+
+    /// Loads the byte code and serialized shader resources from memory or from disk. Returns false if there is
+    /// no valid entry for the key. Resources is empty if the entry does not contain serialized resources.
+    bool Load(const Key& EntryKey, std::vector<uint32_t>& SPIRV, std::vector<Uint8>& Resources);
+
+    /// Stores the byte code and optional serialized shader resources in memory and on disk,
+    /// replacing the existing entry. Disk failures are not fatal and are only reported as warnings.
+    void Store(const Key& EntryKey, const std::vector<uint32_t>& SPIRV, const std::vector<Uint8>& Resources);
+
+    /// Removes all entries from memory. Entries on disk are not affected.
+    void Clear();
+
+    Stats GetStats() const;
+
+    std::string GetEntryPath(const Key& EntryKey) const;
+
+    static constexpr size_t DefaultMaxMemorySize = 32 << 20;
+
+private:
+    bool LoadFromDisk(const Key& EntryKey, std::vector<uint32_t>& SPIRV, std::vector<Uint8>& Resources) const;
+    void StoreOnDisk(const Key& EntryKey, const std::vector<uint32_t>& SPIRV, const std::vector<Uint8>& Resources) const;
+    void AddToMemory(const Key& EntryKey, const std::vector<uint32_t>& SPIRV, const std::vector<Uint8>& Resources);
+
+    struct MemoryEntry
+    {
+        std::vector<uint32_t> SPIRV;
+        std::vector<Uint8>    Resources;
+
+        size_t GetSize() const { return SPIRV.size() * sizeof(SPIRV[0]) + Resources.size(); }
+    };
+
+    const std::string m_Directory;
+
+    mutable std::mutex m_Mtx;
+
+    std::unordered_map<Key, MemoryEntry, Key::Hasher> m_Entries;
+    // Keys in the order the entries were added, used for eviction
+    std::deque<Key> m_EntryOrder;
+
+    const size_t m_MaxMemorySize;
+    size_t       m_MemorySize = 0;
+
+    std::atomic<Uint32> m_MemoryHits{0};
+    std::atomic<Uint32> m_DiskHits{0};
+    std::atomic<Uint32> m_Misses{0};
+};
+
+} // namespace Diligent
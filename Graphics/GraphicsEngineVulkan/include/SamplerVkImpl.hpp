@@ -55,11 +55,17 @@ public:
     /// Implementation of ISamplerVk::GetVkSampler().
     virtual VkSampler DILIGENT_CALL_TYPE GetVkSampler() const override final { return m_VkSampler; }
 
+    /// Implementation of ISamplerVk::GetBindlessIndex().
+    virtual Uint32 DILIGENT_CALL_TYPE GetBindlessIndex() const override final { return m_BindlessIndex; }
+
 private:
     friend class ShaderVkImpl;
     /// Vk sampler handle
     VulkanUtilities::SamplerWrapper m_VkSampler;
     static constexpr Uint64         m_CommandQueueMask = ~Uint64{0};
+
+    /// Index of the sampler in the bindless resource table
+    Uint32 m_BindlessIndex = BindlessResourceTableVk::InvalidIndex;
 };
 
 } // namespace Diligent
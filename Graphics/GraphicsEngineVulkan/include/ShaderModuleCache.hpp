@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderModuleCache class
+
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include "BasicTypes.h"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Device-wide cache of reference-counted Vulkan shader modules.
+
+/// Pipeline states that use the same shader with the same resource layout produce identical
+/// patched SPIR-V. The cache creates one module for such byte code and shares it between
+/// all pipelines. The module is released when the last pipeline that uses it is destroyed.
+/// The cache keeps a copy of the byte code of every module, so that different byte code
+/// with the same hash never resolves to the same module.
+class ShaderModuleCache
+{
+public:
+    ShaderModuleCache(RenderDeviceVkImpl& DeviceVk) noexcept :
+        m_DeviceVkImpl{DeviceVk}
+    {}
+
+    // clang-format off
+    ShaderModuleCache             (const ShaderModuleCache&) = delete;
+    ShaderModuleCache             (ShaderModuleCache&&)      = delete;
+    ShaderModuleCache& operator = (const ShaderModuleCache&) = delete;
+    ShaderModuleCache& operator = (ShaderModuleCache&&)      = delete;
+    // clang-format on
+
+    ~ShaderModuleCache();
+
+    /// Returns the shader module for the given SPIR-V byte code, creating the module if necessary,
+    /// and increments its reference counter. Every call must be matched by a call to Release().
+    VkShaderModule GetShaderModule(const std::vector<uint32_t>& SPIRV, const char* DebugName);
+
+    /// Decrements the reference counter of the module and releases the module when the counter reaches zero.
+    void Release(VkShaderModule ShaderModule, Uint64 CommandQueueMask);
+
+    /// Returns the number of unique modules in the cache.
+    size_t GetNumModules();
+
+private:
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    struct ModuleInfo
+    {
+        std::vector<uint32_t>                SPIRV;
+        VulkanUtilities::ShaderModuleWrapper Module;
+        Uint32                               RefCounter = 0;
+    };
+
+    // Finds the module with the given byte code and increments its reference counter.
+    // The mutex must be locked by the caller.
+    VkShaderModule FindModule(size_t Hash, const std::vector<uint32_t>& SPIRV);
+
+    std::mutex m_Mutex;
+    // Byte code hash -> modules. Different byte code with the same hash is kept in the same bucket.
+    std::unordered_multimap<size_t, ModuleInfo> m_Cache;
+    // Module handle -> byte code hash
+    std::unordered_map<VkShaderModule, size_t> m_ModuleToHash;
+};
+
+} // namespace Diligent
@@ -41,15 +41,19 @@ namespace Diligent
 {
 
 class FixedBlockMemoryAllocator;
+class DescriptorSetAllocation;
 
 /// Implementation of the Diligent::IShaderResourceBindingVk interface
-// sizeof(ShaderResourceBindingVkImpl) == 72 (x64, msvc, Release)
+// sizeof(ShaderResourceBindingVkImpl) == 216 (x64, msvc, Release)
 class ShaderResourceBindingVkImpl final : public ShaderResourceBindingBase<IShaderResourceBindingVk>
 {
 public:
     using TBase = ShaderResourceBindingBase<IShaderResourceBindingVk>;
 
-    ShaderResourceBindingVkImpl(IReferenceCounters* pRefCounters, class PipelineStateVkImpl* pPSO, bool IsPSOInternal);
+    ShaderResourceBindingVkImpl(IReferenceCounters*        pRefCounters,
+                                class PipelineStateVkImpl* pPSO,
+                                bool                       IsPSOInternal,
+                                DescriptorSetAllocation*   pStaticAndMutSetAllocation = nullptr);
     ~ShaderResourceBindingVkImpl();
 
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
@@ -60,6 +64,14 @@ public:
     /// Implementation of IShaderResourceBinding::GetVariableByName() in Vulkan backend.
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByName(SHADER_TYPE ShaderType, const char* Name) override final;
 
+    /// Implementation of IShaderResourceBinding::GetVariableByHash() in Vulkan backend.
+    virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash) override final;
+
+    /// Implementation of IShaderResourceBinding::SetVariables() in Vulkan backend.
+    /// The method reuses scratch storage of the SRB, so it must not be called
+    /// simultaneously from multiple threads for the same SRB.
+    virtual void DILIGENT_CALL_TYPE SetVariables(const ResourceBindDesc* pBindings, Uint32 Count) override final;
+
     /// Implementation of IShaderResourceBinding::GetVariableCount() in Vulkan backend.
     virtual Uint32 DILIGENT_CALL_TYPE GetVariableCount(SHADER_TYPE ShaderType) const override final;
 
@@ -77,6 +89,10 @@ private:
     ShaderResourceCacheVk    m_ShaderResourceCache;
     ShaderVariableManagerVk* m_pShaderVarMgrs = nullptr;
 
+    // Scratch storage of SetVariables() that is reused between calls to avoid allocations
+    std::vector<ShaderVariableVkImpl*> m_SetVariablesScratch;
+    DescriptorSetWriteBatch            m_SetVariablesWriteBatch;
+
     // Shader variable manager index in m_pShaderVarMgrs[] array for every shader stage
     Int8  m_ResourceLayoutIndex[6]      = {-1, -1, -1, -1, -1, -1};
     bool  m_bStaticResourcesInitialized = false;
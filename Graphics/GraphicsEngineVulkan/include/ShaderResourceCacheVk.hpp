@@ -63,6 +63,15 @@ namespace Diligent
 
 class DeviceContextVkImpl;
 
+// Element of the array that descriptor update templates read descriptors from. All template
+// entries use the size of this union as the stride, so descriptors of any type fit in one array.
+union DescriptorUpdateTemplateData
+{
+    VkDescriptorImageInfo  ImageInfo;
+    VkDescriptorBufferInfo BufferInfo;
+    VkBufferView           TexelBufferView;
+};
+
 // sizeof(ShaderResourceCacheVk) == 24 (x64, msvc, Release)
 class ShaderResourceCacheVk
 {
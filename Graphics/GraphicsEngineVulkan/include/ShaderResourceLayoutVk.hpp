@@ -98,7 +98,9 @@
 //      - Bindings, descriptor sets and offsets are assigned during the initialization
 
 #include <array>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "PipelineState.h"
 #include "ShaderBase.hpp"
@@ -110,6 +112,43 @@
 namespace Diligent
 {
 
+/// Collects descriptor writes so that they can be submitted to Vulkan with one vkUpdateDescriptorSets call
+
+/// Writes to consecutive elements of the same binding are merged into a single VkWriteDescriptorSet.
+/// Descriptor infos are stored by value, so the batch does not reference any temporary data.
+class DescriptorSetWriteBatch
+{
+public:
+    void Reserve(size_t NumWrites);
+
+    void AddWrite(VkDescriptorSet               vkDescrSet,
+                  uint32_t                      Binding,
+                  uint32_t                      ArrayElement,
+                  VkDescriptorType              DescrType,
+                  const VkDescriptorImageInfo*  pImageInfo,
+                  const VkDescriptorBufferInfo* pBufferInfo,
+                  const VkBufferView*           pTexelBufferView);
+
+    // Submits all pending writes and clears the batch
+    void Flush(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+
+    bool IsEmpty() const { return m_Writes.empty(); }
+
+private:
+    // Info pointers of the writes are set by Flush() as info arrays may be reallocated
+    struct PendingWrite
+    {
+        VkWriteDescriptorSet Write;
+        size_t               FirstInfo;
+    };
+    std::vector<PendingWrite>           m_Writes;
+    std::vector<VkDescriptorImageInfo>  m_ImageInfos;
+    std::vector<VkDescriptorBufferInfo> m_BufferInfos;
+    std::vector<VkBufferView>           m_TexelBufferViews;
+
+    std::vector<VkWriteDescriptorSet> m_FlushWrites;
+};
+
 /// Diligent::ShaderResourceLayoutVk class
 // sizeof(ShaderResourceLayoutVk)==56 (MS compiler, x64)
 class ShaderResourceLayoutVk
@@ -203,15 +242,20 @@ public:
         // Checks if a resource is bound in ResourceCache at the given ArrayIndex
         bool IsBound(Uint32 ArrayIndex, const ShaderResourceCacheVk& ResourceCache) const;
 
-        // Binds a resource pObject in the ResourceCache
-        void BindResource(IDeviceObject* pObject, Uint32 ArrayIndex, ShaderResourceCacheVk& ResourceCache) const;
+        // Binds a resource pObject in the ResourceCache. If pWriteBatch is not null, descriptor
+        // writes are added to the batch instead of being submitted to Vulkan immediately.
+        void BindResource(IDeviceObject*           pObject,
+                          Uint32                   ArrayIndex,
+                          ShaderResourceCacheVk&   ResourceCache,
+                          DescriptorSetWriteBatch* pWriteBatch = nullptr) const;
 
         // Updates resource descriptor in the descriptor set
         inline void UpdateDescriptorHandle(VkDescriptorSet               vkDescrSet,
                                            uint32_t                      ArrayElement,
                                            const VkDescriptorImageInfo*  pImageInfo,
                                            const VkDescriptorBufferInfo* pBufferInfo,
-                                           const VkBufferView*           pTexelBufferView) const;
+                                           const VkBufferView*           pTexelBufferView,
+                                           DescriptorSetWriteBatch*      pWriteBatch) const;
 
         bool IsImmutableSamplerAssigned() const
         {
@@ -232,31 +276,36 @@ public:
                                 ShaderResourceCacheVk::Resource& DstRes,
                                 VkDescriptorSet                  vkDescrSet,
                                 Uint32                           ArrayInd,
-                                Uint16&                          DynamicBuffersCounter) const;
+                                Uint16&                          DynamicBuffersCounter,
+                                DescriptorSetWriteBatch*         pWriteBatch) const;
 
         void CacheStorageBuffer(IDeviceObject*                   pBufferView,
                                 ShaderResourceCacheVk::Resource& DstRes,
                                 VkDescriptorSet                  vkDescrSet,
                                 Uint32                           ArrayInd,
-                                Uint16&                          DynamicBuffersCounter) const;
+                                Uint16&                          DynamicBuffersCounter,
+                                DescriptorSetWriteBatch*         pWriteBatch) const;
 
         void CacheTexelBuffer(IDeviceObject*                   pBufferView,
                               ShaderResourceCacheVk::Resource& DstRes,
                               VkDescriptorSet                  vkDescrSet,
                               Uint32                           ArrayInd,
-                              Uint16&                          DynamicBuffersCounter) const;
+                              Uint16&                          DynamicBuffersCounter,
+                              DescriptorSetWriteBatch*         pWriteBatch) const;
 
         template <typename TCacheSampler>
         void CacheImage(IDeviceObject*                   pTexView,
                         ShaderResourceCacheVk::Resource& DstRes,
                         VkDescriptorSet                  vkDescrSet,
                         Uint32                           ArrayInd,
+                        DescriptorSetWriteBatch*         pWriteBatch,
                         TCacheSampler                    CacheSampler) const;
 
         void CacheSeparateSampler(IDeviceObject*                   pSampler,
                                   ShaderResourceCacheVk::Resource& DstRes,
                                   VkDescriptorSet                  vkDescrSet,
-                                  Uint32                           ArrayInd) const;
+                                  Uint32                           ArrayInd,
+                                  DescriptorSetWriteBatch*         pWriteBatch) const;
 
         template <typename ObjectType, typename TPreUpdateObject>
         bool UpdateCachedResource(ShaderResourceCacheVk::Resource& DstRes,
@@ -285,10 +334,30 @@ public:
     // Initializes resource slots in the ResourceCache
     void InitializeResourceMemoryInCache(ShaderResourceCacheVk& ResourceCache) const;
 
+    // Appends update template entries for the dynamic resources of this layout. Descriptors of the
+    // resources are read from the DescriptorUpdateTemplateData array starting at element DataOffset.
+    // The offset is advanced by the number of descriptors.
+    void GetDynamicResourceUpdateTemplateEntries(std::vector<VkDescriptorUpdateTemplateEntry>& Entries,
+                                                 Uint32&                                       DataOffset) const;
+
+    // Writes descriptors of the dynamic resources in the order defined by GetDynamicResourceUpdateTemplateEntries().
+    // Returns the pointer to the element that follows the last written one.
+    DescriptorUpdateTemplateData* WriteDynamicResourceDescriptors(const ShaderResourceCacheVk&  ResourceCache,
+                                                                  DescriptorUpdateTemplateData* pData) const;
+
     // Writes dynamic resource descriptors from ResourceCache to vkDynamicDescriptorSet
     void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                 VkDescriptorSet              vkDynamicDescriptorSet) const;
 
+    using UpdateDescriptorSetsCallbackType = std::function<void(Uint32 DescriptorWriteCount, const VkWriteDescriptorSet* pDescriptorWrites)>;
+
+    // Prepares the same descriptor writes as the method above, but hands every batch of writes
+    // to UpdateDescriptorSets instead of submitting it to the device. Descriptor infos referenced
+    // by the writes are only valid for the duration of the callback.
+    void CommitDynamicResources(const ShaderResourceCacheVk&            ResourceCache,
+                                VkDescriptorSet                         vkDynamicDescriptorSet,
+                                const UpdateDescriptorSetsCallbackType& UpdateDescriptorSets) const;
+
     const Char* GetShaderName() const
     {
         return m_pResources->GetShaderName();
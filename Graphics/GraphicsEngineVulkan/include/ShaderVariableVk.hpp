@@ -69,12 +69,13 @@ namespace Diligent
 
 class ShaderVariableVkImpl;
 
-// sizeof(ShaderVariableManagerVk) == 32 (x64, msvc, Release)
+// sizeof(ShaderVariableManagerVk) == 40 (x64, msvc, Release)
 class ShaderVariableManagerVk
 {
 public:
     ShaderVariableManagerVk(IObject&                             Owner,
                             const ShaderResourceLayoutVk&        SrcLayout,
+                            const ShaderVariableIndexMap&        VarIndexMap,
                             IMemoryAllocator&                    Allocator,
                             const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
                             Uint32                               NumAllowedTypes,
@@ -85,6 +86,7 @@ public:
     void DestroyVariables(IMemoryAllocator& Allocator);
 
     ShaderVariableVkImpl* GetVariable(const Char* Name);
+    ShaderVariableVkImpl* GetVariableByHash(Uint64 NameHash);
     ShaderVariableVkImpl* GetVariable(Uint32 Index);
 
     void BindResources(IResourceMapping* pResourceMapping, Uint32 Flags);
@@ -94,11 +96,22 @@ public:
                                         Uint32                               NumAllowedTypes,
                                         Uint32&                              NumVariables);
 
+    // Creates the map of the names of the variables that a manager initialized with the same
+    // arguments will contain. The pipeline state creates the maps once and all managers share them.
+    static ShaderVariableIndexMap CreateVariableIndexMap(const ShaderResourceLayoutVk&        Layout,
+                                                         const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                                                         Uint32                               NumAllowedTypes);
+
     Uint32 GetVariableCount() const { return m_NumVariables; }
 
 private:
     friend ShaderVariableVkImpl;
 
+    template <typename THandler>
+    static void ProcessVariableResources(const ShaderResourceLayoutVk& Layout, Uint32 AllowedTypeBits, THandler Handler);
+
+    ShaderVariableVkImpl* GetVariableAtMapIndex(Uint32 Index, const Char* Name);
+
     Uint32 GetVariableIndex(const ShaderVariableVkImpl& Variable);
 
     IObject& m_Owner;
@@ -108,6 +121,9 @@ private:
     // (which the variables reference) are guaranteed to be alive while the manager is alive.
     ShaderResourceCacheVk& m_ResourceCache;
 
+    // The map is owned by the pipeline state and is shared by all managers created for the same layout
+    const ShaderVariableIndexMap& m_VarIndexMap;
+
     // Memory is allocated through the allocator provided by the pipeline state. If allocation granularity > 1, fixed block
     // memory allocator is used. This ensures that all resources from different shader resource bindings reside in
     // continuous memory. If allocation granularity == 1, raw allocator is used.
@@ -199,6 +215,12 @@ public:
         return m_Resource.IsBound(ArrayIndex, m_ParentManager.m_ResourceCache);
     }
 
+    // Binds the resource, but adds descriptor writes to the batch instead of submitting them to Vulkan
+    void BindResource(IDeviceObject* pObject, Uint32 ArrayIndex, DescriptorSetWriteBatch& WriteBatch)
+    {
+        m_Resource.BindResource(pObject, ArrayIndex, m_ParentManager.m_ResourceCache, &WriteBatch);
+    }
+
     const ShaderResourceLayoutVk::VkResource& GetResource() const
     {
         return m_Resource;
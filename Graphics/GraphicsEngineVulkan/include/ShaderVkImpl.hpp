@@ -48,7 +48,13 @@ class ShaderVkImpl final : public ShaderBase<IShaderVk, RenderDeviceVkImpl>
 public:
     using TShaderBase = ShaderBase<IShaderVk, RenderDeviceVkImpl>;
 
-    ShaderVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pRenderDeviceVk, const ShaderCreateInfo& CreationAttribs);
+    /// pSerializedResources optionally points to shader resources serialized by SPIRVShaderResources::Serialize(),
+    /// in which case reflection is not performed. The data is not referenced after the constructor returns.
+    ShaderVkImpl(IReferenceCounters*     pRefCounters,
+                 RenderDeviceVkImpl*     pRenderDeviceVk,
+                 const ShaderCreateInfo& CreationAttribs,
+                 const void*             pSerializedResources    = nullptr,
+                 size_t                  SerializedResourcesSize = 0);
     ~ShaderVkImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ShaderVk, TShaderBase);
@@ -60,6 +60,9 @@ public:
     /// Implementation of ITextureViewVk::GetVulkanImageView().
     virtual VkImageView DILIGENT_CALL_TYPE GetVulkanImageView() const override final { return m_ImageView; }
 
+    /// Implementation of ITextureViewVk::GetBindlessIndex().
+    virtual Uint32 DILIGENT_CALL_TYPE GetBindlessIndex() const override final { return m_BindlessIndex; }
+
     bool HasMipLevelViews() const
     {
         return m_MipLevelViews != nullptr;
@@ -84,12 +87,20 @@ public:
         m_MipLevelViews = MipLevelViews;
     }
 
+    // Places a shader resource view into the bindless resource table, if the table is enabled.
+    // Only views returned to the application are placed in the table; internal mip level views
+    // used for mipmap generation are never accessed by index and do not take a slot.
+    void AllocateBindlessSlot();
+
 protected:
     /// Vulkan image view descriptor handle
     VulkanUtilities::ImageViewWrapper m_ImageView;
 
     /// Individual mip level views used for mipmap generation
     MipLevelViewAutoPtrType* m_MipLevelViews = nullptr;
+
+    /// Index of the view in the bindless resource table (shader resource views only)
+    Uint32 m_BindlessIndex = BindlessResourceTableVk::InvalidIndex;
 };
 
 } // namespace Diligent
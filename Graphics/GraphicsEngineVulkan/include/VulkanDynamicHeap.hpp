@@ -28,6 +28,7 @@
 #pragma once
 
 #include <mutex>
+#include <atomic>
 #include "vulkan.h"
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
@@ -113,7 +114,9 @@ struct VulkanDynamicAllocation
 //  |_______________________________________________________________________|
 //
 // We cannot use global memory manager for dynamic resources because they
-// need to use the same Vulkan buffer
+// need to use the same Vulkan buffer. Master blocks are allocated by the list-based manager:
+// contexts release their blocks on independent fences, and a block that is held for a long time
+// (e.g. by an idle deferred context) would stall all allocations behind it in a shared ring.
 class VulkanDynamicMemoryManager : public DynamicHeap::MasterBlockListBasedManager
 {
 public:
@@ -149,7 +152,7 @@ private:
     Uint8*                               m_CPUAddress;
     const VkDeviceSize                   m_DefaultAlignment;
     const Uint64                         m_CommandQueueMask;
-    OffsetType                           m_TotalPeakSize = 0;
+    std::atomic<OffsetType>              m_TotalPeakSize{0};
 };
 
 
@@ -66,6 +66,9 @@ public:
 
     VkPhysicalDevice SelectPhysicalDevice()const;
 
+    // Returns true if VK_KHR_get_physical_device_properties2 extension is enabled
+    bool IsPhysicalDeviceProperties2Enabled()const{return m_PhysicalDeviceProperties2Enabled;}
+
     VkAllocationCallbacks* GetVkAllocator()const{return m_pVkAllocator;}
     VkInstance             GetVkInstance() const{return m_VkInstance;  }
     // clang-format on
@@ -76,7 +79,8 @@ private:
                    const char* const*     ppGlobalExtensionNames,
                    VkAllocationCallbacks* pVkAllocator);
 
-    bool                         m_DebugUtilsEnabled = false;
+    bool                         m_DebugUtilsEnabled                = false;
+    bool                         m_PhysicalDeviceProperties2Enabled = false;
     VkAllocationCallbacks* const m_pVkAllocator;
     VkInstance                   m_VkInstance = VK_NULL_HANDLE;
 
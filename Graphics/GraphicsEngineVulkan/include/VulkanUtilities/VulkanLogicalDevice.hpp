@@ -57,7 +57,9 @@ enum class VulkanHandleTypeId : uint32_t
     Semaphore,
     Queue,
     Event,
-    QueryPool
+    QueryPool,
+    PipelineCache,
+    DescriptorUpdateTemplate
 };
 
 template <typename VulkanObjectType, VulkanHandleTypeId>
@@ -81,6 +83,8 @@ using DescriptorPoolWrapper      = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorPool);
 using DescriptorSetLayoutWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorSetLayout);
 using SemaphoreWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(Semaphore);
 using QueryPoolWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(QueryPool);
+using PipelineCacheWrapper       = DEFINE_VULKAN_OBJECT_WRAPPER(PipelineCache);
+using DescriptorUpdateTemplateWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorUpdateTemplate);
 #undef DEFINE_VULKAN_OBJECT_WRAPPER
 
 class VulkanLogicalDevice : public std::enable_shared_from_this<VulkanLogicalDevice>
@@ -141,8 +145,14 @@ public:
     SemaphoreWrapper    CreateSemaphore(const VkSemaphoreCreateInfo& SemaphoreCI, const char* DebugName = "") const;
     QueryPoolWrapper    CreateQueryPool(const VkQueryPoolCreateInfo& QueryPoolCI, const char* DebugName = "") const;
 
+    PipelineCacheWrapper CreatePipelineCache(const VkPipelineCacheCreateInfo& PipelineCacheCI, const char* DebugName = "") const;
+
+    // Must only be called if IsDescriptorUpdateTemplateSupported() returns true
+    DescriptorUpdateTemplateWrapper CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfo& TemplateCI, const char* DebugName = "") const;
+
     VkCommandBuffer     AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo& AllocInfo, const char* DebugName = "") const;
     VkDescriptorSet     AllocateVkDescriptorSet(const VkDescriptorSetAllocateInfo& AllocInfo, const char* DebugName = "") const;
+    bool                AllocateVkDescriptorSets(const VkDescriptorSetAllocateInfo& AllocInfo, VkDescriptorSet* pDescrSets, const char* DebugName = "") const;
 
     void ReleaseVulkanObject(CommandPoolWrapper&&  CmdPool) const;
     void ReleaseVulkanObject(BufferWrapper&&       Buffer) const;
@@ -161,6 +171,8 @@ public:
     void ReleaseVulkanObject(DescriptorSetLayoutWrapper&& DescriptorSetLayout) const;
     void ReleaseVulkanObject(SemaphoreWrapper&&     Semaphore) const;
     void ReleaseVulkanObject(QueryPoolWrapper&&     QueryPool) const;
+    void ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache) const;
+    void ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescriptorUpdateTemplate) const;
 
     void FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const;
 
@@ -189,6 +201,16 @@ public:
                               uint32_t                    descriptorCopyCount,
                               const VkCopyDescriptorSet*  pDescriptorCopies) const;
 
+    void UpdateDescriptorSetWithTemplate(VkDescriptorSet            descriptorSet,
+                                         VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                         const void*                pData) const;
+
+    void CmdPushDescriptorSetWithTemplate(VkCommandBuffer            commandBuffer,
+                                          VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                          VkPipelineLayout           layout,
+                                          uint32_t                   set,
+                                          const void*                pData) const;
+
     VkResult ResetCommandPool(VkCommandPool           vkCmdPool,
                               VkCommandPoolResetFlags flags = 0) const;
 
@@ -207,8 +229,25 @@ public:
                                      dataSize, pData, stride, flags);
     }
 
+    VkResult GetPipelineCacheData(VkPipelineCache pipelineCache,
+                                  size_t*         pDataSize,
+                                  void*           pData) const
+    {
+        return vkGetPipelineCacheData(m_VkDevice, pipelineCache, pDataSize, pData);
+    }
+
     VkPipelineStageFlags GetEnabledGraphicsShaderStages() const { return m_EnabledGraphicsShaderStages; }
 
+    // Returns true if VK_KHR_descriptor_update_template extension is enabled
+    bool IsDescriptorUpdateTemplateSupported() const { return m_vkUpdateDescriptorSetWithTemplateKHR != nullptr; }
+
+    // Returns true if VK_KHR_push_descriptor extension is enabled and descriptors can be
+    // pushed with vkCmdPushDescriptorSetWithTemplateKHR
+    bool IsPushDescriptorSupported() const { return m_vkCmdPushDescriptorSetWithTemplateKHR != nullptr; }
+
+    // Returns true if VK_EXT_descriptor_indexing extension is enabled
+    bool IsDescriptorIndexingEnabled() const { return m_DescriptorIndexingEnabled; }
+
 private:
     VulkanLogicalDevice(VkPhysicalDevice             vkPhysicalDevice,
                         const VkDeviceCreateInfo&    DeviceCI,
@@ -226,6 +265,15 @@ private:
     VkDevice                           m_VkDevice = VK_NULL_HANDLE;
     const VkAllocationCallbacks* const m_VkAllocator;
     VkPipelineStageFlags               m_EnabledGraphicsShaderStages = 0;
+    bool                               m_DescriptorIndexingEnabled   = false;
+
+    // VK_KHR_descriptor_update_template extension functions
+    PFN_vkCreateDescriptorUpdateTemplateKHR  m_vkCreateDescriptorUpdateTemplateKHR  = nullptr;
+    PFN_vkDestroyDescriptorUpdateTemplateKHR m_vkDestroyDescriptorUpdateTemplateKHR = nullptr;
+    PFN_vkUpdateDescriptorSetWithTemplateKHR m_vkUpdateDescriptorSetWithTemplateKHR = nullptr;
+
+    // VK_KHR_push_descriptor extension functions
+    PFN_vkCmdPushDescriptorSetWithTemplateKHR m_vkCmdPushDescriptorSetWithTemplateKHR = nullptr;
 };
 
 } // namespace VulkanUtilities
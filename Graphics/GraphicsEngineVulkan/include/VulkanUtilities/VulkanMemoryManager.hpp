@@ -124,6 +124,12 @@ public:
 
     VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
 
+    // Free size is tracked by the allocations manager, so this method is O(1)
+    VkDeviceSize GetFreeSize();
+
+    // Walks all free blocks of the page. Only intended for diagnostics.
+    Diligent::VariableSizeAllocationsManager::FragmentationStats GetFragmentationStats();
+
     VkDeviceMemory GetVkMemory() const { return m_VkMemory; }
     void*          GetCPUMemory() const { return m_CPUMemory; }
 
@@ -183,7 +189,8 @@ public:
         //m_CurrUsedSize      {rhs.m_CurrUsedSize},
         m_PeakUsedSize      {rhs.m_PeakUsedSize     },
         m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
-        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
+        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize},
+        m_FragmentedPageAllocations{rhs.m_FragmentedPageAllocations}
     {
         // clang-format on
         for (size_t i = 0; i < m_CurrUsedSize.size(); ++i)
@@ -202,6 +209,10 @@ public:
     VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps);
     void                   ShrinkMemory();
 
+    // Logs free space distribution of every page. This is a diagnostics method that
+    // walks all free blocks of all pages and should not be called on hot paths.
+    void LogFragmentationStats();
+
 protected:
     friend class VulkanMemoryPage;
 
@@ -258,6 +269,10 @@ protected:
     std::array<VkDeviceSize, 2>        m_CurrAllocatedSize = {};
     std::array<VkDeviceSize, 2>        m_PeakAllocatedSize = {};
 
+    // Number of pages that were created because no existing page had a large enough
+    // free block even though the total free size of the pages was sufficient
+    std::array<uint32_t, 2> m_FragmentedPageAllocations = {};
+
     // If adding new member, do not forget to update move ctor
 };
 
@@ -34,6 +34,8 @@
 namespace VulkanUtilities
 {
 
+class VulkanInstance;
+
 class VulkanPhysicalDevice
 {
 public:
@@ -44,7 +46,7 @@ public:
     VulkanPhysicalDevice& operator = (VulkanPhysicalDevice&&)      = delete;
     // clang-format on
 
-    static std::unique_ptr<VulkanPhysicalDevice> Create(VkPhysicalDevice vkDevice);
+    static std::unique_ptr<VulkanPhysicalDevice> Create(VkPhysicalDevice vkDevice, const VulkanInstance& Instance);
 
     // clang-format off
     uint32_t         FindQueueFamily     (VkQueueFlags QueueFlags)                           const;
@@ -61,8 +63,19 @@ public:
     const VkPhysicalDeviceFeatures&   GetFeatures() const { return m_Features; }
     VkFormatProperties                GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const;
 
+    // Descriptor indexing features and properties are only queried if VK_EXT_descriptor_indexing is supported
+    // by the device and VK_KHR_get_physical_device_properties2 is enabled by the instance. Otherwise, all
+    // members are zero.
+    const VkPhysicalDeviceDescriptorIndexingFeaturesEXT&   GetDescriptorIndexingFeatures() const { return m_DescriptorIndexingFeatures; }
+    const VkPhysicalDeviceDescriptorIndexingPropertiesEXT& GetDescriptorIndexingProperties() const { return m_DescriptorIndexingProperties; }
+
+    // Push descriptor properties are only queried if VK_KHR_push_descriptor is supported by the device and
+    // VK_KHR_get_physical_device_properties2 is enabled by the instance. Otherwise, maxPushDescriptors is
+    // the minimum value guaranteed by the extension.
+    const VkPhysicalDevicePushDescriptorPropertiesKHR& GetPushDescriptorProperties() const { return m_PushDescriptorProperties; }
+
 private:
-    VulkanPhysicalDevice(VkPhysicalDevice vkDevice);
+    VulkanPhysicalDevice(VkPhysicalDevice vkDevice, const VulkanInstance& Instance);
 
     const VkPhysicalDevice               m_VkDevice;
     VkPhysicalDeviceProperties           m_Properties       = {};
@@ -70,6 +83,10 @@ private:
     VkPhysicalDeviceMemoryProperties     m_MemoryProperties = {};
     std::vector<VkQueueFamilyProperties> m_QueueFamilyProperties;
     std::vector<VkExtensionProperties>   m_SupportedExtensions;
+
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT   m_DescriptorIndexingFeatures   = {};
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT m_DescriptorIndexingProperties = {};
+    VkPhysicalDevicePushDescriptorPropertiesKHR     m_PushDescriptorProperties     = {};
 };
 
 } // namespace VulkanUtilities
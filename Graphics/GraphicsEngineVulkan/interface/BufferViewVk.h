@@ -52,6 +52,14 @@ DILIGENT_BEGIN_INTERFACE(IBufferViewVk, IBufferView)
 {
     /// Returns Vulkan buffer view object.
     VIRTUAL VkBufferView METHOD(GetVkBufferView)(THIS) CONST PURE;
+
+    /// Returns the index of the view in the device-wide bindless resource table.
+
+    /// Shader resource and unordered access views of structured and raw buffers are placed in
+    /// the table as storage buffers. The index does not change during the lifetime of the view.
+    /// The method returns 0xFFFFFFFF if the view is not in the table
+    /// (see EngineVkCreateInfo::EnableBindlessResources).
+    VIRTUAL Uint32 METHOD(GetBindlessIndex)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -61,7 +69,8 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IBufferViewVk_GetVkBufferView(This) CALL_IFACE_METHOD(BufferViewVk, GetVkBufferView, This)
+#    define IBufferViewVk_GetVkBufferView(This)  CALL_IFACE_METHOD(BufferViewVk, GetVkBufferView,  This)
+#    define IBufferViewVk_GetBindlessIndex(This) CALL_IFACE_METHOD(BufferViewVk, GetBindlessIndex, This)
 
 // clang-format on
 
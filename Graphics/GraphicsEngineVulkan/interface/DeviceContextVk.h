@@ -39,6 +39,17 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_DeviceContextVk =
     {0x72aeb1ba, 0xc6ad, 0x42ec, {0x88, 0x11, 0x7e, 0xd9, 0xc7, 0x21, 0x76, 0xbb}};
 
+/// Dynamic descriptor set cache statistics, see IDeviceContextVk::GetDynamicDescriptorSetCacheStats().
+struct DynamicDescriptorSetCacheStatsVk
+{
+    /// The number of times a previously written descriptor set was reused.
+    Uint64 Hits   DEFAULT_INITIALIZER(0);
+
+    /// The number of times a new descriptor set had to be allocated and written.
+    Uint64 Misses DEFAULT_INITIALIZER(0);
+};
+typedef struct DynamicDescriptorSetCacheStatsVk DynamicDescriptorSetCacheStatsVk;
+
 #define DILIGENT_INTERFACE_NAME IDeviceContextVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -89,6 +100,14 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextVk, IDeviceContext)
 
     /// Unlocks the command queue that was previously locked by IDeviceContextVk::LockCommandQueue().
     VIRTUAL void METHOD(UnlockCommandQueue)(THIS) PURE;
+
+    /// Returns the statistics of the dynamic descriptor set cache.
+
+    /// \remarks  When shader resources with dynamic variables are committed, the context reuses the descriptor
+    ///           set it has already written for the same layout and the same resources, if there is one.
+    ///           Cached sets are discarded when the context's command buffer is submitted or closed,
+    ///           and when the frame is finished. The counters accumulate over the lifetime of the context.
+    VIRTUAL const DynamicDescriptorSetCacheStatsVk REF METHOD(GetDynamicDescriptorSetCacheStats)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -98,10 +117,11 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IDeviceContextVk_TransitionImageLayout(This, ...) CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout, This, __VA_ARGS__)
-#    define IDeviceContextVk_BufferMemoryBarrier(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,   This, __VA_ARGS__)
-#    define IDeviceContextVk_LockCommandQueue(This)           CALL_IFACE_METHOD(DeviceContextVk, LockCommandQueue,      This)
-#    define IDeviceContextVk_UnlockCommandQueue(This)         CALL_IFACE_METHOD(DeviceContextVk, UnlockCommandQueue,    This)
+#    define IDeviceContextVk_TransitionImageLayout(This, ...)        CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout,             This, __VA_ARGS__)
+#    define IDeviceContextVk_BufferMemoryBarrier(This, ...)          CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,               This, __VA_ARGS__)
+#    define IDeviceContextVk_LockCommandQueue(This)                  CALL_IFACE_METHOD(DeviceContextVk, LockCommandQueue,                  This)
+#    define IDeviceContextVk_UnlockCommandQueue(This)                CALL_IFACE_METHOD(DeviceContextVk, UnlockCommandQueue,                This)
+#    define IDeviceContextVk_GetDynamicDescriptorSetCacheStats(This) CALL_IFACE_METHOD(DeviceContextVk, GetDynamicDescriptorSetCacheStats, This)
 
 // clang-format on
 
@@ -52,6 +52,9 @@ DILIGENT_BEGIN_INTERFACE(IPipelineStateVk, IPipelineState)
     VIRTUAL VkRenderPass METHOD(GetVkRenderPass)(THIS) CONST PURE;
 
     /// Returns handle to a vulkan pipeline pass object.
+
+    /// \remarks If the pipeline state is being created asynchronously, the method
+    ///          returns VK_NULL_HANDLE until the status becomes PIPELINE_STATE_STATUS_READY.
     VIRTUAL VkPipeline METHOD(GetVkPipeline)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
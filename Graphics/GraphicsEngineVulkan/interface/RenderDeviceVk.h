@@ -112,6 +112,19 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                                         const BufferDesc REF BuffDesc,
                                                         RESOURCE_STATE       InitialState,
                                                         IBuffer**            ppBuffer) PURE;
+
+    /// Serializes the contents of the device-wide Vulkan pipeline cache
+
+    /// \param [out] ppData - Address of the memory location where the pointer to the
+    ///                        data blob will be written. The blob can be passed to
+    ///                        EngineVkCreateInfo::pPipelineCacheData when the device
+    ///                        is created next time.
+    ///
+    /// \remarks  The blob contains the Vulkan pipeline cache header followed by
+    ///           implementation-specific data, and is only valid for the same
+    ///           physical device and driver version.
+    VIRTUAL void METHOD(GetPipelineCacheData)(THIS_
+                                              IDataBlob** ppData) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -129,6 +142,7 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_IsFenceSignaled(This, ...)                CALL_IFACE_METHOD(RenderDeviceVk, IsFenceSignaled,                This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateTextureFromVulkanImage(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTextureFromVulkanImage,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateBufferFromVulkanResource(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, CreateBufferFromVulkanResource, This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetPipelineCacheData(This, ...)           CALL_IFACE_METHOD(RenderDeviceVk, GetPipelineCacheData,           This, __VA_ARGS__)
 
 // clang-format on
 
@@ -50,6 +50,12 @@ DILIGENT_BEGIN_INTERFACE(ISamplerVk, ISampler)
 {
     /// Returns a vulkan sampler object handle
     VIRTUAL VkSampler METHOD(GetVkSampler)() CONST PURE;
+
+    /// Returns the index of the sampler in the device-wide bindless resource table.
+
+    /// The index does not change during the lifetime of the sampler. The method returns
+    /// 0xFFFFFFFF if the sampler is not in the table (see EngineVkCreateInfo::EnableBindlessResources).
+    VIRTUAL Uint32 METHOD(GetBindlessIndex)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -57,7 +63,8 @@ DILIGENT_END_INTERFACE
 
 #if DILIGENT_C_INTERFACE
 
-#    define ISamplerVk_GetVkSampler(This) CALL_IFACE_METHOD(SamplerVk, GetVkSampler, This)
+#    define ISamplerVk_GetVkSampler(This)     CALL_IFACE_METHOD(SamplerVk, GetVkSampler,     This)
+#    define ISamplerVk_GetBindlessIndex(This) CALL_IFACE_METHOD(SamplerVk, GetBindlessIndex, This)
 
 #endif
 
@@ -52,6 +52,14 @@ DILIGENT_BEGIN_INTERFACE(ITextureViewVk, ITextureView)
 {
     /// Returns Vulkan image view handle
     VIRTUAL VkImageView METHOD(GetVulkanImageView)(THIS) CONST PURE;
+
+    /// Returns the index of the view in the device-wide bindless resource table.
+
+    /// Only shader resource views created by the application (including default views) are placed
+    /// in the table; internal views created by the engine are not. The index does not change during the
+    /// lifetime of the view. The method returns 0xFFFFFFFF if the view is not in the table
+    /// (see EngineVkCreateInfo::EnableBindlessResources).
+    VIRTUAL Uint32 METHOD(GetBindlessIndex)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -62,6 +70,7 @@ DILIGENT_END_INTERFACE
 // clang-format off
 
 #    define ITextureViewVk_GetVulkanImageView(This) CALL_IFACE_METHOD(TextureViewVk, GetVulkanImageView, This)
+#    define ITextureViewVk_GetBindlessIndex(This)   CALL_IFACE_METHOD(TextureViewVk, GetBindlessIndex,   This)
 
 // clang-format ons
 
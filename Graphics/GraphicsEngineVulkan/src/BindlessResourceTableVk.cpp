@@ -0,0 +1,339 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include <algorithm>
+
+#include "BindlessResourceTableVk.hpp"
+#include "RenderDeviceVkImpl.hpp"
+
+namespace Diligent
+{
+
+static constexpr VkDescriptorType TableDescriptorTypes[] =
+    {
+        VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,  // BINDING_SAMPLED_IMAGE
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, // BINDING_STORAGE_BUFFER
+        VK_DESCRIPTOR_TYPE_SAMPLER         // BINDING_SAMPLER
+};
+static_assert(_countof(TableDescriptorTypes) == BindlessResourceTableVk::BINDING_COUNT, "Please update the descriptor type list");
+
+static const char* GetTableBindingName(BindlessResourceTableVk::TABLE_BINDING Binding)
+{
+    switch (Binding)
+    {
+        // clang-format off
+        case BindlessResourceTableVk::BINDING_SAMPLED_IMAGE:  return "sampled image";
+        case BindlessResourceTableVk::BINDING_STORAGE_BUFFER: return "storage buffer";
+        case BindlessResourceTableVk::BINDING_SAMPLER:        return "sampler";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected table binding");
+            return "unknown";
+    }
+}
+
+bool BindlessResourceTableVk::IsSupported(const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice)
+{
+    if (!PhysicalDevice.IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) ||
+        !PhysicalDevice.IsExtensionSupported(VK_KHR_MAINTENANCE3_EXTENSION_NAME))
+        return false;
+
+    // All members are zero if the features could not be queried
+    const auto& Features = PhysicalDevice.GetDescriptorIndexingFeatures();
+    return Features.runtimeDescriptorArray != VK_FALSE &&
+        Features.descriptorBindingPartiallyBound != VK_FALSE &&
+        Features.descriptorBindingUpdateUnusedWhilePending != VK_FALSE &&
+        Features.descriptorBindingSampledImageUpdateAfterBind != VK_FALSE &&
+        Features.descriptorBindingStorageBufferUpdateAfterBind != VK_FALSE;
+}
+
+BindlessResourceTableVk::TABLE_BINDING BindlessResourceTableVk::GetBinding(SPIRVShaderResourceAttribs::ResourceType ResType)
+{
+    switch (ResType)
+    {
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+            return BINDING_SAMPLED_IMAGE;
+
+        case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
+        case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
+            return BINDING_STORAGE_BUFFER;
+
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+            return BINDING_SAMPLER;
+
+        default:
+            return BINDING_COUNT;
+    }
+}
+
+BindlessResourceTableVk::BindlessResourceTableVk(RenderDeviceVkImpl&                       DeviceVkImpl,
+                                                 const std::array<Uint32, BINDING_COUNT>& Sizes) :
+    m_DeviceVkImpl{DeviceVkImpl}
+{
+    const auto& LogicalDevice = DeviceVkImpl.GetLogicalDevice();
+    const auto& Limits        = DeviceVkImpl.GetPhysicalDevice().GetDescriptorIndexingProperties();
+    const auto& DeviceLimits  = DeviceVkImpl.GetPhysicalDevice().GetProperties().limits;
+
+    // Update-after-bind limits apply to all descriptors of every pipeline layout that includes the table,
+    // so the engine-managed descriptor sets of the pipeline count towards them as well. These sets never
+    // use more descriptors than the regular per-stage limit allows, which is reserved for them. At least
+    // half of the update-after-bind limit is left for the table on devices where both limits are equal.
+    auto GetMaxTableSize = [](Uint32 MaxSetUABDescriptors, Uint32 MaxPerStageUABDescriptors, Uint32 MaxPerStageDescriptors) //
+    {
+        const auto MaxUABDescriptors = std::min(MaxSetUABDescriptors, MaxPerStageUABDescriptors);
+        return MaxUABDescriptors - std::min(MaxPerStageDescriptors, MaxUABDescriptors / 2);
+    };
+    const std::array<Uint32, BINDING_COUNT> MaxSizes =
+        {
+            GetMaxTableSize(Limits.maxDescriptorSetUpdateAfterBindSampledImages, Limits.maxPerStageDescriptorUpdateAfterBindSampledImages, DeviceLimits.maxPerStageDescriptorSampledImages),
+            GetMaxTableSize(Limits.maxDescriptorSetUpdateAfterBindStorageBuffers, Limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers, DeviceLimits.maxPerStageDescriptorStorageBuffers),
+            GetMaxTableSize(Limits.maxDescriptorSetUpdateAfterBindSamplers, Limits.maxPerStageDescriptorUpdateAfterBindSamplers, DeviceLimits.maxPerStageDescriptorSamplers) //
+        };
+
+    std::array<VkDescriptorSetLayoutBinding, BINDING_COUNT> LayoutBindings = {};
+    std::array<VkDescriptorBindingFlagsEXT, BINDING_COUNT>  BindingFlags   = {};
+    std::vector<VkDescriptorPoolSize>                       PoolSizes;
+    for (Uint32 b = 0; b < BINDING_COUNT; ++b)
+    {
+        auto& Slots = m_Slots[b];
+        Slots.Size  = Sizes[b];
+        if (Slots.Size > MaxSizes[b])
+        {
+            LOG_WARNING_MESSAGE("The requested number of ", GetTableBindingName(static_cast<TABLE_BINDING>(b)), " slots in the bindless resource table (",
+                                Slots.Size, ") exceeds the device limit (", MaxSizes[b], ")");
+            Slots.Size = MaxSizes[b];
+        }
+
+        auto& LayoutBinding           = LayoutBindings[b];
+        LayoutBinding.binding         = b;
+        LayoutBinding.descriptorType  = TableDescriptorTypes[b];
+        LayoutBinding.descriptorCount = Slots.Size;
+        // The table is shared by all pipelines, so it is visible to all stages
+        LayoutBinding.stageFlags         = VK_SHADER_STAGE_ALL;
+        LayoutBinding.pImmutableSamplers = nullptr;
+
+        // Slots that are not allocated are never written, and slots are written while
+        // the set is bound in command buffers that are being recorded or executed
+        BindingFlags[b] =
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+        if (Slots.Size != 0)
+            PoolSizes.push_back({TableDescriptorTypes[b], Slots.Size});
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT BindingFlagsCI = {};
+
+    BindingFlagsCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    BindingFlagsCI.pNext         = nullptr;
+    BindingFlagsCI.bindingCount  = static_cast<uint32_t>(BindingFlags.size());
+    BindingFlagsCI.pBindingFlags = BindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo SetLayoutCI = {};
+
+    SetLayoutCI.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    SetLayoutCI.pNext        = &BindingFlagsCI;
+    SetLayoutCI.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    SetLayoutCI.bindingCount = static_cast<uint32_t>(LayoutBindings.size());
+    SetLayoutCI.pBindings    = LayoutBindings.data();
+    m_SetLayout              = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI, "Bindless resource table layout");
+
+    VkDescriptorPoolCreateInfo PoolCI = {};
+
+    PoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    PoolCI.pNext = nullptr;
+    // Sets allocated from a pool without UPDATE_AFTER_BIND_BIT must not use layouts created with
+    // UPDATE_AFTER_BIND_POOL_BIT (13.2.3)
+    PoolCI.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    PoolCI.maxSets       = 1;
+    PoolCI.poolSizeCount = static_cast<uint32_t>(PoolSizes.size());
+    PoolCI.pPoolSizes    = PoolSizes.empty() ? nullptr : PoolSizes.data();
+    m_Pool               = LogicalDevice.CreateDescriptorPool(PoolCI, "Bindless resource table pool");
+
+    VkDescriptorSetLayout       vkSetLayout = m_SetLayout;
+    VkDescriptorSetAllocateInfo AllocInfo   = {};
+
+    AllocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    AllocInfo.pNext              = nullptr;
+    AllocInfo.descriptorPool     = m_Pool;
+    AllocInfo.descriptorSetCount = 1;
+    AllocInfo.pSetLayouts        = &vkSetLayout;
+    m_vkDescriptorSet            = LogicalDevice.AllocateVkDescriptorSet(AllocInfo, "Bindless resource table");
+    if (m_vkDescriptorSet == VK_NULL_HANDLE)
+        LOG_ERROR_AND_THROW("Failed to allocate bindless resource table descriptor set");
+
+    LOG_INFO_MESSAGE("Created bindless resource table: ", m_Slots[BINDING_SAMPLED_IMAGE].Size, " sampled images, ",
+                     m_Slots[BINDING_STORAGE_BUFFER].Size, " storage buffers, ", m_Slots[BINDING_SAMPLER].Size, " samplers");
+}
+
+BindlessResourceTableVk::~BindlessResourceTableVk()
+{
+    DEV_CHECK_ERR(GetAllocatedSlotCount() == 0, "Not all bindless resource table slots have been returned to the table. "
+                                                "If there are outstanding references to the slots in release queues, the app will crash when BindlessResourceTableVk::ReturnSlot() is called.");
+    // The set is freed when the pool is destroyed
+}
+
+Uint32 BindlessResourceTableVk::AllocateSampledImage(const VkDescriptorImageInfo& ImageInfo, const char* DbgName)
+{
+    return AllocateSlot(BINDING_SAMPLED_IMAGE, &ImageInfo, nullptr, DbgName);
+}
+
+Uint32 BindlessResourceTableVk::AllocateStorageBuffer(const VkDescriptorBufferInfo& BufferInfo, const char* DbgName)
+{
+    return AllocateSlot(BINDING_STORAGE_BUFFER, nullptr, &BufferInfo, DbgName);
+}
+
+Uint32 BindlessResourceTableVk::AllocateSampler(VkSampler vkSampler, const char* DbgName)
+{
+    VkDescriptorImageInfo ImageInfo = {};
+
+    ImageInfo.sampler     = vkSampler;
+    ImageInfo.imageView   = VK_NULL_HANDLE;
+    ImageInfo.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    return AllocateSlot(BINDING_SAMPLER, &ImageInfo, nullptr, DbgName);
+}
+
+Uint32 BindlessResourceTableVk::AllocateSlot(TABLE_BINDING                 Binding,
+                                             const VkDescriptorImageInfo*  pImageInfo,
+                                             const VkDescriptorBufferInfo* pBufferInfo,
+                                             const char*                   DbgName)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto&  Slots = m_Slots[Binding];
+    Uint32 Index = InvalidIndex;
+    if (!Slots.FreeIndices.empty())
+    {
+        Index = Slots.FreeIndices.back();
+        Slots.FreeIndices.pop_back();
+    }
+    else if (Slots.NextUnusedIndex < Slots.Size)
+    {
+        Index = Slots.NextUnusedIndex++;
+    }
+    else
+    {
+        LOG_WARNING_MESSAGE("Bindless resource table is out of ", GetTableBindingName(Binding), " slots (", Slots.Size,
+                            "). Object '", (DbgName != nullptr ? DbgName : ""), "' will not be accessible through the table. "
+                            "Increase the table size in EngineVkCreateInfo.");
+        return InvalidIndex;
+    }
+
+    VkWriteDescriptorSet WriteDescrSet = {};
+
+    WriteDescrSet.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    WriteDescrSet.pNext            = nullptr;
+    WriteDescrSet.dstSet           = m_vkDescriptorSet;
+    WriteDescrSet.dstBinding       = Binding;
+    WriteDescrSet.dstArrayElement  = Index;
+    WriteDescrSet.descriptorCount  = 1;
+    WriteDescrSet.descriptorType   = TableDescriptorTypes[Binding];
+    WriteDescrSet.pImageInfo       = pImageInfo;
+    WriteDescrSet.pBufferInfo      = pBufferInfo;
+    WriteDescrSet.pTexelBufferView = nullptr;
+    m_DeviceVkImpl.GetLogicalDevice().UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
+
+    return Index;
+}
+
+void BindlessResourceTableVk::FreeSlot(TABLE_BINDING Binding, Uint32 Index, Uint64 CmdQueueMask)
+{
+    VERIFY_EXPR(Binding < BINDING_COUNT);
+    if (Index == InvalidIndex)
+        return;
+
+    class TableSlotDeleter
+    {
+    public:
+        // clang-format off
+        TableSlotDeleter(BindlessResourceTableVk& _Table,
+                         TABLE_BINDING            _Binding,
+                         Uint32                   _Index) noexcept :
+            Table   {&_Table  },
+            Binding {_Binding },
+            Index   {_Index   }
+        {}
+
+        TableSlotDeleter             (const TableSlotDeleter&) = delete;
+        TableSlotDeleter& operator = (const TableSlotDeleter&) = delete;
+        TableSlotDeleter& operator = (      TableSlotDeleter&&)= delete;
+
+        TableSlotDeleter(TableSlotDeleter&& rhs) noexcept :
+            Table   {rhs.Table  },
+            Binding {rhs.Binding},
+            Index   {rhs.Index  }
+        {
+            rhs.Table = nullptr;
+        }
+        // clang-format on
+
+        ~TableSlotDeleter()
+        {
+            if (Table != nullptr)
+            {
+                Table->ReturnSlot(Binding, Index);
+            }
+        }
+
+    private:
+        BindlessResourceTableVk* Table;
+        TABLE_BINDING            Binding;
+        Uint32                   Index;
+    };
+
+    // The slot may still be referenced by command buffers in flight, so it must not be
+    // reused until the GPU has finished executing them. The descriptor is not cleared as
+    // partially bound slots that are not dynamically used may contain stale descriptors.
+    m_DeviceVkImpl.SafeReleaseDeviceObject(TableSlotDeleter{*this, Binding, Index}, CmdQueueMask);
+}
+
+void BindlessResourceTableVk::ReturnSlot(TABLE_BINDING Binding, Uint32 Index)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto& Slots = m_Slots[Binding];
+    VERIFY_EXPR(Index < Slots.NextUnusedIndex);
+    VERIFY(std::find(Slots.FreeIndices.begin(), Slots.FreeIndices.end(), Index) == Slots.FreeIndices.end(),
+           "Slot ", Index, " has already been returned to the table");
+    Slots.FreeIndices.push_back(Index);
+}
+
+Uint32 BindlessResourceTableVk::GetAllocatedSlotCount() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    Uint32 Count = 0;
+    for (const auto& Slots : m_Slots)
+        Count += Slots.NextUnusedIndex - static_cast<Uint32>(Slots.FreeIndices.size());
+    return Count;
+}
+
+} // namespace Diligent
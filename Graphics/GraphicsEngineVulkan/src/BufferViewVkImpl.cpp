@@ -51,10 +51,40 @@ BufferViewVkImpl::BufferViewVkImpl(IReferenceCounters*                  pRefCoun
     m_BuffView{std::move(BuffView)}
 // clang-format on
 {
+    auto* pBindlessTable = pDevice->GetBindlessResourceTable();
+    if (pBindlessTable == nullptr)
+        return;
+
+    // Structured and raw buffer views are mapped to storage buffers, formatted views to texel buffers
+    // that cannot be placed into the table
+    const auto& BuffDesc = m_pBuffer->GetDesc();
+    if ((BuffDesc.Mode != BUFFER_MODE_STRUCTURED && BuffDesc.Mode != BUFFER_MODE_RAW) ||
+        (m_Desc.ViewType != BUFFER_VIEW_SHADER_RESOURCE && m_Desc.ViewType != BUFFER_VIEW_UNORDERED_ACCESS))
+        return;
+
+    // The offset member of VkDescriptorBufferInfo must be a multiple of
+    // VkPhysicalDeviceLimits::minStorageBufferOffsetAlignment (13.2.4)
+    const auto& DeviceLimits = pDevice->GetPhysicalDevice().GetProperties().limits;
+    if ((m_Desc.ByteOffset % DeviceLimits.minStorageBufferOffsetAlignment) != 0)
+    {
+        LOG_WARNING_MESSAGE("Buffer view '", m_Desc.Name, "' will not be added to the bindless resource table because its offset (",
+                            m_Desc.ByteOffset, ") is not a multiple of minStorageBufferOffsetAlignment (", DeviceLimits.minStorageBufferOffsetAlignment, ")");
+        return;
+    }
+
+    // Buffers with SRV or UAV bind flags are always allocated in GPU memory (even dynamic ones),
+    // so the view always references the buffer's own VkBuffer
+    VkDescriptorBufferInfo BufferInfo = {};
+    BufferInfo.buffer                 = GetBufferVk()->GetVkBuffer();
+    BufferInfo.offset                 = m_Desc.ByteOffset;
+    BufferInfo.range                  = m_Desc.ByteWidth;
+    m_BindlessIndex                   = pBindlessTable->AllocateStorageBuffer(BufferInfo, m_Desc.Name);
 }
 
 BufferViewVkImpl::~BufferViewVkImpl()
 {
+    if (m_BindlessIndex != BindlessResourceTableVk::InvalidIndex)
+        m_pDevice->GetBindlessResourceTable()->FreeSlot(BindlessResourceTableVk::BINDING_STORAGE_BUFFER, m_BindlessIndex, m_pBuffer->GetDesc().CommandQueueMask);
     m_pDevice->SafeReleaseDeviceObject(std::move(m_BuffView), m_pBuffer->GetDesc().CommandQueueMask);
 }
 
@@ -26,8 +26,14 @@
  */
 
 #include "pch.h"
+
+#include <array>
+#include <algorithm>
+#include <cstring>
+
 #include "DescriptorPoolManager.hpp"
 #include "RenderDeviceVkImpl.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -152,6 +158,24 @@ static VkDescriptorSet AllocateDescriptorSet(const VulkanUtilities::VulkanLogica
 }
 
 
+static bool AllocateDescriptorSets(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                                   VkDescriptorPool                            Pool,
+                                   const VkDescriptorSetLayout*                pSetLayouts,
+                                   uint32_t                                    NumSets,
+                                   VkDescriptorSet*                            pSets,
+                                   const char*                                 DebugName)
+{
+    VkDescriptorSetAllocateInfo DescrSetAllocInfo = {};
+
+    DescrSetAllocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    DescrSetAllocInfo.pNext              = nullptr;
+    DescrSetAllocInfo.descriptorPool     = Pool;
+    DescrSetAllocInfo.descriptorSetCount = NumSets;
+    DescrSetAllocInfo.pSetLayouts        = pSetLayouts;
+    return LogicalDevice.AllocateVkDescriptorSets(DescrSetAllocInfo, pSets, DebugName);
+}
+
+
 DescriptorSetAllocator::~DescriptorSetAllocator()
 {
     DEV_CHECK_ERR(m_AllocatedSetCounter == 0, m_AllocatedSetCounter, " descriptor set(s) have not been returned to the allocator. If there are outstanding references to the sets in release queues, the app will crash when DescriptorSetAllocator::FreeDescriptorSet() is called");
@@ -162,13 +186,71 @@ DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask
     // Descriptor pools are externally synchronized, meaning that the application must not allocate
     // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
     std::lock_guard<std::mutex> Lock{m_Mutex};
+    return AllocateSet(CommandQueueMask, SetLayout, DebugName);
+}
+
+void DescriptorSetAllocator::Allocate(Uint64                   CommandQueueMask,
+                                      VkDescriptorSetLayout    SetLayout,
+                                      Uint32                   NumSets,
+                                      DescriptorSetAllocation* pAllocations,
+                                      const char*              DebugName)
+{
+    VERIFY_EXPR(NumSets == 0 || pAllocations != nullptr);
+
+    static constexpr Uint32 MaxSetsInBatch = 64;
+
+    std::array<VkDescriptorSetLayout, MaxSetsInBatch> SetLayouts;
+    std::array<VkDescriptorSet, MaxSetsInBatch>       Sets;
+    SetLayouts.fill(SetLayout);
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
+    for (Uint32 FirstSet = 0; FirstSet < NumSets; FirstSet += MaxSetsInBatch)
+    {
+        const auto BatchSize = std::min(NumSets - FirstSet, MaxSetsInBatch);
+
+        bool BatchAllocated = false;
+        // Try all pools starting from the frontmost
+        for (auto it = m_Pools.begin(); it != m_Pools.end() && !BatchAllocated; ++it)
+        {
+            VkDescriptorPool Pool = *it;
+            if (AllocateDescriptorSets(LogicalDevice, Pool, SetLayouts.data(), BatchSize, Sets.data(), DebugName))
+            {
+                // Move the pool to the front
+                if (it != m_Pools.begin())
+                {
+                    std::swap(*it, m_Pools.front());
+                }
+
+                for (Uint32 s = 0; s < BatchSize; ++s)
+                    pAllocations[FirstSet + s] = DescriptorSetAllocation{Sets[s], Pool, CommandQueueMask, *this};
+
+#ifdef DEVELOPMENT
+                m_AllocatedSetCounter += static_cast<int32_t>(BatchSize);
+#endif
+                BatchAllocated = true;
+            }
+        }
+
+        if (!BatchAllocated)
+        {
+            // No pool has enough space for the whole batch - allocate the sets one by one.
+            // This will use up the space left in existing pools and create new pools as necessary.
+            for (Uint32 s = 0; s < BatchSize; ++s)
+                pAllocations[FirstSet + s] = AllocateSet(CommandQueueMask, SetLayout, DebugName);
+        }
+    }
+}
 
+DescriptorSetAllocation DescriptorSetAllocator::AllocateSet(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
+{
     const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
     // Try all pools starting from the frontmost
     for (auto it = m_Pools.begin(); it != m_Pools.end(); ++it)
     {
-        auto& Pool = *it;
-        auto  Set  = AllocateDescriptorSet(LogicalDevice, Pool, SetLayout, DebugName);
+        VkDescriptorPool Pool = *it;
+        auto             Set  = AllocateDescriptorSet(LogicalDevice, Pool, SetLayout, DebugName);
         if (Set != VK_NULL_HANDLE)
         {
             // Move the pool to the front
@@ -283,4 +365,60 @@ DynamicDescriptorSetAllocator::~DynamicDescriptorSetAllocator()
     LOG_INFO_MESSAGE(m_Name, " peak descriptor pool count: ", m_PeakPoolCount);
 }
 
+
+static size_t ComputeDescriptorDataHash(VkDescriptorSetLayout SetLayout, const void* pData, size_t DataSize)
+{
+    auto        Hash  = ComputeHash(SetLayout, DataSize);
+    const auto* pByte = reinterpret_cast<const Uint8*>(pData);
+    for (; DataSize >= sizeof(Uint64); DataSize -= sizeof(Uint64), pByte += sizeof(Uint64))
+    {
+        Uint64 Word;
+        memcpy(&Word, pByte, sizeof(Word));
+        HashCombine(Hash, Word);
+    }
+    for (; DataSize > 0; --DataSize, ++pByte)
+        HashCombine(Hash, *pByte);
+    return Hash;
+}
+
+VkDescriptorSet DynamicDescriptorSetCache::Find(VkDescriptorSetLayout SetLayout, const void* pData, size_t DataSize, size_t& Hash)
+{
+    Hash       = ComputeDescriptorDataHash(SetLayout, pData, DataSize);
+    auto Range = m_Sets.equal_range(Hash);
+    for (auto it = Range.first; it != Range.second; ++it)
+    {
+        const auto& Cached = it->second;
+        if (Cached.SetLayout == SetLayout && Cached.DataSize == DataSize &&
+            (DataSize == 0 || memcmp(&m_Data[Cached.DataOffset], pData, DataSize) == 0))
+        {
+            ++m_Stats.Hits;
+            return Cached.Set;
+        }
+    }
+
+    ++m_Stats.Misses;
+    return VK_NULL_HANDLE;
+}
+
+void DynamicDescriptorSetCache::Add(VkDescriptorSetLayout SetLayout, const void* pData, size_t DataSize, size_t Hash, VkDescriptorSet Set)
+{
+    VERIFY_EXPR(Set != VK_NULL_HANDLE);
+    VERIFY_EXPR(Hash == ComputeDescriptorDataHash(SetLayout, pData, DataSize));
+
+    CachedSet NewSet;
+    NewSet.SetLayout  = SetLayout;
+    NewSet.DataOffset = m_Data.size();
+    NewSet.DataSize   = DataSize;
+    NewSet.Set        = Set;
+    m_Data.insert(m_Data.end(), reinterpret_cast<const Uint8*>(pData), reinterpret_cast<const Uint8*>(pData) + DataSize);
+    m_Sets.emplace(Hash, NewSet);
+}
+
+void DynamicDescriptorSetCache::Clear()
+{
+    // m_Data keeps its capacity, so the next command buffer does not need to reallocate it
+    m_Sets.clear();
+    m_Data.clear();
+}
+
 } // namespace Diligent
@@ -264,15 +264,21 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
     TDeviceContextBase::SetPipelineState(pPipelineStateVk, 0 /*Dummy*/);
     EnsureVkCmdBuffer();
 
+    // If the pipeline is being created asynchronously, the Vulkan pipeline
+    // is bound by the first draw or dispatch command after it becomes ready
+    auto vkPipeline                = pPipelineStateVk->GetVkPipeline();
+    m_State.PendingPipelineState  = vkPipeline == VK_NULL_HANDLE;
+    m_State.FallbackPipelineBound = false;
+
     if (PSODesc.IsComputePipeline)
     {
-        auto vkPipeline = pPipelineStateVk->GetVkPipeline();
-        m_CommandBuffer.BindComputePipeline(vkPipeline);
+        if (vkPipeline != VK_NULL_HANDLE)
+            m_CommandBuffer.BindComputePipeline(vkPipeline);
     }
     else
     {
-        auto vkPipeline = pPipelineStateVk->GetVkPipeline();
-        m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
+        if (vkPipeline != VK_NULL_HANDLE)
+            m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
 
         if (CommitStates)
         {
@@ -289,6 +295,45 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
     }
 
     m_DescrSetBindInfo.Reset();
+
+    // Pipelines that only use the bindless resource table have no resources to commit
+    pPipelineStateVk->GetPipelineLayout().BindStandaloneBindlessResourceTable(
+        m_CommandBuffer, PSODesc.IsComputePipeline ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS);
+}
+
+bool DeviceContextVkImpl::CommitPendingPipelineState()
+{
+    VERIFY_EXPR(m_State.PendingPipelineState && m_pPipelineState);
+
+    const PipelineStateVkImpl* pPSOToBind = nullptr;
+    switch (m_pPipelineState->GetStatus())
+    {
+        case PIPELINE_STATE_STATUS_READY:
+            pPSOToBind                   = m_pPipelineState;
+            m_State.PendingPipelineState = false;
+            break;
+
+        case PIPELINE_STATE_STATUS_COMPILING:
+            if (m_State.FallbackPipelineBound)
+                return true;
+
+            pPSOToBind = m_pPipelineState->GetFallbackPSO();
+            if (pPSOToBind == nullptr || pPSOToBind->GetStatus() != PIPELINE_STATE_STATUS_READY)
+                return false;
+
+            m_State.FallbackPipelineBound = true;
+            break;
+
+        default:
+            return false;
+    }
+
+    if (pPSOToBind->GetDesc().IsComputePipeline)
+        m_CommandBuffer.BindComputePipeline(pPSOToBind->GetVkPipeline());
+    else
+        m_CommandBuffer.BindGraphicsPipeline(pPSOToBind->GetVkPipeline());
+
+    return true;
 }
 
 void DeviceContextVkImpl::TransitionShaderResources(IPipelineState* pPipelineState, IShaderResourceBinding* pShaderResourceBinding)
@@ -506,6 +551,9 @@ void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
     if (!DvpVerifyDrawArguments(Attribs))
         return;
 
+    if (m_State.PendingPipelineState && !CommitPendingPipelineState())
+        return;
+
     PrepareForDraw(Attribs.Flags);
 
     m_CommandBuffer.Draw(Attribs.NumVertices, Attribs.NumInstances, Attribs.StartVertexLocation, Attribs.FirstInstanceLocation);
@@ -517,6 +565,9 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
     if (!DvpVerifyDrawIndexedArguments(Attribs))
         return;
 
+    if (m_State.PendingPipelineState && !CommitPendingPipelineState())
+        return;
+
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
     m_CommandBuffer.DrawIndexed(Attribs.NumIndices, Attribs.NumInstances, Attribs.FirstIndexLocation, Attribs.BaseVertex, Attribs.FirstInstanceLocation);
@@ -528,6 +579,9 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuff
     if (!DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer))
         return;
 
+    if (m_State.PendingPipelineState && !CommitPendingPipelineState())
+        return;
+
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
     BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectDrawAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode);
@@ -543,6 +597,9 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
     if (!DvpVerifyDrawIndexedIndirectArguments(Attribs, pAttribsBuffer))
         return;
 
+    if (m_State.PendingPipelineState && !CommitPendingPipelineState())
+        return;
+
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
     BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectDrawAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode);
@@ -585,6 +642,9 @@ void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
     if (!DvpVerifyDispatchArguments(Attribs))
         return;
 
+    if (m_State.PendingPipelineState && !CommitPendingPipelineState())
+        return;
+
     PrepareForDispatchCompute();
     m_CommandBuffer.Dispatch(Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ);
     ++m_State.NumCommands;
@@ -595,6 +655,9 @@ void DeviceContextVkImpl::DispatchComputeIndirect(const DispatchComputeIndirectA
     if (!DvpVerifyDispatchIndirectArguments(Attribs, pAttribsBuffer))
         return;
 
+    if (m_State.PendingPipelineState && !CommitPendingPipelineState())
+        return;
+
     PrepareForDispatchCompute();
 
     auto* pBufferVk = ValidatedCast<BufferVkImpl>(pAttribsBuffer);
@@ -857,6 +920,7 @@ void DeviceContextVkImpl::FinishFrame()
     // Dynamic descriptor set allocator returns all allocated pools to the global dynamic descriptor pool manager.
     // Note: as global pool manager is hosted by the render device, the allocator can
     // be destroyed before the pools are actually returned to the global pool manager.
+    m_DynamicDescrSetCache.Clear();
     m_DynamicDescrSetAllocator.ReleasePools(m_SubmittedBuffersCmdQueueMask);
 
     EndFrame();
@@ -934,6 +998,8 @@ void DeviceContextVkImpl::Flush()
     m_DescrSetBindInfo.Reset();
     m_CommandBuffer.Reset();
     m_pPipelineState = nullptr;
+    // Objects referenced by cached descriptor sets may be destroyed once the command buffer is executed
+    m_DynamicDescrSetCache.Clear();
 }
 
 void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartSlot,
@@ -1955,6 +2021,8 @@ void DeviceContextVkImpl::FinishCommandList(class ICommandList** ppCommandList)
     m_State = ContextState{};
     m_DescrSetBindInfo.Reset();
     m_pPipelineState = nullptr;
+    // Objects referenced by cached descriptor sets may be destroyed once the command list is executed
+    m_DynamicDescrSetCache.Clear();
 
     InvalidateState();
 }
@@ -134,7 +134,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
             reinterpret_cast<VkAllocationCallbacks*>(EngineCI.pVkAllocator));
 
         auto        vkDevice               = Instance->SelectPhysicalDevice();
-        auto        PhysicalDevice         = VulkanUtilities::VulkanPhysicalDevice::Create(vkDevice);
+        auto        PhysicalDevice         = VulkanUtilities::VulkanPhysicalDevice::Create(vkDevice, *Instance);
         const auto& PhysicalDeviceFeatures = PhysicalDevice->GetFeatures();
 
         // If an implementation exposes any queue family that supports graphics operations,
@@ -190,6 +190,46 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& _E
                 VK_KHR_SWAPCHAIN_EXTENSION_NAME,
                 VK_KHR_MAINTENANCE1_EXTENSION_NAME // To allow negative viewport height
             };
+        // Descriptor update templates are used to write dynamic descriptor sets, when available
+        if (PhysicalDevice->IsExtensionSupported(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+        {
+            DeviceExtensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+            // Push descriptors are used for small dynamic descriptor sets, when available
+            if (PhysicalDevice->IsExtensionSupported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+                DeviceExtensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+        }
+        // Descriptor indexing is used by the device-wide bindless resource table, when requested
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT DescriptorIndexingFeatures = {};
+        if (EngineCI.EnableBindlessResources)
+        {
+            if (BindlessResourceTableVk::IsSupported(*PhysicalDevice))
+            {
+                DeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+                DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+
+                const auto& SupportedFeatures = PhysicalDevice->GetDescriptorIndexingFeatures();
+
+                DescriptorIndexingFeatures.sType                                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+                DescriptorIndexingFeatures.pNext                                         = nullptr;
+                DescriptorIndexingFeatures.runtimeDescriptorArray                        = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingPartiallyBound               = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending     = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
+                DescriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+                // Non-uniform indexing is optional. Without it, shaders may only index the table with dynamically uniform values.
+                DescriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing  = SupportedFeatures.shaderSampledImageArrayNonUniformIndexing;
+                DescriptorIndexingFeatures.shaderStorageBufferArrayNonUniformIndexing = SupportedFeatures.shaderStorageBufferArrayNonUniformIndexing;
+
+                DeviceCreateInfo.pNext = &DescriptorIndexingFeatures;
+            }
+            else
+            {
+                LOG_WARNING_MESSAGE("Bindless resources are requested, but ", VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,
+                                    " extension or required descriptor indexing features are not supported by the device. "
+                                    "Bindless resource table will be disabled.");
+            }
+        }
+
         DeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
         DeviceCreateInfo.enabledExtensionCount   = static_cast<uint32_t>(DeviceExtensions.size());
 
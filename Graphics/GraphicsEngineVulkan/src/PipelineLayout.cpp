@@ -181,7 +181,7 @@ void PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::Finalize(c
 
     SetLayoutCI.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     SetLayoutCI.pNext        = nullptr;
-    SetLayoutCI.flags        = 0;
+    SetLayoutCI.flags        = IsPushDescriptorSet ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
     SetLayoutCI.bindingCount = NumLayoutBindings;
     SetLayoutCI.pBindings    = pBindings;
     VkLayout                 = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
@@ -213,7 +213,8 @@ bool PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::operator==
     if (TotalDescriptors      != rhs.TotalDescriptors      ||
         SetIndex              != rhs.SetIndex              ||
         NumDynamicDescriptors != rhs.NumDynamicDescriptors ||
-        NumLayoutBindings     != rhs.NumLayoutBindings)
+        NumLayoutBindings     != rhs.NumLayoutBindings     ||
+        IsPushDescriptorSet   != rhs.IsPushDescriptorSet)
         return false;
     // clang-format on
 
@@ -239,7 +240,7 @@ bool PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::operator==
 
 size_t PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::GetHash() const
 {
-    size_t Hash = ComputeHash(SetIndex, NumLayoutBindings, TotalDescriptors, NumDynamicDescriptors);
+    size_t Hash = ComputeHash(SetIndex, NumLayoutBindings, TotalDescriptors, NumDynamicDescriptors, IsPushDescriptorSet);
     for (uint32_t b = 0; b < NumLayoutBindings; ++b)
     {
         const auto& B = pBindings[b];
@@ -249,7 +250,7 @@ size_t PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::GetHash(
     return Hash;
 }
 
-void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice)
 {
     size_t TotalBindings = 0;
     for (const auto& Layout : m_DescriptorSetLayouts)
@@ -259,7 +260,20 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
     m_LayoutBindings.resize(TotalBindings);
     size_t BindingOffset = 0;
 
-    std::array<VkDescriptorSetLayout, 2> ActiveDescrSetLayouts = {};
+    // Dynamic resources are pushed directly into the command buffer when the set fits the maxPushDescriptors
+    // limit reported by the device.
+    // Push descriptor set layouts must not contain dynamic uniform or storage buffers (13.2.1), which is how
+    // all buffers are bound in this back-end, so only sets without such descriptors qualify.
+    // The bindless table set is bound together with the engine-managed sets in one contiguous range,
+    // which is not possible when the dynamic set is pushed, so push descriptors are not used in this case.
+    auto& DynamicSet               = GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    DynamicSet.IsPushDescriptorSet = DynamicSet.SetIndex >= 0 &&
+        m_BindlessSetIndex < 0 &&
+        LogicalDevice.IsPushDescriptorSupported() &&
+        DynamicSet.NumDynamicDescriptors == 0 &&
+        DynamicSet.TotalDescriptors <= PhysicalDevice.GetPushDescriptorProperties().maxPushDescriptors;
+
+    std::array<VkDescriptorSetLayout, 3> ActiveDescrSetLayouts = {};
     for (auto& Layout : m_DescriptorSetLayouts)
     {
         if (Layout.SetIndex >= 0)
@@ -277,12 +291,20 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
                 m_ActiveSets == 2 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] != VK_NULL_HANDLE);
     // clang-format on
 
+    Uint32 SetLayoutCount = m_ActiveSets;
+    if (m_BindlessSetIndex >= 0)
+    {
+        VERIFY_EXPR(m_pBindlessTable != nullptr && m_BindlessSetIndex == m_ActiveSets);
+        ActiveDescrSetLayouts[m_BindlessSetIndex] = m_pBindlessTable->GetVkDescriptorSetLayout();
+        ++SetLayoutCount;
+    }
+
     VkPipelineLayoutCreateInfo PipelineLayoutCI = {};
 
     PipelineLayoutCI.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     PipelineLayoutCI.pNext                  = nullptr;
     PipelineLayoutCI.flags                  = 0; // reserved for future use
-    PipelineLayoutCI.setLayoutCount         = m_ActiveSets;
+    PipelineLayoutCI.setLayoutCount         = SetLayoutCount;
     PipelineLayoutCI.pSetLayouts            = PipelineLayoutCI.setLayoutCount != 0 ? ActiveDescrSetLayouts.data() : nullptr;
     PipelineLayoutCI.pushConstantRangeCount = 0;
     PipelineLayoutCI.pPushConstantRanges    = nullptr;
@@ -310,7 +332,7 @@ bool PipelineLayout::DescriptorSetLayoutManager::operator==(const DescriptorSetL
     // defined descriptor set layouts for sets zero through N, and if they were created with identical push
     // constant ranges (13.2.2)
 
-    if (m_ActiveSets != rhs.m_ActiveSets)
+    if (m_ActiveSets != rhs.m_ActiveSets || m_BindlessSetIndex != rhs.m_BindlessSetIndex)
         return false;
 
     for (size_t i = 0; i < m_DescriptorSetLayouts.size(); ++i)
@@ -322,7 +344,7 @@ bool PipelineLayout::DescriptorSetLayoutManager::operator==(const DescriptorSetL
 
 size_t PipelineLayout::DescriptorSetLayoutManager::GetHash() const
 {
-    size_t Hash = 0;
+    size_t Hash = ComputeHash(m_BindlessSetIndex);
     for (const auto& SetLayout : m_DescriptorSetLayouts)
         HashCombine(Hash, SetLayout.GetHash());
 
@@ -340,6 +362,7 @@ void PipelineLayout::DescriptorSetLayoutManager::AllocateResourceSlot(const SPIR
     auto& DescrSet = GetDescriptorSet(VariableType);
     if (DescrSet.SetIndex < 0)
     {
+        VERIFY(m_BindlessSetIndex < 0, "Bindless resource table set has already been allocated. All engine-managed sets must be allocated before the table set.");
         DescrSet.SetIndex = m_ActiveSets++;
     }
     DescriptorSet = DescrSet.SetIndex;
@@ -370,6 +393,18 @@ void PipelineLayout::DescriptorSetLayoutManager::AllocateResourceSlot(const SPIR
     DescrSet.AddBinding(VkBinding, m_MemAllocator);
 }
 
+Uint32 PipelineLayout::DescriptorSetLayoutManager::AllocateBindlessResourceSlot(const BindlessResourceTableVk* pBindlessTable)
+{
+    VERIFY_EXPR(pBindlessTable != nullptr);
+    VERIFY(m_pBindlessTable == nullptr || m_pBindlessTable == pBindlessTable, "Only one bindless resource table is expected");
+    if (m_BindlessSetIndex < 0)
+    {
+        m_pBindlessTable   = pBindlessTable;
+        m_BindlessSetIndex = static_cast<int8_t>(m_ActiveSets);
+    }
+    return static_cast<Uint32>(m_BindlessSetIndex);
+}
+
 PipelineLayout::PipelineLayout() :
     m_MemAllocator{GetRawAllocator()},
     m_LayoutMgr{m_MemAllocator}
@@ -399,9 +434,40 @@ void PipelineLayout::AllocateResourceSlot(const SPIRVShaderResourceAttribs& ResA
     SPIRV[ResAttribs.DescriptorSetDecorationOffset] = DescriptorSet;
 }
 
-void PipelineLayout::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+void PipelineLayout::AllocateBindlessResourceSlot(const BindlessResourceTableVk*    pBindlessTable,
+                                                  const SPIRVShaderResourceAttribs& ResAttribs,
+                                                  std::vector<uint32_t>&            SPIRV)
+{
+    if (pBindlessTable == nullptr)
+    {
+        LOG_ERROR_AND_THROW("Shader resource '", ResAttribs.Name,
+                            "' is a runtime-sized array, which requires the bindless resource table. "
+                            "Set EngineVkCreateInfo::EnableBindlessResources to true and make sure that the device supports descriptor indexing.");
+    }
+
+    const auto TableBinding = BindlessResourceTableVk::GetBinding(ResAttribs.Type);
+    if (TableBinding == BindlessResourceTableVk::BINDING_COUNT)
+    {
+        LOG_ERROR_AND_THROW("Runtime-sized array '", ResAttribs.Name, "' has resource type that is not supported by the bindless resource table. "
+                            "Only separate images, storage buffers and separate samplers can be runtime-sized arrays.");
+    }
+
+    SPIRV[ResAttribs.BindingDecorationOffset]       = static_cast<Uint32>(TableBinding);
+    SPIRV[ResAttribs.DescriptorSetDecorationOffset] = m_LayoutMgr.AllocateBindlessResourceSlot(pBindlessTable);
+}
+
+void PipelineLayout::BindStandaloneBindlessResourceTable(VulkanUtilities::VulkanCommandBuffer& CmdBuffer, VkPipelineBindPoint BindPoint) const
+{
+    if (m_LayoutMgr.GetBindlessSetIndex() != 0)
+        return;
+
+    VkDescriptorSet vkTableSet = m_LayoutMgr.GetBindlessTable()->GetVkDescriptorSet();
+    CmdBuffer.BindDescriptorSets(BindPoint, m_LayoutMgr.GetVkPipelineLayout(), 0, 1, &vkTableSet, 0, nullptr);
+}
+
+void PipelineLayout::Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice)
 {
-    m_LayoutMgr.Finalize(LogicalDevice);
+    m_LayoutMgr.Finalize(LogicalDevice, PhysicalDevice);
 }
 
 std::array<Uint32, 2> PipelineLayout::GetDescriptorSetSizes(Uint32& NumSets) const
@@ -426,10 +492,11 @@ std::array<Uint32, 2> PipelineLayout::GetDescriptorSetSizes(Uint32& NumSets) con
     return SetSizes;
 }
 
-void PipelineLayout::InitResourceCache(RenderDeviceVkImpl*    pDeviceVkImpl,
-                                       ShaderResourceCacheVk& ResourceCache,
-                                       IMemoryAllocator&      CacheMemAllocator,
-                                       const char*            DbgPipelineName) const
+void PipelineLayout::InitResourceCache(RenderDeviceVkImpl*      pDeviceVkImpl,
+                                       ShaderResourceCacheVk&   ResourceCache,
+                                       IMemoryAllocator&        CacheMemAllocator,
+                                       const char*              DbgPipelineName,
+                                       DescriptorSetAllocation* pStaticAndMutSetAllocation) const
 {
     Uint32 NumSets  = 0;
     auto   SetSizes = GetDescriptorSetSizes(NumSets);
@@ -439,7 +506,12 @@ void PipelineLayout::InitResourceCache(RenderDeviceVkImpl*    pDeviceVkImpl,
     ResourceCache.InitializeSets(CacheMemAllocator, NumSets, SetSizes.data());
 
     const auto& StaticAndMutSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
-    if (StaticAndMutSet.SetIndex >= 0)
+    if (StaticAndMutSet.SetIndex >= 0 && pStaticAndMutSetAllocation != nullptr && *pStaticAndMutSetAllocation)
+    {
+        // The set has been allocated by the caller
+        ResourceCache.GetDescriptorSet(StaticAndMutSet.SetIndex).AssignDescriptorSetAllocation(std::move(*pStaticAndMutSetAllocation));
+    }
+    else if (StaticAndMutSet.SetIndex >= 0)
     {
         const char* DescrSetName = "Static/Mutable Descriptor Set";
 #ifdef DEVELOPMENT
@@ -461,6 +533,7 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkIm
 #ifdef _DEBUG
     BindInfo.vkSets.clear();
 #endif
+    BindInfo.PushDescriptorTemplate = VK_NULL_HANDLE;
 
     // Do not use vector::resize for BindInfo.vkSets and BindInfo.DynamicOffsets as this
     // causes unnecessary work to zero-initialize new elements
@@ -469,26 +542,61 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkIm
            "Static and mutable variables are expected to share the same descriptor set");
     Uint32 TotalDynamicDescriptors = 0;
 
-    BindInfo.SetCout = 0;
-    for (SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE; VarType <= SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC; VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VarType + 1))
+    BindInfo.FirstSet = 0;
+    BindInfo.SetCout  = 0;
+    if (m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).IsPushDescriptorSet)
+    {
+        // Dynamic resources are pushed into the command buffer by PushDynamicDescriptors(), so only
+        // the static/mutable set needs to be bound
+        VERIFY(VkDynamicDescrSet == VK_NULL_HANDLE, "Push descriptor set must not be allocated");
+        VERIFY_EXPR(m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).NumDynamicDescriptors == 0);
+        const auto& StaticAndMutSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
+        if (StaticAndMutSet.SetIndex >= 0)
+        {
+            BindInfo.FirstSet = static_cast<Uint32>(StaticAndMutSet.SetIndex);
+            BindInfo.SetCout  = 1;
+            if (BindInfo.vkSets.empty())
+                BindInfo.vkSets.resize(1);
+            BindInfo.vkSets[0] = ResourceCache.GetDescriptorSet(StaticAndMutSet.SetIndex).GetVkDescriptorSet();
+            VERIFY(BindInfo.vkSets[0] != VK_NULL_HANDLE, "Descriptor set must not be null");
+        }
+        TotalDynamicDescriptors = StaticAndMutSet.NumDynamicDescriptors;
+    }
+    else
     {
-        const auto& Set = m_LayoutMgr.GetDescriptorSet(VarType);
-        if (Set.SetIndex >= 0)
+        for (SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE; VarType <= SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC; VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VarType + 1))
         {
-            BindInfo.SetCout = std::max(BindInfo.SetCout, static_cast<Uint32>(Set.SetIndex + 1));
-            if (BindInfo.SetCout > BindInfo.vkSets.size())
-                BindInfo.vkSets.resize(BindInfo.SetCout);
-            VERIFY_EXPR(BindInfo.vkSets[Set.SetIndex] == VK_NULL_HANDLE);
-            if (VarType == SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
-                BindInfo.vkSets[Set.SetIndex] = ResourceCache.GetDescriptorSet(Set.SetIndex).GetVkDescriptorSet();
-            else
+            const auto& Set = m_LayoutMgr.GetDescriptorSet(VarType);
+            if (Set.SetIndex >= 0)
             {
-                VERIFY_EXPR(ResourceCache.GetDescriptorSet(Set.SetIndex).GetVkDescriptorSet() == VK_NULL_HANDLE);
-                BindInfo.vkSets[Set.SetIndex] = VkDynamicDescrSet;
+                BindInfo.SetCout = std::max(BindInfo.SetCout, static_cast<Uint32>(Set.SetIndex + 1));
+                if (BindInfo.SetCout > BindInfo.vkSets.size())
+                    BindInfo.vkSets.resize(BindInfo.SetCout);
+                VERIFY_EXPR(BindInfo.vkSets[Set.SetIndex] == VK_NULL_HANDLE);
+                if (VarType == SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
+                    BindInfo.vkSets[Set.SetIndex] = ResourceCache.GetDescriptorSet(Set.SetIndex).GetVkDescriptorSet();
+                else
+                {
+                    VERIFY_EXPR(ResourceCache.GetDescriptorSet(Set.SetIndex).GetVkDescriptorSet() == VK_NULL_HANDLE);
+                    BindInfo.vkSets[Set.SetIndex] = VkDynamicDescrSet;
+                }
+                VERIFY(BindInfo.vkSets[Set.SetIndex] != VK_NULL_HANDLE, "Descriptor set must not be null");
             }
-            VERIFY(BindInfo.vkSets[Set.SetIndex] != VK_NULL_HANDLE, "Descriptor set must not be null");
+            TotalDynamicDescriptors += Set.NumDynamicDescriptors;
         }
-        TotalDynamicDescriptors += Set.NumDynamicDescriptors;
+    }
+
+    const auto BindlessSetIndex = m_LayoutMgr.GetBindlessSetIndex();
+    if (BindlessSetIndex >= 0)
+    {
+        // The table set follows the engine-managed sets and is bound by the same command
+        VERIFY(!m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC).IsPushDescriptorSet,
+               "Push descriptors must not be used when the layout includes the bindless resource table");
+        VERIFY_EXPR(BindInfo.FirstSet == 0 && BindInfo.SetCout == static_cast<Uint32>(BindlessSetIndex));
+        BindInfo.SetCout = static_cast<Uint32>(BindlessSetIndex) + 1;
+        if (BindInfo.SetCout > BindInfo.vkSets.size())
+            BindInfo.vkSets.resize(BindInfo.SetCout);
+        BindInfo.vkSets[BindlessSetIndex] = m_LayoutMgr.GetBindlessTable()->GetVkDescriptorSet();
     }
 
 #ifdef _DEBUG
@@ -506,13 +614,13 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkIm
 #endif
     BindInfo.DynamicBuffersPresent = ResourceCache.GetNumDynamicBuffers() > 0;
 
-    if (TotalDynamicDescriptors == 0)
+    if (TotalDynamicDescriptors == 0 && BindInfo.SetCout != 0)
     {
         // There are no dynamic descriptors, so we can bind descriptor sets right now
         auto& CmdBuffer = pCtxVkImpl->GetCommandBuffer();
         CmdBuffer.BindDescriptorSets(BindInfo.BindPoint,
                                      m_LayoutMgr.GetVkPipelineLayout(),
-                                     0, // First set
+                                     BindInfo.FirstSet,
                                      BindInfo.SetCout,
                                      BindInfo.vkSets.data(), // BindInfo.vkSets is never empty
                                      0,
@@ -522,4 +630,34 @@ void PipelineLayout::PrepareDescriptorSets(DeviceContextVkImpl*         pCtxVkIm
     BindInfo.DynamicDescriptorsBound = false;
 }
 
+void PipelineLayout::PushDynamicDescriptors(DeviceContextVkImpl*                pCtxVkImpl,
+                                            VkDescriptorUpdateTemplate          PushTemplate,
+                                            const DescriptorUpdateTemplateData* pData,
+                                            Uint32                              NumDescriptors,
+                                            DescriptorSetBindInfo&              BindInfo) const
+{
+    const auto& DynamicSet = m_LayoutMgr.GetDescriptorSet(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    VERIFY_EXPR(DynamicSet.IsPushDescriptorSet && DynamicSet.SetIndex >= 0);
+    VERIFY_EXPR(PushTemplate != VK_NULL_HANDLE);
+
+    if (BindInfo.DynamicOffsetCount != 0 && !BindInfo.DynamicDescriptorsBound && BindInfo.PushDescriptorTemplate == VK_NULL_HANDLE)
+    {
+        // The static/mutable set has dynamic buffers and will only be bound by the next draw or dispatch command.
+        // Keep a copy of the descriptors as the source array may be overwritten before that.
+        BindInfo.PushDescriptorTemplate = PushTemplate;
+        BindInfo.PushDescriptorData.assign(pData, pData + NumDescriptors);
+        return;
+    }
+
+    // The static/mutable set, if any, has already been bound
+    auto&       CmdBuffer     = pCtxVkImpl->GetCommandBuffer();
+    const auto& LogicalDevice = ValidatedCast<RenderDeviceVkImpl>(pCtxVkImpl->GetDevice())->GetLogicalDevice();
+    LogicalDevice.CmdPushDescriptorSetWithTemplate(CmdBuffer.GetVkCmdBuffer(),
+                                                   PushTemplate,
+                                                   m_LayoutMgr.GetVkPipelineLayout(),
+                                                   static_cast<Uint32>(DynamicSet.SetIndex),
+                                                   pData);
+    BindInfo.PushDescriptorTemplate = VK_NULL_HANDLE;
+}
+
 } // namespace Diligent
@@ -35,7 +35,7 @@
 #include "ShaderResourceBindingVkImpl.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
-#include "spirv-tools/optimizer.hpp"
+#include "SPIRVUtils.hpp"
 
 namespace Diligent
 {
@@ -133,25 +133,11 @@ VkRenderPassCreateInfo PipelineStateVkImpl::GetRenderPassCreateInfo(
     return RenderPassCI;
 }
 
-static std::vector<uint32_t> StripReflection(const std::vector<uint32_t>& OriginalSPIRV)
-{
-    std::vector<uint32_t> StrippedSPIRV;
-    spvtools::Optimizer   SpirvOptimizer(SPV_ENV_VULKAN_1_0);
-    // Decorations defined in SPV_GOOGLE_hlsl_functionality1 are the only instructions
-    // removed by strip-reflect-info pass. SPIRV offsets become INVALID after this operation.
-    SpirvOptimizer.RegisterPass(spvtools::CreateStripReflectInfoPass());
-    auto res = SpirvOptimizer.Run(OriginalSPIRV.data(), OriginalSPIRV.size(), &StrippedSPIRV);
-    if (!res)
-    {
-        // Optimized SPIRV may be invalid
-        StrippedSPIRV.clear();
-    }
-    return StrippedSPIRV;
-}
-
 PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
                                          RenderDeviceVkImpl*      pDeviceVk,
-                                         const PipelineStateDesc& PipelineDesc) :
+                                         const PipelineStateDesc& PipelineDesc,
+                                         bool                     CreateAsync,
+                                         PipelineStateVkImpl*     pFallbackPSO) :
     TPipelineStateBase{pRefCounters, pDeviceVk, PipelineDesc},
     m_SRBMemAllocator{GetRawAllocator()}
 {
@@ -166,6 +152,7 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
     m_ShaderResourceLayouts = ALLOCATE(ShaderResLayoutAllocator, "Raw memory for ShaderResourceLayoutVk", ShaderResourceLayoutVk, m_NumShaders * 2);
     m_StaticResCaches       = ALLOCATE(GetRawAllocator(), "Raw memory for ShaderResourceCacheVk", ShaderResourceCacheVk, m_NumShaders);
     m_StaticVarsMgrs        = ALLOCATE(GetRawAllocator(), "Raw memory for ShaderVariableManagerVk", ShaderVariableManagerVk, m_NumShaders);
+    m_VarIndexMaps.resize(m_NumShaders * 2);
     for (Uint32 s = 0; s < m_NumShaders; ++s)
     {
         new (m_ShaderResourceLayouts + s) ShaderResourceLayoutVk(LogicalDevice);
@@ -181,11 +168,19 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
         auto* pStaticResCache  = new (m_StaticResCaches + s) ShaderResourceCacheVk(ShaderResourceCacheVk::DbgCacheContentType::StaticShaderResources);
         pStaticResLayout->InitializeStaticResourceLayout(ShaderResources[s], ShaderResLayoutAllocator, m_Desc.ResourceLayout, m_StaticResCaches[s]);
 
-        new (m_StaticVarsMgrs + s) ShaderVariableManagerVk(*this, *pStaticResLayout, GetRawAllocator(), nullptr, 0, *pStaticResCache);
+        m_VarIndexMaps[m_NumShaders + s] = ShaderVariableManagerVk::CreateVariableIndexMap(*pStaticResLayout, nullptr, 0);
+        new (m_StaticVarsMgrs + s) ShaderVariableManagerVk(*this, *pStaticResLayout, m_VarIndexMaps[m_NumShaders + s], GetRawAllocator(), nullptr, 0, *pStaticResCache);
     }
     ShaderResourceLayoutVk::Initialize(pDeviceVk, m_NumShaders, m_ShaderResourceLayouts, ShaderResources.data(), GetRawAllocator(),
                                        m_Desc.ResourceLayout, ShaderSPIRVs.data(), m_PipelineLayout);
-    m_PipelineLayout.Finalize(LogicalDevice);
+    m_PipelineLayout.Finalize(LogicalDevice, pDeviceVk->GetPhysicalDevice());
+
+    // Variable names are hashed once here rather than every time a variable is looked up in an SRB
+    for (Uint32 s = 0; s < m_NumShaders; ++s)
+    {
+        const SHADER_RESOURCE_VARIABLE_TYPE AllowedVarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
+        m_VarIndexMaps[s] = ShaderVariableManagerVk::CreateVariableIndexMap(m_ShaderResourceLayouts[s], AllowedVarTypes, _countof(AllowedVarTypes));
+    }
 
     if (m_Desc.SRBAllocationGranularity > 1)
     {
@@ -205,6 +200,150 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
         m_SRBMemAllocator.Initialize(m_Desc.SRBAllocationGranularity, m_NumShaders, ShaderVariableDataSizes.data(), 1, &CacheMemorySize);
     }
 
+    if (!m_Desc.IsComputePipeline)
+    {
+        const auto& GraphicsPipeline = m_Desc.GraphicsPipeline;
+
+        RenderPassCache::RenderPassCacheKey Key{
+            GraphicsPipeline.NumRenderTargets,
+            GraphicsPipeline.SmplDesc.Count,
+            GraphicsPipeline.RTVFormats,
+            GraphicsPipeline.DSVFormat};
+        m_RenderPass = pDeviceVk->GetRenderPassCache().GetRenderPass(Key);
+    }
+
+    m_HasStaticResources    = false;
+    m_HasNonStaticResources = false;
+    for (Uint32 s = 0; s < m_NumShaders; ++s)
+    {
+        const auto& Layout = m_ShaderResourceLayouts[s];
+        if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_STATIC) != 0)
+            m_HasStaticResources = true;
+
+        if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE) != 0 ||
+            Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
+            m_HasNonStaticResources = true;
+    }
+
+    m_ShaderResourceLayoutHash = m_PipelineLayout.GetHash();
+
+    CreateDynamicDescrSetUpdateTemplate();
+
+    if (!CreateAsync)
+    {
+        try
+        {
+            CreateVkPipeline(ShaderSPIRVs);
+        }
+        catch (...)
+        {
+            // The destructor will not be called, so shader modules must be returned to the cache here
+            ReleaseShaderModules();
+            throw;
+        }
+        return;
+    }
+
+    if (pFallbackPSO != nullptr)
+    {
+        if (!IsValidFallbackPSO(*pFallbackPSO))
+        {
+            LOG_ERROR_MESSAGE("Fallback pipeline state '", pFallbackPSO->GetDesc().Name, "' is not compatible with pipeline state '",
+                              m_Desc.Name, "' and will not be used. The fallback pipeline must be of the same type, use the same render pass, "
+                              "input layout and primitive topology, and have compatible resource layout.");
+        }
+        else
+        {
+            m_pFallbackPSO = pFallbackPSO;
+        }
+    }
+
+    // Shader modules and the pipeline are created by a worker thread, see StartAsyncCreation().
+    // All members used by draw and dispatch commands other than the Vulkan pipeline have been
+    // initialized at this point.
+    m_Status      = PIPELINE_STATE_STATUS_COMPILING;
+    m_AsyncSPIRVs = std::move(ShaderSPIRVs);
+}
+
+void PipelineStateVkImpl::StartAsyncCreation()
+{
+    VERIFY(m_Status == PIPELINE_STATE_STATUS_COMPILING, "This pipeline state is not being created asynchronously");
+
+    // The task keeps a strong reference to the pipeline state, so releasing the last external
+    // reference while the pipeline is being created does not block: the object is destroyed
+    // by the worker thread when the task is complete.
+    RefCntAutoPtr<PipelineStateVkImpl> pThis{this};
+    m_pDevice->GetWorkerThreadPool().EnqueueTask(
+        [pThis]() mutable //
+        {
+            try
+            {
+                if (pThis->m_SimulateAsyncCreationFailure)
+                    LOG_ERROR_AND_THROW("Simulated failure");
+
+                pThis->CreateVkPipeline(pThis->m_AsyncSPIRVs);
+                pThis->m_Status = PIPELINE_STATE_STATUS_READY;
+            }
+            catch (...)
+            {
+                LOG_ERROR_MESSAGE("Failed to asynchronously create pipeline state '", pThis->m_Desc.Name, '\'');
+                pThis->m_Status = PIPELINE_STATE_STATUS_FAILED;
+            }
+            for (auto& SPIRV : pThis->m_AsyncSPIRVs)
+                std::vector<uint32_t>{}.swap(SPIRV);
+        } //
+    );
+}
+
+static bool IsSameInputLayout(const InputLayoutDesc& Layout0, const InputLayoutDesc& Layout1)
+{
+    if (Layout0.NumElements != Layout1.NumElements)
+        return false;
+
+    for (Uint32 i = 0; i < Layout0.NumElements; ++i)
+    {
+        // Vulkan identifies vertex attributes by location, so HLSL semantics are not compared.
+        // Offsets and strides have been resolved by the base class at this point.
+        const auto& Elem0 = Layout0.LayoutElements[i];
+        const auto& Elem1 = Layout1.LayoutElements[i];
+        if (Elem0.InputIndex != Elem1.InputIndex ||
+            Elem0.BufferSlot != Elem1.BufferSlot ||
+            Elem0.NumComponents != Elem1.NumComponents ||
+            Elem0.ValueType != Elem1.ValueType ||
+            Elem0.IsNormalized != Elem1.IsNormalized ||
+            Elem0.RelativeOffset != Elem1.RelativeOffset ||
+            Elem0.Stride != Elem1.Stride ||
+            Elem0.Frequency != Elem1.Frequency ||
+            Elem0.InstanceDataStepRate != Elem1.InstanceDataStepRate)
+            return false;
+    }
+
+    return true;
+}
+
+bool PipelineStateVkImpl::IsValidFallbackPSO(const PipelineStateVkImpl& FallbackPSO) const
+{
+    const auto& FallbackDesc = FallbackPSO.GetDesc();
+    if (FallbackDesc.IsComputePipeline != m_Desc.IsComputePipeline)
+        return false;
+
+    if (!m_Desc.IsComputePipeline)
+    {
+        // The fallback pipeline is bound in place of this pipeline, so it must consume the same
+        // vertex buffers and primitives and render into the same render pass.
+        if (FallbackPSO.GetVkRenderPass() != m_RenderPass ||
+            FallbackDesc.GraphicsPipeline.PrimitiveTopology != m_Desc.GraphicsPipeline.PrimitiveTopology ||
+            !IsSameInputLayout(FallbackDesc.GraphicsPipeline.InputLayout, m_Desc.GraphicsPipeline.InputLayout))
+            return false;
+    }
+
+    return IsCompatibleWith(&FallbackPSO);
+}
+
+void PipelineStateVkImpl::CreateVkPipeline(const std::array<std::vector<uint32_t>, MAX_SHADERS_IN_PIPELINE>& ShaderSPIRVs)
+{
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
     // Create shader modules and initialize shader stages
     std::array<VkPipelineShaderStageCreateInfo, MAX_SHADERS_IN_PIPELINE> ShaderStages = {};
     for (Uint32 s = 0; s < m_NumShaders; ++s)
@@ -229,30 +368,20 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
                 // clang-format on
         }
 
-        VkShaderModuleCreateInfo ShaderModuleCI = {};
-
-        ShaderModuleCI.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        ShaderModuleCI.pNext = nullptr;
-        ShaderModuleCI.flags = 0;
-        const auto& SPIRV    = ShaderSPIRVs[s];
+        const auto& SPIRV = ShaderSPIRVs[s];
 
         // We have to strip reflection instructions to fix the follownig validation error:
         //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
         // Optimizer also performs validation and may catch problems with the byte code.
-        auto StrippedSPIRV = StripReflection(SPIRV);
-        if (!StrippedSPIRV.empty())
-        {
-            ShaderModuleCI.codeSize = StrippedSPIRV.size() * sizeof(uint32_t);
-            ShaderModuleCI.pCode    = StrippedSPIRV.data();
-        }
-        else
+        auto StrippedSPIRV = StripReflection(SPIRV, (m_pDevice->GetSPIRVOptimizationFlags() & SPIRV_OPTIMIZATION_FLAG_STRIP_DEBUG_INFO) != 0);
+        if (StrippedSPIRV.empty())
         {
             LOG_ERROR("Failed to strip reflection information from shader '", pShaderVk->GetDesc().Name, "'. This may indicate a problem with the byte code.");
-            ShaderModuleCI.codeSize = SPIRV.size() * sizeof(uint32_t);
-            ShaderModuleCI.pCode    = SPIRV.data();
+            StrippedSPIRV = SPIRV;
         }
 
-        m_ShaderModules[s] = LogicalDevice.CreateShaderModule(ShaderModuleCI, pShaderVk->GetDesc().Name);
+        // Pipelines that use the same shader with the same resource layout share the module
+        m_ShaderModules[s] = m_pDevice->GetShaderModuleCache().GetShaderModule(StrippedSPIRV, pShaderVk->GetDesc().Name);
 
         StageCI.module              = m_ShaderModules[s];
         StageCI.pName               = pShaderVk->GetEntryPoint();
@@ -280,20 +409,12 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
         PipelineCI.stage  = ShaderStages[0];
         PipelineCI.layout = m_PipelineLayout.GetVkPipelineLayout();
 
-        m_Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, VK_NULL_HANDLE, m_Desc.Name);
+        m_Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, m_pDevice->GetVkPipelineCache(), m_Desc.Name);
     }
     else
     {
-        const auto& PhysicalDevice   = pDeviceVk->GetPhysicalDevice();
+        const auto& PhysicalDevice   = m_pDevice->GetPhysicalDevice();
         auto&       GraphicsPipeline = m_Desc.GraphicsPipeline;
-        auto&       RPCache          = pDeviceVk->GetRenderPassCache();
-
-        RenderPassCache::RenderPassCacheKey Key{
-            GraphicsPipeline.NumRenderTargets,
-            GraphicsPipeline.SmplDesc.Count,
-            GraphicsPipeline.RTVFormats,
-            GraphicsPipeline.DSVFormat};
-        m_RenderPass = RPCache.GetRenderPass(Key);
 
         VkGraphicsPipelineCreateInfo PipelineCI = {};
 
@@ -438,37 +559,82 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
         PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
         PipelineCI.basePipelineIndex  = 0;              // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-        m_Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, VK_NULL_HANDLE, m_Desc.Name);
+        m_Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, m_pDevice->GetVkPipelineCache(), m_Desc.Name);
     }
+}
 
-    m_HasStaticResources    = false;
-    m_HasNonStaticResources = false;
-    for (Uint32 s = 0; s < m_NumShaders; ++s)
+void PipelineStateVkImpl::ReleaseShaderModules()
+{
+    for (auto& ShaderModule : m_ShaderModules)
     {
-        const auto& Layout = m_ShaderResourceLayouts[s];
-        if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_STATIC) != 0)
-            m_HasStaticResources = true;
+        if (ShaderModule != VK_NULL_HANDLE)
+        {
+            m_pDevice->GetShaderModuleCache().Release(ShaderModule, m_Desc.CommandQueueMask);
+            ShaderModule = VK_NULL_HANDLE;
+        }
+    }
+}
 
-        if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE) != 0 ||
-            Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
-            m_HasNonStaticResources = true;
+void PipelineStateVkImpl::CreateDynamicDescrSetUpdateTemplate()
+{
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+
+    auto DynamicDescriptorSetVkLayout = m_PipelineLayout.GetDynamicDescriptorSetVkLayout();
+    if (DynamicDescriptorSetVkLayout == VK_NULL_HANDLE)
+        return;
+
+    // The packed descriptors are also used to look up dynamic descriptor sets in the context's cache,
+    // so the number of descriptors is needed even if update templates are not supported
+    std::vector<VkDescriptorUpdateTemplateEntry> Entries;
+    for (Uint32 s = 0; s < m_NumShaders; ++s)
+        m_ShaderResourceLayouts[s].GetDynamicResourceUpdateTemplateEntries(Entries, m_NumDynamicDescriptors);
+    if (!LogicalDevice.IsDescriptorUpdateTemplateSupported() || Entries.empty())
+        return;
+
+    VkDescriptorUpdateTemplateCreateInfo TemplateCI = {};
+    TemplateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    TemplateCI.pNext                      = nullptr;
+    TemplateCI.flags                      = 0; // reserved for future use
+    TemplateCI.descriptorUpdateEntryCount = static_cast<uint32_t>(Entries.size());
+    TemplateCI.pDescriptorUpdateEntries   = Entries.data();
+    TemplateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    TemplateCI.descriptorSetLayout        = DynamicDescriptorSetVkLayout;
+    // pipelineBindPoint, pipelineLayout and set are ignored for VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET
+    if (m_PipelineLayout.IsDynamicDescriptorSetPushed())
+    {
+        TemplateCI.templateType      = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+        TemplateCI.pipelineBindPoint = m_Desc.IsComputePipeline ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS;
+        TemplateCI.pipelineLayout    = m_PipelineLayout.GetVkPipelineLayout();
+        TemplateCI.set               = m_PipelineLayout.GetDynamicDescriptorSetIndex();
     }
 
-    m_ShaderResourceLayoutHash = m_PipelineLayout.GetHash();
+    std::string TemplateName{m_Desc.Name != nullptr ? m_Desc.Name : ""};
+    TemplateName.append(" - dynamic set update template");
+    m_DynamicDescrSetUpdateTemplate = LogicalDevice.CreateDescriptorUpdateTemplate(TemplateCI, TemplateName.c_str());
+}
+
+const DescriptorUpdateTemplateData* PipelineStateVkImpl::PackDynamicResourceDescriptors(const ShaderResourceCacheVk& ResourceCache,
+                                                                                         DeviceContextVkImpl*         pCtxVkImpl) const
+{
+    auto* const pData    = pCtxVkImpl->GetDescriptorUpdateTemplateData(m_NumDynamicDescriptors);
+    auto*       pDataEnd = pData;
+    for (Uint32 s = 0; s < m_NumShaders; ++s)
+        pDataEnd = m_ShaderResourceLayouts[s].WriteDynamicResourceDescriptors(ResourceCache, pDataEnd);
+    VERIFY_EXPR(pDataEnd == pData + m_NumDynamicDescriptors);
+    return pData;
 }
 
 PipelineStateVkImpl::~PipelineStateVkImpl()
 {
+    // The asynchronous creation task holds a strong reference, so it is complete at this point
+    VERIFY_EXPR(m_Status != PIPELINE_STATE_STATUS_COMPILING);
+
     m_pDevice->SafeReleaseDeviceObject(std::move(m_Pipeline), m_Desc.CommandQueueMask);
+    if (m_DynamicDescrSetUpdateTemplate != VK_NULL_HANDLE)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_DynamicDescrSetUpdateTemplate), m_Desc.CommandQueueMask);
     m_PipelineLayout.Release(m_pDevice, m_Desc.CommandQueueMask);
 
-    for (auto& ShaderModule : m_ShaderModules)
-    {
-        if (ShaderModule != VK_NULL_HANDLE)
-        {
-            m_pDevice->SafeReleaseDeviceObject(std::move(ShaderModule), m_Desc.CommandQueueMask);
-        }
-    }
+    ReleaseShaderModules();
 
     auto& RawAllocator = GetRawAllocator();
     for (Uint32 s = 0; s < m_NumShaders * 2; ++s)
@@ -499,6 +665,39 @@ void PipelineStateVkImpl::CreateShaderResourceBinding(IShaderResourceBinding** p
     pResBindingVk->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBinding));
 }
 
+void PipelineStateVkImpl::CreateShaderResourceBindings(Uint32 NumSRBs, IShaderResourceBinding** ppShaderResourceBindings, bool InitStaticResources)
+{
+    DEV_CHECK_ERR(NumSRBs == 0 || ppShaderResourceBindings != nullptr, "ppShaderResourceBindings must not be null");
+    if (NumSRBs == 0)
+        return;
+
+    // Allocate static/mutable descriptor sets for all SRBs at once
+    std::vector<DescriptorSetAllocation> SetAllocations;
+
+    auto vkStaticAndMutSetLayout = m_PipelineLayout.GetStaticAndMutableDescriptorSetVkLayout();
+    if (vkStaticAndMutSetLayout != VK_NULL_HANDLE)
+    {
+        const char* DescrSetName = "Static/Mutable Descriptor Set";
+#ifdef DEVELOPMENT
+        std::string _DescrSetName(m_Desc.Name);
+        _DescrSetName.append(" - static/mutable set");
+        DescrSetName = _DescrSetName.c_str();
+#endif
+        SetAllocations.resize(NumSRBs);
+        m_pDevice->AllocateDescriptorSets(~Uint64{0}, vkStaticAndMutSetLayout, NumSRBs, SetAllocations.data(), DescrSetName);
+    }
+
+    auto& SRBAllocator = m_pDevice->GetSRBAllocator();
+    for (Uint32 i = 0; i < NumSRBs; ++i)
+    {
+        auto* pSetAllocation = !SetAllocations.empty() ? &SetAllocations[i] : nullptr;
+        auto  pResBindingVk  = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingVkImpl instance", ShaderResourceBindingVkImpl)(this, false, pSetAllocation);
+        if (InitStaticResources)
+            pResBindingVk->InitializeStaticResources(nullptr);
+        pResBindingVk->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBindings + i));
+    }
+}
+
 bool PipelineStateVkImpl::IsCompatibleWith(const IPipelineState* pPSO) const
 {
     VERIFY_EXPR(pPSO != nullptr);
@@ -611,9 +810,18 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
 
     if (CommitResources)
     {
-        VkDescriptorSet DynamicDescrSet              = VK_NULL_HANDLE;
-        auto            DynamicDescriptorSetVkLayout = m_PipelineLayout.GetDynamicDescriptorSetVkLayout();
-        if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE)
+        VkDescriptorSet                     DynamicDescrSet              = VK_NULL_HANDLE;
+        const DescriptorUpdateTemplateData* pPushDescriptorData          = nullptr;
+        auto                                DynamicDescriptorSetVkLayout = m_PipelineLayout.GetDynamicDescriptorSetVkLayout();
+        if (m_PipelineLayout.IsDynamicDescriptorSetPushed())
+        {
+            // All dynamic resource descriptors are pushed directly into the command buffer. No descriptor set
+            // is allocated, and the descriptors are consumed by the command buffer at record time.
+            // The descriptors are pushed once the static/mutable set has been bound.
+            if (m_DynamicDescrSetUpdateTemplate != VK_NULL_HANDLE)
+                pPushDescriptorData = PackDynamicResourceDescriptors(ResourceCache, pCtxVkImpl);
+        }
+        else if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE)
         {
             const char* DynamicDescrSetName = "Dynamic Descriptor Set";
 #ifdef DEVELOPMENT
@@ -621,19 +829,36 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
             _DynamicDescrSetName.append(" - dynamic set");
             DynamicDescrSetName = _DynamicDescrSetName.c_str();
 #endif
-            // Allocate vulkan descriptor set for dynamic resources
-            DynamicDescrSet = pCtxVkImpl->AllocateDynamicDescriptorSet(DynamicDescriptorSetVkLayout, DynamicDescrSetName);
-            // Commit all dynamic resource descriptors
-            for (Uint32 s = 0; s < m_NumShaders; ++s)
+            // Pack the descriptors into the array the template reads from. The same array is used to find
+            // a set that has already been written with identical descriptors by this context.
+            const auto* pData    = PackDynamicResourceDescriptors(ResourceCache, pCtxVkImpl);
+            bool        IsNewSet = false;
+            // Get cached or allocate new vulkan descriptor set for dynamic resources
+            DynamicDescrSet = pCtxVkImpl->AllocateDynamicDescriptorSet(DynamicDescriptorSetVkLayout, pData, m_NumDynamicDescriptors, IsNewSet, DynamicDescrSetName);
+            if (IsNewSet)
             {
-                const auto& Layout = m_ShaderResourceLayouts[s];
-                if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
-                    Layout.CommitDynamicResources(ResourceCache, DynamicDescrSet);
+                // Commit all dynamic resource descriptors
+                if (m_DynamicDescrSetUpdateTemplate != VK_NULL_HANDLE)
+                {
+                    // Write the entire set with one call
+                    GetDevice()->GetLogicalDevice().UpdateDescriptorSetWithTemplate(DynamicDescrSet, m_DynamicDescrSetUpdateTemplate, pData);
+                }
+                else
+                {
+                    for (Uint32 s = 0; s < m_NumShaders; ++s)
+                    {
+                        const auto& Layout = m_ShaderResourceLayouts[s];
+                        if (Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC) != 0)
+                            Layout.CommitDynamicResources(ResourceCache, DynamicDescrSet);
+                    }
+                }
             }
         }
         // Prepare descriptor sets, and also bind them if there are no dynamic descriptors
         VERIFY_EXPR(pDescrSetBindInfo != nullptr);
         m_PipelineLayout.PrepareDescriptorSets(pCtxVkImpl, m_Desc.IsComputePipeline, ResourceCache, *pDescrSetBindInfo, DynamicDescrSet);
+        if (pPushDescriptorData != nullptr)
+            m_PipelineLayout.PushDynamicDescriptors(pCtxVkImpl, m_DynamicDescrSetUpdateTemplate, pPushDescriptorData, m_NumDynamicDescriptors, *pDescrSetBindInfo);
         // Dynamic descriptor sets are not released individually. Instead, all dynamic descriptor pools
         // are released at the end of the frame by DeviceContextVkImpl::FinishFrame().
     }
@@ -38,6 +38,7 @@
 #include "FenceVkImpl.hpp"
 #include "QueryVkImpl.hpp"
 #include "EngineMemory.h"
+#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
@@ -80,6 +81,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     m_EngineAttribs     {EngineCI                 },
     m_FramebufferCache  {*this                    },
     m_RenderPassCache   {*this                    },
+    m_ShaderModuleCache {*this                    },
     m_DescriptorSetAllocator
     {
         *this,
@@ -144,7 +146,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         *this,
         EngineCI.DynamicHeapSize,
         ~Uint64{0}
-    }
+    },
+    m_SPIRVCache{EngineCI.SPIRVCacheDirectory}
 // clang-format on
 {
     m_DeviceCaps.DevType      = RENDER_DEVICE_TYPE_VULKAN;
@@ -199,10 +202,137 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     SamCaps.BorderSamplingModeSupported   = True;
     SamCaps.AnisotropicFilteringSupported = vkDeviceFeatures.samplerAnisotropy;
     SamCaps.LODBiasSupported              = True;
+
+    if (EngineCI.EnableAsyncResourceDestruction)
+        EnableAsyncResourceDestruction(static_cast<double>(EngineCI.ResourceDestructionBudgetMs) / 1000.0);
+
+    CreatePipelineCache(EngineCI.pPipelineCacheData);
+    // The blob is not owned by the device
+    m_EngineAttribs.pPipelineCacheData = nullptr;
+
+    // The engine factory only enables descriptor indexing when the bindless resource table is requested
+    // and all required features are supported
+    if (EngineCI.EnableBindlessResources && m_LogicalVkDevice->IsDescriptorIndexingEnabled())
+    {
+        m_pBindlessResourceTable.reset(
+            new BindlessResourceTableVk{
+                *this,
+                {EngineCI.NumBindlessSampledImages, EngineCI.NumBindlessStorageBuffers, EngineCI.NumBindlessSamplers} //
+            });
+    }
+}
+
+namespace
+{
+
+// Layout of the pipeline cache header version one (see vkGetPipelineCacheData spec)
+struct PipelineCacheHeader
+{
+    Uint32 HeaderSize;
+    Uint32 HeaderVersion;
+    Uint32 VendorID;
+    Uint32 DeviceID;
+    Uint8  PipelineCacheUUID[VK_UUID_SIZE];
+};
+static_assert(sizeof(PipelineCacheHeader) == 16 + VK_UUID_SIZE, "Unexpected pipeline cache header size");
+
+} // namespace
+
+bool RenderDeviceVkImpl::IsPipelineCacheDataCompatible(const void* pData, size_t DataSize, const VkPhysicalDeviceProperties& DeviceProps)
+{
+    if (DataSize < sizeof(PipelineCacheHeader))
+    {
+        LOG_WARNING_MESSAGE("Pipeline cache data is too small (", DataSize, " bytes) to contain a valid header");
+        return false;
+    }
+
+    PipelineCacheHeader Header;
+    memcpy(&Header, pData, sizeof(Header));
+
+    if (Header.HeaderSize < sizeof(PipelineCacheHeader) || Header.HeaderSize > DataSize)
+    {
+        LOG_WARNING_MESSAGE("Pipeline cache data header size (", Header.HeaderSize, ") is invalid");
+        return false;
+    }
+
+    if (Header.HeaderVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+    {
+        LOG_WARNING_MESSAGE("Pipeline cache data header version (", Header.HeaderVersion, ") is not supported");
+        return false;
+    }
+
+    if (Header.VendorID != DeviceProps.vendorID || Header.DeviceID != DeviceProps.deviceID)
+    {
+        LOG_WARNING_MESSAGE("Pipeline cache data was created by a different device (vendor 0x", std::hex, Header.VendorID,
+                            ", device 0x", Header.DeviceID, ")");
+        return false;
+    }
+
+    if (memcmp(Header.PipelineCacheUUID, DeviceProps.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+    {
+        LOG_WARNING_MESSAGE("Pipeline cache data UUID does not match the device. This typically happens after a driver update.");
+        return false;
+    }
+
+    return true;
+}
+
+void RenderDeviceVkImpl::CreatePipelineCache(IDataBlob* pInitialData)
+{
+    VkPipelineCacheCreateInfo PipelineCacheCI = {};
+
+    PipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCI.pNext = nullptr;
+    PipelineCacheCI.flags = 0;
+    if (pInitialData != nullptr && pInitialData->GetSize() > 0)
+    {
+        if (IsPipelineCacheDataCompatible(pInitialData->GetDataPtr(), pInitialData->GetSize(), m_PhysicalDevice->GetProperties()))
+        {
+            PipelineCacheCI.initialDataSize = pInitialData->GetSize();
+            PipelineCacheCI.pInitialData    = pInitialData->GetDataPtr();
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Initial pipeline cache data is ignored");
+        }
+    }
+
+    m_PipelineCache = m_LogicalVkDevice->CreatePipelineCache(PipelineCacheCI, "Device pipeline cache");
+}
+
+void RenderDeviceVkImpl::GetPipelineCacheData(IDataBlob** ppData)
+{
+    DEV_CHECK_ERR(ppData != nullptr, "ppData must not be null");
+    DEV_CHECK_ERR(*ppData == nullptr, "Overwriting reference to an existing object may result in memory leaks");
+
+    size_t DataSize = 0;
+    auto   err      = m_LogicalVkDevice->GetPipelineCacheData(m_PipelineCache, &DataSize, nullptr);
+    if (err != VK_SUCCESS)
+    {
+        LOG_ERROR_MESSAGE("Failed to query the pipeline cache data size");
+        return;
+    }
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob{MakeNewRCObj<DataBlobImpl>()(DataSize)};
+    // The size may change between the calls if other threads are creating pipelines
+    err = m_LogicalVkDevice->GetPipelineCacheData(m_PipelineCache, &DataSize, pDataBlob->GetDataPtr());
+    if (err != VK_SUCCESS && err != VK_INCOMPLETE)
+    {
+        LOG_ERROR_MESSAGE("Failed to retrieve the pipeline cache data");
+        return;
+    }
+    pDataBlob->Resize(DataSize);
+
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
 }
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
 {
+    // Asynchronous creation tasks hold strong references to their pipeline states, which in turn
+    // keep the device alive. The only task that may still be running at this point is the one that
+    // released the last reference to the device, and the pool does not wait for it.
+    m_pWorkerThreadPool.reset();
+
     // Explicitly destroy dynamic heap. This will move resources owned by
     // the heap into release queues
     m_DynamicMemoryManager.Destroy();
@@ -217,6 +347,9 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     DEV_CHECK_ERR(m_DynamicDescriptorPool.GetAllocatedPoolCounter() == 0, "All allocated dynamic descriptor pools must have been released now.");
     DEV_CHECK_ERR(m_DynamicMemoryManager.GetMasterBlockCounter() == 0, "All allocated dynamic master blocks must have been returned to the pool.");
 
+    // All slots have been returned to the table when the release queues were purged
+    m_pBindlessResourceTable.reset();
+
     // Immediately destroys all command pools
     m_TransientCmdPoolMgr.DestroyPools();
 
@@ -484,6 +617,38 @@ void RenderDeviceVkImpl::CreatePipelineState(const PipelineStateDesc& PipelineDe
     );
 }
 
+void RenderDeviceVkImpl::CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc, IPipelineState* pFallbackPSO, IPipelineState** ppPipelineState)
+{
+    CreateDeviceObject(
+        "Pipeline State", PipelineDesc, ppPipelineState,
+        [&]() //
+        {
+            auto*                pFallbackPSOVk = ValidatedCast<PipelineStateVkImpl>(pFallbackPSO);
+            PipelineStateVkImpl* pPipelineStateVk(NEW_RC_OBJ(m_PSOAllocator, "PipelineStateVkImpl instance", PipelineStateVkImpl)(this, PipelineDesc, true, pFallbackPSOVk));
+            pPipelineStateVk->QueryInterface(IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState));
+            pPipelineStateVk->StartAsyncCreation();
+            OnCreateDeviceObject(pPipelineStateVk);
+        } //
+    );
+}
+
+ThreadPool& RenderDeviceVkImpl::GetWorkerThreadPool()
+{
+    std::lock_guard<std::mutex> Lock{m_WorkerThreadPoolMtx};
+    if (!m_pWorkerThreadPool)
+    {
+        size_t NumThreads = m_EngineAttribs.NumWorkerThreads;
+        if (NumThreads == 0)
+        {
+            // Leave one core for the rendering thread
+            const auto NumCores = std::thread::hardware_concurrency();
+            NumThreads          = NumCores > 1 ? NumCores - 1 : 1;
+        }
+        m_pWorkerThreadPool.reset(new ThreadPool{NumThreads});
+    }
+    return *m_pWorkerThreadPool;
+}
+
 
 void RenderDeviceVkImpl::CreateBufferFromVulkanResource(VkBuffer vkBuffer, const BufferDesc& BuffDesc, RESOURCE_STATE InitialState, IBuffer** ppBuffer)
 {
@@ -529,6 +694,95 @@ void RenderDeviceVkImpl::CreateShader(const ShaderCreateInfo& ShaderCI, IShader*
     );
 }
 
+void RenderDeviceVkImpl::CreateShaderFromArchive(IDataBlob* pArchive, const Char* EntryName, IShader** ppShader)
+{
+    DEV_CHECK_ERR(pArchive != nullptr && EntryName != nullptr && ppShader != nullptr, "pArchive, EntryName and ppShader must not be null");
+    *ppShader = nullptr;
+
+    ShaderArchiveReader        Reader{pArchive->GetDataPtr(), pArchive->GetSize()};
+    ShaderArchiveReader::Entry Entry;
+    if (!Reader.FindEntry(EntryName, Entry))
+    {
+        LOG_ERROR_MESSAGE("Shader '", EntryName, "' is not found in the archive");
+        return;
+    }
+
+    if (Entry.pSPIRV == nullptr)
+    {
+        // Compile GLSL source
+        TRenderDeviceBase::CreateShaderFromArchive(pArchive, EntryName, ppShader);
+        return;
+    }
+
+    // The archive builder compiles HLSL source with combined texture samplers.
+    // The byte code is copied by the shader, reflection is rehydrated from the serialized resources.
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc.Name                  = Entry.Name;
+    ShaderCI.Desc.ShaderType            = Entry.ShaderType;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ByteCode                   = Entry.pSPIRV;
+    ShaderCI.ByteCodeSize               = Entry.SPIRVSize;
+    ShaderCI.UseCombinedTextureSamplers = true;
+
+    CreateDeviceObject(
+        "shader", ShaderCI.Desc, ppShader,
+        [&]() //
+        {
+            ShaderVkImpl* pShaderVk(NEW_RC_OBJ(m_ShaderObjAllocator, "ShaderVkImpl instance", ShaderVkImpl)(this, ShaderCI, Entry.pResources, Entry.ResourcesSize));
+            pShaderVk->QueryInterface(IID_Shader, reinterpret_cast<IObject**>(ppShader));
+
+            OnCreateDeviceObject(pShaderVk);
+        } //
+    );
+}
+
+void RenderDeviceVkImpl::CreateShaders(const ShaderCreateInfo* pShaderCIs, Uint32 NumShaders, IShader** ppShaders)
+{
+    DEV_CHECK_ERR(NumShaders == 0 || (pShaderCIs != nullptr && ppShaders != nullptr), "pShaderCIs and ppShaders must not be null");
+
+    auto& Pool = GetWorkerThreadPool();
+    // A worker thread that waited for the batch would block one of the threads the batch needs,
+    // and the whole pool if all of them did the same.
+    if (NumShaders <= 1 || Pool.IsWorkerThread())
+    {
+        TRenderDeviceBase::CreateShaders(pShaderCIs, NumShaders, ppShaders);
+        return;
+    }
+
+    // glslang process-wide state is initialized by the Vulkan instance, which outlives the pool.
+    // glslang sets up its per-thread state on its own, so worker threads need no initialization.
+    std::vector<std::future<void>> Tasks;
+    Tasks.reserve(NumShaders);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        Tasks.emplace_back(Pool.EnqueueTask(
+            [this, pShaderCIs, ppShaders, i]() //
+            {
+                CreateShader(pShaderCIs[i], ppShaders + i);
+            } //
+            ));
+    }
+
+    // Compilation errors are reported through null shaders. Other exceptions are propagated to
+    // the caller as if the shaders were created one by one, but only after all tasks are complete
+    // since they reference the caller's arrays.
+    std::exception_ptr pException;
+    for (auto& Task : Tasks)
+    {
+        try
+        {
+            Task.get();
+        }
+        catch (...)
+        {
+            if (!pException)
+                pException = std::current_exception();
+        }
+    }
+    if (pException)
+        std::rethrow_exception(pException);
+}
+
 
 void RenderDeviceVkImpl::CreateTextureFromVulkanImage(VkImage vkImage, const TextureDesc& TexDesc, RESOURCE_STATE InitialState, ITexture** ppTexture)
 {
@@ -0,0 +1,448 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <functional>
+#include <unordered_set>
+#include <algorithm>
+
+#include "SPIRVCache.hpp"
+#include "APIInfo.h"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Increment the version whenever the entry format or the way the key is computed changes
+constexpr Uint32 SPIRVCacheFormatVersion = 2;
+constexpr Uint32 SPIRVCacheMagic         = 0x56505344; // 'DSPV'
+
+constexpr char   IncludeDirective[]  = "include";
+constexpr size_t IncludeDirectiveLen = sizeof(IncludeDirective) - 1;
+
+struct SPIRVCacheEntryHeader
+{
+    Uint32 Magic         = SPIRVCacheMagic;
+    Uint32 FormatVersion = SPIRVCacheFormatVersion;
+    Uint64 KeyHash1      = 0;
+    Uint64 ByteCodeHash  = 0;
+    Uint64 ByteCodeSize  = 0;
+    Uint64 ResourcesHash = 0;
+    Uint64 ResourcesSize = 0;
+};
+
+// Hash values are stored on disk, so std::hash cannot be used
+SPIRVCache::Key GetKey(const StableHasher& Hasher)
+{
+    SPIRVCache::Key Key;
+    Key.Hash0 = Hasher.GetHash0();
+    Key.Hash1 = Hasher.GetHash1();
+    return Key;
+}
+
+template <typename T>
+Uint64 ComputeDataHash(const std::vector<T>& Data)
+{
+    return ComputeFNV1aHash(Data.data(), Data.size() * sizeof(T));
+}
+
+void HashCommonAttribs(StableHasher& Hasher, SHADER_TYPE ShaderType, SHADER_SOURCE_LANGUAGE SourceLang, const char* CompilerVersion)
+{
+    Hasher.Update(SPIRVCacheFormatVersion);
+    Hasher.Update(static_cast<Uint32>(DILIGENT_API_VERSION));
+    Hasher.UpdateStr(CompilerVersion);
+    Hasher.Update(static_cast<Uint32>(ShaderType));
+    Hasher.Update(static_cast<Uint32>(SourceLang));
+}
+
+// Hashes the contents of all files referenced by #include directives. Conditional compilation
+// is not evaluated, so the hash may depend on files that are not actually compiled,
+// which can only cause unnecessary cache misses.
+void HashIncludes(StableHasher&                    Hasher,
+                  const char*                      Source,
+                  size_t                           SourceLen,
+                  IShaderSourceInputStreamFactory* pStreamFactory,
+                  std::unordered_set<std::string>& ProcessedIncludes)
+{
+    const char* const End = Source + SourceLen;
+
+    const char* Pos = Source;
+    while (Pos < End)
+    {
+        const char* LineEnd = static_cast<const char*>(memchr(Pos, '\n', End - Pos));
+        if (LineEnd == nullptr)
+            LineEnd = End;
+
+        auto SkipSpaces = [LineEnd](const char* c) {
+            while (c < LineEnd && (*c == ' ' || *c == '\t'))
+                ++c;
+            return c;
+        };
+
+        const char* c = SkipSpaces(Pos);
+        if (c < LineEnd && *c == '#')
+        {
+            c = SkipSpaces(c + 1);
+            if (static_cast<size_t>(LineEnd - c) > IncludeDirectiveLen && strncmp(c, IncludeDirective, IncludeDirectiveLen) == 0)
+            {
+                c = SkipSpaces(c + IncludeDirectiveLen);
+                if (c < LineEnd && (*c == '"' || *c == '<'))
+                {
+                    const char  ClosingQuote = *c == '"' ? '"' : '>';
+                    const char* NameStart    = c + 1;
+                    const char* NameEnd      = static_cast<const char*>(memchr(NameStart, ClosingQuote, LineEnd - NameStart));
+                    if (NameEnd != nullptr)
+                    {
+                        std::string IncludeName{NameStart, NameEnd};
+                        Hasher.UpdateStr(IncludeName.c_str(), IncludeName.length());
+                        if (pStreamFactory != nullptr && ProcessedIncludes.insert(IncludeName).second)
+                        {
+                            RefCntAutoPtr<IFileStream> pIncludeStream;
+                            pStreamFactory->CreateInputStream(IncludeName.c_str(), &pIncludeStream);
+                            if (pIncludeStream)
+                            {
+                                RefCntAutoPtr<IDataBlob> pIncludeData(MakeNewRCObj<DataBlobImpl>()(0));
+                                pIncludeStream->ReadBlob(pIncludeData);
+                                const auto* IncludeSource = reinterpret_cast<const char*>(pIncludeData->GetDataPtr());
+                                const auto  IncludeLen    = pIncludeData->GetSize();
+                                Hasher.UpdateStr(IncludeSource, IncludeLen);
+                                HashIncludes(Hasher, IncludeSource, IncludeLen, pStreamFactory, ProcessedIncludes);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        Pos = LineEnd + 1;
+    }
+}
+
+std::string GetCacheDirectory(const char* CacheDirectory)
+{
+    std::string Directory;
+    if (CacheDirectory != nullptr && *CacheDirectory != '\0')
+    {
+        Directory = CacheDirectory;
+        if (Directory.back() != '/' && Directory.back() != '\\')
+            Directory.push_back(FileSystem::GetSlashSymbol());
+    }
+    return Directory;
+}
+
+} // namespace
+
+SPIRVCache::SPIRVCache(const char* CacheDirectory, size_t MaxMemorySize) :
+    m_Directory{GetCacheDirectory(CacheDirectory)},
+    m_MaxMemorySize{MaxMemorySize}
+{
+}
+
+SPIRVCache::Key SPIRVCache::ComputeHLSLKey(const ShaderCreateInfo& ShaderCI, const char* CompilerVersion)
+{
+    StableHasher Hasher;
+    HashCommonAttribs(Hasher, ShaderCI.Desc.ShaderType, SHADER_SOURCE_LANGUAGE_HLSL, CompilerVersion);
+    Hasher.UpdateStr(ShaderCI.EntryPoint);
+
+    if (ShaderCI.Macros != nullptr)
+    {
+        for (const auto* pMacro = ShaderCI.Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+        {
+            Hasher.UpdateStr(pMacro->Name);
+            Hasher.UpdateStr(pMacro->Definition);
+        }
+    }
+    // Separate macros from the source
+    Hasher.Update(Uint64{~0ull});
+
+    RefCntAutoPtr<IDataBlob> pFileData;
+
+    const char* Source    = ShaderCI.Source;
+    size_t      SourceLen = 0;
+    if (Source != nullptr)
+    {
+        SourceLen = strlen(Source);
+    }
+    else
+    {
+        VERIFY(ShaderCI.pShaderSourceStreamFactory, "Input stream factory is null");
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        ShaderCI.pShaderSourceStreamFactory->CreateInputStream(ShaderCI.FilePath, &pSourceStream);
+        if (pSourceStream == nullptr)
+            LOG_ERROR_AND_THROW("Failed to open shader source file");
+
+        pFileData = MakeNewRCObj<DataBlobImpl>()(0);
+        pSourceStream->ReadBlob(pFileData);
+        Source    = reinterpret_cast<const char*>(pFileData->GetDataPtr());
+        SourceLen = pFileData->GetSize();
+    }
+    Hasher.UpdateStr(Source, SourceLen);
+
+    std::unordered_set<std::string> ProcessedIncludes;
+    HashIncludes(Hasher, Source, SourceLen, ShaderCI.pShaderSourceStreamFactory, ProcessedIncludes);
+
+    return GetKey(Hasher);
+}
+
+SPIRVCache::Key SPIRVCache::ComputeGLSLKey(SHADER_TYPE ShaderType, const std::string& GLSLSource, const char* CompilerVersion)
+{
+    StableHasher Hasher;
+    HashCommonAttribs(Hasher, ShaderType, SHADER_SOURCE_LANGUAGE_GLSL, CompilerVersion);
+    Hasher.UpdateStr(GLSLSource.c_str(), GLSLSource.length());
+    return GetKey(Hasher);
+}
+
+std::string SPIRVCache::GetEntryPath(const Key& EntryKey) const
+{
+    char FileName[32];
+    snprintf(FileName, sizeof(FileName), "%016llx.spv", static_cast<unsigned long long>(EntryKey.Hash0));
+    return m_Directory + FileName;
+}
+
+bool SPIRVCache::Load(const Key& EntryKey, std::vector<uint32_t>& SPIRV, std::vector<Uint8>& Resources)
+{
+    if (!IsEnabled())
+        return false;
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto It = m_Entries.find(EntryKey);
+        if (It != m_Entries.end())
+        {
+            SPIRV     = It->second.SPIRV;
+            Resources = It->second.Resources;
+            m_MemoryHits.fetch_add(1);
+            return true;
+        }
+    }
+
+    // Disk access is performed without holding the lock
+    if (LoadFromDisk(EntryKey, SPIRV, Resources))
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        AddToMemory(EntryKey, SPIRV, Resources);
+        m_DiskHits.fetch_add(1);
+        return true;
+    }
+
+    m_Misses.fetch_add(1);
+    return false;
+}
+
+void SPIRVCache::Store(const Key& EntryKey, const std::vector<uint32_t>& SPIRV, const std::vector<Uint8>& Resources)
+{
+    if (!IsEnabled() || SPIRV.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        AddToMemory(EntryKey, SPIRV, Resources);
+    }
+
+    StoreOnDisk(EntryKey, SPIRV, Resources);
+}
+
+void SPIRVCache::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Entries.clear();
+    m_EntryOrder.clear();
+    m_MemorySize = 0;
+}
+
+SPIRVCache::Stats SPIRVCache::GetStats() const
+{
+    Stats CacheStats;
+    CacheStats.MemoryHits = m_MemoryHits.load();
+    CacheStats.DiskHits   = m_DiskHits.load();
+    CacheStats.Misses     = m_Misses.load();
+    return CacheStats;
+}
+
+void SPIRVCache::AddToMemory(const Key& EntryKey, const std::vector<uint32_t>& SPIRV, const std::vector<Uint8>& Resources)
+{
+    const auto EntrySize = SPIRV.size() * sizeof(SPIRV[0]) + Resources.size();
+
+    auto It = m_Entries.find(EntryKey);
+    if (It != m_Entries.end())
+    {
+        // Replace the existing entry, e.g. when serialized resources are added to it
+        m_MemorySize -= It->second.GetSize();
+        if (EntrySize > m_MaxMemorySize)
+        {
+            m_Entries.erase(It);
+            m_EntryOrder.erase(std::find(m_EntryOrder.begin(), m_EntryOrder.end(), EntryKey));
+            return;
+        }
+        It->second.SPIRV     = SPIRV;
+        It->second.Resources = Resources;
+    }
+    else
+    {
+        if (EntrySize > m_MaxMemorySize)
+            return;
+
+        MemoryEntry Entry;
+        Entry.SPIRV     = SPIRV;
+        Entry.Resources = Resources;
+        m_Entries.emplace(EntryKey, std::move(Entry));
+        m_EntryOrder.push_back(EntryKey);
+    }
+
+    m_MemorySize += EntrySize;
+    while (m_MemorySize > m_MaxMemorySize)
+    {
+        VERIFY_EXPR(!m_EntryOrder.empty());
+        auto EvictIt = m_Entries.find(m_EntryOrder.front());
+        VERIFY_EXPR(EvictIt != m_Entries.end());
+        m_MemorySize -= EvictIt->second.GetSize();
+        m_Entries.erase(EvictIt);
+        m_EntryOrder.pop_front();
+    }
+}
+
+bool SPIRVCache::LoadFromDisk(const Key& EntryKey, std::vector<uint32_t>& SPIRV, std::vector<Uint8>& Resources) const
+{
+    const auto EntryPath = GetEntryPath(EntryKey);
+    if (!FileSystem::FileExists(EntryPath.c_str()))
+        return false;
+
+    bool IsValid = false;
+    {
+        FileWrapper File{EntryPath.c_str(), EFileAccessMode::Read};
+        if (!File)
+            return false;
+
+        const auto FileSize = File->GetSize();
+
+        SPIRVCacheEntryHeader Header;
+        if (FileSize >= sizeof(Header) && File->Read(&Header, sizeof(Header)))
+        {
+            if (Header.Magic == SPIRVCacheMagic &&
+                Header.FormatVersion == SPIRVCacheFormatVersion &&
+                Header.KeyHash1 == EntryKey.Hash1 &&
+                Header.ByteCodeSize != 0 &&
+                Header.ByteCodeSize % sizeof(uint32_t) == 0 &&
+                Header.ByteCodeSize + Header.ResourcesSize == FileSize - sizeof(Header))
+            {
+                SPIRV.resize(static_cast<size_t>(Header.ByteCodeSize / sizeof(uint32_t)));
+                Resources.resize(static_cast<size_t>(Header.ResourcesSize));
+                IsValid = File->Read(SPIRV.data(), static_cast<size_t>(Header.ByteCodeSize)) &&
+                    (Resources.empty() || File->Read(Resources.data(), Resources.size())) &&
+                    ComputeDataHash(SPIRV) == Header.ByteCodeHash &&
+                    ComputeDataHash(Resources) == Header.ResourcesHash;
+            }
+        }
+    }
+
+    if (!IsValid)
+    {
+        LOG_WARNING_MESSAGE("SPIR-V cache entry '", EntryPath, "' is corrupted or belongs to a different shader and will be removed");
+        SPIRV.clear();
+        Resources.clear();
+        FileSystem::DeleteFile(EntryPath.c_str());
+    }
+
+    return IsValid;
+}
+
+void SPIRVCache::StoreOnDisk(const Key& EntryKey, const std::vector<uint32_t>& SPIRV, const std::vector<Uint8>& Resources) const
+{
+    const auto EntryPath = GetEntryPath(EntryKey);
+
+    // Write the entry to a uniquely named temporary file first, so that other threads and
+    // processes never see a partially written entry
+    static std::atomic<Uint32> TmpFileCounter{0};
+    std::string                TmpPath = EntryPath;
+    TmpPath += '.';
+    TmpPath += std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    TmpPath += '.';
+    TmpPath += std::to_string(TmpFileCounter.fetch_add(1));
+    TmpPath += ".tmp";
+
+    SPIRVCacheEntryHeader Header;
+    Header.KeyHash1     = EntryKey.Hash1;
+    Header.ByteCodeHash  = ComputeDataHash(SPIRV);
+    Header.ByteCodeSize  = SPIRV.size() * sizeof(SPIRV[0]);
+    Header.ResourcesHash = ComputeDataHash(Resources);
+    Header.ResourcesSize = Resources.size();
+
+    bool Written = false;
+    {
+        FileWrapper File{TmpPath.c_str(), EFileAccessMode::Overwrite};
+        if (File)
+        {
+            Written = File->Write(&Header, sizeof(Header)) &&
+                File->Write(SPIRV.data(), static_cast<size_t>(Header.ByteCodeSize)) &&
+                (Resources.empty() || File->Write(Resources.data(), Resources.size()));
+        }
+    }
+
+    if (!Written)
+    {
+        LOG_WARNING_MESSAGE("Failed to write SPIR-V cache entry '", TmpPath, "'");
+        FileSystem::DeleteFile(TmpPath.c_str());
+        return;
+    }
+
+    if (std::rename(TmpPath.c_str(), EntryPath.c_str()) != 0)
+    {
+        // POSIX rename atomically replaces the destination, but on Windows it always fails
+        // if the destination exists. Entries are content-addressed, so an existing file
+        // holds the same data and can be kept, unless it is an entry without serialized
+        // resources that is being updated. In that case, the old entry is removed first;
+        // a concurrent reader may briefly miss the entry, which only causes a recompilation.
+        bool Renamed = false;
+        if (FileSystem::FileExists(EntryPath.c_str()) && !Resources.empty())
+        {
+            FileSystem::DeleteFile(EntryPath.c_str());
+            Renamed = std::rename(TmpPath.c_str(), EntryPath.c_str()) == 0;
+        }
+        if (!Renamed)
+        {
+            if (!FileSystem::FileExists(EntryPath.c_str()))
+                LOG_WARNING_MESSAGE("Failed to rename SPIR-V cache entry '", TmpPath, "' to '", EntryPath, "'");
+            FileSystem::DeleteFile(TmpPath.c_str());
+        }
+    }
+}
+
+} // namespace Diligent
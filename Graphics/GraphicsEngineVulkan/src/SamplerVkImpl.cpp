@@ -84,10 +84,15 @@ SamplerVkImpl::SamplerVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImp
     SamplerCI.unnormalizedCoordinates = VK_FALSE;
 
     m_VkSampler = LogicalDevice.CreateSampler(SamplerCI);
+
+    if (auto* pBindlessTable = pRenderDeviceVk->GetBindlessResourceTable())
+        m_BindlessIndex = pBindlessTable->AllocateSampler(m_VkSampler, m_Desc.Name);
 }
 
 SamplerVkImpl::~SamplerVkImpl()
 {
+    if (m_BindlessIndex != BindlessResourceTableVk::InvalidIndex)
+        m_pDevice->GetBindlessResourceTable()->FreeSlot(BindlessResourceTableVk::BINDING_SAMPLER, m_BindlessIndex, m_CommandQueueMask);
     m_pDevice->SafeReleaseDeviceObject(std::move(m_VkSampler), m_CommandQueueMask);
 }
 
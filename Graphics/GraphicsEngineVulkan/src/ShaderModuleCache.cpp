@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ShaderModuleCache.hpp"
+#include "HashUtils.hpp"
+#include "RenderDeviceVkImpl.hpp"
+
+namespace Diligent
+{
+
+static size_t ComputeSPIRVHash(const std::vector<uint32_t>& SPIRV)
+{
+    size_t Hash = SPIRV.size();
+    for (auto Word : SPIRV)
+        HashCombine(Hash, Word);
+    return Hash;
+}
+
+VkShaderModule ShaderModuleCache::FindModule(size_t Hash, const std::vector<uint32_t>& SPIRV)
+{
+    auto range = m_Cache.equal_range(Hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        auto& Info = it->second;
+        if (Info.SPIRV == SPIRV)
+        {
+            ++Info.RefCounter;
+            return Info.Module;
+        }
+    }
+    return VK_NULL_HANDLE;
+}
+
+VkShaderModule ShaderModuleCache::GetShaderModule(const std::vector<uint32_t>& SPIRV, const char* DebugName)
+{
+    const auto Hash = ComputeSPIRVHash(SPIRV);
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+        if (auto vkModule = FindModule(Hash, SPIRV))
+            return vkModule;
+    }
+
+    // Create the module without holding the lock so that other threads are not
+    // blocked while the driver processes the byte code
+    VkShaderModuleCreateInfo ShaderModuleCI = {};
+
+    ShaderModuleCI.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    ShaderModuleCI.pNext    = nullptr;
+    ShaderModuleCI.flags    = 0;
+    ShaderModuleCI.codeSize = SPIRV.size() * sizeof(uint32_t);
+    ShaderModuleCI.pCode    = SPIRV.data();
+
+    auto NewModule = m_DeviceVkImpl.GetLogicalDevice().CreateShaderModule(ShaderModuleCI, DebugName);
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    if (auto vkModule = FindModule(Hash, SPIRV))
+    {
+        // Another thread has created the module for the same byte code in the meantime.
+        // The new module has never been used, so it is destroyed right away by the wrapper.
+        return vkModule;
+    }
+
+    ModuleInfo Info;
+    Info.SPIRV      = SPIRV;
+    Info.Module     = std::move(NewModule);
+    Info.RefCounter = 1;
+
+    VkShaderModule vkModule = Info.Module;
+    m_Cache.emplace(Hash, std::move(Info));
+    m_ModuleToHash.emplace(vkModule, Hash);
+
+    return vkModule;
+}
+
+void ShaderModuleCache::Release(VkShaderModule ShaderModule, Uint64 CommandQueueMask)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto hash_it = m_ModuleToHash.find(ShaderModule);
+    if (hash_it == m_ModuleToHash.end())
+    {
+        UNEXPECTED("Shader module is not found in the cache");
+        return;
+    }
+
+    auto range = m_Cache.equal_range(hash_it->second);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        auto& Info = it->second;
+        if (Info.Module != ShaderModule)
+            continue;
+
+        VERIFY_EXPR(Info.RefCounter > 0);
+        if (--Info.RefCounter == 0)
+        {
+            m_DeviceVkImpl.SafeReleaseDeviceObject(std::move(Info.Module), CommandQueueMask);
+            m_Cache.erase(it);
+            m_ModuleToHash.erase(hash_it);
+        }
+        return;
+    }
+
+    UNEXPECTED("Shader module is not found in the cache");
+}
+
+size_t ShaderModuleCache::GetNumModules()
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    return m_Cache.size();
+}
+
+ShaderModuleCache::~ShaderModuleCache()
+{
+    VERIFY(m_Cache.empty(), "All shader modules must be released");
+    VERIFY(m_ModuleToHash.empty(), "All shader modules must be released");
+}
+
+} // namespace Diligent
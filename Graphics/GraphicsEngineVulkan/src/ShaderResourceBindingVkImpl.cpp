@@ -34,9 +34,10 @@
 namespace Diligent
 {
 
-ShaderResourceBindingVkImpl::ShaderResourceBindingVkImpl(IReferenceCounters*  pRefCounters,
-                                                         PipelineStateVkImpl* pPSO,
-                                                         bool                 IsPSOInternal) :
+ShaderResourceBindingVkImpl::ShaderResourceBindingVkImpl(IReferenceCounters*      pRefCounters,
+                                                         PipelineStateVkImpl*     pPSO,
+                                                         bool                     IsPSOInternal,
+                                                         DescriptorSetAllocation* pStaticAndMutSetAllocation) :
     // clang-format off
     TBase
     {
@@ -54,7 +55,7 @@ ShaderResourceBindingVkImpl::ShaderResourceBindingVkImpl(IReferenceCounters*  pR
     // This will only allocate memory and initialize descriptor sets in the resource cache
     // Resources will be initialized by InitializeResourceMemoryInCache()
     auto& ResourceCacheDataAllocator = pPSO->GetSRBMemoryAllocator().GetResourceCacheDataAllocator(0);
-    pPSO->GetPipelineLayout().InitResourceCache(pRenderDeviceVkImpl, m_ShaderResourceCache, ResourceCacheDataAllocator, pPSO->GetDesc().Name);
+    pPSO->GetPipelineLayout().InitResourceCache(pRenderDeviceVkImpl, m_ShaderResourceCache, ResourceCacheDataAllocator, pPSO->GetDesc().Name, pStaticAndMutSetAllocation);
 
     m_pShaderVarMgrs = ALLOCATE(GetRawAllocator(), "Raw memory for ShaderVariableManagerVk", ShaderVariableManagerVk, m_NumShaders);
 
@@ -76,7 +77,7 @@ ShaderResourceBindingVkImpl::ShaderResourceBindingVkImpl(IReferenceCounters*  pR
         // Initialize vars manager to reference mutable and dynamic variables
         // Note that the cache has space for all variable types
         const SHADER_RESOURCE_VARIABLE_TYPE VarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
-        new (m_pShaderVarMgrs + s) ShaderVariableManagerVk(*this, SrcLayout, VarDataAllocator, VarTypes, _countof(VarTypes), m_ShaderResourceCache);
+        new (m_pShaderVarMgrs + s) ShaderVariableManagerVk(*this, SrcLayout, pPSO->GetSRBVarIndexMap(s), VarDataAllocator, VarTypes, _countof(VarTypes), m_ShaderResourceCache);
     }
 #ifdef _DEBUG
     m_ShaderResourceCache.DbgVerifyResourceInitialization();
@@ -126,6 +127,60 @@ IShaderResourceVariable* ShaderResourceBindingVkImpl::GetVariableByName(SHADER_T
     return m_pShaderVarMgrs[ResLayoutInd].GetVariable(Name);
 }
 
+IShaderResourceVariable* ShaderResourceBindingVkImpl::GetVariableByHash(SHADER_TYPE ShaderType, Uint64 NameHash)
+{
+    auto ShaderInd    = GetShaderTypeIndex(ShaderType);
+    auto ResLayoutInd = m_ResourceLayoutIndex[ShaderInd];
+    if (ResLayoutInd < 0)
+    {
+        LOG_WARNING_MESSAGE("Unable to find mutable/dynamic variable by name hash: shader stage ", GetShaderTypeLiteralName(ShaderType),
+                            " is inactive in Pipeline State '", m_pPSO->GetDesc().Name, "'.");
+        return nullptr;
+    }
+    return m_pShaderVarMgrs[ResLayoutInd].GetVariableByHash(NameHash);
+}
+
+void ShaderResourceBindingVkImpl::SetVariables(const ResourceBindDesc* pBindings, Uint32 Count)
+{
+    if (Count == 0)
+        return;
+    DEV_CHECK_ERR(pBindings != nullptr, "Bindings must not be null");
+
+    // Resolve and validate all bindings before any resource is bound
+    auto& Variables = m_SetVariablesScratch;
+    Variables.assign(Count, nullptr);
+    for (Uint32 i = 0; i < Count; ++i)
+    {
+        const auto& Binding = pBindings[i];
+        if (auto* pVar = GetBindingVariable(Binding))
+        {
+            auto* pVarVk = ValidatedCast<ShaderVariableVkImpl>(pVar);
+
+            const auto& Attribs = pVarVk->GetResource().SpirvAttribs;
+            if (Binding.ArrayIndex < Attribs.ArraySize)
+            {
+                Variables[i] = pVarVk;
+            }
+            else
+            {
+                LOG_ERROR_MESSAGE("Array index (", Binding.ArrayIndex, ") is out of range 0 .. ", Attribs.ArraySize - 1, " of variable '", Attribs.Name, "'");
+            }
+        }
+    }
+
+    // All descriptors written while binding the resources are submitted with a single
+    // vkUpdateDescriptorSets() call rather than one call per resource. The batch keeps
+    // its capacity after flushing, so repeated calls do not allocate.
+    auto& WriteBatch = m_SetVariablesWriteBatch;
+    WriteBatch.Reserve(Count);
+    for (Uint32 i = 0; i < Count; ++i)
+    {
+        if (Variables[i] != nullptr)
+            Variables[i]->BindResource(pBindings[i].pObject, pBindings[i].ArrayIndex, WriteBatch);
+    }
+    WriteBatch.Flush(GetPipelineState<const PipelineStateVkImpl>()->GetDevice()->GetLogicalDevice());
+}
+
 Uint32 ShaderResourceBindingVkImpl::GetVariableCount(SHADER_TYPE ShaderType) const
 {
     auto ShaderInd    = GetShaderTypeIndex(ShaderType);
@@ -123,6 +123,10 @@ void ShaderResourceLayoutVk::AllocateMemory(std::shared_ptr<const SPIRVShaderRes
     m_pResources->ProcessResources(
         [&](const SPIRVShaderResourceAttribs& ResAttribs, Uint32) //
         {
+            // Runtime-sized arrays are accessed through the bindless resource table and are not exposed as variables
+            if (ResAttribs.IsRuntimeArray())
+                return;
+
             auto VarType = FindShaderVariableType(ShaderType, ResAttribs, ResourceLayoutDesc, CombinedSamplerSuffix);
             if (IsAllowedType(VarType, AllowedTypeBits))
             {
@@ -191,6 +195,9 @@ void ShaderResourceLayoutVk::InitializeStaticResourceLayout(std::shared_ptr<cons
     m_pResources->ProcessResources(
         [&](const SPIRVShaderResourceAttribs& Attribs, Uint32) //
         {
+            if (Attribs.IsRuntimeArray())
+                return;
+
             auto VarType = FindShaderVariableType(ShaderType, Attribs, ResourceLayoutDesc, CombinedSamplerSuffix);
             if (!IsAllowedType(VarType, AllowedTypeBits))
                 return;
@@ -364,12 +371,21 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*
 #ifdef _DEBUG
     std::unordered_map<Uint32, std::pair<Uint32, Uint32>> dbgBindings_CacheOffsets;
 #endif
+    // Runtime-sized arrays are mapped to the bindless resource table after all other resources
+    // have been processed, as the table set must follow the engine-managed sets
+    std::vector<std::pair<Uint32, const SPIRVShaderResourceAttribs*>> BindlessResources;
 
     auto AddResource = [&](Uint32                            ShaderInd,
                            ShaderResourceLayoutVk&           ResLayout,
                            const SPIRVShaderResources&       Resources,
                            const SPIRVShaderResourceAttribs& Attribs) //
     {
+        if (Attribs.IsRuntimeArray())
+        {
+            BindlessResources.emplace_back(ShaderInd, &Attribs);
+            return;
+        }
+
         const auto                          ShaderType = Resources.GetShaderType();
         const SHADER_RESOURCE_VARIABLE_TYPE VarType    = FindShaderVariableType(ShaderType, Attribs, ResourceLayoutDesc, Resources.GetCombinedSamplerSuffix());
         if (!IsAllowedType(VarType, AllowedTypeBits))
@@ -501,6 +517,13 @@ void ShaderResourceLayoutVk::Initialize(IRenderDevice*
         // clang-format on
     }
 
+    if (!BindlessResources.empty())
+    {
+        const auto* pBindlessTable = ValidatedCast<RenderDeviceVkImpl>(pRenderDevice)->GetBindlessResourceTable();
+        for (const auto& ShaderInd_Attribs : BindlessResources)
+            PipelineLayout.AllocateBindlessResourceSlot(pBindlessTable, *ShaderInd_Attribs.second, SPIRVs[ShaderInd_Attribs.first]);
+    }
+
 #ifdef _DEBUG
     for (Uint32 s = 0; s < NumShaders; ++s)
     {
@@ -552,14 +575,120 @@ Uint32 ShaderResourceLayoutVk::FindAssignedSampler(const SPIRVShaderResourceAttr
 }
 
 
+void DescriptorSetWriteBatch::Reserve(size_t NumWrites)
+{
+    m_Writes.reserve(NumWrites);
+}
+
+void DescriptorSetWriteBatch::AddWrite(VkDescriptorSet               vkDescrSet,
+                                       uint32_t                      Binding,
+                                       uint32_t                      ArrayElement,
+                                       VkDescriptorType              DescrType,
+                                       const VkDescriptorImageInfo*  pImageInfo,
+                                       const VkDescriptorBufferInfo* pBufferInfo,
+                                       const VkBufferView*           pTexelBufferView)
+{
+    VERIFY((pImageInfo != nullptr ? 1 : 0) + (pBufferInfo != nullptr ? 1 : 0) + (pTexelBufferView != nullptr ? 1 : 0) == 1,
+           "Exactly one descriptor info is expected");
+
+    size_t InfoInd = 0;
+    if (pImageInfo != nullptr)
+    {
+        InfoInd = m_ImageInfos.size();
+        m_ImageInfos.push_back(*pImageInfo);
+    }
+    else if (pBufferInfo != nullptr)
+    {
+        InfoInd = m_BufferInfos.size();
+        m_BufferInfos.push_back(*pBufferInfo);
+    }
+    else
+    {
+        InfoInd = m_TexelBufferViews.size();
+        m_TexelBufferViews.push_back(*pTexelBufferView);
+    }
+
+    if (!m_Writes.empty())
+    {
+        // Merge the write with the previous one if it updates the next element of the same binding
+        // and its info immediately follows the infos of the previous write. Descriptor type defines
+        // the info array, so the infos of both writes are in the same array.
+        auto& LastWrite = m_Writes.back();
+        auto& Write     = LastWrite.Write;
+        // clang-format off
+        if (Write.dstSet         == vkDescrSet &&
+            Write.dstBinding     == Binding    &&
+            Write.descriptorType == DescrType  &&
+            Write.dstArrayElement + Write.descriptorCount == ArrayElement &&
+            LastWrite.FirstInfo   + Write.descriptorCount == InfoInd)
+        // clang-format on
+        {
+            ++Write.descriptorCount;
+            return;
+        }
+    }
+
+    PendingWrite NewWrite;
+    NewWrite.FirstInfo = InfoInd;
+
+    auto& Write = NewWrite.Write;
+    Write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    Write.pNext           = nullptr;
+    Write.dstSet          = vkDescrSet;
+    Write.dstBinding      = Binding;
+    Write.dstArrayElement = ArrayElement;
+    Write.descriptorCount = 1;
+    Write.descriptorType  = DescrType;
+    // Non-null pointers only mark the info type until the batch is flushed
+    Write.pImageInfo       = pImageInfo;
+    Write.pBufferInfo      = pBufferInfo;
+    Write.pTexelBufferView = pTexelBufferView;
+    m_Writes.push_back(NewWrite);
+}
+
+void DescriptorSetWriteBatch::Flush(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+{
+    if (m_Writes.empty())
+        return;
+
+    m_FlushWrites.clear();
+    m_FlushWrites.reserve(m_Writes.size());
+    for (const auto& PendingWrite : m_Writes)
+    {
+        m_FlushWrites.push_back(PendingWrite.Write);
+        auto& Write = m_FlushWrites.back();
+        if (Write.pImageInfo != nullptr)
+            Write.pImageInfo = &m_ImageInfos[PendingWrite.FirstInfo];
+        else if (Write.pBufferInfo != nullptr)
+            Write.pBufferInfo = &m_BufferInfos[PendingWrite.FirstInfo];
+        else
+            Write.pTexelBufferView = &m_TexelBufferViews[PendingWrite.FirstInfo];
+    }
+
+    LogicalDevice.UpdateDescriptorSets(static_cast<uint32_t>(m_FlushWrites.size()), m_FlushWrites.data(), 0, nullptr);
+
+    m_Writes.clear();
+    m_ImageInfos.clear();
+    m_BufferInfos.clear();
+    m_TexelBufferViews.clear();
+}
+
+
 void ShaderResourceLayoutVk::VkResource::UpdateDescriptorHandle(VkDescriptorSet               vkDescrSet,
                                                                 uint32_t                      ArrayElement,
                                                                 const VkDescriptorImageInfo*  pImageInfo,
                                                                 const VkDescriptorBufferInfo* pBufferInfo,
-                                                                const VkBufferView*           pTexelBufferView) const
+                                                                const VkBufferView*           pTexelBufferView,
+                                                                DescriptorSetWriteBatch*      pWriteBatch) const
 {
     VERIFY_EXPR(vkDescrSet != VK_NULL_HANDLE);
 
+    if (pWriteBatch != nullptr)
+    {
+        pWriteBatch->AddWrite(vkDescrSet, Binding, ArrayElement, PipelineLayout::GetVkDescriptorType(SpirvAttribs), pImageInfo, pBufferInfo, pTexelBufferView);
+        return;
+    }
+
     VkWriteDescriptorSet WriteDescrSet;
     WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     WriteDescrSet.pNext           = nullptr;
@@ -607,7 +736,8 @@ void ShaderResourceLayoutVk::VkResource::CacheUniformBuffer(IDeviceObject*
                                                             ShaderResourceCacheVk::Resource& DstRes,
                                                             VkDescriptorSet                  vkDescrSet,
                                                             Uint32                           ArrayInd,
-                                                            Uint16&                          DynamicBuffersCounter) const
+                                                            Uint16&                          DynamicBuffersCounter,
+                                                            DescriptorSetWriteBatch*         pWriteBatch) const
 {
     VERIFY(SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::UniformBuffer, "Uniform buffer resource is expected");
     RefCntAutoPtr<BufferVkImpl> pBufferVk(pBuffer, IID_BufferVk);
@@ -634,7 +764,7 @@ void ShaderResourceLayoutVk::VkResource::CacheUniformBuffer(IDeviceObject*
         if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
         {
             VkDescriptorBufferInfo DescrBuffInfo = DstRes.GetUniformBufferDescriptorWriteInfo();
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, nullptr, &DescrBuffInfo, nullptr);
+            UpdateDescriptorHandle(vkDescrSet, ArrayInd, nullptr, &DescrBuffInfo, nullptr, pWriteBatch);
         }
     }
 }
@@ -643,7 +773,8 @@ void ShaderResourceLayoutVk::VkResource::CacheStorageBuffer(IDeviceObject*
                                                             ShaderResourceCacheVk::Resource& DstRes,
                                                             VkDescriptorSet                  vkDescrSet,
                                                             Uint32                           ArrayInd,
-                                                            Uint16&                          DynamicBuffersCounter) const
+                                                            Uint16&                          DynamicBuffersCounter,
+                                                            DescriptorSetWriteBatch*         pWriteBatch) const
 {
     // clang-format off
     VERIFY(SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer || 
@@ -680,7 +811,7 @@ void ShaderResourceLayoutVk::VkResource::CacheStorageBuffer(IDeviceObject*
         if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
         {
             VkDescriptorBufferInfo DescrBuffInfo = DstRes.GetStorageBufferDescriptorWriteInfo();
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, nullptr, &DescrBuffInfo, nullptr);
+            UpdateDescriptorHandle(vkDescrSet, ArrayInd, nullptr, &DescrBuffInfo, nullptr, pWriteBatch);
         }
     }
 }
@@ -689,7 +820,8 @@ void ShaderResourceLayoutVk::VkResource::CacheTexelBuffer(IDeviceObject*
                                                           ShaderResourceCacheVk::Resource& DstRes,
                                                           VkDescriptorSet                  vkDescrSet,
                                                           Uint32                           ArrayInd,
-                                                          Uint16&                          DynamicBuffersCounter) const
+                                                          Uint16&                          DynamicBuffersCounter,
+                                                          DescriptorSetWriteBatch*         pWriteBatch) const
 {
     // clang-format off
     VERIFY(SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer || 
@@ -727,7 +859,7 @@ void ShaderResourceLayoutVk::VkResource::CacheTexelBuffer(IDeviceObject*
         if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
         {
             VkBufferView BuffView = DstRes.pObject.RawPtr<BufferViewVkImpl>()->GetVkBufferView();
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, nullptr, nullptr, &BuffView);
+            UpdateDescriptorHandle(vkDescrSet, ArrayInd, nullptr, nullptr, &BuffView, pWriteBatch);
         }
     }
 }
@@ -737,6 +869,7 @@ void ShaderResourceLayoutVk::VkResource::CacheImage(IDeviceObject*
                                                     ShaderResourceCacheVk::Resource& DstRes,
                                                     VkDescriptorSet                  vkDescrSet,
                                                     Uint32                           ArrayInd,
+                                                    DescriptorSetWriteBatch*         pWriteBatch,
                                                     TCacheSampler                    CacheSampler) const
 {
     // clang-format off
@@ -774,7 +907,7 @@ void ShaderResourceLayoutVk::VkResource::CacheImage(IDeviceObject*
         if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
         {
             VkDescriptorImageInfo DescrImgInfo = DstRes.GetImageDescriptorWriteInfo(IsImmutableSamplerAssigned());
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, &DescrImgInfo, nullptr, nullptr);
+            UpdateDescriptorHandle(vkDescrSet, ArrayInd, &DescrImgInfo, nullptr, nullptr, pWriteBatch);
         }
 
         if (SamplerInd != InvalidSamplerInd)
@@ -805,7 +938,8 @@ void ShaderResourceLayoutVk::VkResource::CacheImage(IDeviceObject*
 void ShaderResourceLayoutVk::VkResource::CacheSeparateSampler(IDeviceObject*                   pSampler,
                                                               ShaderResourceCacheVk::Resource& DstRes,
                                                               VkDescriptorSet                  vkDescrSet,
-                                                              Uint32                           ArrayInd) const
+                                                              Uint32                           ArrayInd,
+                                                              DescriptorSetWriteBatch*         pWriteBatch) const
 {
     VERIFY(SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler, "Separate sampler resource is expected");
     VERIFY(!IsImmutableSamplerAssigned(), "This separate sampler is assigned an immutable sampler");
@@ -833,13 +967,16 @@ void ShaderResourceLayoutVk::VkResource::CacheSeparateSampler(IDeviceObject*
         if (vkDescrSet != VK_NULL_HANDLE && GetVariableType() != SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
         {
             VkDescriptorImageInfo DescrImgInfo = DstRes.GetSamplerDescriptorWriteInfo();
-            UpdateDescriptorHandle(vkDescrSet, ArrayInd, &DescrImgInfo, nullptr, nullptr);
+            UpdateDescriptorHandle(vkDescrSet, ArrayInd, &DescrImgInfo, nullptr, nullptr, pWriteBatch);
         }
     }
 }
 
 
-void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint32 ArrayIndex, ShaderResourceCacheVk& ResourceCache) const
+void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject*           pObj,
+                                                      Uint32                   ArrayIndex,
+                                                      ShaderResourceCacheVk&   ResourceCache,
+                                                      DescriptorSetWriteBatch* pWriteBatch) const
 {
     VERIFY_EXPR(ArrayIndex < SpirvAttribs.ArraySize);
 
@@ -871,23 +1008,23 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
         switch (SpirvAttribs.Type)
         {
             case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
-                CacheUniformBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
+                CacheUniformBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter(), pWriteBatch);
                 break;
 
             case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
             case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
-                CacheStorageBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
+                CacheStorageBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter(), pWriteBatch);
                 break;
 
             case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
             case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
-                CacheTexelBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter());
+                CacheTexelBuffer(pObj, DstRes, vkDescrSet, ArrayIndex, ResourceCache.GetDynamicBuffersCounter(), pWriteBatch);
                 break;
 
             case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
             case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
             case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
-                CacheImage(pObj, DstRes, vkDescrSet, ArrayIndex,
+                CacheImage(pObj, DstRes, vkDescrSet, ArrayIndex, pWriteBatch,
                            [&](const VkResource& SeparateSampler, ISampler* pSampler) {
                                VERIFY(!SeparateSampler.IsImmutableSamplerAssigned(), "Separate sampler '", SeparateSampler.SpirvAttribs.Name, "' is assigned an immutable sampler");
                                VERIFY_EXPR(SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateImage);
@@ -898,14 +1035,14 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject* pObj, Uint3
                                              "' must be one or the same as the array size (", SpirvAttribs.ArraySize,
                                              ") of separate image variable '", SpirvAttribs.Name, "' it is assigned to");
                                Uint32 SamplerArrInd = SeparateSampler.SpirvAttribs.ArraySize == 1 ? 0 : ArrayIndex;
-                               SeparateSampler.BindResource(pSampler, SamplerArrInd, ResourceCache);
+                               SeparateSampler.BindResource(pSampler, SamplerArrInd, ResourceCache, pWriteBatch);
                            });
                 break;
 
             case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
                 if (!IsImmutableSamplerAssigned())
                 {
-                    CacheSeparateSampler(pObj, DstRes, vkDescrSet, ArrayIndex);
+                    CacheSeparateSampler(pObj, DstRes, vkDescrSet, ArrayIndex, pWriteBatch);
                 }
                 else
                 {
@@ -1048,8 +1185,122 @@ void ShaderResourceLayoutVk::InitializeResourceMemoryInCache(ShaderResourceCache
     }
 }
 
+// Returns false for resources that have no descriptors to write
+static bool HasDescriptorsToWrite(const ShaderResourceLayoutVk::VkResource& Res)
+{
+    // Immutable samplers are permanently bound into the set layout (13.2.1)
+    return Res.SpirvAttribs.Type != SPIRVShaderResourceAttribs::ResourceType::AtomicCounter &&
+        !(Res.SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler && Res.IsImmutableSamplerAssigned());
+}
+
+// Descriptor data is also used as the dynamic descriptor set cache key, so the fields are copied
+// one by one into a zeroed element to keep unused bytes and padding deterministic
+static void WriteTemplateData(DescriptorUpdateTemplateData& Data, const VkDescriptorImageInfo& ImageInfo)
+{
+    memset(&Data, 0, sizeof(Data));
+    Data.ImageInfo.sampler     = ImageInfo.sampler;
+    Data.ImageInfo.imageView   = ImageInfo.imageView;
+    Data.ImageInfo.imageLayout = ImageInfo.imageLayout;
+}
+
+static void WriteTemplateData(DescriptorUpdateTemplateData& Data, const VkDescriptorBufferInfo& BufferInfo)
+{
+    memset(&Data, 0, sizeof(Data));
+    Data.BufferInfo.buffer = BufferInfo.buffer;
+    Data.BufferInfo.offset = BufferInfo.offset;
+    Data.BufferInfo.range  = BufferInfo.range;
+}
+
+static void WriteTemplateData(DescriptorUpdateTemplateData& Data, VkBufferView TexelBufferView)
+{
+    memset(&Data, 0, sizeof(Data));
+    Data.TexelBufferView = TexelBufferView;
+}
+
+void ShaderResourceLayoutVk::GetDynamicResourceUpdateTemplateEntries(std::vector<VkDescriptorUpdateTemplateEntry>& Entries,
+                                                                     Uint32&                                       DataOffset) const
+{
+    Uint32 NumDynamicResources = m_NumResources[SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC];
+    for (Uint32 r = 0; r < NumDynamicResources; ++r)
+    {
+        const auto& Res = GetResource(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, r);
+        if (!HasDescriptorsToWrite(Res))
+            continue;
+
+        VkDescriptorUpdateTemplateEntry Entry;
+        Entry.dstBinding      = Res.Binding;
+        Entry.dstArrayElement = 0;
+        Entry.descriptorCount = Res.SpirvAttribs.ArraySize;
+        Entry.descriptorType  = PipelineLayout::GetVkDescriptorType(Res.SpirvAttribs);
+        Entry.offset          = size_t{DataOffset} * sizeof(DescriptorUpdateTemplateData);
+        Entry.stride          = sizeof(DescriptorUpdateTemplateData);
+        Entries.push_back(Entry);
+
+        DataOffset += Res.SpirvAttribs.ArraySize;
+    }
+}
+
+DescriptorUpdateTemplateData* ShaderResourceLayoutVk::WriteDynamicResourceDescriptors(const ShaderResourceCacheVk&  ResourceCache,
+                                                                                      DescriptorUpdateTemplateData* pData) const
+{
+    Uint32 NumDynamicResources = m_NumResources[SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC];
+    for (Uint32 r = 0; r < NumDynamicResources; ++r)
+    {
+        const auto& Res = GetResource(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, r);
+        if (!HasDescriptorsToWrite(Res))
+            continue;
+
+        const auto& SetResources = ResourceCache.GetDescriptorSet(Res.DescriptorSet);
+        for (Uint32 ArrElem = 0; ArrElem < Res.SpirvAttribs.ArraySize; ++ArrElem, ++pData)
+        {
+            const auto& CachedRes = SetResources.GetResource(Res.CacheOffset + ArrElem);
+            switch (Res.SpirvAttribs.Type)
+            {
+                case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+                    WriteTemplateData(*pData, CachedRes.GetUniformBufferDescriptorWriteInfo());
+                    break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer:
+                case SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer:
+                    WriteTemplateData(*pData, CachedRes.GetStorageBufferDescriptorWriteInfo());
+                    break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+                case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+                    WriteTemplateData(*pData, CachedRes.GetBufferViewWriteInfo());
+                    break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+                case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+                case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+                    WriteTemplateData(*pData, CachedRes.GetImageDescriptorWriteInfo(Res.IsImmutableSamplerAssigned()));
+                    break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+                    WriteTemplateData(*pData, CachedRes.GetSamplerDescriptorWriteInfo());
+                    break;
+
+                default:
+                    UNEXPECTED("Unexpected resource type");
+            }
+        }
+    }
+    return pData;
+}
+
 void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                                     VkDescriptorSet              vkDynamicDescriptorSet) const
+{
+    CommitDynamicResources(ResourceCache, vkDynamicDescriptorSet,
+                           [this](Uint32 DescriptorWriteCount, const VkWriteDescriptorSet* pDescriptorWrites) //
+                           {
+                               m_LogicalDevice.UpdateDescriptorSets(DescriptorWriteCount, pDescriptorWrites, 0, nullptr);
+                           });
+}
+
+void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk&            ResourceCache,
+                                                    VkDescriptorSet                         vkDynamicDescriptorSet,
+                                                    const UpdateDescriptorSetsCallbackType& UpdateDescriptorSets) const
 {
     Uint32 NumDynamicResources = m_NumResources[SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC];
     VERIFY(NumDynamicResources != 0, "This shader resource layout does not contain dynamic resources");
@@ -1206,7 +1457,7 @@ void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk&
         {
             auto DescrWriteCount = static_cast<Uint32>(std::distance(WriteDescrSetArr.begin(), WriteDescrSetIt));
             if (DescrWriteCount > 0)
-                m_LogicalDevice.UpdateDescriptorSets(DescrWriteCount, WriteDescrSetArr.data(), 0, nullptr);
+                UpdateDescriptorSets(DescrWriteCount, WriteDescrSetArr.data());
 
             DescrImgIt      = DescrImgInfoArr.begin();
             DescrBuffIt     = DescrBuffInfoArr.begin();
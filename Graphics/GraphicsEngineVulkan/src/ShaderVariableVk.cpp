@@ -33,53 +33,75 @@
 namespace Diligent
 {
 
-size_t ShaderVariableManagerVk::GetRequiredMemorySize(const ShaderResourceLayoutVk&        Layout,
-                                                      const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
-                                                      Uint32                               NumAllowedTypes,
-                                                      Uint32&                              NumVariables)
+template <typename THandler>
+void ShaderVariableManagerVk::ProcessVariableResources(const ShaderResourceLayoutVk& Layout, Uint32 AllowedTypeBits, THandler Handler)
 {
-    NumVariables                       = 0;
-    const Uint32 AllowedTypeBits       = GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes);
-    const bool   UsingSeparateSamplers = Layout.IsUsingSeparateSamplers();
+    const bool UsingSeparateSamplers = Layout.IsUsingSeparateSamplers();
     for (SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC; VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES; VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VarType + 1))
     {
-        if (IsAllowedType(VarType, AllowedTypeBits))
-        {
-            auto NumResources = Layout.GetResourceCount(VarType);
-            for (Uint32 r = 0; r < NumResources; ++r)
-            {
-                const auto& SrcRes = Layout.GetResource(VarType, r);
+        if (!IsAllowedType(VarType, AllowedTypeBits))
+            continue;
 
-                // When using HLSL-style combined image samplers, we need to skip separate samplers.
-                // Also always skip immutable separate samplers.
-                if (SrcRes.SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler &&
-                    (!UsingSeparateSamplers || SrcRes.IsImmutableSamplerAssigned()))
-                    continue;
+        Uint32 NumResources = Layout.GetResourceCount(VarType);
+        for (Uint32 r = 0; r < NumResources; ++r)
+        {
+            const auto& SrcRes = Layout.GetResource(VarType, r);
+            // Skip separate samplers when using combined HLSL-style image samplers. Also always skip immutable separate samplers.
+            if (SrcRes.SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler &&
+                (!UsingSeparateSamplers || SrcRes.IsImmutableSamplerAssigned()))
+                continue;
 
-                ++NumVariables;
-            }
+            Handler(SrcRes);
         }
     }
+}
+
+size_t ShaderVariableManagerVk::GetRequiredMemorySize(const ShaderResourceLayoutVk&        Layout,
+                                                      const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                                                      Uint32                               NumAllowedTypes,
+                                                      Uint32&                              NumVariables)
+{
+    NumVariables = 0;
+    ProcessVariableResources(Layout, GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes),
+                             [&](const ShaderResourceLayoutVk::VkResource&) //
+                             {
+                                 ++NumVariables;
+                             });
 
     return NumVariables * sizeof(ShaderVariableVkImpl);
 }
 
+ShaderVariableIndexMap ShaderVariableManagerVk::CreateVariableIndexMap(const ShaderResourceLayoutVk&        Layout,
+                                                                       const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
+                                                                       Uint32                               NumAllowedTypes)
+{
+    std::vector<const Char*> Names;
+    ProcessVariableResources(Layout, GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes),
+                             [&](const ShaderResourceLayoutVk::VkResource& Res) //
+                             {
+                                 Names.push_back(Res.SpirvAttribs.Name);
+                             });
+
+    return ShaderVariableIndexMap{static_cast<Uint32>(Names.size()), [&](Uint32 v) { return Names[v]; }};
+}
+
 // Creates shader variable for every resource from SrcLayout whose type is one AllowedVarTypes
 ShaderVariableManagerVk::ShaderVariableManagerVk(IObject&                             Owner,
                                                  const ShaderResourceLayoutVk&        SrcLayout,
+                                                 const ShaderVariableIndexMap&        VarIndexMap,
                                                  IMemoryAllocator&                    Allocator,
                                                  const SHADER_RESOURCE_VARIABLE_TYPE* AllowedVarTypes,
                                                  Uint32                               NumAllowedTypes,
                                                  ShaderResourceCacheVk&               ResourceCache) :
     // clang-format off
     m_Owner        {Owner        },
-    m_ResourceCache{ResourceCache}
+    m_ResourceCache{ResourceCache},
+    m_VarIndexMap  {VarIndexMap  }
 #ifdef _DEBUG
   , m_DbgAllocator {Allocator}
 #endif
 // clang-format on
 {
-    const Uint32 AllowedTypeBits = GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes);
     VERIFY_EXPR(m_NumVariables == 0);
     auto MemSize = GetRequiredMemorySize(SrcLayout, AllowedVarTypes, NumAllowedTypes, m_NumVariables);
 
@@ -89,26 +111,13 @@ ShaderVariableManagerVk::ShaderVariableManagerVk(IObject&
     auto* pRawMem = ALLOCATE_RAW(Allocator, "Raw memory buffer for shader variables", MemSize);
     m_pVariables  = reinterpret_cast<ShaderVariableVkImpl*>(pRawMem);
 
-    Uint32     VarInd                = 0;
-    const bool UsingSeparateSamplers = SrcLayout.IsUsingSeparateSamplers();
-    for (SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC; VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES; VarType = static_cast<SHADER_RESOURCE_VARIABLE_TYPE>(VarType + 1))
-    {
-        if (!IsAllowedType(VarType, AllowedTypeBits))
-            continue;
-
-        Uint32 NumResources = SrcLayout.GetResourceCount(VarType);
-        for (Uint32 r = 0; r < NumResources; ++r)
-        {
-            const auto& SrcRes = SrcLayout.GetResource(VarType, r);
-            // Skip separate samplers when using combined HLSL-style image samplers. Also always skip immutable separate samplers.
-            if (SrcRes.SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler &&
-                (!UsingSeparateSamplers || SrcRes.IsImmutableSamplerAssigned()))
-                continue;
-
-            ::new (m_pVariables + VarInd) ShaderVariableVkImpl(*this, SrcRes);
-            ++VarInd;
-        }
-    }
+    Uint32 VarInd = 0;
+    ProcessVariableResources(SrcLayout, GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes),
+                             [&](const ShaderResourceLayoutVk::VkResource& SrcRes) //
+                             {
+                                 ::new (m_pVariables + VarInd) ShaderVariableVkImpl(*this, SrcRes);
+                                 ++VarInd;
+                             });
     VERIFY_EXPR(VarInd == m_NumVariables);
 }
 
@@ -130,22 +139,26 @@ void ShaderVariableManagerVk::DestroyVariables(IMemoryAllocator& Allocator)
     }
 }
 
+ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariableAtMapIndex(Uint32 Index, const Char* Name)
+{
+    if (Index == ShaderVariableIndexMap::InvalidIndex)
+        return nullptr;
+
+    VERIFY(Index < m_NumVariables, "Variable index map is not consistent with this manager");
+    auto& Var = m_pVariables[Index];
+    VERIFY(Name == nullptr || strcmp(Var.m_Resource.SpirvAttribs.Name, Name) == 0, "Variable index map is not consistent with this manager");
+    return &Var;
+}
+
 ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(const Char* Name)
 {
-    ShaderVariableVkImpl* pVar = nullptr;
-    for (Uint32 v = 0; v < m_NumVariables; ++v)
-    {
-        auto&       Var = m_pVariables[v];
-        const auto& Res = Var.m_Resource;
-        if (strcmp(Res.SpirvAttribs.Name, Name) == 0)
-        {
-            pVar = &Var;
-            break;
-        }
-    }
-    return pVar;
+    return GetVariableAtMapIndex(m_VarIndexMap.Find(Name), Name);
 }
 
+ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariableByHash(Uint64 NameHash)
+{
+    return GetVariableAtMapIndex(m_VarIndexMap.FindByHash(NameHash), nullptr);
+}
 
 ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(Uint32 Index)
 {
@@ -43,7 +43,9 @@ namespace Diligent
 
 ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
                            RenderDeviceVkImpl*     pRenderDeviceVk,
-                           const ShaderCreateInfo& CreationAttribs) :
+                           const ShaderCreateInfo& CreationAttribs,
+                           const void*             pSerializedResources,
+                           size_t                  SerializedResourcesSize) :
     // clang-format off
     TShaderBase
     {
@@ -53,6 +55,13 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     }
 // clang-format on
 {
+    const char* const CombinedSamplerSuffix = CreationAttribs.UseCombinedTextureSamplers ? CreationAttribs.CombinedSamplerSuffix : nullptr;
+
+    // Shader resources serialized in the SPIR-V cache entry
+    std::vector<Uint8> CachedResources;
+    SPIRVCache::Key    CacheKey;
+    bool               UpdateCache = false;
+
     if (CreationAttribs.Source != nullptr || CreationAttribs.FilePath != nullptr)
     {
 #if NO_GLSLANG
@@ -61,9 +70,31 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
         DEV_CHECK_ERR(CreationAttribs.ByteCode == nullptr, "'ByteCode' must be null when shader is created from source code or a file");
         DEV_CHECK_ERR(CreationAttribs.ByteCodeSize == 0, "'ByteCodeSize' must be 0 when shader is created from source code or a file");
 
+        auto& Cache = pRenderDeviceVk->GetSPIRVCache();
+        // The version string is computed once as it does not change while the application is running
+        static const std::string CompilerVersion = GetSPIRVCompilerVersion();
+
+        // Optimization flags affect the byte code and the combined sampler suffix affects
+        // serialized resources, so they are made part of the cache key
+        const auto  OptimizationFlags    = pRenderDeviceVk->GetSPIRVOptimizationFlags();
+        std::string CacheCompilerVersion = CompilerVersion + "; SPIR-V optimization flags " + std::to_string(static_cast<Uint32>(OptimizationFlags));
+        if (CombinedSamplerSuffix != nullptr)
+        {
+            CacheCompilerVersion += "; combined sampler suffix ";
+            CacheCompilerVersion += CombinedSamplerSuffix;
+        }
+
+        bool IsCached = false;
         if (CreationAttribs.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
         {
-            m_SPIRV = HLSLtoSPIRV(CreationAttribs, CreationAttribs.ppCompilerOutput);
+            if (Cache.IsEnabled())
+            {
+                CacheKey = SPIRVCache::ComputeHLSLKey(CreationAttribs, CacheCompilerVersion.c_str());
+                IsCached = Cache.Load(CacheKey, m_SPIRV, CachedResources);
+            }
+
+            if (!IsCached)
+                m_SPIRV = HLSLtoSPIRV(CreationAttribs, CreationAttribs.ppCompilerOutput, OptimizationFlags);
         }
         else
         {
@@ -71,15 +102,33 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
                                                     TargetGLSLCompiler::glslang,
                                                     "#define TARGET_API_VULKAN 1\n");
 
-            m_SPIRV = GLSLtoSPIRV(m_Desc.ShaderType, GLSLSource.c_str(),
-                                  static_cast<int>(GLSLSource.length()),
-                                  CreationAttribs.ppCompilerOutput);
+            if (Cache.IsEnabled())
+            {
+                CacheKey = SPIRVCache::ComputeGLSLKey(m_Desc.ShaderType, GLSLSource, CacheCompilerVersion.c_str());
+                IsCached = Cache.Load(CacheKey, m_SPIRV, CachedResources);
+            }
+
+            if (!IsCached)
+            {
+                m_SPIRV = GLSLtoSPIRV(m_Desc.ShaderType, GLSLSource.c_str(),
+                                      static_cast<int>(GLSLSource.length()),
+                                      CreationAttribs.ppCompilerOutput,
+                                      OptimizationFlags);
+            }
         }
 
         if (m_SPIRV.empty())
         {
             LOG_ERROR_AND_THROW("Failed to compile shader");
         }
+
+        // Entries without serialized resources are updated after reflection
+        UpdateCache = Cache.IsEnabled() && (!IsCached || CachedResources.empty());
+        if (!CachedResources.empty())
+        {
+            pSerializedResources    = CachedResources.data();
+            SerializedResourcesSize = CachedResources.size();
+        }
 #endif
     }
     else if (CreationAttribs.ByteCode != nullptr)
@@ -101,10 +150,39 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     auto& Allocator          = GetRawAllocator();
     auto* pRawMem            = ALLOCATE(Allocator, "Allocator for ShaderResources", SPIRVShaderResources, 1);
     bool  IsHLSLVertexShader = CreationAttribs.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL && m_Desc.ShaderType == SHADER_TYPE_VERTEX;
-    auto* pResources         = new (pRawMem) SPIRVShaderResources(Allocator, pRenderDeviceVk, m_SPIRV, m_Desc, CreationAttribs.UseCombinedTextureSamplers ? CreationAttribs.CombinedSamplerSuffix : nullptr, IsHLSLVertexShader, m_EntryPoint);
+
+    SPIRVShaderResources* pResources = nullptr;
+    if (pSerializedResources != nullptr && SerializedResourcesSize != 0)
+    {
+        // Rehydrate resources from the cache or the shader archive to avoid running reflection
+        try
+        {
+            pResources = new (pRawMem) SPIRVShaderResources(Allocator, pSerializedResources, SerializedResourcesSize, m_Desc, CombinedSamplerSuffix, m_EntryPoint);
+        }
+        catch (...)
+        {
+            LOG_WARNING_MESSAGE("Failed to load serialized resources of shader '", (m_Desc.Name != nullptr ? m_Desc.Name : ""),
+                                "'. Falling back to SPIR-V reflection.");
+            m_EntryPoint.clear();
+            UpdateCache = !CachedResources.empty();
+        }
+    }
+    if (pResources == nullptr)
+    {
+        pResources = new (pRawMem) SPIRVShaderResources(Allocator, pRenderDeviceVk, m_SPIRV, m_Desc, CombinedSamplerSuffix, IsHLSLVertexShader, m_EntryPoint);
+    }
     m_pShaderResources.reset(pResources, STDDeleterRawMem<SPIRVShaderResources>(Allocator));
 
-    if (IsHLSLVertexShader)
+    // Store the entry before vertex shader input locations are remapped
+    if (UpdateCache)
+    {
+        std::vector<Uint8> Resources;
+        m_pShaderResources->Serialize(m_EntryPoint, Resources);
+        pRenderDeviceVk->GetSPIRVCache().Store(CacheKey, m_SPIRV, Resources);
+    }
+
+    // Stage inputs are only loaded for vertex shaders compiled from HLSL
+    if (m_pShaderResources->GetNumShaderStageInputs() > 0)
     {
         MapHLSLVertexShaderInputs();
     }
@@ -53,6 +53,23 @@ TextureViewVkImpl::TextureViewVkImpl(IReferenceCounters*                 pRefCou
 {
 }
 
+void TextureViewVkImpl::AllocateBindlessSlot()
+{
+    VERIFY(m_BindlessIndex == BindlessResourceTableVk::InvalidIndex, "Bindless slot has already been allocated");
+
+    auto* pBindlessTable = m_pDevice->GetBindlessResourceTable();
+    if (pBindlessTable == nullptr || m_Desc.ViewType != TEXTURE_VIEW_SHADER_RESOURCE)
+        return;
+
+    VkDescriptorImageInfo ImageInfo = {};
+    ImageInfo.imageView             = m_ImageView;
+    // Same layout as the one used by ShaderResourceCacheVk::Resource::GetImageDescriptorWriteInfo()
+    ImageInfo.imageLayout = (m_pTexture->GetDesc().BindFlags & BIND_DEPTH_STENCIL) != 0 ?
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL :
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    m_BindlessIndex = pBindlessTable->AllocateSampledImage(ImageInfo, m_Desc.Name);
+}
+
 TextureViewVkImpl::~TextureViewVkImpl()
 {
     if (m_MipLevelViews != nullptr)
@@ -67,6 +84,8 @@ TextureViewVkImpl::~TextureViewVkImpl()
 
     if (m_Desc.ViewType == TEXTURE_VIEW_DEPTH_STENCIL || m_Desc.ViewType == TEXTURE_VIEW_RENDER_TARGET)
         m_pDevice->GetFramebufferCache().OnDestroyImageView(m_ImageView);
+    if (m_BindlessIndex != BindlessResourceTableVk::InvalidIndex)
+        m_pDevice->GetBindlessResourceTable()->FreeSlot(BindlessResourceTableVk::BINDING_SAMPLED_IMAGE, m_BindlessIndex, m_pTexture->GetDesc().CommandQueueMask);
     m_pDevice->SafeReleaseDeviceObject(std::move(m_ImageView), m_pTexture->GetDesc().CommandQueueMask);
 }
 
@@ -529,6 +529,7 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
         VulkanUtilities::ImageViewWrapper ImgView = CreateImageView(UpdatedViewDesc);
         auto                              pViewVk = NEW_RC_OBJ(TexViewAllocator, "TextureViewVkImpl instance", TextureViewVkImpl, bIsDefaultView ? this : nullptr)(GetDevice(), UpdatedViewDesc, this, std::move(ImgView), bIsDefaultView);
         VERIFY(pViewVk->GetDesc().ViewType == ViewDesc.ViewType, "Incorrect view type");
+        pViewVk->AllocateBindlessSlot();
 
         if (bIsDefaultView)
             *ppView = pViewVk;
@@ -130,9 +130,9 @@ VulkanDynamicMemoryManager::~VulkanDynamicMemoryManager()
     LOG_INFO_MESSAGE("Dynamic memory manager usage stats:\n"
                      "                       Total size: ",
                      FormatMemorySize(Size, 2),
-                     ". Peak allocated size: ", FormatMemorySize(m_TotalPeakSize, 2, Size),
+                     ". Peak allocated size: ", FormatMemorySize(m_TotalPeakSize.load(), 2, Size),
                      ". Peak utilization: ",
-                     std::fixed, std::setprecision(1), static_cast<double>(m_TotalPeakSize) / static_cast<double>(std::max(Size, size_t{1})) * 100.0, '%');
+                     std::fixed, std::setprecision(1), static_cast<double>(m_TotalPeakSize.load()) / static_cast<double>(std::max(Size, size_t{1})) * 100.0, '%');
 }
 
 
@@ -211,7 +211,12 @@ VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMast
 
     if (Block.IsValid())
     {
-        m_TotalPeakSize = std::max(m_TotalPeakSize, GetUsedSize());
+        // Master blocks may be allocated by multiple threads simultaneously
+        const auto UsedSize = GetUsedSize();
+        auto       PeakSize = m_TotalPeakSize.load(std::memory_order_relaxed);
+        while (UsedSize > PeakSize && !m_TotalPeakSize.compare_exchange_weak(PeakSize, UsedSize, std::memory_order_relaxed))
+        {
+        }
     }
 
     return Block;
@@ -400,6 +400,16 @@ void SetQueryPoolName(VkDevice device, VkQueryPool queryPool, const char* name)
     SetObjectName(device, (uint64_t)queryPool, VK_OBJECT_TYPE_QUERY_POOL, name);
 }
 
+void SetPipelineCacheName(VkDevice device, VkPipelineCache pipelineCache, const char* name)
+{
+    SetObjectName(device, (uint64_t)pipelineCache, VK_OBJECT_TYPE_PIPELINE_CACHE, name);
+}
+
+void SetDescriptorUpdateTemplateName(VkDevice device, VkDescriptorUpdateTemplate descriptorUpdateTemplate, const char* name)
+{
+    SetObjectName(device, (uint64_t)descriptorUpdateTemplate, VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, name);
+}
+
 
 template <>
 void SetVulkanObjectName<VkCommandPool, VulkanHandleTypeId::CommandPool>(VkDevice device, VkCommandPool cmdPool, const char* name)
@@ -527,6 +537,18 @@ void SetVulkanObjectName<VkQueryPool, VulkanHandleTypeId::QueryPool>(VkDevice de
     SetQueryPoolName(device, queryPool, name);
 }
 
+template <>
+void SetVulkanObjectName<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(VkDevice device, VkPipelineCache pipelineCache, const char* name)
+{
+    SetPipelineCacheName(device, pipelineCache, name);
+}
+
+template <>
+void SetVulkanObjectName<VkDescriptorUpdateTemplate, VulkanHandleTypeId::DescriptorUpdateTemplate>(VkDevice device, VkDescriptorUpdateTemplate descriptorUpdateTemplate, const char* name)
+{
+    SetDescriptorUpdateTemplateName(device, descriptorUpdateTemplate, name);
+}
+
 
 
 const char* VkResultToString(VkResult errorCode)
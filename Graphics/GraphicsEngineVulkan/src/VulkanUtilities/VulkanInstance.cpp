@@ -135,6 +135,21 @@ VulkanInstance::VulkanInstance(bool                   EnableValidation,
             LOG_ERROR_AND_THROW("Required extension ", ExtName, " is not available");
     }
 
+    // VK_KHR_get_physical_device_properties2 is required to query extended device features
+    // such as descriptor indexing support
+    m_PhysicalDeviceProperties2Enabled = IsExtensionAvailable(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    if (m_PhysicalDeviceProperties2Enabled)
+    {
+        bool AlreadyRequested = false;
+        for (const auto* ExtName : GlobalExtensions)
+        {
+            if (strcmp(ExtName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0)
+                AlreadyRequested = true;
+        }
+        if (!AlreadyRequested)
+            GlobalExtensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    }
+
     if (EnableValidation)
     {
         m_DebugUtilsEnabled = IsExtensionAvailable(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
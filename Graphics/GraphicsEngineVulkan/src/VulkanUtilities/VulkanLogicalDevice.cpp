@@ -26,6 +26,7 @@
  */
 
 #include <limits>
+#include <cstring>
 #include "VulkanErrors.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanDebug.hpp"
@@ -60,6 +61,37 @@ VulkanLogicalDevice::VulkanLogicalDevice(VkPhysicalDevice             vkPhysical
         m_EnabledGraphicsShaderStages |= VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT;
     if (DeviceCI.pEnabledFeatures->tessellationShader)
         m_EnabledGraphicsShaderStages |= VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT | VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT;
+
+    for (uint32_t ext = 0; ext < DeviceCI.enabledExtensionCount; ++ext)
+    {
+        if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME) == 0)
+        {
+            m_vkCreateDescriptorUpdateTemplateKHR  = reinterpret_cast<PFN_vkCreateDescriptorUpdateTemplateKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkCreateDescriptorUpdateTemplateKHR"));
+            m_vkDestroyDescriptorUpdateTemplateKHR = reinterpret_cast<PFN_vkDestroyDescriptorUpdateTemplateKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkDestroyDescriptorUpdateTemplateKHR"));
+            m_vkUpdateDescriptorSetWithTemplateKHR = reinterpret_cast<PFN_vkUpdateDescriptorSetWithTemplateKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkUpdateDescriptorSetWithTemplateKHR"));
+            if (m_vkCreateDescriptorUpdateTemplateKHR == nullptr || m_vkDestroyDescriptorUpdateTemplateKHR == nullptr || m_vkUpdateDescriptorSetWithTemplateKHR == nullptr)
+            {
+                LOG_WARNING_MESSAGE("Failed to load ", VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME, " extension functions");
+                m_vkCreateDescriptorUpdateTemplateKHR  = nullptr;
+                m_vkDestroyDescriptorUpdateTemplateKHR = nullptr;
+                m_vkUpdateDescriptorSetWithTemplateKHR = nullptr;
+            }
+        }
+    }
+
+    for (uint32_t ext = 0; ext < DeviceCI.enabledExtensionCount; ++ext)
+    {
+        // vkCmdPushDescriptorSetWithTemplateKHR is only available when descriptor update templates are supported
+        if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) == 0 && IsDescriptorUpdateTemplateSupported())
+        {
+            m_vkCmdPushDescriptorSetWithTemplateKHR = reinterpret_cast<PFN_vkCmdPushDescriptorSetWithTemplateKHR>(vkGetDeviceProcAddr(m_VkDevice, "vkCmdPushDescriptorSetWithTemplateKHR"));
+            if (m_vkCmdPushDescriptorSetWithTemplateKHR == nullptr)
+                LOG_WARNING_MESSAGE("Failed to load ", VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, " extension functions");
+        }
+
+        if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0)
+            m_DescriptorIndexingEnabled = true;
+    }
 }
 
 VkQueue VulkanLogicalDevice::GetQueue(uint32_t queueFamilyIndex, uint32_t queueIndex)
@@ -257,6 +289,19 @@ QueryPoolWrapper VulkanLogicalDevice::CreateQueryPool(const VkQueryPoolCreateInf
     return CreateVulkanObject<VkQueryPool, VulkanHandleTypeId::QueryPool>(vkCreateQueryPool, QueryPoolCI, DebugName, "query pool");
 }
 
+DescriptorUpdateTemplateWrapper VulkanLogicalDevice::CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfo& TemplateCI, const char* DebugName) const
+{
+    VERIFY_EXPR(TemplateCI.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO);
+    VERIFY(IsDescriptorUpdateTemplateSupported(), "Descriptor update templates are not supported by this device");
+    return CreateVulkanObject<VkDescriptorUpdateTemplate, VulkanHandleTypeId::DescriptorUpdateTemplate>(m_vkCreateDescriptorUpdateTemplateKHR, TemplateCI, DebugName, "descriptor update template");
+}
+
+PipelineCacheWrapper VulkanLogicalDevice::CreatePipelineCache(const VkPipelineCacheCreateInfo& PipelineCacheCI, const char* DebugName) const
+{
+    VERIFY_EXPR(PipelineCacheCI.sType == VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
+    return CreateVulkanObject<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(vkCreatePipelineCache, PipelineCacheCI, DebugName, "pipeline cache");
+}
+
 VkCommandBuffer VulkanLogicalDevice::AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo& AllocInfo, const char* DebugName) const
 {
     VERIFY_EXPR(AllocInfo.sType == VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO);
@@ -296,6 +341,25 @@ VkDescriptorSet VulkanLogicalDevice::AllocateVkDescriptorSet(const VkDescriptorS
     return DescrSet;
 }
 
+bool VulkanLogicalDevice::AllocateVkDescriptorSets(const VkDescriptorSetAllocateInfo& AllocInfo, VkDescriptorSet* pDescrSets, const char* DebugName) const
+{
+    VERIFY_EXPR(AllocInfo.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO);
+    VERIFY_EXPR(pDescrSets != nullptr);
+
+    // If the allocation fails, no sets are allocated (13.2.3)
+    auto err = vkAllocateDescriptorSets(m_VkDevice, &AllocInfo, pDescrSets);
+    if (err != VK_SUCCESS)
+        return false;
+
+    if (DebugName != nullptr && *DebugName != 0)
+    {
+        for (uint32_t i = 0; i < AllocInfo.descriptorSetCount; ++i)
+            SetDescriptorSetName(m_VkDevice, pDescrSets[i], DebugName);
+    }
+
+    return true;
+}
+
 void VulkanLogicalDevice::ReleaseVulkanObject(CommandPoolWrapper&& CmdPool) const
 {
     vkDestroyCommandPool(m_VkDevice, CmdPool.m_VkObject, m_VkAllocator);
@@ -398,6 +462,19 @@ void VulkanLogicalDevice::ReleaseVulkanObject(QueryPoolWrapper&& QueryPool) cons
     QueryPool.m_VkObject = VK_NULL_HANDLE;
 }
 
+void VulkanLogicalDevice::ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache) const
+{
+    vkDestroyPipelineCache(m_VkDevice, PipelineCache.m_VkObject, m_VkAllocator);
+    PipelineCache.m_VkObject = VK_NULL_HANDLE;
+}
+
+void VulkanLogicalDevice::ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescriptorUpdateTemplate) const
+{
+    VERIFY_EXPR(m_vkDestroyDescriptorUpdateTemplateKHR != nullptr);
+    m_vkDestroyDescriptorUpdateTemplateKHR(m_VkDevice, DescriptorUpdateTemplate.m_VkObject, m_VkAllocator);
+    DescriptorUpdateTemplate.m_VkObject = VK_NULL_HANDLE;
+}
+
 void VulkanLogicalDevice::FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const
 {
     VERIFY_EXPR(Pool != VK_NULL_HANDLE && Set != VK_NULL_HANDLE);
@@ -479,6 +556,25 @@ void VulkanLogicalDevice::UpdateDescriptorSets(uint32_t                    descr
     vkUpdateDescriptorSets(m_VkDevice, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
 }
 
+void VulkanLogicalDevice::UpdateDescriptorSetWithTemplate(VkDescriptorSet            descriptorSet,
+                                                          VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                                          const void*                pData) const
+{
+    VERIFY(IsDescriptorUpdateTemplateSupported(), "Descriptor update templates are not supported by this device");
+    m_vkUpdateDescriptorSetWithTemplateKHR(m_VkDevice, descriptorSet, descriptorUpdateTemplate, pData);
+}
+
+void VulkanLogicalDevice::CmdPushDescriptorSetWithTemplate(VkCommandBuffer            commandBuffer,
+                                                           VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                                           VkPipelineLayout           layout,
+                                                           uint32_t                   set,
+                                                           const void*                pData) const
+{
+    VERIFY(IsPushDescriptorSupported(), "Push descriptors are not supported by this device");
+    VERIFY_EXPR(commandBuffer != VK_NULL_HANDLE);
+    m_vkCmdPushDescriptorSetWithTemplateKHR(commandBuffer, descriptorUpdateTemplate, layout, set, pData);
+}
+
 VkResult VulkanLogicalDevice::ResetCommandPool(VkCommandPool           vkCmdPool,
                                                VkCommandPoolResetFlags flags) const
 {
@@ -106,6 +106,18 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
     }
 }
 
+VkDeviceSize VulkanMemoryPage::GetFreeSize()
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    return m_AllocationMgr.GetFreeSize();
+}
+
+Diligent::VariableSizeAllocationsManager::FragmentationStats VulkanMemoryPage::GetFragmentationStats()
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    return m_AllocationMgr.GetFragmentationStats();
+}
+
 void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
 {
     m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size, m_CPUMemory != nullptr);
@@ -173,6 +185,14 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     size_t stat_ind = HostVisible ? 1 : 0;
     if (Allocation.Page == nullptr)
     {
+        // None of the existing pages has a free block large enough for the allocation, so
+        // if their total free size is sufficient, the new page is only needed due to fragmentation.
+        VkDeviceSize TotalFreeSize = 0;
+        for (auto page_it = range.first; page_it != range.second; ++page_it)
+            TotalFreeSize += page_it->second.GetFreeSize();
+        if (TotalFreeSize >= Size)
+            ++m_FragmentedPageAllocations[stat_ind];
+
         auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
         while (PageSize < Size)
             PageSize *= 2;
@@ -228,6 +248,33 @@ void VulkanMemoryManager::ShrinkMemory()
     }
 }
 
+void VulkanMemoryManager::LogFragmentationStats()
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    for (auto& it : m_Pages)
+    {
+        auto& Page  = it.second;
+        auto  Stats = Page.GetFragmentationStats();
+
+        std::stringstream HistogramSS;
+        for (size_t bin = 0; bin < Stats.FreeBlockHistogram.size(); ++bin)
+        {
+            if (Stats.FreeBlockHistogram[bin] != 0)
+            {
+                Diligent::FormatStrSS(HistogramSS, "\n                           >= ", Diligent::FormatMemorySize(VkDeviceSize{1} << bin, 0),
+                                      ": ", Stats.FreeBlockHistogram[bin]);
+            }
+        }
+        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': ", (Page.GetCPUMemory() != nullptr ? "host-visible" : "device-local"),
+                         " page (", Diligent::FormatMemorySize(Page.GetPageSize(), 2), ", type idx: ", it.first.MemoryTypeIndex, ")",
+                         "\n                       Free size: ", Diligent::FormatMemorySize(Stats.FreeSize, 2),
+                         ", largest free block: ", Diligent::FormatMemorySize(Stats.LargestFreeBlock, 2),
+                         ", free blocks: ", Stats.NumFreeBlocks,
+                         ", external fragmentation: ", Stats.ExternalFragmentation,
+                         HistogramSS.str());
+    }
+}
+
 void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble)
 {
     m_CurrUsedSize[IsHostVisble ? 1 : 0].fetch_add(-static_cast<int64_t>(Size));
@@ -245,7 +292,9 @@ VulkanMemoryManager::~VulkanMemoryManager()
                      "\n                       Peak used/allocated host-visible memory size: ",
                      Diligent::FormatMemorySize(m_PeakUsedSize[1], 2, m_PeakAllocatedSize[1]), " / ",
                      Diligent::FormatMemorySize(m_PeakAllocatedSize[1], 2, m_PeakAllocatedSize[1]),
-                     " (", PeakHostVisisblePages, (PeakHostVisisblePages == 1 ? " page)" : " pages)"));
+                     " (", PeakHostVisisblePages, (PeakHostVisisblePages == 1 ? " page)" : " pages)"),
+                     "\n                       Pages created due to fragmentation (device-local/host-visible): ",
+                     m_FragmentedPageAllocations[0], " / ", m_FragmentedPageAllocations[1]);
 
     for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
         VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
@@ -29,17 +29,18 @@
 #include <cstring>
 #include "VulkanErrors.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
+#include "VulkanUtilities/VulkanInstance.hpp"
 
 namespace VulkanUtilities
 {
 
-std::unique_ptr<VulkanPhysicalDevice> VulkanPhysicalDevice::Create(VkPhysicalDevice vkDevice)
+std::unique_ptr<VulkanPhysicalDevice> VulkanPhysicalDevice::Create(VkPhysicalDevice vkDevice, const VulkanInstance& Instance)
 {
-    auto* PhysicalDevice = new VulkanPhysicalDevice{vkDevice};
+    auto* PhysicalDevice = new VulkanPhysicalDevice{vkDevice, Instance};
     return std::unique_ptr<VulkanPhysicalDevice>{PhysicalDevice};
 }
 
-VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice vkDevice) :
+VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice vkDevice, const VulkanInstance& Instance) :
     m_VkDevice{vkDevice}
 {
     VERIFY_EXPR(m_VkDevice != VK_NULL_HANDLE);
@@ -65,6 +66,47 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice vkDevice) :
         (void)res;
         VERIFY_EXPR(ExtensionCount == m_SupportedExtensions.size());
     }
+
+    // VK_KHR_push_descriptor guarantees that maxPushDescriptors is at least 32. This value is used
+    // when the actual limit can't be queried.
+    m_PushDescriptorProperties.sType              = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+    m_PushDescriptorProperties.maxPushDescriptors = 32;
+
+    if (!Instance.IsPhysicalDeviceProperties2Enabled())
+        return;
+
+    auto vkGetPhysicalDeviceFeatures2KHR   = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(vkGetInstanceProcAddr(Instance.GetVkInstance(), "vkGetPhysicalDeviceFeatures2KHR"));
+    auto vkGetPhysicalDeviceProperties2KHR = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(vkGetInstanceProcAddr(Instance.GetVkInstance(), "vkGetPhysicalDeviceProperties2KHR"));
+    if (vkGetPhysicalDeviceFeatures2KHR == nullptr || vkGetPhysicalDeviceProperties2KHR == nullptr)
+        return;
+
+    if (IsExtensionSupported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+    {
+        VkPhysicalDeviceProperties2KHR Properties2 = {};
+        Properties2.sType                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+        Properties2.pNext                          = &m_PushDescriptorProperties;
+        vkGetPhysicalDeviceProperties2KHR(m_VkDevice, &Properties2);
+        m_PushDescriptorProperties.pNext = nullptr;
+    }
+
+    if (IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+    {
+        m_DescriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+        VkPhysicalDeviceFeatures2KHR Features2 = {};
+        Features2.sType                        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        Features2.pNext                        = &m_DescriptorIndexingFeatures;
+        vkGetPhysicalDeviceFeatures2KHR(m_VkDevice, &Features2);
+        m_DescriptorIndexingFeatures.pNext = nullptr;
+
+        m_DescriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+        VkPhysicalDeviceProperties2KHR Properties2 = {};
+        Properties2.sType                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+        Properties2.pNext                          = &m_DescriptorIndexingProperties;
+        vkGetPhysicalDeviceProperties2KHR(m_VkDevice, &Properties2);
+        m_DescriptorIndexingProperties.pNext = nullptr;
+    }
 }
 
 uint32_t VulkanPhysicalDevice::FindQueueFamily(VkQueueFlags QueueFlags) const
@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ShaderPermutationManager class
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <future>
+#include <memory>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+#include "../../../Common/interface/HashUtils.hpp"
+
+namespace Diligent
+{
+
+/// Compiles shader permutations on first use and caches them in memory.
+
+/// A permutation is defined by the values of the declared keys. Every key is exposed to the shader
+/// as a macro: boolean keys are defined as 0 or 1, enum keys are defined as an integer in the range
+/// [0, NumValues). Key values are packed into a 64-bit permutation id, so that looking up a compiled
+/// permutation does not require building macro strings.
+///
+/// \remarks    The main source file is read once when the manager is created. Permutations are compiled
+///             through IRenderDevice::CreateShader(), so the byte code is cached on disk by the backend
+///             (see EngineVkCreateInfo::SPIRVCacheDirectory) that takes included files and compiler
+///             options into account.
+class ShaderPermutationManager
+{
+public:
+    using PermutationId = Uint64;
+
+    struct CreateInfo
+    {
+        /// Render device that compiles the permutations.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Attributes common to all permutations. Macros defined by the ShaderCI.Macros member
+        /// are added to every permutation. The manager copies all strings, so they do not
+        /// need to outlive the constructor.
+        ShaderCreateInfo ShaderCI;
+
+        /// Optional thread pool that compiles permutations requested by RequestPermutation().
+        /// If null, the permutations are compiled on the calling thread.
+        /// The pool must outlive the manager.
+        ThreadPool* pThreadPool = nullptr;
+    };
+
+    explicit ShaderPermutationManager(const CreateInfo& CI);
+
+    // clang-format off
+    ShaderPermutationManager             (const ShaderPermutationManager&) = delete;
+    ShaderPermutationManager             (ShaderPermutationManager&&)      = delete;
+    ShaderPermutationManager& operator = (const ShaderPermutationManager&) = delete;
+    ShaderPermutationManager& operator = (ShaderPermutationManager&&)      = delete;
+    // clang-format on
+
+    /// Waits for all asynchronous compilation tasks to complete.
+    ~ShaderPermutationManager();
+
+    /// Declares a boolean key and returns its index. All keys must be declared before
+    /// the first permutation is requested.
+    Uint32 AddBoolKey(const Char* Name);
+
+    /// Declares an enum key that takes NumValues values and returns its index.
+    Uint32 AddEnumKey(const Char* Name, Uint32 NumValues);
+
+    /// Returns the permutation id with the value of the key replaced.
+    PermutationId SetKeyValue(PermutationId Id, Uint32 Key, Uint32 Value) const;
+
+    /// Returns the value of the key in the permutation.
+    Uint32 GetKeyValue(PermutationId Id, Uint32 Key) const;
+
+    /// 128-bit stable hash of a permutation
+    struct PermutationHash
+    {
+        Uint64 Hash0 = 0;
+        Uint64 Hash1 = 0;
+
+        bool operator==(const PermutationHash& rhs) const { return Hash0 == rhs.Hash0 && Hash1 == rhs.Hash1; }
+        bool operator!=(const PermutationHash& rhs) const { return !(*this == rhs); }
+        bool operator<(const PermutationHash& rhs) const { return Hash0 != rhs.Hash0 ? Hash0 < rhs.Hash0 : Hash1 < rhs.Hash1; }
+    };
+
+    /// Returns the stable hash of the permutation that does not change between runs.
+    /// The hash covers the main source, shader attributes, common macros and key values,
+    /// but not the files included by the source.
+    PermutationHash GetPermutationHash(PermutationId Id) const;
+
+    /// Starts compiling the permutation if it has not been requested yet.
+    /// If no thread pool was provided, the permutation is compiled immediately.
+    void RequestPermutation(PermutationId Id);
+
+    /// Returns the compiled permutation, compiling it on the calling thread or waiting for the asynchronous
+    /// task to complete if necessary. Returns null if the permutation failed to compile.
+    /// A permutation that failed to compile is compiled again when it is requested next time.
+    RefCntAutoPtr<IShader> GetPermutation(PermutationId Id);
+
+    /// Returns true if the permutation has been compiled (successfully or not) and GetPermutation() will not block.
+    bool IsPermutationReady(PermutationId Id);
+
+    Uint32 GetNumKeys() const { return static_cast<Uint32>(m_Keys.size()); }
+
+private:
+    struct KeyInfo
+    {
+        std::string Name;
+        Uint32      NumValues = 0;
+        Uint32      BitOffset = 0;
+        Uint32      NumBits   = 0;
+    };
+
+    struct PermutationInfo
+    {
+        RefCntAutoPtr<IShader>  pShader;
+        std::shared_future<void> Compilation;
+    };
+
+    Uint32 AddKey(const Char* Name, Uint32 NumValues);
+
+    // Returns the permutation entry, creating it and starting the compilation if necessary
+    std::shared_ptr<PermutationInfo> GetPermutationInfo(PermutationId Id, bool Async);
+
+    RefCntAutoPtr<IShader> CompilePermutation(PermutationId Id);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    ThreadPool* const            m_pThreadPool;
+
+    // Copies of the strings referenced by the base shader create info
+    ShaderCreateInfo                                 m_ShaderCI;
+    std::string                                      m_Name;
+    std::string                                      m_Source;
+    std::string                                      m_EntryPoint;
+    std::string                                      m_CombinedSamplerSuffix;
+    std::vector<std::pair<std::string, std::string>> m_Macros;
+
+    // Hasher state after the source, shader attributes and common macros have been hashed.
+    // The full state is kept, so that both lanes of the permutation hash cover all data.
+    StableHasher m_BaseHasher;
+
+    std::vector<KeyInfo> m_Keys;
+    Uint32               m_NumKeyBits = 0;
+
+    std::mutex m_Mutex;
+    // Entries are shared with the threads that wait for the compilation, so that
+    // a failed permutation can be replaced while they still reference it
+    std::unordered_map<PermutationId, std::shared_ptr<PermutationInfo>> m_Permutations;
+};
+
+} // namespace Diligent
@@ -0,0 +1,297 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "ShaderPermutationManager.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "APIInfo.h"
+#include "DataBlobImpl.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+ShaderPermutationManager::ShaderPermutationManager(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_pThreadPool{CI.pThreadPool}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+
+    const auto& ShaderCI = CI.ShaderCI;
+    if (ShaderCI.ByteCode != nullptr)
+        LOG_ERROR_AND_THROW("Shader permutations can only be created from source code");
+
+    if (ShaderCI.Source != nullptr)
+    {
+        m_Source = ShaderCI.Source;
+    }
+    else if (ShaderCI.FilePath != nullptr)
+    {
+        if (ShaderCI.pShaderSourceStreamFactory == nullptr)
+            LOG_ERROR_AND_THROW("Input stream factory is null");
+
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        ShaderCI.pShaderSourceStreamFactory->CreateInputStream(ShaderCI.FilePath, &pSourceStream);
+        if (!pSourceStream)
+            LOG_ERROR_AND_THROW("Failed to open shader source file ", ShaderCI.FilePath);
+
+        RefCntAutoPtr<IDataBlob> pFileData(MakeNewRCObj<DataBlobImpl>()(0));
+        pSourceStream->ReadBlob(pFileData);
+        m_Source.assign(reinterpret_cast<const char*>(pFileData->GetDataPtr()), pFileData->GetSize());
+    }
+    else
+    {
+        LOG_ERROR_AND_THROW("Shader source must be provided through one of the 'Source' or 'FilePath' members");
+    }
+
+    if (ShaderCI.Desc.Name != nullptr)
+        m_Name = ShaderCI.Desc.Name;
+    if (ShaderCI.EntryPoint != nullptr)
+        m_EntryPoint = ShaderCI.EntryPoint;
+    if (ShaderCI.CombinedSamplerSuffix != nullptr)
+        m_CombinedSamplerSuffix = ShaderCI.CombinedSamplerSuffix;
+    if (ShaderCI.Macros != nullptr)
+    {
+        for (const auto* pMacro = ShaderCI.Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+            m_Macros.emplace_back(pMacro->Name, pMacro->Definition);
+    }
+
+    // Strings are set when a permutation is compiled
+    m_ShaderCI                       = ShaderCI;
+    m_ShaderCI.Source                = nullptr;
+    m_ShaderCI.FilePath              = nullptr;
+    m_ShaderCI.Macros                = nullptr;
+    m_ShaderCI.Desc.Name             = nullptr;
+    m_ShaderCI.EntryPoint            = nullptr;
+    m_ShaderCI.CombinedSamplerSuffix = nullptr;
+    m_ShaderCI.ppCompilerOutput      = nullptr;
+
+    auto& Hasher = m_BaseHasher;
+    Hasher.Update(Uint32{DILIGENT_API_VERSION});
+    Hasher.Update(m_pDevice->GetDeviceCaps().DevType);
+    Hasher.Update(m_ShaderCI.Desc.ShaderType);
+    Hasher.Update(m_ShaderCI.SourceLanguage);
+    Hasher.Update(m_ShaderCI.HLSLVersion.Major);
+    Hasher.Update(m_ShaderCI.HLSLVersion.Minor);
+    Hasher.Update(m_ShaderCI.GLSLVersion.Major);
+    Hasher.Update(m_ShaderCI.GLSLVersion.Minor);
+    Hasher.Update(m_ShaderCI.GLESSLVersion.Major);
+    Hasher.Update(m_ShaderCI.GLESSLVersion.Minor);
+    Hasher.Update(m_ShaderCI.UseCombinedTextureSamplers);
+    Hasher.UpdateStr(m_CombinedSamplerSuffix.c_str(), m_CombinedSamplerSuffix.length());
+    Hasher.UpdateStr(m_EntryPoint.c_str(), m_EntryPoint.length());
+    Hasher.UpdateStr(m_Source.c_str(), m_Source.length());
+    for (const auto& Macro : m_Macros)
+    {
+        Hasher.UpdateStr(Macro.first.c_str(), Macro.first.length());
+        Hasher.UpdateStr(Macro.second.c_str(), Macro.second.length());
+    }
+}
+
+ShaderPermutationManager::~ShaderPermutationManager()
+{
+    for (auto& it : m_Permutations)
+    {
+        if (it.second->Compilation.valid())
+            it.second->Compilation.wait();
+    }
+}
+
+Uint32 ShaderPermutationManager::AddKey(const Char* Name, Uint32 NumValues)
+{
+    VERIFY(m_Permutations.empty(), "All keys must be declared before the first permutation is requested");
+    VERIFY(Name != nullptr && *Name != '\0', "Key name must not be empty");
+    VERIFY(NumValues >= 2, "Key must have at least two values");
+
+    KeyInfo Key;
+    Key.Name      = Name;
+    Key.NumValues = NumValues;
+    Key.BitOffset = m_NumKeyBits;
+    while ((Uint64{1} << Key.NumBits) < NumValues)
+        ++Key.NumBits;
+    if (m_NumKeyBits + Key.NumBits > sizeof(PermutationId) * 8)
+        LOG_ERROR_AND_THROW("Key '", Name, "' does not fit into the permutation id: the total number of bits required by all keys exceeds 64");
+
+    m_NumKeyBits += Key.NumBits;
+    m_Keys.emplace_back(std::move(Key));
+    return static_cast<Uint32>(m_Keys.size() - 1);
+}
+
+Uint32 ShaderPermutationManager::AddBoolKey(const Char* Name)
+{
+    return AddKey(Name, 2);
+}
+
+Uint32 ShaderPermutationManager::AddEnumKey(const Char* Name, Uint32 NumValues)
+{
+    return AddKey(Name, NumValues);
+}
+
+ShaderPermutationManager::PermutationId ShaderPermutationManager::SetKeyValue(PermutationId Id, Uint32 Key, Uint32 Value) const
+{
+    VERIFY_EXPR(Key < m_Keys.size());
+    const auto& KeyInfo = m_Keys[Key];
+    VERIFY(Value < KeyInfo.NumValues, "Value ", Value, " is out of range for key '", KeyInfo.Name, "'");
+
+    const auto Mask = ((PermutationId{1} << KeyInfo.NumBits) - 1) << KeyInfo.BitOffset;
+    return (Id & ~Mask) | ((PermutationId{Value} << KeyInfo.BitOffset) & Mask);
+}
+
+Uint32 ShaderPermutationManager::GetKeyValue(PermutationId Id, Uint32 Key) const
+{
+    VERIFY_EXPR(Key < m_Keys.size());
+    const auto& KeyInfo = m_Keys[Key];
+    return static_cast<Uint32>((Id >> KeyInfo.BitOffset) & ((PermutationId{1} << KeyInfo.NumBits) - 1));
+}
+
+ShaderPermutationManager::PermutationHash ShaderPermutationManager::GetPermutationHash(PermutationId Id) const
+{
+    // Keys are hashed by name rather than by bit position, so that the hash does not
+    // depend on the order in which the keys are declared
+    auto Hasher = m_BaseHasher;
+    for (Uint32 k = 0; k < m_Keys.size(); ++k)
+    {
+        Hasher.UpdateStr(m_Keys[k].Name.c_str(), m_Keys[k].Name.length());
+        Hasher.Update(GetKeyValue(Id, k));
+    }
+
+    PermutationHash Hash;
+    Hash.Hash0 = Hasher.GetHash0();
+    Hash.Hash1 = Hasher.GetHash1();
+    return Hash;
+}
+
+std::shared_ptr<ShaderPermutationManager::PermutationInfo> ShaderPermutationManager::GetPermutationInfo(PermutationId Id, bool Async)
+{
+    std::unique_lock<std::mutex> Lock{m_Mutex};
+
+    auto it = m_Permutations.find(Id);
+    if (it != m_Permutations.end())
+    {
+        const auto& pInfo = it->second;
+        // A permutation that failed to compile is replaced with a new entry, so that it is compiled again.
+        // The shader is written before the compilation future becomes ready.
+        const auto IsFailed = pInfo->Compilation.wait_for(std::chrono::seconds{0}) == std::future_status::ready && !pInfo->pShader;
+        if (!IsFailed)
+            return pInfo;
+    }
+
+    auto pInfo         = std::make_shared<PermutationInfo>();
+    m_Permutations[Id] = pInfo;
+    if (Async && m_pThreadPool != nullptr)
+    {
+        // The entry is only replaced after the task has completed, and the destructor waits for
+        // all tasks in the map, so the raw pointer remains valid while the task is running.
+        // Capturing the shared pointer would create a reference cycle through the future.
+        auto* pRawInfo = pInfo.get();
+        pInfo->Compilation = m_pThreadPool->EnqueueTask(
+                                             [this, Id, pRawInfo]() //
+                                             {
+                                                 pRawInfo->pShader = CompilePermutation(Id);
+                                             })
+                                 .share();
+    }
+    else
+    {
+        // Other threads that request the same permutation wait for this one to complete
+        std::promise<void> Promise;
+        pInfo->Compilation = Promise.get_future().share();
+        Lock.unlock();
+        pInfo->pShader = CompilePermutation(Id);
+        Promise.set_value();
+    }
+
+    return pInfo;
+}
+
+void ShaderPermutationManager::RequestPermutation(PermutationId Id)
+{
+    GetPermutationInfo(Id, true);
+}
+
+RefCntAutoPtr<IShader> ShaderPermutationManager::GetPermutation(PermutationId Id)
+{
+    auto pInfo = GetPermutationInfo(Id, false);
+    pInfo->Compilation.wait();
+    return pInfo->pShader;
+}
+
+bool ShaderPermutationManager::IsPermutationReady(PermutationId Id)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it = m_Permutations.find(Id);
+    return it != m_Permutations.end() &&
+        it->second->Compilation.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+}
+
+RefCntAutoPtr<IShader> ShaderPermutationManager::CompilePermutation(PermutationId Id)
+{
+    std::string Name = m_Name;
+    Name += " (";
+    for (Uint32 k = 0; k < m_Keys.size(); ++k)
+    {
+        if (k > 0)
+            Name += ", ";
+        Name += m_Keys[k].Name;
+        Name += '=';
+        Name += std::to_string(GetKeyValue(Id, k));
+    }
+    Name += ')';
+
+    auto ShaderCI                  = m_ShaderCI;
+    ShaderCI.Desc.Name             = Name.c_str();
+    ShaderCI.EntryPoint            = !m_EntryPoint.empty() ? m_EntryPoint.c_str() : nullptr;
+    ShaderCI.CombinedSamplerSuffix = !m_CombinedSamplerSuffix.empty() ? m_CombinedSamplerSuffix.c_str() : nullptr;
+
+    ShaderMacroHelper Macros;
+    for (const auto& Macro : m_Macros)
+        Macros.AddShaderMacro(Macro.first.c_str(), Macro.second.c_str());
+    for (Uint32 k = 0; k < m_Keys.size(); ++k)
+    {
+        const auto& Key   = m_Keys[k];
+        const auto  Value = GetKeyValue(Id, k);
+        if (Key.NumValues == 2)
+            Macros.AddShaderMacro(Key.Name.c_str(), Value != 0);
+        else
+            Macros.AddShaderMacro(Key.Name.c_str(), static_cast<Int32>(Value));
+    }
+
+    ShaderCI.Source = m_Source.c_str();
+    ShaderCI.Macros = Macros;
+
+    RefCntAutoPtr<IShader> pShader;
+    m_pDevice->CreateShader(ShaderCI, &pShader);
+    if (!pShader)
+        LOG_ERROR_MESSAGE("Failed to compile shader permutation '", Name, "'");
+
+    return pShader;
+}
+
+} // namespace Diligent
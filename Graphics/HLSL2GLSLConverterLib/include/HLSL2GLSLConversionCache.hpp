@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::HLSL2GLSLConversionCache class
+
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <unordered_map>
+
+#include "BasicTypes.h"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+/// Cache of HLSL->GLSL conversion results.
+
+/// The cache is addressed by a 128-bit hash of everything that affects the conversion result.
+/// Entries are kept in memory and, if the cache directory is set, in separate files on disk,
+/// so that the results can be reused by subsequent runs of the application. A second,
+/// independent hash of the same data is stored in the file header to detect name collisions.
+/// All methods are thread-safe.
+class HLSL2GLSLConversionCache
+{
+public:
+    /// 128-bit key of the cache entry
+    struct Key
+    {
+        Uint64 Hash0 = 0;
+        Uint64 Hash1 = 0;
+
+        bool operator==(const Key& rhs) const { return Hash0 == rhs.Hash0 && Hash1 == rhs.Hash1; }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& K) const { return static_cast<size_t>(K.Hash0); }
+        };
+    };
+
+    // Keys may be stored on disk, so std::hash cannot be used as it is only
+    // required to produce the same result within a single execution of a program.
+    class KeyHasher : public StableHasher
+    {
+    public:
+        using StableHasher::Update;
+
+        void Update(const Key& K)
+        {
+            Update(K.Hash0);
+            Update(K.Hash1);
+        }
+
+        Key GetKey() const
+        {
+            Key K;
+            K.Hash0 = GetHash0();
+            K.Hash1 = GetHash1();
+            return K;
+        }
+    };
+
+    struct Stats
+    {
+        Uint32 MemoryHits = 0;
+        Uint32 DiskHits   = 0;
+        Uint32 Misses     = 0;
+    };
+
+    /// \param [in] MaxMemorySize - Maximum total size, in bytes, of the sources kept in memory.
+    ///                             When the limit is exceeded, the oldest entries are evicted.
+    explicit HLSL2GLSLConversionCache(size_t MaxMemorySize = DefaultMaxMemorySize);
+
+    // clang-format off
+    HLSL2GLSLConversionCache             (const HLSL2GLSLConversionCache&)  = delete;
+    HLSL2GLSLConversionCache             (      HLSL2GLSLConversionCache&&) = delete;
+    HLSL2GLSLConversionCache& operator = (const HLSL2GLSLConversionCache&)  = delete;
+    HLSL2GLSLConversionCache& operator = (      HLSL2GLSLConversionCache&&) = delete;
+    // clang-format on
+
+    /// Sets the path to the directory where the cache entries are stored on disk.
+    /// The directory must exist. If the path is null or empty, the disk cache is disabled.
+    void SetDirectory(const Char* Directory);
+
+    /// Looks up the converted source in memory first and then on disk.
+    /// Returns false if there is no valid entry for the key.
+    bool Find(const Key& EntryKey, String& GLSLSource);
+
+    /// Stores the converted source in memory and, if the disk cache is enabled, on disk.
+    /// Disk failures are not fatal and are only reported as warnings.
+    void Store(const Key& EntryKey, const String& GLSLSource);
+
+    /// Removes all entries from memory. Entries on disk are not affected.
+    void Clear();
+
+    Stats GetStats() const;
+
+    static constexpr size_t DefaultMaxMemorySize = 32 << 20;
+
+private:
+    bool LoadFromDisk(const String& Directory, const Key& EntryKey, String& GLSLSource) const;
+    void StoreOnDisk(const String& Directory, const Key& EntryKey, const String& GLSLSource) const;
+    void AddToMemory(const Key& EntryKey, const String& GLSLSource);
+
+    mutable std::mutex m_Mtx;
+
+    std::unordered_map<Key, String, Key::Hasher> m_Entries;
+    // Keys in the order the entries were added, used for eviction
+    std::deque<Key> m_EntryOrder;
+
+    const size_t m_MaxMemorySize;
+    size_t       m_MemorySize = 0;
+
+    String m_Directory;
+
+    std::atomic<Uint32> m_MemoryHits{0};
+    std::atomic<Uint32> m_DiskHits{0};
+    std::atomic<Uint32> m_Misses{0};
+};
+
+} // namespace Diligent
@@ -27,8 +27,6 @@
 
 #pragma once
 
-#include <list>
-#include <unordered_set>
 #include <unordered_map>
 #include <vector>
 
@@ -37,56 +35,16 @@
 #include "HLSLKeywords.h"
 #include "Shader.h"
 #include "HashUtils.hpp"
+#include "PerfectHashMap.hpp"
+#include "StringPool.hpp"
+#include "STDAllocator.hpp"
+#include "HLSLTokenStorage.hpp"
+#include "HLSL2GLSLConversionCache.hpp"
 #include "HLSLKeywords.h"
 
 namespace Diligent
 {
 
-struct FunctionStubHashKey
-{
-    // clang-format off
-    FunctionStubHashKey(const String& _Obj,  const String& _Func, Uint32 _NumArgs) : 
-        Object      {_Obj    },
-        Function    {_Func   },
-        NumArguments{_NumArgs}
-    {
-    }
-
-    FunctionStubHashKey(const Char* _Obj, const Char* _Func, Uint32 _NumArgs) : 
-        Object      {_Obj    },
-        Function    {_Func   },
-        NumArguments{_NumArgs}
-    {
-    }
-
-    FunctionStubHashKey(FunctionStubHashKey&& Key) :
-        Object      {std::move(Key.Object)  },
-        Function    {std::move(Key.Function)},
-        NumArguments{Key.NumArguments       }
-    {
-    }
-    // clang-format on
-
-    bool operator==(const FunctionStubHashKey& rhs) const
-    {
-        return Object == rhs.Object &&
-            Function == rhs.Function &&
-            NumArguments == rhs.NumArguments;
-    }
-
-    HashMapStringKey Object;
-    HashMapStringKey Function;
-    Uint32           NumArguments;
-
-    struct Hasher
-    {
-        size_t operator()(const FunctionStubHashKey& Key) const
-        {
-            return ComputeHash(Key.Object.GetHash(), Key.Function.GetHash(), Key.NumArguments);
-        }
-    };
-};
-
 /// HLSL to GLSL shader source code converter implementation
 class HLSL2GLSLConverterImpl
 {
@@ -119,6 +77,8 @@ public:
         SHADER_TYPE                         ShaderType                 = SHADER_TYPE_UNKNOWN;
 
         /// Whether to include GLSL definitions supporting HLSL->GLSL conversion.
+        /// Only the definitions referenced by the converted code (or by the macros)
+        /// are included.
         bool                                IncludeDefinitions         = false;
 
         /// Input file name. If HLSLSource is not null, this name will only be used for
@@ -133,6 +93,16 @@ public:
         /// This requires separate shader objects extension:
         /// https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_separate_shader_objects.txt
         bool                                UseInOutLocationQualifiers = true;
+
+        /// Optional array of shader macros that will be defined in the final GLSL source
+        /// outside of the converted code. The array must end with an empty macro.
+        /// GLSL definitions referenced by the macros are included into the output
+        /// along with the definitions referenced by the converted code.
+        const ShaderMacro*                  Macros                     = nullptr;
+
+        /// Whether to look up the result in the conversion cache before converting the source
+        /// and to store the result in the cache after the conversion.
+        bool                                UseCache                   = true;
     };
 
     // clang-format on
@@ -161,26 +131,35 @@ public:
                       size_t                           NumSymbols,
                       IHLSL2GLSLConversionStream**     ppStream) const;
 
+    /// Returns the cache of conversion results. The cache is thread-safe.
+    HLSL2GLSLConversionCache& GetConversionCache() const { return m_ConversionCache; }
+
 private:
     HLSL2GLSLConverterImpl();
 
     struct HLSLObjectInfo
     {
-        String GLSLType;      // sampler2D, sampler2DShadow, image2D, etc.
-        Uint32 NumComponents; // 0,1,2,3 or 4
-                              // Texture2D<float4>  -> 4
-                              // Texture2D<uint>    -> 1
-                              // Texture2D          -> 0
-        HLSLObjectInfo(const String& Type, Uint32 NComp) :
+        const Char* GLSLType;      // sampler2D, sampler2DShadow, image2D, etc. (allocated in the stream's arena)
+        Uint32      NumComponents; // 0,1,2,3 or 4
+                                   // Texture2D<float4>  -> 4
+                                   // Texture2D<uint>    -> 1
+                                   // Texture2D          -> 0
+        HLSLObjectInfo(const Char* Type, Uint32 NComp) :
             GLSLType{Type},
             NumComponents{NComp}
         {}
     };
     struct ObjectsTypeHashType
     {
+        using AllocatorType = STDAllocator<std::pair<const HashMapStringKey, HLSLObjectInfo>, ConversionArena>;
+        using MapType       = std::unordered_map<HashMapStringKey, HLSLObjectInfo, HashMapStringKey::Hasher, std::equal_to<HashMapStringKey>, AllocatorType>;
+
+        // Object names and the map itself are allocated in the arena of the conversion stream
+        explicit ObjectsTypeHashType(ConversionArena& Arena) :
+            m{8, HashMapStringKey::Hasher{}, std::equal_to<HashMapStringKey>{}, STD_ALLOCATOR(MapType::value_type, ConversionArena, Arena, "Allocator for unordered_map<HashMapStringKey, HLSLObjectInfo>")}
+        {}
         // This is only required to make the code compile on paranoid MSVC 2017 compiler (19.10.25017):
         // https://stackoverflow.com/questions/47604029/move-constructors-of-stl-containers-in-msvc-2017-are-not-marked-as-noexcept
-        ObjectsTypeHashType() noexcept {}
         ObjectsTypeHashType(ObjectsTypeHashType&& rhs) noexcept :
             m{std::move(rhs.m)}
         {}
@@ -190,7 +169,7 @@ private:
         ObjectsTypeHashType& operator = (ObjectsTypeHashType&)  = delete;
         // clang-format on
 
-        std::unordered_map<HashMapStringKey, HLSLObjectInfo, HashMapStringKey::Hasher> m;
+        MapType m;
     };
 
     struct GLSLStubInfo
@@ -203,9 +182,65 @@ private:
         {}
     };
     // Hash map that maps GLSL object, method and number of arguments
-    // passed to the original function, to the GLSL stub function
-    // Example: {"sampler2D", "Sample", 2} -> {"Sample_2", "_SWIZZLE"}
-    std::unordered_map<FunctionStubHashKey, GLSLStubInfo, FunctionStubHashKey::Hasher> m_GLSLStubs;
+    // passed to the original function, to the GLSL stub function.
+    // The key is formatted by GetGLSLStubKey().
+    // Example: "sampler2D.Sample.2" -> {"Sample_2", "_SWIZZLE"}
+    PerfectHashMap<GLSLStubInfo> m_GLSLStubs;
+
+    static String GetGLSLStubKey(const String& Object, const String& Function, Uint32 NumArguments);
+
+    // Finds the stub without allocating memory; returns null if there is no such stub
+    const GLSLStubInfo* FindGLSLStub(const Char* Object, const Char* Function, Uint32 NumArguments) const;
+
+    // GLSL definitions (GLSLDefinitions.h) are split into segments, each containing a single
+    // top-level definition or preprocessor directive together with the comments preceding it.
+    // Only the segments that are referenced by the converted shader, directly or through other
+    // segments, are included into the output.
+    struct GLSLDefinitionSegment
+    {
+        enum class SegmentType
+        {
+            // Macro or function definition that is only included when referenced
+            Definition,
+
+            // Any other declaration or directive, always included
+            Unconditional,
+
+            // #if, #ifdef or #ifndef
+            ConditionalBegin,
+
+            // #else or #elif
+            ConditionalElse,
+
+            // #endif
+            ConditionalEnd
+        };
+
+        SegmentType Type = SegmentType::Unconditional;
+
+        // Segment text, including the preceding comments and the trailing new line
+        String Text;
+
+        // Indices of the segments that define the identifiers referenced by this segment
+        std::vector<Uint32> Dependencies;
+
+        // For #else, #elif and #endif, the index of the matching #if segment
+        Uint32 ConditionalBeginIdx = ~Uint32{0};
+    };
+
+    void ParseGLSLDefinitions();
+
+    String GetRequiredGLSLDefinitions(const String& GLSLSource, const ShaderMacro* Macros) const;
+
+    std::vector<GLSLDefinitionSegment> m_GLSLDefinitionSegments;
+
+    // Identifier -> indices of the segments that define it (there may be multiple overloads or
+    // definitions in different preprocessor branches)
+    PerfectHashMap<std::vector<Uint32>> m_GLSLDefinitionsByName;
+
+    // Segments that are included into every shader: unconditional segments, preprocessor
+    // directives and everything they reference
+    std::vector<bool> m_AlwaysRequiredGLSLDefinitions;
 
     // clang-format off
     enum class TokenType
@@ -241,9 +276,9 @@ private:
 
     struct TokenInfo
     {
-        TokenType Type;
-        String    Literal;
-        String    Delimiter;
+        TokenType   Type;
+        TokenString Literal;
+        TokenString Delimiter;
 
         bool IsBuiltInType() const
         {
@@ -267,7 +302,7 @@ private:
             Delimiter{_Delimiter}
         {}
     };
-    typedef std::list<TokenInfo> TokenListType;
+    typedef TokenList<TokenInfo> TokenListType;
 
 
     class ConversionStream : public ObjectBase<IHLSL2GLSLConversionStream>
@@ -298,11 +333,12 @@ private:
                          size_t                           NumSymbols,
                          bool                             bPreserveTokens);
 
-        String Convert(const Char* EntryPoint,
-                       SHADER_TYPE ShaderType,
-                       bool        IncludeDefintions,
-                       const char* SamplerSuffix,
-                       bool        UseInOutLocationQualifiers);
+        String Convert(const Char*        EntryPoint,
+                       SHADER_TYPE        ShaderType,
+                       bool               IncludeDefintions,
+                       const char*        SamplerSuffix,
+                       bool               UseInOutLocationQualifiers,
+                       const ShaderMacro* Macros = nullptr);
 
         virtual void DILIGENT_CALL_TYPE Convert(const Char* EntryPoint,
                                                 SHADER_TYPE ShaderType,
@@ -315,13 +351,16 @@ private:
 
         const String& GetInputFileName() const { return m_InputFileName; }
 
+        /// Returns the hash of the source code with all includes expanded
+        const HLSL2GLSLConversionCache::Key& GetSourceHash();
+
     private:
         void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
         void Tokenize(const String& Source);
 
         typedef std::unordered_map<String, bool> SamplerHashType;
 
-        const HLSLObjectInfo* FindHLSLObject(const String& Name);
+        const HLSLObjectInfo* FindHLSLObject(const Char* Name);
 
         void ProcessShaderDeclaration(TokenListType::iterator EntryPointToken, SHADER_TYPE ShaderType);
 
@@ -501,9 +540,25 @@ private:
 
         String BuildGLSLSource();
 
+        // Source code with all includes expanded. The source is tokenized by the first conversion
+        // that is not found in the cache.
+        String m_Source;
+        bool   m_bTokenized = false;
+
+        HLSL2GLSLConversionCache::Key m_SourceHash;
+        bool                          m_bSourceHashComputed = false;
+
+        // Storage for the text of all token literals and delimiters produced by the tokenizer.
+        // Tokens reference this text until they are modified.
+        StringPool m_TokenTextPool;
+
         // Tokenized source code
         TokenListType m_Tokens;
 
+        // Transient data of the current conversion. The arena is reset at the start of every
+        // conversion and must be declared before all containers that allocate from it.
+        ConversionArena m_Arena;
+
         // List of tokens defining structs
         std::unordered_map<HashMapStringKey, TokenListType::iterator, HashMapStringKey::Hasher> m_StructDefinitions;
 
@@ -525,22 +580,32 @@ private:
         const String m_InputFileName;
     };
 
-    // HLSL keyword->token info hash map
-    // Example: "Texture2D" -> TokenInfo(TokenType::Texture2D, "Texture2D")
-    std::unordered_map<HashMapStringKey, TokenInfo, HashMapStringKey::Hasher> m_HLSLKeywords;
+    String ConvertStream(ConversionStream& Stream, const ConversionAttribs& Attribs) const;
+
+    mutable HLSL2GLSLConversionCache m_ConversionCache;
+
+    // Hash of the converter version and GLSL definitions, included into every cache key
+    HLSL2GLSLConversionCache::Key m_ConverterHash;
+
+    // All tables below are built once by the constructor and are never modified afterwards,
+    // so any number of conversion streams can read them concurrently.
+
+    // HLSL keyword->token type hash map
+    // Example: "Texture2D" -> TokenType::kw_Texture2D
+    PerfectHashMap<TokenType> m_HLSLKeywords;
 
     // Set of all GLSL image types (image1D, uimage1D, iimage1D, image2D, ... )
-    std::unordered_set<HashMapStringKey, HashMapStringKey::Hasher> m_ImageTypes;
+    PerfectHashSet m_ImageTypes;
 
     // Set of all HLSL atomic operations (InterlockedAdd, InterlockedOr, ...)
-    std::unordered_set<HashMapStringKey, HashMapStringKey::Hasher> m_AtomicOperations;
+    PerfectHashSet m_AtomicOperations;
 
     // HLSL semantic -> glsl variable, for every shader stage and input/output type (in == 0, out == 1)
     // Example: [vertex, output] SV_Position -> gl_Position
     //          [fragment, input] SV_Position -> gl_FragCoord
-    static constexpr int                                                   InVar  = 0;
-    static constexpr int                                                   OutVar = 1;
-    std::unordered_map<HashMapStringKey, String, HashMapStringKey::Hasher> m_HLSLSemanticToGLSLVar[6][2];
+    static constexpr int   InVar  = 0;
+    static constexpr int   OutVar = 1;
+    PerfectHashMap<String> m_HLSLSemanticToGLSLVar[6][2];
 };
 
 } // namespace Diligent
@@ -0,0 +1,529 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Definition of Diligent::TokenString, Diligent::TokenList and Diligent::ConversionArena classes used by the HLSL->GLSL converter
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "BasicTypes.h"
+#include "MemoryAllocator.h"
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+/// String that references null-terminated text owned by someone else (typically,
+/// the string pool of the conversion stream) until it is modified for the first time.
+
+/// Tokens produced by the tokenizer never change for the most part, so keeping them
+/// as views avoids allocating and copying a string per literal and per delimiter.
+/// Any modifying operation makes the string copy the text into its own storage.
+class TokenString
+{
+public:
+    TokenString() noexcept {}
+
+    explicit TokenString(const Char* Str)
+    {
+        VERIFY_EXPR(Str != nullptr);
+        // Keep empty strings as views to avoid touching the owned storage
+        if (*Str != 0)
+        {
+            m_pView = nullptr;
+            m_Str   = Str;
+        }
+    }
+
+    explicit TokenString(String Str) :
+        m_pView{nullptr},
+        m_Str{std::move(Str)}
+    {}
+
+    /// Creates a string that references Length characters starting at Str.
+    /// The text must be null-terminated and must outlive the string and all its copies.
+    static TokenString View(const Char* Str, size_t Length)
+    {
+        VERIFY(Str != nullptr && Str[Length] == 0, "The text referenced by the token string must be null-terminated");
+        TokenString ViewStr;
+        ViewStr.m_pView  = Str;
+        ViewStr.m_Length = Length;
+        return ViewStr;
+    }
+
+    // clang-format off
+    bool IsView() const { return m_pView != nullptr; }
+
+    const Char* c_str()  const { return m_pView != nullptr ? m_pView  : m_Str.c_str();  }
+    const Char* data()   const { return c_str(); }
+    size_t      length() const { return m_pView != nullptr ? m_Length : m_Str.length(); }
+    size_t      size()   const { return length(); }
+    bool        empty()  const { return length() == 0; }
+
+    const Char* begin() const { return c_str(); }
+    const Char* end()   const { return c_str() + length(); }
+
+    Char operator[](size_t i) const { VERIFY_EXPR(i < length()); return c_str()[i]; }
+    Char back()               const { VERIFY_EXPR(!empty()); return c_str()[length() - 1]; }
+
+    String str() const { return String{c_str(), length()}; }
+
+    TokenString& operator=(const Char* Str)   { MakeOwned() = Str;            return *this; }
+    TokenString& operator=(const String& Str) { MakeOwned() = Str;            return *this; }
+    TokenString& operator=(String&& Str)      { MakeOwned() = std::move(Str); return *this; }
+
+    void push_back(Char c) { MakeOwned().push_back(c); }
+    void pop_back()        { VERIFY_EXPR(!empty()); MakeOwned().pop_back(); }
+    void reserve(size_t n) { MakeOwned().reserve(n); }
+
+    TokenString& append(const Char* Str, size_t Len) { MakeOwned().append(Str, Len); return *this; }
+    TokenString& append(const Char* Str)             { MakeOwned().append(Str);      return *this; }
+    TokenString& append(const String& Str)           { return append(Str.c_str(), Str.length()); }
+    TokenString& append(const TokenString& Str)      { return append(Str.c_str(), Str.length()); }
+    template <typename IterType>
+    TokenString& append(IterType First, IterType Last) { MakeOwned().append(First, Last); return *this; }
+
+    TokenString& operator+=(Char c)                   { push_back(c);      return *this; }
+    TokenString& operator+=(const Char* Str)          { return append(Str); }
+    TokenString& operator+=(const String& Str)        { return append(Str); }
+    TokenString& operator+=(const TokenString& Str)   { return append(Str); }
+    // clang-format on
+
+    /// Resets the string to an empty view without releasing the owned storage
+    void clear()
+    {
+        m_pView  = "";
+        m_Length = 0;
+        m_Str.clear();
+    }
+
+private:
+    String& MakeOwned()
+    {
+        if (m_pView != nullptr)
+        {
+            m_Str.assign(m_pView, m_Length);
+            m_pView  = nullptr;
+            m_Length = 0;
+        }
+        return m_Str;
+    }
+
+    // When not null, the string references external text of length m_Length.
+    // Otherwise the text is stored in m_Str.
+    const Char* m_pView  = "";
+    size_t      m_Length = 0;
+    String      m_Str;
+};
+
+// clang-format off
+inline bool operator==(const TokenString& Str1, const Char*        Str2) { return strcmp(Str1.c_str(), Str2) == 0; }
+inline bool operator==(const Char*        Str1, const TokenString& Str2) { return Str2 == Str1; }
+inline bool operator==(const TokenString& Str1, const String&      Str2) { return Str1.length() == Str2.length() && Str1 == Str2.c_str(); }
+inline bool operator==(const String&      Str1, const TokenString& Str2) { return Str2 == Str1; }
+inline bool operator==(const TokenString& Str1, const TokenString& Str2) { return Str1.length() == Str2.length() && Str1 == Str2.c_str(); }
+
+inline bool operator!=(const TokenString& Str1, const Char*        Str2) { return !(Str1 == Str2); }
+inline bool operator!=(const Char*        Str1, const TokenString& Str2) { return !(Str1 == Str2); }
+inline bool operator!=(const TokenString& Str1, const String&      Str2) { return !(Str1 == Str2); }
+inline bool operator!=(const String&      Str1, const TokenString& Str2) { return !(Str1 == Str2); }
+inline bool operator!=(const TokenString& Str1, const TokenString& Str2) { return !(Str1 == Str2); }
+
+inline String operator+(const TokenString& Str1, const TokenString& Str2) { return Str1.str().append(Str2.c_str(), Str2.length()); }
+inline String operator+(const TokenString& Str1, const Char*        Str2) { return Str1.str().append(Str2); }
+inline String operator+(const TokenString& Str1, const String&      Str2) { return Str1.str().append(Str2); }
+inline String operator+(const TokenString& Str1, Char               c   ) { return Str1.str() + c; }
+inline String operator+(const Char*        Str1, const TokenString& Str2) { return String{Str1}.append(Str2.c_str(), Str2.length()); }
+inline String operator+(String             Str1, const TokenString& Str2) { return Str1.append(Str2.c_str(), Str2.length()); }
+// clang-format on
+
+inline std::ostream& operator<<(std::ostream& os, const TokenString& Str)
+{
+    return os.write(Str.c_str(), Str.length());
+}
+
+
+
+/// Doubly-linked list that keeps its nodes in large contiguous blocks rather than
+/// allocating every node separately.
+
+/// Nodes are linked by indices, so iterators and references remain valid when other
+/// elements are inserted or erased, exactly like in std::list. Erased nodes are recycled.
+/// Nodes are never relocated, so element addresses are stable as well.
+template <typename ValueType, Uint32 BlockSizeLog2 = 9>
+class TokenList
+{
+    static constexpr Uint32 BlockSize = 1u << BlockSizeLog2;
+    static constexpr Uint32 BlockMask = BlockSize - 1u;
+
+    // Index of the sentinel node. The list is circular: the sentinel's
+    // Next is the first element, and its Prev is the last element.
+    static constexpr Uint32 EndIdx = 0;
+
+    static constexpr Uint32 InvalidIdx = ~Uint32{0};
+
+    struct Node
+    {
+        ValueType Value;
+        Uint32    Prev = EndIdx;
+        Uint32    Next = EndIdx;
+    };
+
+    template <typename ListType, typename ElementType>
+    class IteratorBase
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = ValueType;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = ElementType*;
+        using reference         = ElementType&;
+
+        IteratorBase() noexcept {}
+
+        IteratorBase(ListType* pList, Uint32 Idx) noexcept :
+            m_pList{pList},
+            m_Idx{Idx}
+        {}
+
+        // Allow iterator -> const_iterator conversion
+        template <typename OtherListType, typename OtherElementType>
+        IteratorBase(const IteratorBase<OtherListType, OtherElementType>& It) noexcept :
+            m_pList{It.m_pList},
+            m_Idx{It.m_Idx}
+        {}
+
+        reference operator*() const { return m_pList->GetNode(m_Idx).Value; }
+        pointer   operator->() const { return &m_pList->GetNode(m_Idx).Value; }
+
+        IteratorBase& operator++()
+        {
+            m_Idx = m_pList->GetNode(m_Idx).Next;
+            return *this;
+        }
+
+        IteratorBase operator++(int)
+        {
+            auto Tmp = *this;
+            ++(*this);
+            return Tmp;
+        }
+
+        IteratorBase& operator--()
+        {
+            m_Idx = m_pList->GetNode(m_Idx).Prev;
+            return *this;
+        }
+
+        IteratorBase operator--(int)
+        {
+            auto Tmp = *this;
+            --(*this);
+            return Tmp;
+        }
+
+        template <typename OtherListType, typename OtherElementType>
+        bool operator==(const IteratorBase<OtherListType, OtherElementType>& It) const
+        {
+            VERIFY(m_pList == It.m_pList, "Comparing iterators from different lists");
+            return m_Idx == It.m_Idx;
+        }
+
+        template <typename OtherListType, typename OtherElementType>
+        bool operator!=(const IteratorBase<OtherListType, OtherElementType>& It) const
+        {
+            return !(*this == It);
+        }
+
+    private:
+        template <typename, typename>
+        friend class IteratorBase;
+        friend class TokenList;
+
+        ListType* m_pList = nullptr;
+        Uint32    m_Idx   = EndIdx;
+    };
+
+public:
+    using value_type     = ValueType;
+    using iterator       = IteratorBase<TokenList, ValueType>;
+    using const_iterator = IteratorBase<const TokenList, const ValueType>;
+
+    TokenList()
+    {
+        // Allocate the sentinel node
+        AllocateNode();
+    }
+
+    TokenList(const TokenList& List) :
+        m_NumNodes{List.m_NumNodes},
+        m_FreeListHead{List.m_FreeListHead},
+        m_Size{List.m_Size}
+    {
+        // Copy the nodes as is so that the links remain valid
+        m_Blocks.reserve(List.m_Blocks.size());
+        for (size_t b = 0; b < List.m_Blocks.size(); ++b)
+        {
+            m_Blocks.emplace_back(new Node[BlockSize]);
+            const auto NumNodesInBlock = std::min(Uint32{BlockSize}, m_NumNodes - static_cast<Uint32>(b << BlockSizeLog2));
+            std::copy(List.m_Blocks[b].get(), List.m_Blocks[b].get() + NumNodesInBlock, m_Blocks[b].get());
+        }
+    }
+
+    TokenList(TokenList&& List) :
+        TokenList{}
+    {
+        swap(List);
+    }
+
+    TokenList& operator=(TokenList List) noexcept
+    {
+        swap(List);
+        return *this;
+    }
+
+    void swap(TokenList& List) noexcept
+    {
+        std::swap(m_Blocks, List.m_Blocks);
+        std::swap(m_NumNodes, List.m_NumNodes);
+        std::swap(m_FreeListHead, List.m_FreeListHead);
+        std::swap(m_Size, List.m_Size);
+    }
+
+    // clang-format off
+    iterator       begin()       { return iterator      {this, GetNode(EndIdx).Next}; }
+    const_iterator begin() const { return const_iterator{this, GetNode(EndIdx).Next}; }
+    iterator       end()         { return iterator      {this, EndIdx}; }
+    const_iterator end()   const { return const_iterator{this, EndIdx}; }
+
+    ValueType&       front()       { VERIFY_EXPR(!empty()); return GetNode(GetNode(EndIdx).Next).Value; }
+    const ValueType& front() const { VERIFY_EXPR(!empty()); return GetNode(GetNode(EndIdx).Next).Value; }
+    ValueType&       back()        { VERIFY_EXPR(!empty()); return GetNode(GetNode(EndIdx).Prev).Value; }
+    const ValueType& back()  const { VERIFY_EXPR(!empty()); return GetNode(GetNode(EndIdx).Prev).Value; }
+
+    size_t size()  const { return m_Size; }
+    bool   empty() const { return m_Size == 0; }
+    // clang-format on
+
+    /// Reserves space for at least NumElements elements
+    void reserve(size_t NumElements)
+    {
+        // +1 for the sentinel node
+        const auto NumBlocks = (NumElements + 1 + BlockMask) >> BlockSizeLog2;
+        m_Blocks.reserve(NumBlocks);
+        while (m_Blocks.size() < NumBlocks)
+            m_Blocks.emplace_back(new Node[BlockSize]);
+    }
+
+    iterator insert(const_iterator Pos, ValueType Value)
+    {
+        VERIFY(Pos.m_pList == this, "Iterator does not belong to this list");
+        const auto NewIdx  = AllocateNode();
+        const auto NextIdx = Pos.m_Idx;
+        const auto PrevIdx = GetNode(NextIdx).Prev;
+
+        auto& NewNode = GetNode(NewIdx);
+        NewNode.Value = std::move(Value);
+        NewNode.Prev  = PrevIdx;
+        NewNode.Next  = NextIdx;
+
+        GetNode(PrevIdx).Next = NewIdx;
+        GetNode(NextIdx).Prev = NewIdx;
+        ++m_Size;
+
+        return iterator{this, NewIdx};
+    }
+
+    void push_back(ValueType Value)
+    {
+        insert(end(), std::move(Value));
+    }
+
+    iterator erase(const_iterator Pos)
+    {
+        VERIFY(Pos.m_pList == this, "Iterator does not belong to this list");
+        VERIFY(Pos.m_Idx != EndIdx, "Attempting to erase end()");
+
+        auto&      ErasedNode = GetNode(Pos.m_Idx);
+        const auto NextIdx    = ErasedNode.Next;
+        GetNode(ErasedNode.Prev).Next = NextIdx;
+        GetNode(NextIdx).Prev         = ErasedNode.Prev;
+
+        // Release the owned memory and recycle the node
+        ErasedNode.Value = ValueType{};
+        ErasedNode.Prev  = InvalidIdx;
+        ErasedNode.Next  = m_FreeListHead;
+        m_FreeListHead   = Pos.m_Idx;
+        --m_Size;
+
+        return iterator{this, NextIdx};
+    }
+
+    iterator erase(const_iterator First, const_iterator Last)
+    {
+        while (First != Last)
+            First = erase(First);
+        return iterator{this, Last.m_Idx};
+    }
+
+    void clear()
+    {
+        m_Blocks.clear();
+        m_NumNodes     = 0;
+        m_FreeListHead = InvalidIdx;
+        m_Size         = 0;
+        AllocateNode();
+    }
+
+private:
+    Node& GetNode(Uint32 Idx)
+    {
+        VERIFY_EXPR(Idx < m_NumNodes);
+        return m_Blocks[Idx >> BlockSizeLog2][Idx & BlockMask];
+    }
+
+    const Node& GetNode(Uint32 Idx) const
+    {
+        VERIFY_EXPR(Idx < m_NumNodes);
+        return m_Blocks[Idx >> BlockSizeLog2][Idx & BlockMask];
+    }
+
+    Uint32 AllocateNode()
+    {
+        if (m_FreeListHead != InvalidIdx)
+        {
+            const auto Idx = m_FreeListHead;
+            m_FreeListHead = GetNode(Idx).Next;
+            return Idx;
+        }
+
+        const auto Idx = m_NumNodes++;
+        if ((Idx >> BlockSizeLog2) >= m_Blocks.size())
+            m_Blocks.emplace_back(new Node[BlockSize]);
+        return Idx;
+    }
+
+    std::vector<std::unique_ptr<Node[]>> m_Blocks;
+
+    // Total number of allocated nodes, including the sentinel and free nodes
+    Uint32 m_NumNodes = 0;
+
+    Uint32 m_FreeListHead = InvalidIdx;
+
+    // Number of elements in the list
+    size_t m_Size = 0;
+};
+
+
+
+/// Memory arena for the transient data of a single conversion (parsed objects, their names, etc.).
+
+/// Memory is allocated linearly from large blocks and is never released individually.
+/// Reset() makes all memory available again while keeping the blocks, so that once the
+/// arena has grown to the size required by the shader, subsequent conversions of the same
+/// stream do not touch the heap. Every conversion stream owns its arena, so streams converted
+/// by different threads do not contend for the global allocator.
+class ConversionArena final : public IMemoryAllocator
+{
+public:
+    explicit ConversionArena(size_t BlockSize = 16 << 10) noexcept :
+        m_BlockSize{BlockSize}
+    {}
+
+    // clang-format off
+    ConversionArena           (const ConversionArena&) = delete;
+    ConversionArena& operator=(const ConversionArena&) = delete;
+    // clang-format on
+
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final
+    {
+        static constexpr size_t Alignment = sizeof(void*) * 2;
+
+        Size = Align(std::max(Size, size_t{1}), Alignment);
+        if (m_CurrBlock >= m_Blocks.size() || m_CurrOffset + Size > m_Blocks[m_CurrBlock].Size)
+        {
+            // Move to the next block that is large enough
+            if (m_CurrBlock < m_Blocks.size())
+                ++m_CurrBlock;
+            while (m_CurrBlock < m_Blocks.size() && m_Blocks[m_CurrBlock].Size < Size)
+                ++m_CurrBlock;
+            if (m_CurrBlock == m_Blocks.size())
+            {
+                Block NewBlock;
+                NewBlock.Size = std::max(m_BlockSize, Size);
+                NewBlock.pData.reset(new Uint8[NewBlock.Size]);
+                m_Blocks.emplace_back(std::move(NewBlock));
+            }
+            m_CurrOffset = 0;
+        }
+
+        auto* Ptr = m_Blocks[m_CurrBlock].pData.get() + m_CurrOffset;
+        m_CurrOffset += Size;
+        return Ptr;
+    }
+
+    /// Memory is only released by Reset()
+    virtual void Free(void* Ptr) override final {}
+
+    /// Copies Length characters starting at Str into the arena and appends the null terminator
+    const Char* CopyString(const Char* Str, size_t Length)
+    {
+        auto* Copy = reinterpret_cast<Char*>(Allocate(Length + 1, "String copy", __FILE__, __LINE__));
+        memcpy(Copy, Str, Length);
+        Copy[Length] = 0;
+        return Copy;
+    }
+
+    /// Makes all memory available for reuse. All objects allocated from the arena must have been destroyed.
+    void Reset()
+    {
+        m_CurrBlock  = 0;
+        m_CurrOffset = 0;
+    }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<Uint8[]> pData;
+        size_t                   Size = 0;
+    };
+
+    const size_t       m_BlockSize;
+    std::vector<Block> m_Blocks;
+    size_t             m_CurrBlock  = 0;
+    size_t             m_CurrOffset = 0;
+};
+
+} // namespace Diligent
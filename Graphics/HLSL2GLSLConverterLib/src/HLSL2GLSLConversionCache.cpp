@@ -0,0 +1,265 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include <cstdio>
+#include <thread>
+#include <functional>
+
+#include "HLSL2GLSLConversionCache.hpp"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Increment the version whenever the entry format changes
+constexpr Uint32 ConversionCacheFormatVersion = 1;
+constexpr Uint32 ConversionCacheMagic         = 0x43534C47; // 'GLSC'
+
+struct ConversionCacheEntryHeader
+{
+    Uint32 Magic         = ConversionCacheMagic;
+    Uint32 FormatVersion = ConversionCacheFormatVersion;
+    Uint64 KeyHash1      = 0;
+    Uint64 SourceHash    = 0;
+    Uint64 SourceSize    = 0;
+};
+
+Uint64 ComputeSourceHash(const String& Source)
+{
+    HLSL2GLSLConversionCache::KeyHasher Hasher;
+    Hasher.Update(Source.data(), Source.length());
+    return Hasher.GetKey().Hash0;
+}
+
+} // namespace
+
+HLSL2GLSLConversionCache::HLSL2GLSLConversionCache(size_t MaxMemorySize) :
+    m_MaxMemorySize{MaxMemorySize}
+{
+}
+
+void HLSL2GLSLConversionCache::SetDirectory(const Char* Directory)
+{
+    String Dir;
+    if (Directory != nullptr && *Directory != '\0')
+    {
+        Dir = Directory;
+        if (Dir.back() != '/' && Dir.back() != '\\')
+            Dir.push_back(FileSystem::GetSlashSymbol());
+    }
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Directory = std::move(Dir);
+}
+
+bool HLSL2GLSLConversionCache::Find(const Key& EntryKey, String& GLSLSource)
+{
+    String Directory;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto It = m_Entries.find(EntryKey);
+        if (It != m_Entries.end())
+        {
+            GLSLSource = It->second;
+            m_MemoryHits.fetch_add(1);
+            return true;
+        }
+        Directory = m_Directory;
+    }
+
+    // Disk access is performed without holding the lock
+    if (!Directory.empty() && LoadFromDisk(Directory, EntryKey, GLSLSource))
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        AddToMemory(EntryKey, GLSLSource);
+        m_DiskHits.fetch_add(1);
+        return true;
+    }
+
+    m_Misses.fetch_add(1);
+    return false;
+}
+
+void HLSL2GLSLConversionCache::Store(const Key& EntryKey, const String& GLSLSource)
+{
+    String Directory;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        AddToMemory(EntryKey, GLSLSource);
+        Directory = m_Directory;
+    }
+
+    if (!Directory.empty())
+        StoreOnDisk(Directory, EntryKey, GLSLSource);
+}
+
+void HLSL2GLSLConversionCache::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Entries.clear();
+    m_EntryOrder.clear();
+    m_MemorySize = 0;
+}
+
+HLSL2GLSLConversionCache::Stats HLSL2GLSLConversionCache::GetStats() const
+{
+    Stats CacheStats;
+    CacheStats.MemoryHits = m_MemoryHits.load();
+    CacheStats.DiskHits   = m_DiskHits.load();
+    CacheStats.Misses     = m_Misses.load();
+    return CacheStats;
+}
+
+void HLSL2GLSLConversionCache::AddToMemory(const Key& EntryKey, const String& GLSLSource)
+{
+    if (GLSLSource.length() > m_MaxMemorySize)
+        return;
+
+    auto Inserted = m_Entries.emplace(EntryKey, GLSLSource);
+    if (!Inserted.second)
+        return;
+
+    m_EntryOrder.push_back(EntryKey);
+    m_MemorySize += GLSLSource.length();
+    while (m_MemorySize > m_MaxMemorySize)
+    {
+        VERIFY_EXPR(!m_EntryOrder.empty());
+        auto It = m_Entries.find(m_EntryOrder.front());
+        VERIFY_EXPR(It != m_Entries.end());
+        m_MemorySize -= It->second.length();
+        m_Entries.erase(It);
+        m_EntryOrder.pop_front();
+    }
+}
+
+static String GetEntryPath(const String& Directory, const HLSL2GLSLConversionCache::Key& EntryKey)
+{
+    char FileName[32];
+    snprintf(FileName, sizeof(FileName), "%016llx.glsl", static_cast<unsigned long long>(EntryKey.Hash0));
+    return Directory + FileName;
+}
+
+bool HLSL2GLSLConversionCache::LoadFromDisk(const String& Directory, const Key& EntryKey, String& GLSLSource) const
+{
+    const auto EntryPath = GetEntryPath(Directory, EntryKey);
+    if (!FileSystem::FileExists(EntryPath.c_str()))
+        return false;
+
+    bool IsValid = false;
+    {
+        FileWrapper File{EntryPath.c_str(), EFileAccessMode::Read};
+        if (!File)
+            return false;
+
+        const auto FileSize = File->GetSize();
+
+        ConversionCacheEntryHeader Header;
+        if (FileSize >= sizeof(Header) && File->Read(&Header, sizeof(Header)))
+        {
+            if (Header.Magic == ConversionCacheMagic &&
+                Header.FormatVersion == ConversionCacheFormatVersion &&
+                Header.KeyHash1 == EntryKey.Hash1 &&
+                Header.SourceSize != 0 &&
+                Header.SourceSize == FileSize - sizeof(Header))
+            {
+                GLSLSource.resize(static_cast<size_t>(Header.SourceSize));
+                IsValid = File->Read(&GLSLSource[0], GLSLSource.length()) &&
+                    ComputeSourceHash(GLSLSource) == Header.SourceHash;
+            }
+        }
+    }
+
+    if (!IsValid)
+    {
+        LOG_WARNING_MESSAGE("HLSL->GLSL conversion cache entry '", EntryPath, "' is corrupted or belongs to a different shader and will be removed");
+        GLSLSource.clear();
+        FileSystem::DeleteFile(EntryPath.c_str());
+    }
+
+    return IsValid;
+}
+
+void HLSL2GLSLConversionCache::StoreOnDisk(const String& Directory, const Key& EntryKey, const String& GLSLSource) const
+{
+    if (GLSLSource.empty())
+        return;
+
+    const auto EntryPath = GetEntryPath(Directory, EntryKey);
+
+    // Write the entry to a uniquely named temporary file first, so that other threads and
+    // processes never see a partially written entry
+    static std::atomic<Uint32> TmpFileCounter{0};
+    String                     TmpPath = EntryPath;
+    TmpPath += '.';
+    TmpPath += std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    TmpPath += '.';
+    TmpPath += std::to_string(TmpFileCounter.fetch_add(1));
+    TmpPath += ".tmp";
+
+    ConversionCacheEntryHeader Header;
+    Header.KeyHash1   = EntryKey.Hash1;
+    Header.SourceHash = ComputeSourceHash(GLSLSource);
+    Header.SourceSize = GLSLSource.length();
+
+    bool Written = false;
+    {
+        FileWrapper File{TmpPath.c_str(), EFileAccessMode::Overwrite};
+        if (File)
+        {
+            Written = File->Write(&Header, sizeof(Header)) &&
+                File->Write(GLSLSource.data(), GLSLSource.length());
+        }
+    }
+
+    if (!Written)
+    {
+        LOG_WARNING_MESSAGE("Failed to write HLSL->GLSL conversion cache entry '", TmpPath, "'");
+        FileSystem::DeleteFile(TmpPath.c_str());
+        return;
+    }
+
+    if (std::rename(TmpPath.c_str(), EntryPath.c_str()) != 0)
+    {
+        // POSIX rename atomically replaces the destination, but on Windows it always fails
+        // if the destination exists. Entries are content-addressed, so an existing file
+        // holds the same source and is kept.
+        if (!FileSystem::FileExists(EntryPath.c_str()))
+            LOG_WARNING_MESSAGE("Failed to rename HLSL->GLSL conversion cache entry '", TmpPath, "' to '", EntryPath, "'");
+        FileSystem::DeleteFile(TmpPath.c_str());
+    }
+}
+
+} // namespace Diligent
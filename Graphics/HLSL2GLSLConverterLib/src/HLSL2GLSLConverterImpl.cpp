@@ -356,18 +356,24 @@
 #include "pch.h"
 #include <unordered_set>
 #include <string>
+#include <algorithm>
 
 #include "HLSL2GLSLConverterImpl.hpp"
 #include "ShaderBase.hpp"
 #include "DataBlobImpl.hpp"
 #include "StringDataBlobImpl.hpp"
 #include "StringTools.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "APIInfo.h"
 
 using namespace std;
 
 namespace Diligent
 {
 
+// Increment the version whenever a change in the converter affects the conversion result
+static constexpr Uint32 ConversionCacheVersion = 1;
+
 static const Char* g_GLSLDefinitions =
     {
 #include "GLSLDefinitions_inc.h"
@@ -516,12 +522,40 @@ const HLSL2GLSLConverterImpl& HLSL2GLSLConverterImpl::GetInstance()
     return Converter;
 }
 
+String HLSL2GLSLConverterImpl::GetGLSLStubKey(const String& Object, const String& Function, Uint32 NumArguments)
+{
+    return Object + '.' + Function + '.' + std::to_string(NumArguments);
+}
+
+const HLSL2GLSLConverterImpl::GLSLStubInfo* HLSL2GLSLConverterImpl::FindGLSLStub(const Char* Object, const Char* Function, Uint32 NumArguments) const
+{
+    // Format the key on the stack to avoid memory allocations
+    Char Key[128];
+
+    const auto KeyLen = snprintf(Key, sizeof(Key), "%s.%s.%u", Object, Function, NumArguments);
+    if (KeyLen < 0 || static_cast<size_t>(KeyLen) >= sizeof(Key))
+        return nullptr; // No stub has such a long key
+
+    return m_GLSLStubs.Find(Key, static_cast<size_t>(KeyLen));
+}
+
 HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
 {
+    // The tables are first populated into temporary containers and
+    // then converted into immutable perfect hash maps.
+
     // Populate HLSL keywords hash map
-#define DEFINE_KEYWORD(keyword) m_HLSLKeywords.insert(std::make_pair(#keyword, TokenInfo(TokenType::kw_##keyword, #keyword)));
+    std::vector<PerfectHashMap<TokenType>::EntryType> HLSLKeywords;
+#define DEFINE_KEYWORD(keyword) HLSLKeywords.emplace_back(#keyword, TokenType::kw_##keyword);
     ITERATE_KEYWORDS(DEFINE_KEYWORD)
 #undef DEFINE_KEYWORD
+    m_HLSLKeywords = PerfectHashMap<TokenType>{std::move(HLSLKeywords)};
+
+    // Some stubs are defined more than once, the first definition is used
+    std::unordered_map<String, GLSLStubInfo> GLSLStubs;
+
+    std::vector<String> ImageTypes;
+    std::vector<String> AtomicOperations;
 
     // Prepare texture function stubs
     //                          sampler  usampler  isampler sampler*Shadow
@@ -532,7 +566,7 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
         const auto& Pref = Prefixes[i];
         const auto& Suff = Suffixes[i];
         // GetDimensions() does not return anything, so swizzle should be empty
-#define DEFINE_GET_DIM_STUB(Name, Obj, NumArgs) m_GLSLStubs.emplace(make_pair(FunctionStubHashKey(Pref + Obj + Suff, "GetDimensions", NumArgs), GLSLStubInfo(Name, "")))
+#define DEFINE_GET_DIM_STUB(Name, Obj, NumArgs) GLSLStubs.emplace(GetGLSLStubKey(Pref + Obj + Suff, "GetDimensions", NumArgs), GLSLStubInfo(Name, ""))
 
         DEFINE_GET_DIM_STUB("GetTex1DDimensions_1", "sampler1D", 1); // GetDimensions( Width )
         DEFINE_GET_DIM_STUB("GetTex1DDimensions_3", "sampler1D", 3); // GetDimensions( Mip, Width, NumberOfMips )
@@ -574,12 +608,12 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
             DEFINE_GET_DIM_STUB("GetRWTexBufferDimensions_1", "imageBuffer",  1); // GetDimensions( Width )
             // clang-format on
 
-            m_ImageTypes.insert(HashMapStringKey(Pref + "image1D"));
-            m_ImageTypes.insert(HashMapStringKey(Pref + "image1DArray"));
-            m_ImageTypes.insert(HashMapStringKey(Pref + "image2D"));
-            m_ImageTypes.insert(HashMapStringKey(Pref + "image2DArray"));
-            m_ImageTypes.insert(HashMapStringKey(Pref + "image3D"));
-            m_ImageTypes.insert(HashMapStringKey(Pref + "imageBuffer"));
+            ImageTypes.emplace_back(Pref + "image1D");
+            ImageTypes.emplace_back(Pref + "image1DArray");
+            ImageTypes.emplace_back(Pref + "image2D");
+            ImageTypes.emplace_back(Pref + "image2DArray");
+            ImageTypes.emplace_back(Pref + "image3D");
+            ImageTypes.emplace_back(Pref + "imageBuffer");
         }
 #undef DEFINE_GET_DIM_STUB
     }
@@ -600,7 +634,7 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
             // Tex2D.Sample(Tex2D_sampler, f2UV) -> Sample_2(Tex2D, Tex2D_sampler, f2UV)_SWIZZLE3
             const Char* Swizzle = "_SWIZZLE";
 
-#define DEFINE_STUB(Name, Obj, Func, NumArgs) m_GLSLStubs.emplace(make_pair(FunctionStubHashKey(Obj, Func, NumArgs), GLSLStubInfo(Name, Swizzle)))
+#define DEFINE_STUB(Name, Obj, Func, NumArgs) GLSLStubs.emplace(GetGLSLStubKey(Obj, Func, NumArgs), GLSLStubInfo(Name, Swizzle))
 
             // clang-format off
             DEFINE_STUB("Sample_2",      GLSLSampler, "Sample",      2); // Sample     ( Sampler, Location )
@@ -709,7 +743,7 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
     DEFINE_STUB("Interlocked" Op "SharedVar_3", "shared_var", "Interlocked" Op, 3); \
     DEFINE_STUB("Interlocked" Op "Image_2", "image", "Interlocked" Op, 2);          \
     DEFINE_STUB("Interlocked" Op "Image_3", "image", "Interlocked" Op, 3);          \
-    m_AtomicOperations.insert(HashMapStringKey("Interlocked" Op));
+    AtomicOperations.emplace_back("Interlocked" Op);
 
 
     DEFINE_ATOMIC_OP_STUBS("Add");
@@ -723,16 +757,22 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
     // InterlockedCompareExchange( dest, compare_value, value, original_value )
     DEFINE_STUB("InterlockedCompareExchangeSharedVar_4", "shared_var", "InterlockedCompareExchange", 4);
     DEFINE_STUB("InterlockedCompareExchangeImage_4", "image", "InterlockedCompareExchange", 4);
-    m_AtomicOperations.insert(HashMapStringKey("InterlockedCompareExchange"));
+    AtomicOperations.emplace_back("InterlockedCompareExchange");
 
     // InterlockedCompareStore( dest, compare_value, value )
     DEFINE_STUB("InterlockedCompareStoreSharedVar_3", "shared_var", "InterlockedCompareStore", 3);
     DEFINE_STUB("InterlockedCompareStoreImage_3", "image", "InterlockedCompareStore", 3);
-    m_AtomicOperations.insert(HashMapStringKey("InterlockedCompareStore"));
+    AtomicOperations.emplace_back("InterlockedCompareStore");
 
 #undef DEFINE_STUB
 
-#define DEFINE_VARIABLE(ShaderInd, IsOut, Semantic, Variable) m_HLSLSemanticToGLSLVar[ShaderInd][IsOut].emplace(make_pair(HashMapStringKey(Semantic), Variable))
+    m_GLSLStubs        = PerfectHashMap<GLSLStubInfo>{{GLSLStubs.begin(), GLSLStubs.end()}};
+    m_ImageTypes       = PerfectHashSet{ImageTypes};
+    m_AtomicOperations = PerfectHashSet{AtomicOperations};
+
+    std::vector<PerfectHashMap<String>::EntryType> HLSLSemanticToGLSLVar[_countof(m_HLSLSemanticToGLSLVar)][2];
+
+#define DEFINE_VARIABLE(ShaderInd, IsOut, Semantic, Variable) HLSLSemanticToGLSLVar[ShaderInd][IsOut].emplace_back(Semantic, Variable)
     DEFINE_VARIABLE(VSInd, InVar, "sv_vertexid", "_GET_GL_VERTEX_ID");
     DEFINE_VARIABLE(VSInd, InVar, "sv_instanceid", "_GET_GL_INSTANCE_ID");
     DEFINE_VARIABLE(VSInd, OutVar, "sv_position", "_SET_GL_POSITION");
@@ -764,9 +804,368 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
     DEFINE_VARIABLE(CSInd, InVar, "sv_groupthreadid", "_GET_GL_LOCAL_INVOCATION_ID");
     DEFINE_VARIABLE(CSInd, InVar, "sv_groupindex", "_GET_GL_LOCAL_INVOCATION_INDEX");
 #undef DEFINE_VARIABLE
+
+    for (size_t ShaderInd = 0; ShaderInd < _countof(m_HLSLSemanticToGLSLVar); ++ShaderInd)
+    {
+        for (int IsOut = InVar; IsOut <= OutVar; ++IsOut)
+            m_HLSLSemanticToGLSLVar[ShaderInd][IsOut] = PerfectHashMap<String>{std::move(HLSLSemanticToGLSLVar[ShaderInd][IsOut])};
+    }
+
+    ParseGLSLDefinitions();
+
+    HLSL2GLSLConversionCache::KeyHasher Hasher;
+    Hasher.Update(ConversionCacheVersion);
+    Hasher.Update(Uint32{DILIGENT_API_VERSION});
+    Hasher.UpdateStr(g_GLSLDefinitions);
+    m_ConverterHash = Hasher.GetKey();
+}
+
+
+// Calls Handler for every identifier in the [Pos, End) range of Source, skipping comments and numeric constants
+template <typename HandlerType>
+static void EnumerateIdentifiers(const String& Source, String::const_iterator Pos, String::const_iterator End, HandlerType Handler)
+{
+    while (Pos < End)
+    {
+        if (SkipComment(Source, Pos))
+            continue;
+
+        if (isalpha(*Pos) || *Pos == '_')
+        {
+            auto IdentifierStart = Pos;
+            SkipIdentifier(Source, Pos);
+            Handler(IdentifierStart, Pos);
+        }
+        else if (isdigit(*Pos))
+        {
+            // 1.0f, 0u, 1e-5
+            while (Pos < End && (isalnum(*Pos) || *Pos == '_' || *Pos == '.'))
+                ++Pos;
+        }
+        else
+            ++Pos;
+    }
+}
+
+// Splits GLSL definitions into segments and finds dependencies between them
+void HLSL2GLSLConverterImpl::ParseGLSLDefinitions()
+{
+    using SegmentType = GLSLDefinitionSegment::SegmentType;
+
+    const String Definitions{g_GLSLDefinitions};
+
+    // Identifiers referenced by every segment
+    std::vector<std::vector<String>> References;
+    std::vector<Uint32>              ConditionalStack;
+
+    std::unordered_map<String, std::vector<Uint32>> DefinitionsByName;
+
+    auto Pos          = Definitions.cbegin();
+    auto SegmentStart = Pos;
+    while (!SkipDelimetersAndComments(Definitions, Pos))
+    {
+        GLSLDefinitionSegment Segment;
+        String                Name;
+        // Identifiers are collected starting from this position
+        auto BodyStart = Pos;
+        if (*Pos == '#')
+        {
+            // #   define mad fma
+            // ^
+            ++Pos;
+            while (Pos != Definitions.end() && IsWhitespace(*Pos))
+                ++Pos;
+            // #   define mad fma
+            //     ^
+            auto DirectiveStart = Pos;
+            SkipIdentifier(Definitions, Pos);
+            const String Directive{DirectiveStart, Pos};
+            // #   define mad fma
+            //           ^
+            BodyStart = Pos;
+
+            if (Directive == "if" || Directive == "ifdef" || Directive == "ifndef")
+            {
+                Segment.Type = SegmentType::ConditionalBegin;
+                ConditionalStack.push_back(static_cast<Uint32>(m_GLSLDefinitionSegments.size()));
+            }
+            else if (Directive == "else" || Directive == "elif" || Directive == "endif")
+            {
+                if (ConditionalStack.empty())
+                    LOG_ERROR_AND_THROW("Unexpected #", Directive, " in GLSL definitions");
+                Segment.Type                = Directive == "endif" ? SegmentType::ConditionalEnd : SegmentType::ConditionalElse;
+                Segment.ConditionalBeginIdx = ConditionalStack.back();
+                if (Segment.Type == SegmentType::ConditionalEnd)
+                    ConditionalStack.pop_back();
+            }
+            else if (Directive == "define")
+            {
+                Segment.Type = SegmentType::Definition;
+                while (Pos != Definitions.end() && IsWhitespace(*Pos))
+                    ++Pos;
+                auto NameStart = Pos;
+                SkipIdentifier(Definitions, Pos);
+                Name.assign(NameStart, Pos);
+                BodyStart = Pos;
+            }
+
+            // Find the end of the directive, taking line continuations into account
+            for (; Pos != Definitions.end() && !IsNewLine(*Pos); ++Pos)
+            {
+                if (*Pos == '\\')
+                {
+                    // Skip the escaped new line
+                    ++Pos;
+                    if (Pos != Definitions.end() && *Pos == '\r')
+                        ++Pos;
+                    if (Pos == Definitions.end())
+                        break;
+                }
+            }
+        }
+        else
+        {
+            // float rcp( float x ){ return 1.0 / x; }
+            // ^
+            // in gl_PerVertex { vec4 gl_Position; } gl_in[];
+            // ^
+            int  BraceDepth       = 0;
+            int  BracketDepth     = 0;
+            bool IsFunction       = false;
+            bool BodyFound        = false;
+            bool StatementEndFound = false;
+            while (Pos != Definitions.end() && !StatementEndFound)
+            {
+                if (SkipComment(Definitions, Pos))
+                    continue;
+
+                switch (*Pos)
+                {
+                    case '(':
+                        if (BracketDepth == 0 && BraceDepth == 0 && !BodyFound && Name.empty())
+                        {
+                            // float rcp( float x ){ return 1.0 / x; }
+                            //          ^
+                            auto NameEnd = Pos;
+                            while (NameEnd != BodyStart && IsDelimiter(*(NameEnd - 1)))
+                                --NameEnd;
+                            auto NameStart = NameEnd;
+                            while (NameStart != BodyStart && (isalnum(*(NameStart - 1)) || *(NameStart - 1) == '_'))
+                                --NameStart;
+                            Name.assign(NameStart, NameEnd);
+                            IsFunction = !Name.empty();
+                        }
+                        ++BracketDepth;
+                        break;
+
+                    case ')':
+                        --BracketDepth;
+                        break;
+
+                    case '=':
+                        // Global variable initialization
+                        if (BraceDepth == 0 && !BodyFound)
+                            IsFunction = false;
+                        break;
+
+                    case '{':
+                        ++BraceDepth;
+                        BodyFound = true;
+                        break;
+
+                    case '}':
+                        --BraceDepth;
+                        if (BraceDepth == 0 && IsFunction)
+                            StatementEndFound = true;
+                        break;
+
+                    case ';':
+                        if (BraceDepth == 0)
+                        {
+                            // Function prototypes and variable declarations are always included
+                            IsFunction        = false;
+                            StatementEndFound = true;
+                        }
+                        break;
+                }
+                ++Pos;
+            }
+
+            if (IsFunction && BodyFound)
+                Segment.Type = SegmentType::Definition;
+            else
+                Name.clear();
+        }
+
+        // Include the rest of the line into the segment
+        while (Pos != Definitions.end() && IsWhitespace(*Pos))
+            ++Pos;
+        if (Pos != Definitions.end() && *Pos == '\r')
+            ++Pos;
+        if (Pos != Definitions.end() && *Pos == '\n')
+            ++Pos;
+
+        std::vector<String> SegmentReferences;
+        EnumerateIdentifiers(Definitions, BodyStart, Pos,
+                             [&](String::const_iterator IdStart, String::const_iterator IdEnd) //
+                             {
+                                 SegmentReferences.emplace_back(IdStart, IdEnd);
+                             });
+        References.emplace_back(std::move(SegmentReferences));
+
+        const auto SegmentIdx = static_cast<Uint32>(m_GLSLDefinitionSegments.size());
+        if (!Name.empty())
+        {
+            VERIFY_EXPR(Segment.Type == SegmentType::Definition);
+            DefinitionsByName[Name].push_back(SegmentIdx);
+        }
+
+        Segment.Text.assign(SegmentStart, Pos);
+        m_GLSLDefinitionSegments.emplace_back(std::move(Segment));
+        SegmentStart = Pos;
+    }
+    if (!ConditionalStack.empty())
+        LOG_ERROR_AND_THROW("Missing #endif in GLSL definitions");
+
+    m_GLSLDefinitionsByName = PerfectHashMap<std::vector<Uint32>>{{DefinitionsByName.begin(), DefinitionsByName.end()}};
+
+    m_AlwaysRequiredGLSLDefinitions.resize(m_GLSLDefinitionSegments.size());
+    for (Uint32 i = 0; i < m_GLSLDefinitionSegments.size(); ++i)
+    {
+        auto& Segment = m_GLSLDefinitionSegments[i];
+        for (const auto& Identifier : References[i])
+        {
+            if (const auto* pSegments = m_GLSLDefinitionsByName.Find(Identifier))
+                Segment.Dependencies.insert(Segment.Dependencies.end(), pSegments->begin(), pSegments->end());
+        }
+        std::sort(Segment.Dependencies.begin(), Segment.Dependencies.end());
+        Segment.Dependencies.erase(std::unique(Segment.Dependencies.begin(), Segment.Dependencies.end()), Segment.Dependencies.end());
+
+        if (Segment.Type != SegmentType::Definition)
+            m_AlwaysRequiredGLSLDefinitions[i] = true;
+    }
+
+    // Add all dependencies of the always required segments
+    std::vector<Uint32> Worklist;
+    for (Uint32 i = 0; i < m_GLSLDefinitionSegments.size(); ++i)
+    {
+        if (m_AlwaysRequiredGLSLDefinitions[i])
+            Worklist.push_back(i);
+    }
+    while (!Worklist.empty())
+    {
+        auto SegmentIdx = Worklist.back();
+        Worklist.pop_back();
+        for (auto Dependency : m_GLSLDefinitionSegments[SegmentIdx].Dependencies)
+        {
+            if (!m_AlwaysRequiredGLSLDefinitions[Dependency])
+            {
+                m_AlwaysRequiredGLSLDefinitions[Dependency] = true;
+                Worklist.push_back(Dependency);
+            }
+        }
+    }
+}
+
+// Returns the GLSL definitions that are referenced by the GLSL source or by the macros
+String HLSL2GLSLConverterImpl::GetRequiredGLSLDefinitions(const String& GLSLSource, const ShaderMacro* Macros) const
+{
+    using SegmentType = GLSLDefinitionSegment::SegmentType;
+
+    const auto NumSegments = m_GLSLDefinitionSegments.size();
+
+    auto                IsRequired = m_AlwaysRequiredGLSLDefinitions;
+    std::vector<Uint32> Worklist;
+
+    auto AddReference = [&](String::const_iterator IdStart, String::const_iterator IdEnd) //
+    {
+        const auto* pSegments = m_GLSLDefinitionsByName.Find(&*IdStart, static_cast<size_t>(IdEnd - IdStart));
+        if (pSegments == nullptr)
+            return;
+
+        for (auto SegmentIdx : *pSegments)
+        {
+            if (!IsRequired[SegmentIdx])
+            {
+                IsRequired[SegmentIdx] = true;
+                Worklist.push_back(SegmentIdx);
+            }
+        }
+    };
+
+    EnumerateIdentifiers(GLSLSource, GLSLSource.begin(), GLSLSource.end(), AddReference);
+    if (Macros != nullptr)
+    {
+        for (auto* pMacro = Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+        {
+            const String Definition{pMacro->Definition};
+            EnumerateIdentifiers(Definition, Definition.begin(), Definition.end(), AddReference);
+        }
+    }
+
+    while (!Worklist.empty())
+    {
+        auto SegmentIdx = Worklist.back();
+        Worklist.pop_back();
+        for (auto Dependency : m_GLSLDefinitionSegments[SegmentIdx].Dependencies)
+        {
+            if (!IsRequired[Dependency])
+            {
+                IsRequired[Dependency] = true;
+                Worklist.push_back(Dependency);
+            }
+        }
+    }
+
+    // Conditional blocks that do not contain any required definition are removed entirely.
+    // IsRequired is updated for #if segments to indicate whether the block is used.
+    std::vector<Uint32> ConditionalStack;
+    for (size_t i = 0; i < NumSegments; ++i)
+    {
+        const auto& Segment = m_GLSLDefinitionSegments[i];
+        switch (Segment.Type)
+        {
+            case SegmentType::ConditionalBegin:
+                ConditionalStack.push_back(static_cast<Uint32>(i));
+                IsRequired[i] = false;
+                break;
+
+            case SegmentType::ConditionalElse:
+                break;
+
+            case SegmentType::ConditionalEnd:
+            {
+                VERIFY_EXPR(!ConditionalStack.empty() && ConditionalStack.back() == Segment.ConditionalBeginIdx);
+                ConditionalStack.pop_back();
+                if (IsRequired[Segment.ConditionalBeginIdx] && !ConditionalStack.empty())
+                    IsRequired[ConditionalStack.back()] = true;
+            }
+            break;
+
+            default:
+                if (IsRequired[i] && !ConditionalStack.empty())
+                    IsRequired[ConditionalStack.back()] = true;
+        }
+    }
+
+    String RequiredDefinitions;
+    for (size_t i = 0; i < NumSegments; ++i)
+    {
+        const auto& Segment = m_GLSLDefinitionSegments[i];
+
+        const bool IncludeSegment = (Segment.Type == SegmentType::ConditionalElse || Segment.Type == SegmentType::ConditionalEnd) ?
+            IsRequired[Segment.ConditionalBeginIdx] :
+            IsRequired[i];
+        if (IncludeSegment)
+            RequiredDefinitions.append(Segment.Text);
+    }
+    if (!RequiredDefinitions.empty() && RequiredDefinitions.back() != '\n')
+        RequiredDefinitions.push_back('\n');
+
+    return RequiredDefinitions;
 }
 
-String CompressNewLines(const String& Str)
+String CompressNewLines(const TokenString& Str)
 {
     String Out;
     auto   Char = Str.begin();
@@ -792,7 +1191,7 @@ String CompressNewLines(const String& Str)
     return Out;
 }
 
-static Int32 CountNewLines(const String& Str)
+static Int32 CountNewLines(const TokenString& Str)
 {
     Int32 NumNewLines = 0;
     auto  Char        = Str.begin();
@@ -871,7 +1270,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     for (; Token != CurrLineStartToken; ++Token)
     {
         Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx.append(Token->Literal.c_str());
     }
 
     //\n  if ( x != 0 )
@@ -903,7 +1302,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
             Spaces.append(Token->Literal.length(), ' ');
 
         Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx.append(Token->Literal.c_str());
         ++Token;
 
         if (Token == m_Tokens.end())
@@ -921,7 +1320,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     while (Token != m_Tokens.end() && NumLinesBelow <= NumAdjacentLines)
     {
         Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx.append(Token->Literal.c_str());
         ++Token;
 
         if (Token == m_Tokens.end())
@@ -1070,42 +1469,42 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
 }
 
 
-void ReadNumericConstant(const String& Source, String::const_iterator& Pos, String& Output)
+void SkipNumericConstant(const String& Source, String::const_iterator& Pos)
 {
-#define COPY_SYMBOL()                    \
+#define SKIP_SYMBOL()                    \
     {                                    \
-        Output.push_back(*(Pos++));      \
+        ++Pos;                           \
         if (Pos == Source.end()) return; \
     }
 
     while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
     if (*Pos == '.')
     {
-        COPY_SYMBOL()
-        // Copy all numbers
+        SKIP_SYMBOL()
+        // Skip all numbers
         while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
 
     // Scientific notation
     // e+1242, E-234
     if (*Pos == 'e' || *Pos == 'E')
     {
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
         if (*Pos == '+' || *Pos == '-')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
 
         // Skip all numbers
         while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
 
     if (*Pos == 'f' || *Pos == 'F')
-        COPY_SYMBOL()
-#undef COPY_SYMBOL
+        SKIP_SYMBOL()
+#undef SKIP_SYMBOL
 }
 
 
@@ -1126,6 +1525,27 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
     int OpenBraceCount   = 0;
     int OpenStapleCount  = 0;
 
+    // Text of all literals and delimiters is copied into the string pool, and tokens keep null-terminated
+    // views into it. Every non-empty string takes at most twice its length (including the terminator),
+    // and the strings never overlap in the source, so twice the source length is always enough.
+    m_TokenTextPool.Reserve(Source.length() * 2 + 1, DefaultRawMemoryAllocator::GetAllocator());
+
+    auto MakeTokenString = [&](String::const_iterator Start, String::const_iterator End) //
+    {
+        if (Start == End)
+            return TokenString{};
+
+        const auto Length = static_cast<size_t>(End - Start);
+        auto*      Str    = m_TokenTextPool.Allocate(Length + 1);
+        memcpy(Str, &*Start, Length);
+        Str[Length] = 0;
+        return TokenString::View(Str, Length);
+    };
+
+    // Most tokens are a few characters long, so a rough estimate avoids
+    // multiple reallocations of the block list
+    m_Tokens.reserve(Source.length() / 4);
+
     // Push empty node in the beginning of the list to facilitate
     // backwards searching
     m_Tokens.push_back(TokenInfo());
@@ -1142,38 +1562,32 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
         TokenInfo NewToken;
         auto      DelimStart = SrcPos;
         SkipDelimetersAndComments(Source, SrcPos);
-        if (DelimStart != SrcPos)
-        {
-            auto DelimSize = SrcPos - DelimStart;
-            NewToken.Delimiter.reserve(DelimSize);
-            NewToken.Delimiter.append(DelimStart, SrcPos);
-        }
+        NewToken.Delimiter = MakeTokenString(DelimStart, SrcPos);
         if (SrcPos == Source.end())
             break;
 
+        // For all tokens except for string constants and identifiers, the literal
+        // is the source text between LiteralStart and SrcPos after the switch
+        auto LiteralStart = SrcPos;
         switch (*SrcPos)
         {
             case '#':
             {
-                NewToken.Type       = TokenType::PreprocessorDirective;
-                auto DirectiveStart = SrcPos;
+                NewToken.Type = TokenType::PreprocessorDirective;
                 ++SrcPos;
                 SkipDelimetersAndComments(Source, SrcPos);
                 CHECK_END("Missing preprocessor directive");
                 SkipIdentifier(Source, SrcPos);
-                auto DirectiveSize = SrcPos - DirectiveStart;
-                NewToken.Literal.reserve(DirectiveSize);
-                NewToken.Literal.append(DirectiveStart, SrcPos);
             }
             break;
 
             case ';':
                 NewToken.Type = TokenType::Semicolon;
-                NewToken.Literal.push_back(*(SrcPos++));
+                ++SrcPos;
                 break;
 
             case '=':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "")
+                if (m_Tokens.size() > 0 && NewToken.Delimiter.empty())
                 {
                     auto& LastToken = m_Tokens.back();
                     // +=, -=, *=, /=, %=, <<=, >>=, &=, |=, ^=
@@ -1204,12 +1618,12 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 }
 
                 NewToken.Type = TokenType::Assignment;
-                NewToken.Literal.push_back(*(SrcPos++));
+                ++SrcPos;
                 break;
 
             case '|':
             case '&':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
+                if (m_Tokens.size() > 0 && NewToken.Delimiter.empty() &&
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
                 {
                     m_Tokens.back().Type = TokenType::BooleanOp;
@@ -1219,13 +1633,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 else
                 {
                     NewToken.Type = TokenType::BitwiseOp;
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    ++SrcPos;
                 }
                 break;
 
             case '<':
             case '>':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
+                if (m_Tokens.size() > 0 && NewToken.Delimiter.empty() &&
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
                 {
                     m_Tokens.back().Type = TokenType::BitwiseOp;
@@ -1238,13 +1652,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                     // and template arguments like in Texture2D<float> at this
                     // point. This will be clarified when textures are processed.
                     NewToken.Type = TokenType::ComparisonOp;
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    ++SrcPos;
                 }
                 break;
 
             case '+':
             case '-':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
+                if (m_Tokens.size() > 0 && NewToken.Delimiter.empty() &&
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
                 {
                     m_Tokens.back().Type = TokenType::IncDecOp;
@@ -1255,55 +1669,59 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 {
                     // We do not currently distinguish between math operator a + b,
                     // unary operator -a and numerical constant -1:
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    ++SrcPos;
                 }
                 break;
 
             case '~':
             case '^':
                 NewToken.Type = TokenType::BitwiseOp;
-                NewToken.Literal.push_back(*(SrcPos++));
+                ++SrcPos;
                 break;
 
             case '*':
             case '/':
             case '%':
                 NewToken.Type = TokenType::MathOp;
-                NewToken.Literal.push_back(*(SrcPos++));
+                ++SrcPos;
                 break;
 
             case '!':
                 NewToken.Type = TokenType::BooleanOp;
-                NewToken.Literal.push_back(*(SrcPos++));
+                ++SrcPos;
                 break;
 
             case ',':
                 NewToken.Type = TokenType::Comma;
-                NewToken.Literal.push_back(*(SrcPos++));
+                ++SrcPos;
                 break;
 
             case '"':
+            {
                 //[domain("quad")]
                 //        ^
                 NewToken.Type = TokenType::SrtingConstant;
                 ++SrcPos;
                 //[domain("quad")]
                 //         ^
+                auto StringStart = SrcPos;
                 while (SrcPos != Source.end() && *SrcPos != '"')
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    ++SrcPos;
                 //[domain("quad")]
                 //             ^
+                NewToken.Literal = MakeTokenString(StringStart, SrcPos);
                 if (SrcPos != Source.end())
                     ++SrcPos;
                 //[domain("quad")]
                 //              ^
-                break;
+            }
+            break;
 
-#define BRACKET_CASE(Symbol, TokenType, Action)  \
-    case Symbol:                                 \
-        NewToken.Type = TokenType;               \
-        NewToken.Literal.push_back(*(SrcPos++)); \
-        Action;                                  \
+#define BRACKET_CASE(Symbol, TokenType, Action) \
+    case Symbol:                                \
+        NewToken.Type = TokenType;              \
+        ++SrcPos;                               \
+        Action;                                 \
         break;
 
                 BRACKET_CASE('(', TokenType::OpenBracket, ++OpenBracketCount);
@@ -1318,23 +1736,12 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
 
             default:
             {
-                auto IdentifierStartPos = SrcPos;
                 SkipIdentifier(Source, SrcPos);
-                if (IdentifierStartPos != SrcPos)
+                if (LiteralStart != SrcPos)
                 {
-                    auto IDSize = SrcPos - IdentifierStartPos;
-                    NewToken.Literal.reserve(IDSize);
-                    NewToken.Literal.append(IdentifierStartPos, SrcPos);
-                    auto KeywordIt = m_Converter.m_HLSLKeywords.find(NewToken.Literal.c_str());
-                    if (KeywordIt != m_Converter.m_HLSLKeywords.end())
-                    {
-                        NewToken.Type = KeywordIt->second.Type;
-                        VERIFY(NewToken.Literal == KeywordIt->second.Literal, "Inconsistent literal");
-                    }
-                    else
-                    {
-                        NewToken.Type = TokenType::Identifier;
-                    }
+                    NewToken.Literal = MakeTokenString(LiteralStart, SrcPos);
+                    const auto* pKeyword = m_Converter.m_HLSLKeywords.Find(NewToken.Literal.c_str(), NewToken.Literal.length());
+                    NewToken.Type        = pKeyword != nullptr ? *pKeyword : TokenType::Identifier;
                 }
 
                 if (NewToken.Type == TokenType::Undefined)
@@ -1347,21 +1754,24 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                     }
                     if (bIsNumericalCostant)
                     {
-                        ReadNumericConstant(Source, SrcPos, NewToken.Literal);
+                        SkipNumericConstant(Source, SrcPos);
                         NewToken.Type = TokenType::NumericConstant;
                     }
                 }
 
                 if (NewToken.Type == TokenType::Undefined)
                 {
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    ++SrcPos;
                 }
                 // Operators
                 // https://msdn.microsoft.com/en-us/library/windows/desktop/bb509631(v=vs.85).aspx
             }
         }
 
-        m_Tokens.push_back(NewToken);
+        if (NewToken.Type != TokenType::SrtingConstant && NewToken.Literal.empty())
+            NewToken.Literal = MakeTokenString(LiteralStart, SrcPos);
+
+        m_Tokens.push_back(std::move(NewToken));
     }
 #undef CHECK_END
 }
@@ -1671,7 +2081,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseSamplers(TokenListType::iter
                 const auto& SamplerName = Token->Literal;
 
                 // Add sampler state into the hash map
-                SamplersHash.insert(std::make_pair(SamplerName, bIsComparison));
+                SamplersHash.insert(std::make_pair(SamplerName.str(), bIsComparison));
 
                 ++Token;
                 // SamplerState LinearClamp ;
@@ -1897,13 +2307,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
         {
             // RWTexture2D<float /* format = r32f */ >
             //                                       ^
-            ParseImageFormat(Token->Delimiter, ImgFormat);
+            ParseImageFormat(Token->Delimiter.str(), ImgFormat);
             if (ImgFormat.length() == 0)
             {
                 // RWTexture2D</* format = r32f */ float >
                 //                                 ^
                 //                            TexFmtToken
-                ParseImageFormat(TexFmtToken->Delimiter, ImgFormat);
+                ParseImageFormat(TexFmtToken->Delimiter.str(), ImgFormat);
             }
 
             if (ImgFormat.length() != 0)
@@ -2022,7 +2432,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
                 TexDeclToken->Literal.append("IMAGE_WRITEONLY "); // defined as 'writeonly' on GLES and as '' on desktop in GLSLDefinitions.h
         }
         TexDeclToken->Literal.append(CompleteGLSLSampler);
-        Objects.m.insert(std::make_pair(HashMapStringKey(TextureName), HLSLObjectInfo(CompleteGLSLSampler, NumComponents)));
+        Objects.m.emplace(HashMapStringKey{m_Arena.CopyString(TextureName.c_str(), TextureName.length())},
+                          HLSLObjectInfo{m_Arena.CopyString(CompleteGLSLSampler.c_str(), CompleteGLSLSampler.length()), NumComponents});
 
         // In global scope, multiple variables can be declared in the same statement
         if (IsGlobalScope)
@@ -2095,11 +2506,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
 
 
 // Finds an HLSL object with the given name in object stack
-const HLSL2GLSLConverterImpl::HLSLObjectInfo* HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject(const String& Name)
+const HLSL2GLSLConverterImpl::HLSLObjectInfo* HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject(const Char* Name)
 {
     for (auto ScopeIt = m_Objects.rbegin(); ScopeIt != m_Objects.rend(); ++ScopeIt)
     {
-        auto It = ScopeIt->m.find(Name.c_str());
+        auto It = ScopeIt->m.find(Name);
         if (It != ScopeIt->m.end())
             return &It->second;
     }
@@ -2173,7 +2584,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // IdentifierToken
 
     // Try to find identifier
-    const auto* pObjectInfo = FindHLSLObject(IdentifierToken->Literal);
+    const auto* pObjectInfo = FindHLSLObject(IdentifierToken->Literal.c_str());
     if (pObjectInfo == nullptr)
     {
         return false;
@@ -2197,8 +2608,8 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // TestText.Sample( TestText_sampler, float2(0.0, 1.0)  );
     //                                                       ^
     //                                               ArgsListEndToken
-    auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey(ObjectType, MethodToken->Literal.c_str(), NumArguments));
-    if (StubIt == m_Converter.m_GLSLStubs.end())
+    const auto* pStub = m_Converter.FindGLSLStub(ObjectType, MethodToken->Literal.c_str(), NumArguments);
+    if (pStub == nullptr)
     {
         LOG_ERROR_MESSAGE("Unable to find function stub for ", IdentifierToken->Literal, ".", MethodToken->Literal, "(", NumArguments, " args). GLSL object type: ", ObjectType);
         return false;
@@ -2220,7 +2631,10 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // ^
     // IdentifierToken
 
-    m_Tokens.insert(IdentifierToken, TokenInfo(TokenType::Identifier, StubIt->second.Name.c_str(), IdentifierToken->Delimiter.c_str()));
+    // Stub names are owned by the converter, so the token can reference them without making a copy
+    auto StubToken       = m_Tokens.insert(IdentifierToken, TokenInfo{TokenType::Identifier});
+    StubToken->Literal   = TokenString::View(pStub->Name.c_str(), pStub->Name.length());
+    StubToken->Delimiter = IdentifierToken->Delimiter;
     IdentifierToken->Delimiter = " ";
     // FunctionStub TestTextArr[2], TestTextArr_sampler, ...
     //              ^
@@ -2244,13 +2658,13 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
 
 
     // Add swizzling if there is any
-    if (StubIt->second.Swizzle.length() > 0)
+    if (pStub->Swizzle.length() > 0)
     {
         // FunctionStub( TestTextArr[2], TestTextArr_sampler, ...    );
         //                                                            ^
         //                                                     ArgsListEndToken
 
-        auto SwizzleToken = m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, StubIt->second.Swizzle.c_str(), ""));
+        auto SwizzleToken = m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, pStub->Swizzle.c_str(), ""));
         SwizzleToken->Literal.push_back(static_cast<Char>('0' + pObjectInfo->NumComponents));
         // FunctionStub( TestTextArr[2], TestTextArr_sampler, ...    )_SWIZZLE4;
         //                                                                     ^
@@ -2493,7 +2907,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessRWTextures(const TokenList
         if (Token->Type == TokenType::Identifier)
         {
             // Try to find the object in all scopes
-            const auto* pObjectInfo = FindHLSLObject(Token->Literal);
+            const auto* pObjectInfo = FindHLSLObject(Token->Literal.c_str());
             if (pObjectInfo == nullptr)
             {
                 ++Token;
@@ -2501,8 +2915,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessRWTextures(const TokenList
             }
 
             // Check if the object is image type
-            auto ImgTypeIt = m_Converter.m_ImageTypes.find(pObjectInfo->GLSLType.c_str());
-            if (ImgTypeIt == m_Converter.m_ImageTypes.end())
+            if (!m_Converter.m_ImageTypes.Contains(pObjectInfo->GLSLType))
             {
                 ++Token;
                 continue;
@@ -2531,8 +2944,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
     {
         if (Token->Type == TokenType::Identifier)
         {
-            auto AtomicIt = m_Converter.m_AtomicOperations.find(Token->Literal.c_str());
-            if (AtomicIt == m_Converter.m_AtomicOperations.end())
+            if (!m_Converter.m_AtomicOperations.Contains(Token->Literal.c_str(), Token->Literal.length()))
             {
                 ++Token;
                 continue;
@@ -2557,13 +2969,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
             ++Token;
             VERIFY_PARSER_STATE(Token, Token != ScopeEnd, "Unexpected EOF");
 
-            const auto* pObjectInfo = FindHLSLObject(Token->Literal);
+            const auto* pObjectInfo = FindHLSLObject(Token->Literal.c_str());
             if (pObjectInfo != nullptr)
             {
                 // InterlockedAdd(Tex2D[GTid.xy], 1, iOldVal);
                 //                ^
-                auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey("image", OperationToken->Literal.c_str(), NumArguments));
-                VERIFY_PARSER_STATE(OperationToken, StubIt != m_Converter.m_GLSLStubs.end(), "Unable to find function stub for funciton ", OperationToken->Literal, " with ", NumArguments, " arguments");
+                const auto* pStub = m_Converter.FindGLSLStub("image", OperationToken->Literal.c_str(), NumArguments);
+                VERIFY_PARSER_STATE(OperationToken, pStub != nullptr, "Unable to find function stub for funciton ", OperationToken->Literal, " with ", NumArguments, " arguments");
 
                 // Find first comma
                 int NumOpenBrackets = 1;
@@ -2605,16 +3017,16 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
                 // InterlockedAdd(Tex2D,GTid.xy, 1, iOldVal);
                 //                     ^
 
-                OperationToken->Literal = StubIt->second.Name;
+                OperationToken->Literal = TokenString::View(pStub->Name.c_str(), pStub->Name.length());
                 // InterlockedAddImage_3(Tex2D,GTid.xy, 1, iOldVal);
             }
             else
             {
                 // InterlockedAdd(g_i4SharedArray[GTid.x].x, 1, iOldVal);
                 //                ^
-                auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey("shared_var", OperationToken->Literal.c_str(), NumArguments));
-                VERIFY_PARSER_STATE(OperationToken, StubIt != m_Converter.m_GLSLStubs.end(), "Unable to find function stub for funciton ", OperationToken->Literal, " with ", NumArguments, " arguments");
-                OperationToken->Literal = StubIt->second.Name;
+                const auto* pStub = m_Converter.FindGLSLStub("shared_var", OperationToken->Literal.c_str(), NumArguments);
+                VERIFY_PARSER_STATE(OperationToken, pStub != nullptr, "Unable to find function stub for funciton ", OperationToken->Literal, " with ", NumArguments, " arguments");
+                OperationToken->Literal = TokenString::View(pStub->Name.c_str(), pStub->Name.length());
                 // InterlockedAddSharedVar_3(g_i4SharedArray[GTid.x].x, 1, iOldVal);
             }
             Token = ArgsListEndToken;
@@ -2631,14 +3043,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
     VERIFY_PARSER_STATE(Token, Token->IsBuiltInType() || Token->Type == TokenType::Identifier,
                         "Missing argument type");
     auto TypeToken = Token;
-    ParamInfo.Type = Token->Literal;
+    ParamInfo.Type = Token->Literal.str();
 
     ++Token;
     //          out float4 Color : SV_Target,
     //                     ^
     VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF while parsing argument list");
     VERIFY_PARSER_STATE(Token, Token->Type == TokenType::Identifier, "Missing argument name after ", ParamInfo.Type);
-    ParamInfo.Name = Token->Literal;
+    ParamInfo.Name = Token->Literal.str();
 
     ++Token;
     VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF");
@@ -2650,8 +3062,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
         ProcessScope(
             Token, m_Tokens.end(), TokenType::OpenStaple, TokenType::ClosingStaple,
             [&](TokenListType::iterator& tkn, int) {
-                ParamInfo.ArraySize.append(tkn->Delimiter);
-                ParamInfo.ArraySize.append(tkn->Literal);
+                ParamInfo.ArraySize.append(tkn->Delimiter.c_str());
+                ParamInfo.ArraySize.append(tkn->Literal.c_str());
                 ++tkn;
             } //
         );
@@ -2679,7 +3091,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
             VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected end of file while looking for semantic for argument \"", ParamInfo.Name, '\"');
             VERIFY_PARSER_STATE(Token, Token->Type == TokenType::Identifier, "Missing semantic for argument \"", ParamInfo.Name, '\"');
             // Transform to lower case -  semantics are case-insensitive
-            ParamInfo.Semantic = StrToLower(Token->Literal);
+            ParamInfo.Semantic = StrToLower(Token->Literal.str());
 
             ++Token;
             //          out float4 Color : SV_Target,
@@ -2743,8 +3155,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
     if (!bIsVoid)
     {
         ShaderParameterInfo RetParam;
-        RetParam.Type             = TypeToken->Literal;
-        RetParam.Name             = FuncNameToken->Literal;
+        RetParam.Type             = TypeToken->Literal.str();
+        RetParam.Name             = FuncNameToken->Literal.str();
         RetParam.storageQualifier = ShaderParameterInfo::StorageQualifier::Ret;
         Params.push_back(RetParam);
     }
@@ -2918,7 +3330,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
                     //                                   ^
                     VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::NumericConstant, "Numeric constant expected");
 
-                    ParamInfo.ArraySize     = TmpToken->Literal;
+                    ParamInfo.ArraySize     = TmpToken->Literal.str();
                     auto NumCtrlPointsToken = TmpToken;
                     ++TmpToken;
                     VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Literal == ">", "Angle bracket expected");
@@ -2968,7 +3380,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
             VERIFY_PARSER_STATE(SemanticToken, SemanticToken != m_Tokens.end(), "Unexpected EOF");
             VERIFY_PARSER_STATE(SemanticToken, SemanticToken->Type == TokenType::Identifier, "Exepcted semantic for the return argument ");
             // Transform to lower case -  semantics are case-insensitive
-            RetParam.Semantic = StrToLower(SemanticToken->Literal);
+            RetParam.Semantic = StrToLower(SemanticToken->Literal.str());
             ++SemanticToken;
             // float4 TestPS  ( in VSOutput In ) : SV_Target
             // {
@@ -3066,10 +3478,9 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderArgument(const Shade
             String GLSLVariable;
             if (ShaderInd >= 0)
             {
-                auto& SemanticToVarMap = m_Converter.m_HLSLSemanticToGLSLVar[ShaderInd][IsOutVar];
-                auto  VarIt            = SemanticToVarMap.find(CurrParam.Semantic.c_str());
-                if (VarIt != SemanticToVarMap.end())
-                    GLSLVariable = VarIt->second;
+                const auto* pVariable = m_Converter.m_HLSLSemanticToGLSLVar[ShaderInd][IsOutVar].Find(CurrParam.Semantic);
+                if (pVariable != nullptr)
+                    GLSLVariable = *pVariable;
             }
 
             ArgHandler(MemberStack, CurrParam, move(GLSLVariable));
@@ -3099,12 +3510,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderArgument(const Shade
 
 bool HLSL2GLSLConverterImpl::ConversionStream::RequiresFlatQualifier(const String& Type)
 {
-    auto keywordIt    = m_Converter.m_HLSLKeywords.find(Type.c_str());
-    bool RequiresFlat = false;
-    if (keywordIt != m_Converter.m_HLSLKeywords.end())
+    const auto* pKeyword     = m_Converter.m_HLSLKeywords.Find(Type);
+    bool        RequiresFlat = false;
+    if (pKeyword != nullptr)
     {
-        VERIFY_EXPR(keywordIt->second.Literal == Type);
-        auto kw      = keywordIt->second.Type;
+        auto kw      = *pKeyword;
         RequiresFlat = (kw >= TokenType::kw_int && kw <= TokenType::kw_int4x4) ||
             (kw >= TokenType::kw_uint && kw <= TokenType::kw_uint4x4) ||
             (kw >= TokenType::kw_min16int && kw <= TokenType::kw_min16int4x4) ||
@@ -3681,8 +4091,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
         VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::Identifier, "Identifier expected");
         // [domain("quad")]
         //  ^
-        auto& Attrib = TmpToken->Literal;
-        StrToLowerInPlace(Attrib);
+        auto Attrib = StrToLower(TmpToken->Literal.str());
 
         ++TmpToken;
         VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::OpenBracket, "\'(\' expected");
@@ -3691,8 +4100,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
             TmpToken, m_Tokens.end(), TokenType::OpenBracket, TokenType::ClosingBracket,
             [&](TokenListType::iterator& tkn, int) //
             {
-                AttribValue.append(tkn->Delimiter);
-                AttribValue.append(tkn->Literal);
+                AttribValue.append(tkn->Delimiter.c_str());
+                AttribValue.append(tkn->Literal.c_str());
                 ++tkn;
             } //
         );
@@ -3998,7 +4407,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessDomainShaderArguments(Toke
     // ^
 
     std::unordered_map<HashMapStringKey, String, HashMapStringKey::Hasher> Attributes;
-    ParseAttributesInComment(TypeToken->Delimiter, Attributes);
+    ParseAttributesInComment(TypeToken->Delimiter.str(), Attributes);
     ProcessShaderAttributes(Token, Attributes);
 
     stringstream GlobalsSS;
@@ -4552,8 +4961,8 @@ String HLSL2GLSLConverterImpl::ConversionStream::BuildGLSLSource()
     String Output;
     for (const auto& Token : m_Tokens)
     {
-        Output.append(Token.Delimiter);
-        Output.append(Token.Literal);
+        Output.append(Token.Delimiter.c_str(), Token.Delimiter.length());
+        Output.append(Token.Literal.c_str(), Token.Literal.length());
     }
     return Output;
 }
@@ -4592,11 +5001,21 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
         NumSymbols = pFileData->GetSize();
     }
 
-    String Source(HLSLSource, NumSymbols);
+    m_Source.assign(HLSLSource, NumSymbols);
 
-    InsertIncludes(Source, pInputStreamFactory);
+    InsertIncludes(m_Source, pInputStreamFactory);
+}
 
-    Tokenize(Source);
+const HLSL2GLSLConversionCache::Key& HLSL2GLSLConverterImpl::ConversionStream::GetSourceHash()
+{
+    if (!m_bSourceHashComputed)
+    {
+        HLSL2GLSLConversionCache::KeyHasher Hasher;
+        Hasher.UpdateStr(m_Source.c_str(), m_Source.length());
+        m_SourceHash          = Hasher.GetKey();
+        m_bSourceHashComputed = true;
+    }
+    return m_SourceHash;
 }
 
 
@@ -4607,7 +5026,7 @@ String HLSL2GLSLConverterImpl::Convert(ConversionAttribs& Attribs) const
         try
         {
             ConversionStream Stream(nullptr, *this, Attribs.InputFileName, Attribs.pSourceStreamFactory, Attribs.HLSLSource, Attribs.NumSymbols, false);
-            return Stream.Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers);
+            return ConvertStream(Stream, Attribs);
         }
         catch (std::runtime_error&)
         {
@@ -4636,10 +5055,42 @@ String HLSL2GLSLConverterImpl::Convert(ConversionAttribs& Attribs) const
             pStream = ValidatedCast<ConversionStream>(*Attribs.ppConversionStream);
         }
 
-        return pStream->Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers);
+        return ConvertStream(*pStream, Attribs);
     }
 }
 
+String HLSL2GLSLConverterImpl::ConvertStream(ConversionStream& Stream, const ConversionAttribs& Attribs) const
+{
+    if (!Attribs.UseCache)
+        return Stream.Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers, Attribs.Macros);
+
+    HLSL2GLSLConversionCache::KeyHasher Hasher;
+    Hasher.Update(m_ConverterHash);
+    Hasher.Update(Stream.GetSourceHash());
+    Hasher.UpdateStr(Attribs.EntryPoint);
+    Hasher.Update(static_cast<Uint32>(Attribs.ShaderType));
+    Hasher.UpdateStr(Attribs.SamplerSuffix);
+    Hasher.Update(Attribs.UseInOutLocationQualifiers);
+    Hasher.Update(Attribs.IncludeDefinitions);
+    // Macros are not expanded by the converter and only affect the set of included definitions
+    if (Attribs.IncludeDefinitions && Attribs.Macros != nullptr)
+    {
+        for (const auto* pMacro = Attribs.Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+            Hasher.UpdateStr(pMacro->Definition);
+    }
+    const auto CacheKey = Hasher.GetKey();
+
+    String GLSLSource;
+    if (m_ConversionCache.Find(CacheKey, GLSLSource))
+        return GLSLSource;
+
+    GLSLSource = Stream.Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers, Attribs.Macros);
+    if (!GLSLSource.empty())
+        m_ConversionCache.Store(CacheKey, GLSLSource);
+
+    return GLSLSource;
+}
+
 void HLSL2GLSLConverterImpl::CreateStream(const Char*                      InputFileName,
                                           IShaderSourceInputStreamFactory* pSourceStreamFactory,
                                           const Char*                      HLSLSource,
@@ -4676,12 +5127,23 @@ void HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
     }
 }
 
-String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
-                                                         SHADER_TYPE ShaderType,
-                                                         bool        IncludeDefintions,
-                                                         const char* SamplerSuffix,
-                                                         bool        UseInOutLocationQualifiers)
+String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char*        EntryPoint,
+                                                         SHADER_TYPE        ShaderType,
+                                                         bool               IncludeDefintions,
+                                                         const char*        SamplerSuffix,
+                                                         bool               UseInOutLocationQualifiers,
+                                                         const ShaderMacro* Macros)
 {
+    if (!m_bTokenized)
+    {
+        Tokenize(m_Source);
+        m_bTokenized = true;
+    }
+
+    // Release all objects of the previous conversion before recycling the arena memory
+    m_Objects.clear();
+    m_Arena.Reset();
+
     m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
     TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
 
@@ -4746,7 +5208,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
 
         // Find all samplers in the global scope
         Samplers.emplace_back();
-        m_Objects.emplace_back();
+        m_Objects.emplace_back(m_Arena);
         Token = m_Tokens.begin();
         ParseSamplers(Token, Samplers.back());
         VERIFY_EXPR(Token == m_Tokens.end());
@@ -4825,7 +5287,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                         //             Token
 
                         // Put empty table on top of the object stack
-                        m_Objects.emplace_back(ObjectsTypeHashType());
+                        m_Objects.emplace_back(m_Arena);
                     }
                     else
                     {
@@ -4917,7 +5379,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
     }
 
     if (IncludeDefintions)
-        GLSLSource.insert(0, g_GLSLDefinitions);
+        GLSLSource.insert(0, m_Converter.GetRequiredGLSLDefinitions(GLSLSource, Macros));
 
     return GLSLSource;
 }
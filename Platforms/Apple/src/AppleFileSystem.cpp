@@ -23,7 +23,10 @@
 
 #include <stdio.h>
 #include <unistd.h>
+#include <glob.h>
+#include <sys/stat.h>
 #include <cstdio>
+#include <cstring>
 #include <CoreFoundation/CoreFoundation.h>
 
 #include "CFObjectWrapper.hpp"
@@ -139,8 +142,43 @@ void AppleFileSystem::DeleteFile(const Diligent::Char* strPath)
     remove(strPath);
 }
 
+struct AppleFindFileData : public FindFileData
+{
+    virtual const Diligent::Char* Name() const override { return m_Name.c_str(); }
+
+    virtual bool IsDirectory() const override { return m_IsDirectory; }
+
+    AppleFindFileData(std::string _Name, bool _IsDirectory) :
+        m_Name{std::move(_Name)},
+        m_IsDirectory{_IsDirectory}
+    {}
+
+private:
+    const std::string m_Name;
+    const bool        m_IsDirectory;
+};
+
 std::vector<std::unique_ptr<FindFileData>> AppleFileSystem::Search(const Diligent::Char* SearchPattern)
 {
-    UNSUPPORTED("Not implemented");
-    return std::vector<std::unique_ptr<FindFileData>>();
+    std::vector<std::unique_ptr<FindFileData>> SearchRes;
+
+    // Files in the application bundle are not searched
+    glob_t GlobRes = {};
+    if (glob(SearchPattern, 0, nullptr, &GlobRes) == 0)
+    {
+        for (size_t i = 0; i < GlobRes.gl_pathc; ++i)
+        {
+            const char* Path = GlobRes.gl_pathv[i];
+
+            struct stat FileStat;
+            const bool  IsDirectory = stat(Path, &FileStat) == 0 && S_ISDIR(FileStat.st_mode);
+
+            // Similar to Windows, only file names are returned
+            const char* Slash = strrchr(Path, '/');
+            SearchRes.emplace_back(new AppleFindFileData(Slash != nullptr ? Slash + 1 : Path, IsDirectory));
+        }
+    }
+    globfree(&GlobRes);
+
+    return SearchRes;
 }
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "EngineFactoryVk.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+/// Creates a Vulkan device and an immediate context that are independent of the testing environment.
+
+/// Tests use a separate device to enable engine features (e.g. the SPIR-V cache or the bindless
+/// resource table) without affecting other tests. Validation is always enabled.
+/// The function is only available in DiligentCoreAPITest-VkInternal, which links the backend statically.
+void CreateTestDeviceVk(EngineVkCreateInfo             CreateInfo,
+                        RefCntAutoPtr<IRenderDevice>&  pDevice,
+                        RefCntAutoPtr<IDeviceContext>& pContext);
+
+/// Unique directory in the working directory that is removed along with all files in it
+/// when the object is destroyed. Subdirectories are not supported.
+class ScopedTempDirectory
+{
+public:
+    explicit ScopedTempDirectory(const char* Prefix);
+    ~ScopedTempDirectory();
+
+    // clang-format off
+    ScopedTempDirectory             (const ScopedTempDirectory&) = delete;
+    ScopedTempDirectory& operator = (const ScopedTempDirectory&) = delete;
+    // clang-format on
+
+    /// Returns the path of the directory. The path is empty if the directory could not be created.
+    const std::string& GetPath() const { return m_Path; }
+
+    /// Returns the path of the file with the given name in the directory.
+    std::string GetFilePath(const char* FileName) const;
+
+private:
+    std::string m_Path;
+};
+
+} // namespace Testing
+
+} // namespace Diligent
@@ -0,0 +1,200 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#if PLATFORM_LINUX || PLATFORM_MACOS
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "TestingEnvironment.hpp"
+#include "DataBlobImpl.hpp"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<ICachingShaderSourceStreamFactory> CreateCachingFactory(const char* SearchDirectories = "shaders/HLSL2GLSLConverter")
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<ICachingShaderSourceStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateCachingShaderSourceStreamFactory(SearchDirectories, &pShaderSourceFactory);
+    return pShaderSourceFactory;
+}
+
+void WriteFile(const char* Path, const char* Data)
+{
+    FileWrapper File{Path, EFileAccessMode::Overwrite};
+    ASSERT_TRUE(File != nullptr);
+    ASSERT_TRUE(File->Write(Data, strlen(Data)));
+}
+
+std::string ReadStream(IShaderSourceInputStreamFactory* pFactory, const char* Name)
+{
+    RefCntAutoPtr<IFileStream> pStream;
+    pFactory->CreateInputStream(Name, &pStream);
+    if (!pStream)
+        return "";
+
+    RefCntAutoPtr<IDataBlob> pData(MakeNewRCObj<DataBlobImpl>()(0));
+    pStream->ReadBlob(pData);
+    return std::string(reinterpret_cast<const char*>(pData->GetDataPtr()), pData->GetSize());
+}
+
+TEST(CachingShaderSourceStreamFactoryTest, CreateInputStream)
+{
+    auto pCachingFactory = CreateCachingFactory();
+    ASSERT_NE(pCachingFactory, nullptr);
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pDefaultFactory;
+    TestingEnvironment::GetInstance()->GetDevice()->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &pDefaultFactory);
+    ASSERT_NE(pDefaultFactory, nullptr);
+
+    const auto Source = ReadStream(pDefaultFactory, "IncludeTest.h");
+    EXPECT_FALSE(Source.empty());
+    // The second stream is served from the cache and must be independent from the first one
+    EXPECT_EQ(ReadStream(pCachingFactory, "IncludeTest.h"), Source);
+    EXPECT_EQ(ReadStream(pCachingFactory, "IncludeTest.h"), Source);
+}
+
+TEST(CachingShaderSourceStreamFactoryTest, ComputeDependencyHash)
+{
+    auto pFactory = CreateCachingFactory();
+    ASSERT_NE(pFactory, nullptr);
+
+    const auto Hash1D = pFactory->ComputeDependencyHash("CS_RWTex1D.hlsl");
+    EXPECT_NE(Hash1D, Uint64{0});
+    EXPECT_EQ(pFactory->ComputeDependencyHash("CS_RWTex1D.hlsl"), Hash1D);
+    EXPECT_NE(pFactory->ComputeDependencyHash("CS_RWTex2D_1.hlsl"), Hash1D);
+    EXPECT_NE(pFactory->ComputeDependencyHash("IncludeTest.h"), Hash1D);
+    EXPECT_EQ(pFactory->ComputeDependencyHash("NonExistingFile.h"), Uint64{0});
+
+    // The number of preloaded files depends on the platform support for directory
+    // search, but preloading must not change the hashes
+    auto pPreloadedFactory = CreateCachingFactory();
+    ASSERT_NE(pPreloadedFactory, nullptr);
+    pPreloadedFactory->PreloadDirectory(nullptr);
+    EXPECT_EQ(pPreloadedFactory->ComputeDependencyHash("CS_RWTex1D.hlsl"), Hash1D);
+    EXPECT_EQ(ReadStream(pPreloadedFactory, "IncludeTest.h"), ReadStream(pFactory, "IncludeTest.h"));
+}
+
+TEST(CachingShaderSourceStreamFactoryTest, FileModification)
+{
+    // The file is created in the working directory and removed by the test
+    constexpr char FileName[] = "CachingShaderSourceStreamFactoryTest.h";
+
+    auto pFactory = CreateCachingFactory(".");
+    ASSERT_NE(pFactory, nullptr);
+
+    WriteFile(FileName, "#define VALUE 1\n");
+    EXPECT_EQ(ReadStream(pFactory, FileName), "#define VALUE 1\n");
+    const auto Hash1 = pFactory->ComputeDependencyHash(FileName);
+    EXPECT_NE(Hash1, Uint64{0});
+
+    // The file is modified immediately without changing its size, which may not
+    // change the modification time on file systems with coarse timestamps
+    WriteFile(FileName, "#define VALUE 2\n");
+    EXPECT_EQ(ReadStream(pFactory, FileName), "#define VALUE 2\n");
+    const auto Hash2 = pFactory->ComputeDependencyHash(FileName);
+    EXPECT_NE(Hash2, Hash1);
+
+    FileSystem::DeleteFile(FileName);
+}
+
+#if PLATFORM_LINUX || PLATFORM_MACOS
+TEST(CachingShaderSourceStreamFactoryTest, PreloadDirectorySkipsSymlinks)
+{
+    // The directories are created in the working directory and removed by the test:
+    //   CachingShaderSourceStreamFactorySymlinkTest/Dir/File.h
+    //   CachingShaderSourceStreamFactorySymlinkTest/Dir/Parent -> ..   (makes the recursion infinite if followed)
+    //   CachingShaderSourceStreamFactorySymlinkTest/Link       -> Dir  (loads File.h twice if followed)
+    constexpr char RootDir[]   = "CachingShaderSourceStreamFactorySymlinkTest";
+    const auto     Dir         = std::string{RootDir} + "/Dir";
+    const auto     FilePath    = Dir + "/File.h";
+    const auto     ParentLink  = Dir + "/Parent";
+    const auto     SiblingLink = std::string{RootDir} + "/Link";
+
+    ASSERT_EQ(mkdir(RootDir, 0755), 0);
+    ASSERT_EQ(mkdir(Dir.c_str(), 0755), 0);
+    WriteFile(FilePath.c_str(), "#define VALUE 1\n");
+    EXPECT_EQ(symlink("..", ParentLink.c_str()), 0);
+    EXPECT_EQ(symlink("Dir", SiblingLink.c_str()), 0);
+
+    auto pFactory = CreateCachingFactory(RootDir);
+    ASSERT_NE(pFactory, nullptr);
+    EXPECT_EQ(pFactory->PreloadDirectory(nullptr), 1u);
+    EXPECT_EQ(ReadStream(pFactory, "Dir/File.h"), "#define VALUE 1\n");
+
+    unlink(SiblingLink.c_str());
+    unlink(ParentLink.c_str());
+    unlink(FilePath.c_str());
+    rmdir(Dir.c_str());
+    rmdir(RootDir);
+}
+#endif
+
+TEST(CachingShaderSourceStreamFactoryTest, CreateShader)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pFactory = CreateCachingFactory();
+    ASSERT_NE(pFactory, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.FilePath                   = "VS_PS.hlsl";
+    ShaderCI.pShaderSourceStreamFactory = pFactory;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.UseCombinedTextureSamplers = pDevice->GetDeviceCaps().IsGLDevice();
+
+    ShaderCI.Desc.Name       = "Caching factory test VS";
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+    ShaderCI.EntryPoint      = "TestVS";
+    RefCntAutoPtr<IShader> pVS;
+    pDevice->CreateShader(ShaderCI, &pVS);
+    EXPECT_NE(pVS, nullptr);
+
+    ShaderCI.Desc.Name       = "Caching factory test PS";
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    ShaderCI.EntryPoint      = "TestPS";
+    RefCntAutoPtr<IShader> pPS;
+    pDevice->CreateShader(ShaderCI, &pPS);
+    EXPECT_NE(pPS, nullptr);
+}
+
+} // namespace
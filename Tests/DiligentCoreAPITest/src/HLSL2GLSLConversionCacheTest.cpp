@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "TestingEnvironment.hpp"
+
+#ifdef HLSL2GLSL_CONVERTER_SUPPORTED
+#    include "HLSL2GLSLConverterImpl.hpp"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+#ifdef HLSL2GLSL_CONVERTER_SUPPORTED
+
+namespace
+{
+
+TEST(HLSL2GLSLConverterTest, ConversionCache)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+    auto&       Cache     = Converter.GetConversionCache();
+    Cache.Clear();
+
+    HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+    Attribs.pSourceStreamFactory = pShaderSourceFactory;
+    Attribs.InputFileName        = "VS_PS.hlsl";
+    Attribs.EntryPoint           = "TestVS";
+    Attribs.ShaderType           = SHADER_TYPE_VERTEX;
+
+    Attribs.UseCache         = false;
+    const auto RefGLSLSource = Converter.Convert(Attribs);
+    ASSERT_FALSE(RefGLSLSource.empty());
+
+    Attribs.UseCache = true;
+
+    auto Stats0 = Cache.GetStats();
+    EXPECT_EQ(Converter.Convert(Attribs), RefGLSLSource);
+    auto Stats1 = Cache.GetStats();
+    EXPECT_EQ(Stats1.Misses, Stats0.Misses + 1);
+
+    EXPECT_EQ(Converter.Convert(Attribs), RefGLSLSource);
+    auto Stats2 = Cache.GetStats();
+    EXPECT_EQ(Stats2.MemoryHits, Stats1.MemoryHits + 1);
+    EXPECT_EQ(Stats2.Misses, Stats1.Misses);
+
+    // A stream that is created for the cached source is not tokenized until
+    // a conversion is not found in the cache
+    IHLSL2GLSLConversionStream* pStream = nullptr;
+    Attribs.ppConversionStream          = &pStream;
+    EXPECT_EQ(Converter.Convert(Attribs), RefGLSLSource);
+    ASSERT_NE(pStream, nullptr);
+    auto Stats3 = Cache.GetStats();
+    EXPECT_EQ(Stats3.MemoryHits, Stats2.MemoryHits + 1);
+
+    // Different entry point must not be served from the cache
+    Attribs.EntryPoint = "TestPS";
+    Attribs.ShaderType = SHADER_TYPE_PIXEL;
+    EXPECT_NE(Converter.Convert(Attribs), RefGLSLSource);
+    auto Stats4 = Cache.GetStats();
+    EXPECT_EQ(Stats4.Misses, Stats3.Misses + 1);
+    pStream->Release();
+
+    Cache.Clear();
+}
+
+} // namespace
+
+#endif // HLSL2GLSL_CONVERTER_SUPPORTED
@@ -0,0 +1,256 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <thread>
+#include <atomic>
+
+#include "TestingEnvironment.hpp"
+#include "DataBlobImpl.hpp"
+#include "Timer.hpp"
+
+#ifdef HLSL2GLSL_CONVERTER_SUPPORTED
+#    include "HLSL2GLSLConverterImpl.hpp"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+#ifdef HLSL2GLSL_CONVERTER_SUPPORTED
+
+namespace
+{
+
+struct ConverterBenchmarkShader
+{
+    const char* FileName;
+    const char* EntryPoint;
+    SHADER_TYPE ShaderType;
+};
+
+// clang-format off
+static const ConverterBenchmarkShader g_BenchmarkShaders[] =
+{
+    {"VS_PS.hlsl",        "TestVS", SHADER_TYPE_VERTEX },
+    {"VS_PS.hlsl",        "TestPS", SHADER_TYPE_PIXEL  },
+    {"CS_RWBuff.hlsl",    "TestCS", SHADER_TYPE_COMPUTE},
+    {"CS_RWTex1D.hlsl",   "TestCS", SHADER_TYPE_COMPUTE},
+    {"CS_RWTex2D_1.hlsl", "TestCS", SHADER_TYPE_COMPUTE},
+    {"CS_RWTex2D_2.hlsl", "TestCS", SHADER_TYPE_COMPUTE}
+};
+// clang-format on
+
+#    ifdef _DEBUG
+static constexpr int NumBenchmarkIterations = 5;
+#    else
+static constexpr int NumBenchmarkIterations = 50;
+#    endif
+
+// Converts every shader from the HLSL2GLSLConverterTest corpus multiple times and reports
+// the average time per shader, both for the full conversion (tokenization included) and
+// for the conversion of the already tokenized source from a conversion stream.
+TEST(HLSL2GLSLConverterTest, Benchmark)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+
+    double TotalFullTime   = 0;
+    double TotalStreamTime = 0;
+    for (const auto& Shader : g_BenchmarkShaders)
+    {
+        // Load the source once to exclude file I/O from the measurements
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        pShaderSourceFactory->CreateInputStream(Shader.FileName, &pSourceStream);
+        ASSERT_NE(pSourceStream, nullptr) << Shader.FileName;
+        RefCntAutoPtr<IDataBlob> pSourceData(MakeNewRCObj<DataBlobImpl>()(0));
+        pSourceStream->ReadBlob(pSourceData);
+
+        HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+        Attribs.pSourceStreamFactory = pShaderSourceFactory;
+        Attribs.HLSLSource           = reinterpret_cast<const Char*>(pSourceData->GetDataPtr());
+        Attribs.NumSymbols           = pSourceData->GetSize();
+        Attribs.EntryPoint           = Shader.EntryPoint;
+        Attribs.ShaderType           = Shader.ShaderType;
+        Attribs.InputFileName        = Shader.FileName;
+        // Measure the conversion itself rather than the cache lookup
+        Attribs.UseCache = false;
+
+        String GLSLSource;
+
+        Timer FullTimer;
+        for (int i = 0; i < NumBenchmarkIterations; ++i)
+            GLSLSource = Converter.Convert(Attribs);
+        const auto FullTime = FullTimer.GetElapsedTime() / NumBenchmarkIterations;
+        EXPECT_FALSE(GLSLSource.empty()) << Shader.FileName << ": " << Shader.EntryPoint;
+
+        RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+        Attribs.ppConversionStream = pStream.GetRawDblPtr();
+        // Create the stream and tokenize the source
+        Converter.Convert(Attribs);
+        ASSERT_NE(pStream, nullptr);
+
+        String StreamGLSLSource;
+
+        Timer StreamTimer;
+        for (int i = 0; i < NumBenchmarkIterations; ++i)
+            StreamGLSLSource = Converter.Convert(Attribs);
+        const auto StreamTime = StreamTimer.GetElapsedTime() / NumBenchmarkIterations;
+
+        // Conversion from the preserved tokens must produce exactly the same source
+        EXPECT_EQ(GLSLSource, StreamGLSLSource) << Shader.FileName << ": " << Shader.EntryPoint;
+
+        LOG_INFO_MESSAGE(Shader.FileName, " (", Shader.EntryPoint, ", ", pSourceData->GetSize(), " bytes): ",
+                         FullTime * 1000.0, " ms, from stream: ", StreamTime * 1000.0, " ms");
+
+        TotalFullTime += FullTime;
+        TotalStreamTime += StreamTime;
+    }
+
+    // Timings depend on the machine and its load, so they are only reported and never checked
+    LOG_INFO_MESSAGE("HLSL->GLSL conversion of ", _countof(g_BenchmarkShaders), " shaders took ", TotalFullTime * 1000.0,
+                     " ms (", TotalStreamTime * 1000.0, " ms from conversion streams) on average over ", NumBenchmarkIterations,
+                     " iterations. Average time per shader: ", TotalFullTime * 1000.0 / _countof(g_BenchmarkShaders),
+                     " ms, stream/full ratio: ", TotalStreamTime / TotalFullTime);
+}
+
+#    ifdef _DEBUG
+static constexpr int NumStressIterations = 2;
+#    else
+static constexpr int NumStressIterations = 20;
+#    endif
+
+// Converts the corpus from multiple threads at once, every thread using its own conversion streams,
+// and reports the throughput relative to a single thread. The converter tables are immutable and every
+// stream keeps its transient data in its own arena, so the throughput should scale nearly linearly
+// with the number of hardware threads. Only the converted source is checked; the throughput is logged.
+TEST(HLSL2GLSLConverterTest, MultithreadedStress)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+
+    constexpr size_t NumShaders = _countof(g_BenchmarkShaders);
+
+    std::vector<RefCntAutoPtr<IDataBlob>>                 Sources(NumShaders);
+    std::vector<HLSL2GLSLConverterImpl::ConversionAttribs> Attribs(NumShaders);
+    std::vector<String>                                   References(NumShaders);
+    for (size_t i = 0; i < NumShaders; ++i)
+    {
+        const auto& Shader = g_BenchmarkShaders[i];
+
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        pShaderSourceFactory->CreateInputStream(Shader.FileName, &pSourceStream);
+        ASSERT_NE(pSourceStream, nullptr) << Shader.FileName;
+        Sources[i] = MakeNewRCObj<DataBlobImpl>()(0);
+        pSourceStream->ReadBlob(Sources[i]);
+
+        auto& ShaderAttribs                = Attribs[i];
+        ShaderAttribs.pSourceStreamFactory = pShaderSourceFactory;
+        ShaderAttribs.HLSLSource           = reinterpret_cast<const Char*>(Sources[i]->GetDataPtr());
+        ShaderAttribs.NumSymbols           = Sources[i]->GetSize();
+        ShaderAttribs.EntryPoint           = Shader.EntryPoint;
+        ShaderAttribs.ShaderType           = Shader.ShaderType;
+        ShaderAttribs.InputFileName        = Shader.FileName;
+        ShaderAttribs.UseCache             = false;
+
+        References[i] = Converter.Convert(ShaderAttribs);
+        ASSERT_FALSE(References[i].empty()) << Shader.FileName << ": " << Shader.EntryPoint;
+    }
+
+    const auto MaxThreads = std::max(std::min(std::thread::hardware_concurrency(), 8u), 1u);
+
+    double SingleThreadThroughput = 0;
+    for (Uint32 NumThreads = 1; NumThreads <= MaxThreads; NumThreads *= 2)
+    {
+        // Streams are created and tokenized up front so that only the conversion itself is measured
+        std::vector<std::vector<RefCntAutoPtr<IHLSL2GLSLConversionStream>>> Streams(NumThreads, std::vector<RefCntAutoPtr<IHLSL2GLSLConversionStream>>(NumShaders));
+        for (auto& ThreadStreams : Streams)
+        {
+            for (size_t i = 0; i < NumShaders; ++i)
+            {
+                auto ShaderAttribs               = Attribs[i];
+                ShaderAttribs.ppConversionStream = ThreadStreams[i].GetRawDblPtr();
+                Converter.Convert(ShaderAttribs);
+                ASSERT_NE(ThreadStreams[i], nullptr);
+            }
+        }
+
+        std::atomic<Uint32> NumMismatches{0};
+
+        std::vector<std::thread> Threads;
+        Threads.reserve(NumThreads);
+
+        Timer StressTimer;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back(
+                [&](std::vector<RefCntAutoPtr<IHLSL2GLSLConversionStream>>& ThreadStreams) //
+                {
+                    for (int iter = 0; iter < NumStressIterations; ++iter)
+                    {
+                        for (size_t i = 0; i < NumShaders; ++i)
+                        {
+                            auto ShaderAttribs               = Attribs[i];
+                            ShaderAttribs.ppConversionStream = ThreadStreams[i].GetRawDblPtr();
+                            if (Converter.Convert(ShaderAttribs) != References[i])
+                                ++NumMismatches;
+                        }
+                    }
+                },
+                std::ref(Streams[t]));
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+        const auto ElapsedTime = StressTimer.GetElapsedTime();
+
+        EXPECT_EQ(NumMismatches.load(), Uint32{0}) << NumThreads << " threads";
+
+        const auto Throughput = static_cast<double>(NumThreads * NumStressIterations * NumShaders) / ElapsedTime;
+        if (NumThreads == 1)
+            SingleThreadThroughput = Throughput;
+
+        LOG_INFO_MESSAGE("HLSL->GLSL conversion on ", NumThreads, (NumThreads == 1 ? " thread: " : " threads: "), Throughput,
+                         " shaders/s, scaling: ", Throughput / SingleThreadThroughput, "x");
+    }
+}
+
+} // namespace
+
+#endif // HLSL2GLSL_CONVERTER_SUPPORTED
@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#ifdef HLSL2GLSL_CONVERTER_SUPPORTED
+#    include "HLSL2GLSLConverterImpl.hpp"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+#ifdef HLSL2GLSL_CONVERTER_SUPPORTED
+
+namespace
+{
+
+// log10() is referenced directly by the shader, while FOG_DENSITY is only defined
+// by a macro that expands to _ToVec3(), which in turn references _ToFloat().
+static const char* g_DefinitionsTestPS = R"(
+float4 TestPS(in float4 f4Color : COLOR) : SV_Target
+{
+    float Lum = log10(f4Color.r + 1.0);
+    return float4(FOG_DENSITY * Lum, 1.0);
+}
+)";
+
+String ConvertDefinitionsTestShader(const ShaderMacro* Macros)
+{
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+
+    HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+    Attribs.HLSLSource         = g_DefinitionsTestPS;
+    Attribs.NumSymbols         = strlen(g_DefinitionsTestPS);
+    Attribs.EntryPoint         = "TestPS";
+    Attribs.ShaderType         = SHADER_TYPE_PIXEL;
+    Attribs.IncludeDefinitions = true;
+    Attribs.InputFileName      = "DefinitionsTestPS";
+    Attribs.Macros             = Macros;
+    Attribs.UseCache           = false;
+    return Converter.Convert(Attribs);
+}
+
+bool HasDefinition(const String& GLSLSource, const char* Definition)
+{
+    return GLSLSource.find(Definition) != String::npos;
+}
+
+TEST(HLSL2GLSLConverterTest, RequiredDefinitions)
+{
+    const ShaderMacro Macros[] = {{"FOG_DENSITY", "_ToVec3(0.5, 0.25, 0.125)"}, {nullptr, nullptr}};
+
+    const auto GLSLSource = ConvertDefinitionsTestShader(Macros);
+    ASSERT_FALSE(GLSLSource.empty());
+
+    // Declarations are always included
+    EXPECT_TRUE(HasDefinition(GLSLSource, "#define _GLSL_DEFINITIONS_"));
+    EXPECT_TRUE(HasDefinition(GLSLSource, "#define float4 vec4"));
+
+    // Helper referenced by the converted source
+    EXPECT_TRUE(HasDefinition(GLSLSource, "float log10( float x )"));
+    EXPECT_TRUE(HasDefinition(GLSLSource, "vec4 log10( vec4 x )"));
+
+    // Helper referenced by the macro and its transitive dependency
+    EXPECT_TRUE(HasDefinition(GLSLSource, "#define _ToVec3(x,y,z)"));
+    EXPECT_TRUE(HasDefinition(GLSLSource, "float _ToFloat( float x )"));
+
+    // Unreferenced helpers must be dropped, including the conditional blocks
+    // that contain nothing else
+    EXPECT_FALSE(HasDefinition(GLSLSource, "bool isfinite( float x )"));
+    EXPECT_FALSE(HasDefinition(GLSLSource, "float BoolToFloat( bool b )"));
+    EXPECT_FALSE(HasDefinition(GLSLSource, "#define _ToIvec3(x,y,z)"));
+    EXPECT_FALSE(HasDefinition(GLSLSource, "float f16tof32( uint u1 )"));
+    EXPECT_FALSE(HasDefinition(GLSLSource, "#define frexp _frexp"));
+
+    // Without the macro, neither the macro helper nor its dependency is required
+    const auto GLSLSourceNoMacros = ConvertDefinitionsTestShader(nullptr);
+    ASSERT_FALSE(GLSLSourceNoMacros.empty());
+    EXPECT_TRUE(HasDefinition(GLSLSourceNoMacros, "float log10( float x )"));
+    EXPECT_FALSE(HasDefinition(GLSLSourceNoMacros, "#define _ToVec3(x,y,z)"));
+    EXPECT_FALSE(HasDefinition(GLSLSourceNoMacros, "float _ToFloat( float x )"));
+    EXPECT_LT(GLSLSourceNoMacros.length(), GLSLSource.length());
+
+    // The emitted preprocessor conditionals must stay balanced
+    size_t NumIfs = 0, NumEndifs = 0;
+    for (size_t Pos = GLSLSource.find('#'); Pos != String::npos; Pos = GLSLSource.find('#', Pos + 1))
+    {
+        if (GLSLSource.compare(Pos, 3, "#if") == 0)
+            ++NumIfs;
+        else if (GLSLSource.compare(Pos, 6, "#endif") == 0)
+            ++NumEndifs;
+    }
+    EXPECT_EQ(NumIfs, NumEndifs);
+}
+
+} // namespace
+
+#endif // HLSL2GLSL_CONVERTER_SUPPORTED
@@ -0,0 +1,304 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ShaderPermutationManager.hpp"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// The include file is created in the working directory and removed by the tests
+constexpr char IncludeFileName[] = "ShaderPermutationManagerTest.fxh";
+
+constexpr char ShaderSource[] = R"(
+#include "ShaderPermutationManagerTest.fxh"
+
+#if !defined(USE_FOG) || !defined(LIGHT_MODEL)
+#    error Permutation keys are not defined
+#endif
+
+float4 main() : SV_Target
+{
+    return float4(float(USE_FOG), float(LIGHT_MODEL), INCLUDED_VALUE, 1.0);
+}
+)";
+
+void WriteIncludeFile(const char* Source)
+{
+    FileWrapper File{IncludeFileName, EFileAccessMode::Overwrite};
+    ASSERT_TRUE(File != nullptr);
+    ASSERT_TRUE(File->Write(Source, strlen(Source)));
+}
+
+class ShaderPermutationManagerTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        WriteIncludeFile("#define INCLUDED_VALUE 0.5\n");
+    }
+
+    static void TearDownTestSuite()
+    {
+        FileSystem::DeleteFile(IncludeFileName);
+    }
+
+    static ShaderPermutationManager::CreateInfo GetCreateInfo(IShaderSourceInputStreamFactory* pShaderSourceFactory)
+    {
+        ShaderPermutationManager::CreateInfo CI;
+        CI.pDevice                             = TestingEnvironment::GetInstance()->GetDevice();
+        CI.ShaderCI.Source                     = ShaderSource;
+        CI.ShaderCI.EntryPoint                 = "main";
+        CI.ShaderCI.Desc.ShaderType            = SHADER_TYPE_PIXEL;
+        CI.ShaderCI.Desc.Name                  = "Shader permutation manager test";
+        CI.ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        CI.ShaderCI.UseCombinedTextureSamplers = true;
+        CI.ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+        return CI;
+    }
+
+    static RefCntAutoPtr<IShaderSourceInputStreamFactory> CreateShaderSourceFactory()
+    {
+        RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+        TestingEnvironment::GetInstance()->GetDevice()->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(".", &pShaderSourceFactory);
+        return pShaderSourceFactory;
+    }
+};
+
+TEST_F(ShaderPermutationManagerTest, KeyBitPacking)
+{
+    auto pShaderSourceFactory = CreateShaderSourceFactory();
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    ShaderPermutationManager Manager{GetCreateInfo(pShaderSourceFactory)};
+
+    const Uint32 NumValues[] = {2, 3, 5, 2, 8};
+
+    const auto UseFog     = Manager.AddBoolKey("USE_FOG");
+    const auto LightModel = Manager.AddEnumKey("LIGHT_MODEL", NumValues[1]);
+    const auto Quality    = Manager.AddEnumKey("QUALITY", NumValues[2]);
+    const auto UseShadows = Manager.AddBoolKey("USE_SHADOWS");
+    const auto Material   = Manager.AddEnumKey("MATERIAL", NumValues[4]);
+    ASSERT_EQ(Manager.GetNumKeys(), 5u);
+    EXPECT_EQ(UseFog, 0u);
+    EXPECT_EQ(LightModel, 1u);
+    EXPECT_EQ(Quality, 2u);
+    EXPECT_EQ(UseShadows, 3u);
+    EXPECT_EQ(Material, 4u);
+
+    // Every combination of key values must produce a unique id that decodes to the same values
+    std::set<ShaderPermutationManager::PermutationId> Ids;
+    for (Uint32 f = 0; f < NumValues[0]; ++f)
+        for (Uint32 l = 0; l < NumValues[1]; ++l)
+            for (Uint32 q = 0; q < NumValues[2]; ++q)
+                for (Uint32 s = 0; s < NumValues[3]; ++s)
+                    for (Uint32 m = 0; m < NumValues[4]; ++m)
+                    {
+                        ShaderPermutationManager::PermutationId Id = 0;
+
+                        Id = Manager.SetKeyValue(Id, UseFog, f);
+                        Id = Manager.SetKeyValue(Id, LightModel, l);
+                        Id = Manager.SetKeyValue(Id, Quality, q);
+                        Id = Manager.SetKeyValue(Id, UseShadows, s);
+                        Id = Manager.SetKeyValue(Id, Material, m);
+
+                        EXPECT_EQ(Manager.GetKeyValue(Id, UseFog), f);
+                        EXPECT_EQ(Manager.GetKeyValue(Id, LightModel), l);
+                        EXPECT_EQ(Manager.GetKeyValue(Id, Quality), q);
+                        EXPECT_EQ(Manager.GetKeyValue(Id, UseShadows), s);
+                        EXPECT_EQ(Manager.GetKeyValue(Id, Material), m);
+
+                        // 1 + 2 + 3 + 1 + 3 bits
+                        EXPECT_LT(Id, ShaderPermutationManager::PermutationId{1} << 10);
+                        EXPECT_TRUE(Ids.insert(Id).second);
+                    }
+    EXPECT_EQ(Ids.size(), size_t{2 * 3 * 5 * 2 * 8});
+
+    // Replacing the value of one key must not affect other keys
+    auto Id = Manager.SetKeyValue(0, Quality, 4);
+    Id      = Manager.SetKeyValue(Id, Material, 7);
+    Id      = Manager.SetKeyValue(Id, Quality, 1);
+    EXPECT_EQ(Manager.GetKeyValue(Id, Quality), 1u);
+    EXPECT_EQ(Manager.GetKeyValue(Id, Material), 7u);
+    EXPECT_EQ(Manager.GetKeyValue(Id, UseFog), 0u);
+    EXPECT_EQ(Manager.GetKeyValue(Id, LightModel), 0u);
+    EXPECT_EQ(Manager.GetKeyValue(Id, UseShadows), 0u);
+}
+
+TEST_F(ShaderPermutationManagerTest, PermutationHash)
+{
+    auto pShaderSourceFactory = CreateShaderSourceFactory();
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    const auto CI = GetCreateInfo(pShaderSourceFactory);
+
+    ShaderPermutationManager Manager0{CI};
+    const auto               UseFog0     = Manager0.AddBoolKey("USE_FOG");
+    const auto               LightModel0 = Manager0.AddEnumKey("LIGHT_MODEL", 3);
+
+    // Keys are declared in a different order
+    ShaderPermutationManager Manager1{CI};
+    const auto               LightModel1 = Manager1.AddEnumKey("LIGHT_MODEL", 3);
+    const auto               UseFog1     = Manager1.AddBoolKey("USE_FOG");
+
+    std::set<ShaderPermutationManager::PermutationHash> Hashes;
+    for (Uint32 f = 0; f < 2; ++f)
+    {
+        for (Uint32 l = 0; l < 3; ++l)
+        {
+            const auto Id0 = Manager0.SetKeyValue(Manager0.SetKeyValue(0, UseFog0, f), LightModel0, l);
+            const auto Id1 = Manager1.SetKeyValue(Manager1.SetKeyValue(0, UseFog1, f), LightModel1, l);
+
+            const auto Hash = Manager0.GetPermutationHash(Id0);
+            EXPECT_EQ(Hash, Manager0.GetPermutationHash(Id0));
+            EXPECT_EQ(Hash, Manager1.GetPermutationHash(Id1));
+            EXPECT_TRUE(Hashes.insert(Hash).second);
+        }
+    }
+
+    // Common macros are part of the hash
+    const ShaderMacro Macros[] = {{"EXTRA_MACRO", "1"}, {}};
+
+    auto CI2            = CI;
+    CI2.ShaderCI.Macros = Macros;
+    ShaderPermutationManager Manager2{CI2};
+    Manager2.AddBoolKey("USE_FOG");
+    Manager2.AddEnumKey("LIGHT_MODEL", 3);
+    for (Uint32 Id = 0; Id < 8; ++Id)
+    {
+        if (Manager2.GetKeyValue(Id, 1) < 3)
+            EXPECT_EQ(Hashes.count(Manager2.GetPermutationHash(Id)), size_t{0});
+    }
+}
+
+TEST_F(ShaderPermutationManagerTest, RetryFailedPermutation)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    auto pShaderSourceFactory = CreateShaderSourceFactory();
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    ShaderPermutationManager Manager{GetCreateInfo(pShaderSourceFactory)};
+    Manager.AddBoolKey("USE_FOG");
+    Manager.AddEnumKey("LIGHT_MODEL", 3);
+
+    const ShaderPermutationManager::PermutationId Id = 1;
+
+    // Included files are read every time the permutation is compiled
+    WriteIncludeFile("#define INCLUDED_VALUE\n");
+
+    // The number of errors reported by the compiler depends on the backend
+    pEnv->SetErrorAllowance(10, "\n\nNo worries, testing broken shader permutation...\n\n");
+    auto pShader = Manager.GetPermutation(Id);
+    pEnv->SetErrorAllowance(0);
+    EXPECT_EQ(pShader, nullptr);
+    EXPECT_TRUE(Manager.IsPermutationReady(Id));
+
+    WriteIncludeFile("#define INCLUDED_VALUE 0.5\n");
+
+    pShader = Manager.GetPermutation(Id);
+    EXPECT_NE(pShader, nullptr);
+    EXPECT_EQ(Manager.GetPermutation(Id), pShader);
+}
+
+TEST_F(ShaderPermutationManagerTest, ConcurrentRequests)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+    if (pDevice->GetDeviceCaps().IsGLDevice())
+        GTEST_SKIP() << "OpenGL shaders can't be created on worker threads";
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    auto pShaderSourceFactory = CreateShaderSourceFactory();
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    ThreadPool Pool{4};
+
+    auto CI        = GetCreateInfo(pShaderSourceFactory);
+    CI.pThreadPool = &Pool;
+
+    ShaderPermutationManager Manager{CI};
+    const auto               UseFog     = Manager.AddBoolKey("USE_FOG");
+    const auto               LightModel = Manager.AddEnumKey("LIGHT_MODEL", 3);
+
+    std::vector<ShaderPermutationManager::PermutationId> Ids;
+    for (Uint32 f = 0; f < 2; ++f)
+    {
+        for (Uint32 l = 0; l < 3; ++l)
+            Ids.push_back(Manager.SetKeyValue(Manager.SetKeyValue(0, UseFog, f), LightModel, l));
+    }
+
+    constexpr size_t NumThreads = 8;
+
+    // Every thread requests and then gets all permutations, odd threads in reverse order
+    std::vector<std::vector<RefCntAutoPtr<IShader>>> Shaders(NumThreads);
+    std::vector<std::thread>                         Threads;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&, t]() //
+            {
+                auto& ThreadShaders = Shaders[t];
+                ThreadShaders.resize(Ids.size());
+                for (size_t i = 0; i < Ids.size(); ++i)
+                {
+                    const auto Idx = (t & 0x01) ? Ids.size() - 1 - i : i;
+                    if (t % 4 < 2)
+                        Manager.RequestPermutation(Ids[Idx]);
+                    ThreadShaders[Idx] = Manager.GetPermutation(Ids[Idx]);
+                }
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    for (size_t i = 0; i < Ids.size(); ++i)
+    {
+        EXPECT_TRUE(Manager.IsPermutationReady(Ids[i]));
+        ASSERT_NE(Shaders[0][i], nullptr);
+        // Every permutation must be compiled exactly once
+        for (size_t t = 1; t < NumThreads; ++t)
+            EXPECT_EQ(Shaders[t][i], Shaders[0][i]);
+    }
+}
+
+} // namespace
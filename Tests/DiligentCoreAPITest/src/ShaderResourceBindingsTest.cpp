@@ -0,0 +1,227 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "BasicMath.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+const std::string BulkSRBTestCS{R"(
+cbuffer StaticConstants
+{
+    float4 g_Scale;
+}
+
+cbuffer MutableConstants
+{
+    float4 g_Value;
+}
+
+RWStructuredBuffer<float4> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = g_Value * g_Scale;
+}
+)"};
+
+RefCntAutoPtr<IBuffer> CreateConstantBuffer(IRenderDevice* pDevice, const float4& Value)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = "Bulk SRB test constants";
+    BuffDesc.Usage         = USAGE_DEFAULT;
+    BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+    BuffDesc.uiSizeInBytes = sizeof(Value);
+
+    BufferData InitData;
+    InitData.pData    = &Value;
+    InitData.DataSize = sizeof(Value);
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+    return pBuffer;
+}
+
+float4 ReadOutput(IRenderDevice* pDevice, IDeviceContext* pContext, IBuffer* pOutput)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Bulk SRB test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.uiSizeInBytes  = sizeof(float4);
+    BuffDesc.BindFlags      = BIND_NONE;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    if (!pStagingBuffer)
+    {
+        ADD_FAILURE() << "Failed to create staging buffer";
+        return float4{};
+    }
+
+    pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, BuffDesc.uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    float4 Result;
+    void*  pData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    if (pData != nullptr)
+    {
+        memcpy(&Result, pData, sizeof(Result));
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    }
+    else
+    {
+        ADD_FAILURE() << "Failed to map staging buffer";
+    }
+    return Result;
+}
+
+TEST(ShaderResourceBindingsTest, CreateMultiple)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+    if (!pDevice->GetDeviceCaps().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Desc.Name                  = "Bulk SRB test";
+    ShaderCI.Source                     = BulkSRBTestCS.c_str();
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    // clang-format off
+    ShaderResourceVariableDesc Vars[] =
+    {
+        {SHADER_TYPE_COMPUTE, "MutableConstants", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_COMPUTE, "g_Output",         SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}
+    };
+    // clang-format on
+
+    PipelineStateDesc PSODesc;
+    PSODesc.Name                               = "Bulk SRB test";
+    PSODesc.IsComputePipeline                  = true;
+    PSODesc.ComputePipeline.pCS                = pCS;
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+    PSODesc.ResourceLayout.Variables           = Vars;
+    PSODesc.ResourceLayout.NumVariables        = _countof(Vars);
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreatePipelineState(PSODesc, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    const float4 Scale{1, 2, 3, 4};
+
+    auto pScaleCB = CreateConstantBuffer(pDevice, Scale);
+    ASSERT_NE(pScaleCB, nullptr);
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "StaticConstants")->Set(pScaleCB);
+
+    constexpr Uint32 NumSRBs = 8;
+
+    std::vector<IShaderResourceBinding*> RawSRBs(NumSRBs);
+    pPSO->CreateShaderResourceBindings(NumSRBs, RawSRBs.data(), true);
+
+    std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs(NumSRBs);
+    for (Uint32 i = 0; i < NumSRBs; ++i)
+    {
+        // The method returns new references the same way CreateShaderResourceBinding() does
+        SRBs[i].Attach(RawSRBs[i]);
+        ASSERT_NE(SRBs[i], nullptr) << "SRB " << i;
+        for (Uint32 j = 0; j < i; ++j)
+            EXPECT_NE(SRBs[i], SRBs[j]) << "SRBs " << j << " and " << i << " are the same object";
+
+        EXPECT_EQ(SRBs[i]->GetPipelineState(), pPSO);
+        EXPECT_EQ(SRBs[i]->GetVariableCount(SHADER_TYPE_COMPUTE), 2u);
+        EXPECT_NE(SRBs[i]->GetVariableByName(SHADER_TYPE_COMPUTE, "MutableConstants"), nullptr);
+        EXPECT_NE(SRBs[i]->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output"), nullptr);
+        // Static variables are accessed through the pipeline state
+        EXPECT_EQ(SRBs[i]->GetVariableByName(SHADER_TYPE_COMPUTE, "StaticConstants"), nullptr);
+    }
+
+    // Bind different resources to every SRB and check that each one references its own resource cache
+    std::vector<RefCntAutoPtr<IBuffer>> ValueCBs(NumSRBs);
+    std::vector<RefCntAutoPtr<IBuffer>> Outputs(NumSRBs);
+    for (Uint32 i = 0; i < NumSRBs; ++i)
+    {
+        const auto Value = static_cast<float>(i + 1);
+
+        ValueCBs[i] = CreateConstantBuffer(pDevice, float4{Value, Value, Value, Value});
+        ASSERT_NE(ValueCBs[i], nullptr);
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Bulk SRB test output";
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(float4);
+        BuffDesc.uiSizeInBytes     = sizeof(float4);
+        pDevice->CreateBuffer(BuffDesc, nullptr, &Outputs[i]);
+        ASSERT_NE(Outputs[i], nullptr);
+
+        SRBs[i]->GetVariableByName(SHADER_TYPE_COMPUTE, "MutableConstants")->Set(ValueCBs[i]);
+        SRBs[i]->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(Outputs[i]->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    }
+
+    for (Uint32 i = 0; i < NumSRBs; ++i)
+    {
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(SRBs[i], RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        DispatchComputeAttribs DispatchAttribs{1, 1, 1};
+        pContext->DispatchCompute(DispatchAttribs);
+    }
+
+    for (Uint32 i = 0; i < NumSRBs; ++i)
+    {
+        const auto Value    = static_cast<float>(i + 1);
+        const auto Expected = float4{Value, Value, Value, Value} * Scale;
+        const auto Result   = ReadOutput(pDevice, pContext, Outputs[i]);
+        EXPECT_EQ(Result, Expected) << "SRB " << i;
+    }
+}
+
+} // namespace
@@ -866,6 +866,8 @@ TEST(ShaderResourceLayout, VariableAccess)
 
         auto UniformBuff_Stat = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "UniformBuff_Stat");
         EXPECT_EQ(UniformBuff_Stat, nullptr);
+        EXPECT_EQ(pSRB->GetVariableByHash(SHADER_TYPE_PIXEL, ComputeShaderVariableNameHash("UniformBuff_Stat")), nullptr);
+        EXPECT_EQ(pSRB->GetVariableByHash(SHADER_TYPE_PIXEL, ComputeShaderVariableNameHash("g_NonExistingVar")), nullptr);
     }
 
 
@@ -881,6 +883,8 @@ TEST(ShaderResourceLayout, VariableAccess)
             pVar->GetResourceDesc(ResDesc);
             auto pVar2 = pSRB->GetVariableByName(SHADER_TYPE_VERTEX, ResDesc.Name);
             EXPECT_EQ(pVar, pVar2);
+            auto pVar3 = pSRB->GetVariableByHash(SHADER_TYPE_VERTEX, ComputeShaderVariableNameHash(ResDesc.Name));
+            EXPECT_EQ(pVar, pVar3);
         }
     }
 
@@ -895,6 +899,8 @@ TEST(ShaderResourceLayout, VariableAccess)
             pVar->GetResourceDesc(ResDesc);
             auto pVar2 = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, ResDesc.Name);
             EXPECT_EQ(pVar, pVar2);
+            auto pVar3 = pSRB->GetVariableByHash(SHADER_TYPE_PIXEL, ComputeShaderVariableNameHash(ResDesc.Name));
+            EXPECT_EQ(pVar, pVar3);
         }
     }
 
@@ -926,6 +932,99 @@ TEST(ShaderResourceLayout, VariableAccess)
 
     pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     pContext->Draw(DrawAttrs);
+
+    // Bind the same resources to a new SRB with a single SetVariables() call
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB2;
+        pTestPSO->CreateShaderResourceBinding(&pSRB2, true);
+        ASSERT_NE(pSRB2, nullptr);
+
+        std::vector<ResourceBindDesc> Bindings;
+
+        auto AddBinding = [&](SHADER_TYPE ShaderType, const char* VarName, IDeviceObject* pObject, Uint32 ArrayIndex) //
+        {
+            auto* pVar = pSRB2->GetVariableByName(ShaderType, VarName);
+            ASSERT_NE(pVar, nullptr) << VarName;
+            EXPECT_FALSE(pVar->IsBound(ArrayIndex)) << VarName << '[' << ArrayIndex << ']';
+            // Identify every other variable by the name hash rather than by the index
+            if (Bindings.size() % 2 == 0)
+            {
+                Bindings.emplace_back(ShaderType, pVar->GetIndex(), pObject, ArrayIndex);
+            }
+            else
+            {
+                ResourceBindDesc Binding;
+                Binding.ShaderType = ShaderType;
+                Binding.NameHash   = ComputeShaderVariableNameHash(VarName);
+                Binding.pObject    = pObject;
+                Binding.ArrayIndex = ArrayIndex;
+                Bindings.push_back(Binding);
+            }
+        };
+
+        // Consecutive elements of the array variables are added one after another,
+        // so that the Vulkan backend merges them into a single descriptor write.
+        AddBinding(SHADER_TYPE_VERTEX, "g_tex2D_Mut", pSRVs[0], 0);
+        AddBinding(SHADER_TYPE_VERTEX, "g_tex2D_MutArr", pSRVs[0], 0);
+        AddBinding(SHADER_TYPE_VERTEX, "g_tex2D_MutArr", pSRVs[1], 1);
+        AddBinding(SHADER_TYPE_VERTEX, "g_tex2D_Dyn", pSRVs[0], 0);
+        AddBinding(SHADER_TYPE_VERTEX, "g_tex2D_DynArr", pSRVs[0], 0);
+        AddBinding(SHADER_TYPE_VERTEX, "g_tex2D_DynArr", pSRVs[1], 1);
+        AddBinding(SHADER_TYPE_VERTEX, "UniformBuff_Mut", pUBs[0], 0);
+        AddBinding(SHADER_TYPE_VERTEX, "UniformBuff_Dyn", pUBs[0], 0);
+        AddBinding(SHADER_TYPE_VERTEX, "g_Buffer_Mut", pFormattedBuffSRV, 0);
+        AddBinding(SHADER_TYPE_VERTEX, "g_Buffer_MutArr", pFormattedBuffSRV, 0);
+        AddBinding(SHADER_TYPE_VERTEX, "g_Buffer_MutArr", pFormattedBuffSRV, 1);
+        AddBinding(SHADER_TYPE_VERTEX, "g_Buffer_Dyn", pFormattedBuffSRV, 0);
+        AddBinding(SHADER_TYPE_VERTEX, "g_Buffer_DynArr", pFormattedBuffSRV, 0);
+        AddBinding(SHADER_TYPE_VERTEX, "g_Buffer_DynArr", pFormattedBuffSRV, 1);
+
+        AddBinding(SHADER_TYPE_PIXEL, "g_tex2D_Mut", pRWTexSRVs[4], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_tex2D_MutArr", pRWTexSRVs[5], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_tex2D_MutArr", pRWTexSRVs[6], 1);
+        AddBinding(SHADER_TYPE_PIXEL, "g_tex2D_Dyn", pRWTexSRVs[3], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_tex2D_DynArr", pSRVs[0], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_tex2D_DynArr", pSRVs[1], 1);
+        AddBinding(SHADER_TYPE_PIXEL, "UniformBuff_Mut", pUBs[0], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "UniformBuff_Dyn", pUBs[0], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_Buffer_Mut", spRawBuffSRVs[1], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_Buffer_MutArr", pFormattedBuffSRV, 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_Buffer_MutArr", pFormattedBuffSRV, 1);
+        AddBinding(SHADER_TYPE_PIXEL, "g_Buffer_Dyn", pFormattedBuffSRVs[2], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_Buffer_DynArr", pFormattedBuffSRV, 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_Buffer_DynArr", pFormattedBuffSRV, 1);
+        AddBinding(SHADER_TYPE_PIXEL, "g_rwtex2D_Mut", pTexUAVs[2], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_rwtex2D_Dyn", pTexUAVs[7], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_rwBuff_Mut", pFormattedBuffUAV[1], 0);
+        AddBinding(SHADER_TYPE_PIXEL, "g_rwBuff_Dyn", pFormattedBuffUAV[3], 0);
+
+        pSRB2->SetVariables(Bindings.data(), static_cast<Uint32>(Bindings.size()));
+
+        for (const auto& Binding : Bindings)
+        {
+            auto* pVar = Binding.VariableIndex != INVALID_SHADER_VARIABLE_INDEX ?
+                pSRB2->GetVariableByIndex(Binding.ShaderType, Binding.VariableIndex) :
+                pSRB2->GetVariableByHash(Binding.ShaderType, Binding.NameHash);
+            ASSERT_NE(pVar, nullptr);
+            EXPECT_TRUE(pVar->IsBound(Binding.ArrayIndex));
+        }
+
+        // Every mutable and dynamic variable must now be bound
+        for (auto ShaderType : {SHADER_TYPE_VERTEX, SHADER_TYPE_PIXEL})
+        {
+            for (Uint32 v = 0; v < pSRB2->GetVariableCount(ShaderType); ++v)
+            {
+                auto* pVar = pSRB2->GetVariableByIndex(ShaderType, v);
+                ShaderResourceDesc ResDesc;
+                pVar->GetResourceDesc(ResDesc);
+                for (Uint32 elem = 0; elem < ResDesc.ArraySize; ++elem)
+                    EXPECT_TRUE(pVar->IsBound(elem)) << ResDesc.Name << '[' << elem << ']';
+            }
+        }
+
+        pContext->CommitShaderResources(pSRB2, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->Draw(DrawAttrs);
+    }
 }
 
 } // namespace
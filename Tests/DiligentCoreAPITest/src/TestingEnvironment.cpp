@@ -417,6 +417,7 @@ RefCntAutoPtr<IShader> TestingEnvironment::CreateShader(const ShaderCreateInfo&
         Attribs.IncludeDefinitions   = true;
         Attribs.InputFileName        = ShaderCI.FilePath;
         Attribs.SamplerSuffix        = ShaderCI.CombinedSamplerSuffix;
+        Attribs.Macros               = ShaderCI.Macros;
         // Separate shader objects extension is required to allow input/output layout qualifiers
         Attribs.UseInOutLocationQualifiers = true;
         auto ConvertedSource               = Converter.Convert(Attribs);
@@ -0,0 +1,374 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <cstring>
+#include <future>
+
+#include "vulkan/vulkan.h"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "PipelineStateVkImpl.hpp"
+#include "TestingEnvironment.hpp"
+#include "Vulkan/InternalTestUtilsVk.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class AsyncPipelineStateTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        if (TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().DevType != RENDER_DEVICE_TYPE_VULKAN)
+            return;
+
+        // A single worker thread lets the tests keep pipelines in the compiling state
+        // by blocking the thread until the state has been checked.
+        EngineVkCreateInfo EngineCI;
+        EngineCI.NumWorkerThreads = 1;
+        CreateTestDeviceVk(EngineCI, pDevice, pContext);
+    }
+
+    static void TearDownTestSuite()
+    {
+        pContext.Release();
+        pDevice.Release();
+    }
+
+    void SetUp() override
+    {
+        if (!pDevice)
+            GTEST_SKIP() << "Asynchronous pipeline creation is only implemented in Vulkan backend";
+    }
+
+    static ThreadPool& GetWorkerThreadPool()
+    {
+        return pDevice.RawPtr<RenderDeviceVkImpl>()->GetWorkerThreadPool();
+    }
+
+    static RefCntAutoPtr<IRenderDevice>  pDevice;
+    static RefCntAutoPtr<IDeviceContext> pContext;
+};
+
+RefCntAutoPtr<IRenderDevice>  AsyncPipelineStateTest::pDevice;
+RefCntAutoPtr<IDeviceContext> AsyncPipelineStateTest::pContext;
+
+// Occupies the worker thread until released, so that pipelines enqueued
+// in the meantime stay in the compiling state.
+class WorkerThreadBlocker
+{
+public:
+    explicit WorkerThreadBlocker(ThreadPool& Pool)
+    {
+        auto ReleaseFuture = m_Release.get_future().share();
+        Pool.EnqueueTask([ReleaseFuture]() { ReleaseFuture.wait(); });
+    }
+
+    ~WorkerThreadBlocker()
+    {
+        Release();
+    }
+
+    void Release()
+    {
+        if (!m_IsReleased)
+        {
+            m_Release.set_value();
+            m_IsReleased = true;
+        }
+    }
+
+private:
+    std::promise<void> m_Release;
+    bool               m_IsReleased = false;
+};
+
+// Both shaders write a different value and use the same resource layout, so either
+// pipeline can be the fallback for the other one.
+constexpr char WriteOneCS[] = R"(
+RWStructuredBuffer<float4> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = float4(1.0, 0.0, 0.0, 0.0);
+}
+)";
+
+constexpr char WriteTwoCS[] = R"(
+RWStructuredBuffer<float4> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = float4(2.0, 0.0, 0.0, 0.0);
+}
+)";
+
+RefCntAutoPtr<IPipelineState> CreateComputePSO(IRenderDevice* pDevice, const char* Name, const char* Source, bool CreateAsync, IPipelineState* pFallbackPSO = nullptr)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Desc.Name       = Name;
+    ShaderCI.Source          = Source;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        return {};
+
+    PipelineStateDesc PSODesc;
+    PSODesc.Name                               = Name;
+    PSODesc.IsComputePipeline                  = true;
+    PSODesc.ComputePipeline.pCS                = pCS;
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    if (CreateAsync)
+        pDevice->CreatePipelineStateAsync(PSODesc, pFallbackPSO, &pPSO);
+    else
+        pDevice->CreatePipelineState(PSODesc, &pPSO);
+    return pPSO;
+}
+
+// Dispatches the pipeline and returns the first component written to the output buffer,
+// or zero if the dispatch command has been skipped.
+float DispatchAndReadOutput(IRenderDevice* pDevice, IDeviceContext* pContext, IPipelineState* pPSO)
+{
+    const float Zeros[4] = {};
+
+    RefCntAutoPtr<IBuffer> pOutput;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Async pipeline state test - output";
+        BuffDesc.uiSizeInBytes     = sizeof(Zeros);
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(Zeros);
+        BufferData InitData{Zeros, sizeof(Zeros)};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &pOutput);
+    }
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Async pipeline state test - staging buffer";
+        BuffDesc.uiSizeInBytes  = sizeof(Zeros);
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    }
+    if (!pOutput || !pStagingBuffer)
+    {
+        ADD_FAILURE() << "Failed to create buffers";
+        return 0;
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+    pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, sizeof(Zeros), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    float Result[4] = {};
+    void* pData     = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    if (pData != nullptr)
+    {
+        memcpy(Result, pData, sizeof(Result));
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    }
+    return Result[0];
+}
+
+TEST_F(AsyncPipelineStateTest, CompilingToReady)
+{
+    WorkerThreadBlocker Blocker{GetWorkerThreadPool()};
+
+    auto pPSO = CreateComputePSO(pDevice, "Async pipeline state test - compiling to ready", WriteTwoCS, true);
+    ASSERT_NE(pPSO, nullptr);
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_COMPILING);
+    EXPECT_TRUE(pPSO.RawPtr<PipelineStateVkImpl>()->GetVkPipeline() == VK_NULL_HANDLE);
+
+    Blocker.Release();
+    GetWorkerThreadPool().WaitForAllTasks();
+
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+    EXPECT_TRUE(pPSO.RawPtr<PipelineStateVkImpl>()->GetVkPipeline() != VK_NULL_HANDLE);
+    EXPECT_EQ(DispatchAndReadOutput(pDevice, pContext, pPSO), 2.f);
+}
+
+TEST_F(AsyncPipelineStateTest, FallbackWhileCompiling)
+{
+    auto pFallbackPSO = CreateComputePSO(pDevice, "Async pipeline state test - fallback", WriteOneCS, false);
+    ASSERT_NE(pFallbackPSO, nullptr);
+
+    WorkerThreadBlocker Blocker{GetWorkerThreadPool()};
+
+    auto pPSO = CreateComputePSO(pDevice, "Async pipeline state test - with fallback", WriteTwoCS, true, pFallbackPSO);
+    ASSERT_NE(pPSO, nullptr);
+    EXPECT_EQ(pPSO.RawPtr<PipelineStateVkImpl>()->GetFallbackPSO(), pFallbackPSO.RawPtr<PipelineStateVkImpl>());
+    EXPECT_EQ(DispatchAndReadOutput(pDevice, pContext, pPSO), 1.f) << "The fallback pipeline must be used while the pipeline is compiling";
+
+    Blocker.Release();
+    GetWorkerThreadPool().WaitForAllTasks();
+
+    ASSERT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+    EXPECT_EQ(DispatchAndReadOutput(pDevice, pContext, pPSO), 2.f);
+}
+
+TEST_F(AsyncPipelineStateTest, SkipWithoutFallback)
+{
+    WorkerThreadBlocker Blocker{GetWorkerThreadPool()};
+
+    auto pPSO = CreateComputePSO(pDevice, "Async pipeline state test - no fallback", WriteTwoCS, true);
+    ASSERT_NE(pPSO, nullptr);
+    EXPECT_EQ(DispatchAndReadOutput(pDevice, pContext, pPSO), 0.f) << "The dispatch command must be skipped while the pipeline is compiling";
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_COMPILING);
+}
+
+TEST_F(AsyncPipelineStateTest, Failed)
+{
+    auto pFallbackPSO = CreateComputePSO(pDevice, "Async pipeline state test - fallback", WriteOneCS, false);
+    ASSERT_NE(pFallbackPSO, nullptr);
+
+    WorkerThreadBlocker Blocker{GetWorkerThreadPool()};
+
+    auto pPSO = CreateComputePSO(pDevice, "Async pipeline state test - failed", WriteTwoCS, true, pFallbackPSO);
+    ASSERT_NE(pPSO, nullptr);
+    pPSO.RawPtr<PipelineStateVkImpl>()->SimulateAsyncCreationFailure();
+
+    auto* pEnv = TestingEnvironment::GetInstance();
+    pEnv->SetErrorAllowance(2, "\n\nNo worries, testing failed pipeline creation...\n\n");
+    Blocker.Release();
+    GetWorkerThreadPool().WaitForAllTasks();
+    pEnv->SetErrorAllowance(0);
+
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_FAILED);
+    EXPECT_TRUE(pPSO.RawPtr<PipelineStateVkImpl>()->GetVkPipeline() == VK_NULL_HANDLE);
+    // The fallback pipeline is only used while the pipeline is compiling
+    EXPECT_EQ(DispatchAndReadOutput(pDevice, pContext, pPSO), 0.f);
+}
+
+// Releasing the last reference to a pipeline state that is still compiling must not block
+TEST_F(AsyncPipelineStateTest, ReleaseWhileCompiling)
+{
+    WorkerThreadBlocker Blocker{GetWorkerThreadPool()};
+
+    auto pPSO = CreateComputePSO(pDevice, "Async pipeline state test - release while compiling", WriteTwoCS, true);
+    ASSERT_NE(pPSO, nullptr);
+    pPSO.Release();
+
+    Blocker.Release();
+    GetWorkerThreadPool().WaitForAllTasks();
+}
+
+constexpr char VSSource[] = R"(
+float4 main(float4 Pos : ATTRIB0) : SV_Position
+{
+    return Pos;
+}
+)";
+
+constexpr char PSSource[] = R"(
+float4 main() : SV_Target
+{
+    return float4(1.0, 0.0, 0.0, 1.0);
+}
+)";
+
+TEST_F(AsyncPipelineStateTest, FallbackCompatibility)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.EntryPoint     = "main";
+
+    RefCntAutoPtr<IShader> pVS;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+    ShaderCI.Desc.Name       = "Async pipeline state test - VS";
+    ShaderCI.Source          = VSSource;
+    pDevice->CreateShader(ShaderCI, &pVS);
+    ASSERT_NE(pVS, nullptr);
+
+    RefCntAutoPtr<IShader> pPS;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    ShaderCI.Desc.Name       = "Async pipeline state test - PS";
+    ShaderCI.Source          = PSSource;
+    pDevice->CreateShader(ShaderCI, &pPS);
+    ASSERT_NE(pPS, nullptr);
+
+    LayoutElement Elems[] = {LayoutElement{0, 0, 4, VT_FLOAT32}};
+
+    PipelineStateDesc PSODesc;
+    PSODesc.Name                                        = "Async pipeline state test - graphics";
+    PSODesc.GraphicsPipeline.pVS                        = pVS;
+    PSODesc.GraphicsPipeline.pPS                        = pPS;
+    PSODesc.GraphicsPipeline.NumRenderTargets           = 1;
+    PSODesc.GraphicsPipeline.RTVFormats[0]              = TEX_FORMAT_RGBA8_UNORM;
+    PSODesc.GraphicsPipeline.PrimitiveTopology          = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    PSODesc.GraphicsPipeline.InputLayout.LayoutElements = Elems;
+    PSODesc.GraphicsPipeline.InputLayout.NumElements    = _countof(Elems);
+
+    RefCntAutoPtr<IPipelineState> pFallbackPSO;
+    pDevice->CreatePipelineState(PSODesc, &pFallbackPSO);
+    ASSERT_NE(pFallbackPSO, nullptr);
+
+    auto GetFallbackPSO = [&]() -> const PipelineStateVkImpl* //
+    {
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreatePipelineStateAsync(PSODesc, pFallbackPSO, &pPSO);
+        return pPSO ? pPSO.RawPtr<PipelineStateVkImpl>()->GetFallbackPSO() : nullptr;
+    };
+
+    EXPECT_EQ(GetFallbackPSO(), pFallbackPSO.RawPtr<PipelineStateVkImpl>());
+
+    auto* pEnv = TestingEnvironment::GetInstance();
+    pEnv->SetErrorAllowance(2, "\n\nNo worries, testing incompatible fallback pipelines...\n\n");
+
+    PSODesc.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+    EXPECT_EQ(GetFallbackPSO(), nullptr) << "Fallback pipeline with a different primitive topology must not be used";
+    PSODesc.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    Elems[0].Stride = 32;
+    EXPECT_EQ(GetFallbackPSO(), nullptr) << "Fallback pipeline with a different input layout must not be used";
+
+    pEnv->SetErrorAllowance(0);
+
+    GetWorkerThreadPool().WaitForAllTasks();
+}
+
+} // namespace
@@ -0,0 +1,385 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "BindlessResourceTableVk.hpp"
+#include "TextureViewVk.h"
+#include "BufferViewVk.h"
+#include "SamplerVk.h"
+#include "TestingEnvironment.hpp"
+#include "Vulkan/InternalTestUtilsVk.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class BindlessResourceTableTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        if (TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().DevType != RENDER_DEVICE_TYPE_VULKAN)
+            return;
+
+        // The table is disabled in the testing environment, so the tests use their own device.
+        // The table is not created if the device does not support descriptor indexing.
+        EngineVkCreateInfo EngineCI;
+        EngineCI.EnableBindlessResources = true;
+        CreateTestDeviceVk(EngineCI, pDevice, pContext);
+    }
+
+    static void TearDownTestSuite()
+    {
+        pContext.Release();
+        pDevice.Release();
+    }
+
+    static BindlessResourceTableVk* GetBindlessResourceTable()
+    {
+        return pDevice ? pDevice.RawPtr<RenderDeviceVkImpl>()->GetBindlessResourceTable() : nullptr;
+    }
+
+    static RefCntAutoPtr<IRenderDevice>  pDevice;
+    static RefCntAutoPtr<IDeviceContext> pContext;
+};
+
+RefCntAutoPtr<IRenderDevice>  BindlessResourceTableTest::pDevice;
+RefCntAutoPtr<IDeviceContext> BindlessResourceTableTest::pContext;
+
+RefCntAutoPtr<ITexture> CreateTexture(IRenderDevice* pDevice, const Uint32 Color = 0)
+{
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Bindless resource table test - texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 1;
+    TexDesc.Height    = 1;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    TextureSubResData SubresData;
+    SubresData.pData  = &Color;
+    SubresData.Stride = sizeof(Color);
+    TextureData InitData;
+    InitData.pSubResources   = &SubresData;
+    InitData.NumSubresources = 1;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    return pTexture;
+}
+
+Uint32 GetBindlessIndex(ITexture* pTexture)
+{
+    RefCntAutoPtr<ITextureViewVk> pViewVk{pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), IID_TextureViewVk};
+    return pViewVk ? pViewVk->GetBindlessIndex() : BindlessResourceTableVk::InvalidIndex;
+}
+
+// Every application-visible object takes exactly one slot, and indices are unique within each table binding
+TEST_F(BindlessResourceTableTest, SlotAllocation)
+{
+    auto* pBindlessTable = GetBindlessResourceTable();
+    if (pBindlessTable == nullptr)
+        GTEST_SKIP() << "Bindless resource table is not supported by this device";
+
+    pDevice->IdleGPU();
+    const auto NumSlots0 = pBindlessTable->GetAllocatedSlotCount();
+
+    constexpr Uint32 NumTextures = 8;
+    constexpr Uint32 NumBuffers  = 4;
+    constexpr Uint32 NumSamplers = 4;
+
+    std::vector<RefCntAutoPtr<ITexture>> pTextures;
+    std::vector<Uint32>                  TextureIndices;
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        pTextures.emplace_back(CreateTexture(pDevice));
+        ASSERT_NE(pTextures.back(), nullptr);
+        TextureIndices.push_back(GetBindlessIndex(pTextures.back()));
+        EXPECT_NE(TextureIndices.back(), BindlessResourceTableVk::InvalidIndex);
+        EXPECT_LT(TextureIndices.back(), pBindlessTable->GetSize(BindlessResourceTableVk::BINDING_SAMPLED_IMAGE));
+    }
+
+    std::vector<RefCntAutoPtr<IBuffer>> pBuffers;
+    std::vector<Uint32>                 BufferIndices;
+    for (Uint32 i = 0; i < NumBuffers; ++i)
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Bindless resource table test - structured buffer";
+        BuffDesc.uiSizeInBytes     = 256;
+        BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = 16;
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        ASSERT_NE(pBuffer, nullptr);
+
+        RefCntAutoPtr<IBufferViewVk> pViewVk{pBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE), IID_BufferViewVk};
+        ASSERT_NE(pViewVk, nullptr);
+        BufferIndices.push_back(pViewVk->GetBindlessIndex());
+        EXPECT_NE(BufferIndices.back(), BindlessResourceTableVk::InvalidIndex);
+        pBuffers.emplace_back(std::move(pBuffer));
+    }
+
+    std::vector<RefCntAutoPtr<ISampler>> pSamplers;
+    std::vector<Uint32>                  SamplerIndices;
+    for (Uint32 i = 0; i < NumSamplers; ++i)
+    {
+        // Samplers with identical descriptions are shared by the device, so make every description unique
+        SamplerDesc SamDesc;
+        SamDesc.MipLODBias = static_cast<float>(i) + 0.5f;
+        RefCntAutoPtr<ISampler> pSampler;
+        pDevice->CreateSampler(SamDesc, &pSampler);
+        ASSERT_NE(pSampler, nullptr);
+
+        RefCntAutoPtr<ISamplerVk> pSamplerVk{pSampler, IID_SamplerVk};
+        ASSERT_NE(pSamplerVk, nullptr);
+        SamplerIndices.push_back(pSamplerVk->GetBindlessIndex());
+        EXPECT_NE(SamplerIndices.back(), BindlessResourceTableVk::InvalidIndex);
+        pSamplers.emplace_back(std::move(pSampler));
+    }
+
+    for (auto* pIndices : {&TextureIndices, &BufferIndices, &SamplerIndices})
+    {
+        auto Indices = *pIndices;
+        std::sort(Indices.begin(), Indices.end());
+        EXPECT_TRUE(std::adjacent_find(Indices.begin(), Indices.end()) == Indices.end()) << "Bindless indices are not unique";
+    }
+
+    // The index is stable for the lifetime of the view
+    for (Uint32 i = 0; i < NumTextures; ++i)
+        EXPECT_EQ(GetBindlessIndex(pTextures[i]), TextureIndices[i]);
+
+    EXPECT_EQ(pBindlessTable->GetAllocatedSlotCount(), NumSlots0 + NumTextures + NumBuffers + NumSamplers);
+
+    // Render target views and internal mip level views of a texture with automatic mipmap
+    // generation do not take slots: only the default shader resource view is in the table
+    {
+        const auto NumSlots1 = pBindlessTable->GetAllocatedSlotCount();
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Bindless resource table test - texture with mips";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 64;
+        TexDesc.Height    = 64;
+        TexDesc.MipLevels = 0;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+        TexDesc.MiscFlags = MISC_TEXTURE_FLAG_GENERATE_MIPS;
+        RefCntAutoPtr<ITexture> pTexture;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+        ASSERT_NE(pTexture, nullptr);
+        EXPECT_NE(GetBindlessIndex(pTexture), BindlessResourceTableVk::InvalidIndex);
+        EXPECT_EQ(pBindlessTable->GetAllocatedSlotCount(), NumSlots1 + 1);
+    }
+}
+
+// A released slot goes through the release queue and is only reused once the queue has been purged
+TEST_F(BindlessResourceTableTest, SlotReuse)
+{
+    auto* pBindlessTable = GetBindlessResourceTable();
+    if (pBindlessTable == nullptr)
+        GTEST_SKIP() << "Bindless resource table is not supported by this device";
+
+    pContext->Flush();
+    pDevice->IdleGPU();
+    const auto NumSlots0 = pBindlessTable->GetAllocatedSlotCount();
+
+    auto pTexture = CreateTexture(pDevice);
+    ASSERT_NE(pTexture, nullptr);
+    const auto Index = GetBindlessIndex(pTexture);
+    ASSERT_NE(Index, BindlessResourceTableVk::InvalidIndex);
+    EXPECT_EQ(pBindlessTable->GetAllocatedSlotCount(), NumSlots0 + 1);
+
+    // The slot is held by the release queue until the GPU is done with it
+    pTexture.Release();
+    EXPECT_EQ(pBindlessTable->GetAllocatedSlotCount(), NumSlots0 + 1);
+
+    pContext->Flush();
+    pDevice->IdleGPU();
+    EXPECT_EQ(pBindlessTable->GetAllocatedSlotCount(), NumSlots0);
+
+    // Free slots are reused before the never used ones, most recently returned first
+    auto pTexture2 = CreateTexture(pDevice);
+    ASSERT_NE(pTexture2, nullptr);
+    EXPECT_EQ(GetBindlessIndex(pTexture2), Index);
+    EXPECT_EQ(pBindlessTable->GetAllocatedSlotCount(), NumSlots0 + 1);
+}
+
+// Textures and samplers are only accessible to the shader through the table
+constexpr char BindlessCS[] = R"(
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+layout(set = 0, binding = 0) uniform texture2D g_Textures[];
+layout(set = 0, binding = 1) uniform sampler   g_Samplers[];
+
+layout(std140, set = 0, binding = 2) uniform Constants
+{
+    uvec4 g_Indices; // x - texture index, y - sampler index
+};
+
+layout(std140, set = 0, binding = 3) writeonly buffer g_Output
+{
+    vec4 Color;
+} g_OutputBuff;
+
+void main()
+{
+    g_OutputBuff.Color = textureLod(sampler2D(g_Textures[g_Indices.x], g_Samplers[g_Indices.y]), vec2(0.5, 0.5), 0.0);
+}
+)";
+
+TEST_F(BindlessResourceTableTest, SampleThroughTable)
+{
+    auto* pBindlessTable = GetBindlessResourceTable();
+    if (pBindlessTable == nullptr)
+        GTEST_SKIP() << "Bindless resource table is not supported by this device";
+    if (!pDevice->GetDeviceCaps().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Desc.Name       = "Bindless resource table test";
+    ShaderCI.Source          = BindlessCS;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    PipelineStateDesc PSODesc;
+    PSODesc.Name                               = "Bindless resource table test";
+    PSODesc.IsComputePipeline                  = true;
+    PSODesc.ComputePipeline.pCS                = pCS;
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreatePipelineState(PSODesc, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    // The runtime-sized arrays are not exposed as variables
+    EXPECT_EQ(pPSO->GetStaticVariableCount(SHADER_TYPE_COMPUTE), 0u);
+
+    // Several textures are created, so the shader must select the right one by index
+    const Uint32            Colors[] = {0xFF0000FFu, 0xFF00FF00u, 0xFFFF0000u};
+    RefCntAutoPtr<ITexture> pTextures[_countof(Colors)];
+    for (Uint32 i = 0; i < _countof(Colors); ++i)
+    {
+        pTextures[i] = CreateTexture(pDevice, Colors[i]);
+        ASSERT_NE(pTextures[i], nullptr);
+        // Resources accessed through the table are not transitioned by the engine
+        StateTransitionDesc Barrier{pTextures[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, true};
+        pContext->TransitionResourceStates(1, &Barrier);
+    }
+    constexpr Uint32 SelectedTexture = 1;
+
+    SamplerDesc SamDesc{FILTER_TYPE_POINT, FILTER_TYPE_POINT, FILTER_TYPE_POINT};
+    RefCntAutoPtr<ISampler> pSampler;
+    pDevice->CreateSampler(SamDesc, &pSampler);
+    ASSERT_NE(pSampler, nullptr);
+    RefCntAutoPtr<ISamplerVk> pSamplerVk{pSampler, IID_SamplerVk};
+    ASSERT_NE(pSamplerVk, nullptr);
+
+    const Uint32 Indices[] = {GetBindlessIndex(pTextures[SelectedTexture]), pSamplerVk->GetBindlessIndex(), 0, 0};
+    ASSERT_NE(Indices[0], BindlessResourceTableVk::InvalidIndex);
+    ASSERT_NE(Indices[1], BindlessResourceTableVk::InvalidIndex);
+
+    RefCntAutoPtr<IBuffer> pConstants;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Bindless resource table test - constants";
+        BuffDesc.uiSizeInBytes = sizeof(Indices);
+        BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+        BufferData InitData{Indices, sizeof(Indices)};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &pConstants);
+        ASSERT_NE(pConstants, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pOutput;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Bindless resource table test - output";
+        BuffDesc.uiSizeInBytes     = sizeof(float) * 4;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(float) * 4;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pOutput);
+        ASSERT_NE(pOutput, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Bindless resource table test - staging buffer";
+        BuffDesc.uiSizeInBytes  = sizeof(float) * 4;
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+        ASSERT_NE(pStagingBuffer, nullptr);
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(pConstants);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, sizeof(float) * 4, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    float Result[4] = {};
+    memcpy(Result, pData, sizeof(Result));
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+
+    const auto Color = Colors[SelectedTexture];
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        const float Expected = static_cast<float>((Color >> (c * 8)) & 0xFF) / 255.f;
+        EXPECT_EQ(Result[c], Expected) << "Component " << c;
+    }
+}
+
+} // namespace
@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <array>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "TestingEnvironment.hpp"
+#include "Vulkan/InternalTestUtilsVk.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class CreateShadersTest : public ::testing::Test
+{
+protected:
+    static constexpr Uint32 NumWorkerThreads = 2;
+
+    static void SetUpTestSuite()
+    {
+        if (TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().DevType != RENDER_DEVICE_TYPE_VULKAN)
+            return;
+
+        EngineVkCreateInfo EngineCI;
+        EngineCI.NumWorkerThreads = NumWorkerThreads;
+        CreateTestDeviceVk(EngineCI, pDevice, pContext);
+    }
+
+    static void TearDownTestSuite()
+    {
+        pContext.Release();
+        pDevice.Release();
+    }
+
+    void SetUp() override
+    {
+        if (!pDevice)
+            GTEST_SKIP() << "Shaders are only compiled in parallel by Vulkan backend";
+    }
+
+    static RefCntAutoPtr<IRenderDevice>  pDevice;
+    static RefCntAutoPtr<IDeviceContext> pContext;
+};
+
+constexpr Uint32 CreateShadersTest::NumWorkerThreads;
+
+RefCntAutoPtr<IRenderDevice>  CreateShadersTest::pDevice;
+RefCntAutoPtr<IDeviceContext> CreateShadersTest::pContext;
+
+constexpr Uint32 NumShaders = 6;
+
+// Shader sources differ, so that every shader is compiled rather than taken from a cache
+struct ShaderBatch
+{
+    explicit ShaderBatch(const char* NamePrefix)
+    {
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            const auto Value = std::to_string(i);
+
+            Names[i]   = NamePrefix + Value;
+            Sources[i] = "RWStructuredBuffer<float4> g_Output;\n"
+                         "[numthreads(1, 1, 1)]\n"
+                         "void main() { g_Output[0] = float4(" +
+                Value + ".0, 0.0, 0.0, 0.0); }\n";
+
+            auto& ShaderCI           = ShaderCIs[i];
+            ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+            ShaderCI.EntryPoint      = "main";
+            ShaderCI.Desc.Name       = Names[i].c_str();
+            ShaderCI.Source          = Sources[i].c_str();
+        }
+    }
+
+    ~ShaderBatch()
+    {
+        for (auto* pShader : Shaders)
+        {
+            if (pShader != nullptr)
+                pShader->Release();
+        }
+    }
+
+    std::array<std::string, NumShaders>      Names;
+    std::array<std::string, NumShaders>      Sources;
+    std::array<ShaderCreateInfo, NumShaders> ShaderCIs;
+    std::array<IShader*, NumShaders>         Shaders = {};
+};
+
+TEST_F(CreateShadersTest, Batch)
+{
+    ShaderBatch Batch{"Create shaders test - batch "};
+
+    // One shader in the middle of the batch fails to compile
+    constexpr Uint32 BrokenShaderInd = 3;
+    Batch.Sources[BrokenShaderInd]   = "void main() { undeclared_function(); }";
+
+    IDataBlob* pCompilerOutput                        = nullptr;
+    Batch.ShaderCIs[BrokenShaderInd].Source           = Batch.Sources[BrokenShaderInd].c_str();
+    Batch.ShaderCIs[BrokenShaderInd].ppCompilerOutput = &pCompilerOutput;
+
+    auto* pEnv = TestingEnvironment::GetInstance();
+    pEnv->SetErrorAllowance(3, "\n\nNo worries, testing broken shader...\n\n");
+    pDevice->CreateShaders(Batch.ShaderCIs.data(), NumShaders, Batch.Shaders.data());
+    pEnv->SetErrorAllowance(0);
+
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        if (i == BrokenShaderInd)
+        {
+            EXPECT_EQ(Batch.Shaders[i], nullptr);
+            continue;
+        }
+        ASSERT_NE(Batch.Shaders[i], nullptr) << "Shader " << i;
+        EXPECT_STREQ(Batch.Shaders[i]->GetDesc().Name, Batch.Names[i].c_str());
+        EXPECT_EQ(Batch.Shaders[i]->GetResourceCount(), Uint32{1});
+    }
+
+    EXPECT_NE(pCompilerOutput, nullptr);
+    if (pCompilerOutput != nullptr)
+        pCompilerOutput->Release();
+}
+
+// A worker thread that calls CreateShaders() must not wait for tasks that can only
+// run on the threads that are waiting
+TEST_F(CreateShadersTest, CallFromWorkerThread)
+{
+    auto& Pool = pDevice.RawPtr<RenderDeviceVkImpl>()->GetWorkerThreadPool();
+    ASSERT_EQ(Pool.GetNumThreads(), size_t{NumWorkerThreads});
+
+    std::vector<std::unique_ptr<ShaderBatch>> Batches;
+    std::vector<std::future<void>>            Tasks;
+    for (Uint32 t = 0; t < NumWorkerThreads; ++t)
+    {
+        Batches.emplace_back(new ShaderBatch{"Create shaders test - worker thread "});
+        auto* pBatch = Batches.back().get();
+        Tasks.emplace_back(Pool.EnqueueTask(
+            [pBatch]() //
+            {
+                pDevice->CreateShaders(pBatch->ShaderCIs.data(), NumShaders, pBatch->Shaders.data());
+            } //
+            ));
+    }
+
+    for (auto& Task : Tasks)
+        ASSERT_EQ(Task.wait_for(std::chrono::seconds{60}), std::future_status::ready) << "CreateShaders() deadlocked the worker thread pool";
+
+    for (const auto& pBatch : Batches)
+    {
+        for (auto* pShader : pBatch->Shaders)
+            EXPECT_NE(pShader, nullptr);
+    }
+}
+
+} // namespace
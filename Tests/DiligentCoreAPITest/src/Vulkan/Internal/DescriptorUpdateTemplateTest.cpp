@@ -0,0 +1,387 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "DeviceContextVkImpl.hpp"
+#include "PipelineStateVkImpl.hpp"
+#include "ShaderResourceBindingVkImpl.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// All variables are dynamic. The shader covers uniform buffers, storage and texel buffers,
+// arrays of separate images and samplers, an immutable sampler and a storage image.
+constexpr char DynamicResourcesCS[] = R"(
+cbuffer Constants
+{
+    float4 g_Scale;
+};
+Texture2D                g_Textures[3];
+SamplerState             g_Samplers[2];
+SamplerState             g_ImtblSampler;
+StructuredBuffer<float4> g_Data;
+Buffer<float4>           g_Formatted;
+RWTexture2D<float4>      g_Output;
+
+[numthreads(1, 1, 1)]
+void main(uint3 ThreadId : SV_DispatchThreadID)
+{
+    float2 UV    = float2(0.5, 0.5);
+    float4 Color = g_Scale;
+    Color += g_Textures[0].SampleLevel(g_Samplers[0], UV, 0.0);
+    Color += g_Textures[1].SampleLevel(g_Samplers[1], UV, 0.0);
+    Color += g_Textures[2].SampleLevel(g_ImtblSampler, UV, 0.0);
+    Color += g_Data[0] + g_Formatted.Load(0);
+    g_Output[ThreadId.xy] = Color;
+}
+)";
+
+struct DescriptorRecord
+{
+    VkDescriptorType             Type;
+    DescriptorUpdateTemplateData Data;
+};
+
+// Descriptors keyed by binding and array element
+using DescriptorRecords = std::map<std::pair<uint32_t, uint32_t>, DescriptorRecord>;
+
+bool IsImageDescriptor(VkDescriptorType Type)
+{
+    return Type == VK_DESCRIPTOR_TYPE_SAMPLER ||
+        Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER ||
+        Type == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE ||
+        Type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+}
+
+bool IsTexelBufferDescriptor(VkDescriptorType Type)
+{
+    return Type == VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER ||
+        Type == VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+}
+
+void CompareDescriptors(const DescriptorRecords& TemplateRecords, const DescriptorRecords& WriteRecords)
+{
+    EXPECT_EQ(TemplateRecords.size(), WriteRecords.size());
+    for (const auto& it : WriteRecords)
+    {
+        const auto Binding = it.first.first;
+        const auto Elem    = it.first.second;
+
+        auto tmpl_it = TemplateRecords.find(it.first);
+        if (tmpl_it == TemplateRecords.end())
+        {
+            ADD_FAILURE() << "Descriptor " << Binding << '[' << Elem << "] is not written by the update template";
+            continue;
+        }
+
+        const auto& Ref = it.second;
+        const auto& Tmp = tmpl_it->second;
+        EXPECT_EQ(Tmp.Type, Ref.Type) << "Binding " << Binding << '[' << Elem << ']';
+        if (IsImageDescriptor(Ref.Type))
+        {
+            EXPECT_EQ(Tmp.Data.ImageInfo.sampler, Ref.Data.ImageInfo.sampler) << "Binding " << Binding << '[' << Elem << ']';
+            EXPECT_EQ(Tmp.Data.ImageInfo.imageView, Ref.Data.ImageInfo.imageView) << "Binding " << Binding << '[' << Elem << ']';
+            EXPECT_EQ(Tmp.Data.ImageInfo.imageLayout, Ref.Data.ImageInfo.imageLayout) << "Binding " << Binding << '[' << Elem << ']';
+        }
+        else if (IsTexelBufferDescriptor(Ref.Type))
+        {
+            EXPECT_EQ(Tmp.Data.TexelBufferView, Ref.Data.TexelBufferView) << "Binding " << Binding << '[' << Elem << ']';
+        }
+        else
+        {
+            EXPECT_EQ(Tmp.Data.BufferInfo.buffer, Ref.Data.BufferInfo.buffer) << "Binding " << Binding << '[' << Elem << ']';
+            EXPECT_EQ(Tmp.Data.BufferInfo.offset, Ref.Data.BufferInfo.offset) << "Binding " << Binding << '[' << Elem << ']';
+            EXPECT_EQ(Tmp.Data.BufferInfo.range, Ref.Data.BufferInfo.range) << "Binding " << Binding << '[' << Elem << ']';
+        }
+    }
+}
+
+// Dynamic descriptor sets written with the update template must contain exactly the descriptors
+// written by vkUpdateDescriptorSets() on devices that do not support templates
+TEST(DescriptorUpdateTemplateTest, MatchesDescriptorWrites)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (pDevice->GetDeviceCaps().DevType != RENDER_DEVICE_TYPE_VULKAN)
+        GTEST_SKIP() << "Descriptor update templates are only used by Vulkan backend";
+    if (!pDevice->GetDeviceCaps().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pContextVk = ValidatedCast<DeviceContextVkImpl>(pContext);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.UseCombinedTextureSamplers = false;
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Desc.Name                  = "Descriptor update template test";
+    ShaderCI.Source                     = DynamicResourcesCS;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    StaticSamplerDesc ImtblSampler;
+    ImtblSampler.ShaderStages         = SHADER_TYPE_COMPUTE;
+    ImtblSampler.SamplerOrTextureName = "g_ImtblSampler";
+
+    PipelineStateDesc PSODesc;
+    PSODesc.Name                                  = "Descriptor update template test";
+    PSODesc.IsComputePipeline                     = true;
+    PSODesc.ComputePipeline.pCS                   = pCS;
+    PSODesc.ResourceLayout.DefaultVariableType    = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    PSODesc.ResourceLayout.NumStaticSamplers      = 1;
+    PSODesc.ResourceLayout.StaticSamplers         = &ImtblSampler;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreatePipelineState(PSODesc, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    // Dynamic uniform buffer
+    RefCntAutoPtr<IBuffer> pConstants;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Descriptor update template test - constants";
+        BuffDesc.uiSizeInBytes  = 16;
+        BuffDesc.Usage          = USAGE_DYNAMIC;
+        BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pConstants);
+        ASSERT_NE(pConstants, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pStructBuff;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Descriptor update template test - structured buffer";
+        BuffDesc.uiSizeInBytes     = 64;
+        BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = 16;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStructBuff);
+        ASSERT_NE(pStructBuff, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer>     pFormattedBuff;
+    RefCntAutoPtr<IBufferView> pFormattedBuffSRV;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Descriptor update template test - formatted buffer";
+        BuffDesc.uiSizeInBytes     = 64;
+        BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+        BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+        BuffDesc.ElementByteStride = 16;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pFormattedBuff);
+        ASSERT_NE(pFormattedBuff, nullptr);
+
+        BufferViewDesc ViewDesc;
+        ViewDesc.ViewType             = BUFFER_VIEW_SHADER_RESOURCE;
+        ViewDesc.Format.ValueType     = VT_FLOAT32;
+        ViewDesc.Format.NumComponents = 4;
+        pFormattedBuff->CreateView(ViewDesc, &pFormattedBuffSRV);
+        ASSERT_NE(pFormattedBuffSRV, nullptr);
+    }
+
+    auto CreateTexture = [&](const char* Name, TEXTURE_FORMAT Format, BIND_FLAGS BindFlags) //
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = Name;
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 4;
+        TexDesc.Height    = 4;
+        TexDesc.Format    = Format;
+        TexDesc.BindFlags = BindFlags;
+        RefCntAutoPtr<ITexture> pTexture;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+        return pTexture;
+    };
+
+    RefCntAutoPtr<ITexture> pTextures[3];
+    IDeviceObject*          pTextureSRVs[3] = {};
+    for (Uint32 i = 0; i < _countof(pTextures); ++i)
+    {
+        pTextures[i] = CreateTexture("Descriptor update template test - texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE);
+        ASSERT_NE(pTextures[i], nullptr);
+        pTextureSRVs[i] = pTextures[i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    }
+
+    auto pOutput = CreateTexture("Descriptor update template test - output", TEX_FORMAT_RGBA32_FLOAT, BIND_UNORDERED_ACCESS);
+    ASSERT_NE(pOutput, nullptr);
+
+    RefCntAutoPtr<ISampler> pSamplers[2];
+    IDeviceObject*          pSamplerObjs[2] = {};
+    for (Uint32 i = 0; i < _countof(pSamplers); ++i)
+    {
+        SamplerDesc SamDesc;
+        SamDesc.MinFilter = i == 0 ? FILTER_TYPE_POINT : FILTER_TYPE_LINEAR;
+        pDevice->CreateSampler(SamDesc, &pSamplers[i]);
+        ASSERT_NE(pSamplers[i], nullptr);
+        pSamplerObjs[i] = pSamplers[i];
+    }
+
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(pConstants);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Textures")->SetArray(pTextureSRVs, 0, _countof(pTextureSRVs));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Samplers")->SetArray(pSamplerObjs, 0, _countof(pSamplerObjs));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Data")->Set(pStructBuff->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Formatted")->Set(pFormattedBuffSRV);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+
+    auto*       pPSOVk        = ValidatedCast<PipelineStateVkImpl>(pPSO.RawPtr());
+    const auto& ResourceCache = ValidatedCast<ShaderResourceBindingVkImpl>(pSRB.RawPtr())->GetResourceCache();
+    const auto& Layout        = pPSOVk->GetShaderResLayout(0);
+    ASSERT_GT(Layout.GetResourceCount(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC), 0u);
+
+    // Descriptors as they are written by the update template
+    DescriptorRecords TemplateRecords;
+    {
+        std::vector<VkDescriptorUpdateTemplateEntry> Entries;
+        Uint32                                       NumDescriptors = 0;
+        Layout.GetDynamicResourceUpdateTemplateEntries(Entries, NumDescriptors);
+        ASSERT_FALSE(Entries.empty());
+
+        std::vector<DescriptorUpdateTemplateData> Data(NumDescriptors);
+        auto* pDataEnd = Layout.WriteDynamicResourceDescriptors(ResourceCache, Data.data());
+        EXPECT_EQ(pDataEnd, Data.data() + Data.size());
+
+        const auto* pDataBytes = reinterpret_cast<const Uint8*>(Data.data());
+        for (const auto& Entry : Entries)
+        {
+            for (uint32_t i = 0; i < Entry.descriptorCount; ++i)
+            {
+                const auto Offset = Entry.offset + i * Entry.stride;
+                ASSERT_LE(Offset + sizeof(DescriptorUpdateTemplateData), Data.size() * sizeof(DescriptorUpdateTemplateData));
+
+                auto& Record = TemplateRecords[std::make_pair(Entry.dstBinding, Entry.dstArrayElement + i)];
+                Record.Type  = Entry.descriptorType;
+                memcpy(&Record.Data, pDataBytes + Offset, sizeof(Record.Data));
+            }
+        }
+    }
+
+    // Descriptors as they are written by vkUpdateDescriptorSets(). The writes are only
+    // captured, so the destination set is never accessed.
+    VkDescriptorSet vkDummySet;
+    memset(&vkDummySet, 0xFF, sizeof(vkDummySet));
+    DescriptorRecords WriteRecords;
+    Layout.CommitDynamicResources(
+        ResourceCache, vkDummySet,
+        [&](Uint32 DescriptorWriteCount, const VkWriteDescriptorSet* pDescriptorWrites) //
+        {
+            for (Uint32 w = 0; w < DescriptorWriteCount; ++w)
+            {
+                const auto& Write = pDescriptorWrites[w];
+                for (uint32_t i = 0; i < Write.descriptorCount; ++i)
+                {
+                    auto& Record = WriteRecords[std::make_pair(Write.dstBinding, Write.dstArrayElement + i)];
+                    Record.Type  = Write.descriptorType;
+                    memset(&Record.Data, 0, sizeof(Record.Data));
+                    if (IsImageDescriptor(Write.descriptorType))
+                        Record.Data.ImageInfo = Write.pImageInfo[i];
+                    else if (IsTexelBufferDescriptor(Write.descriptorType))
+                        Record.Data.TexelBufferView = Write.pTexelBufferView[i];
+                    else
+                        Record.Data.BufferInfo = Write.pBufferInfo[i];
+                }
+            }
+        });
+
+    CompareDescriptors(TemplateRecords, WriteRecords);
+
+    // Make sure the tested descriptors include a dynamic buffer, all elements of the
+    // texture array and all separate samplers, but not the immutable sampler
+    size_t NumDynamicBuffers = 0, NumSampledImages = 0, NumSamplers = 0;
+    for (const auto& it : WriteRecords)
+    {
+        switch (it.second.Type)
+        {
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                ++NumDynamicBuffers;
+                break;
+
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                ++NumSampledImages;
+                break;
+
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+                ++NumSamplers;
+                break;
+
+            default:
+                break;
+        }
+    }
+    EXPECT_GE(NumDynamicBuffers, 2u);
+    EXPECT_EQ(NumSampledImages, size_t{_countof(pTextures)});
+    EXPECT_EQ(NumSamplers, size_t{_countof(pSamplers)});
+
+    {
+        void* pData = nullptr;
+        pContext->MapBuffer(pConstants, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        ASSERT_NE(pData, nullptr);
+        const float Scale[] = {0.25f, 0.5f, 0.75f, 1.0f};
+        memcpy(pData, Scale, sizeof(Scale));
+        pContext->UnmapBuffer(pConstants, MAP_WRITE);
+    }
+
+    // Write a real descriptor set with vkUpdateDescriptorSets() to let the validation
+    // layers check the writes. Push descriptor sets cannot be allocated from a pool.
+    const auto& PipelineLayout = pPSOVk->GetPipelineLayout();
+    if (!PipelineLayout.IsDynamicDescriptorSetPushed())
+    {
+        auto vkDynamicSet = pContextVk->AllocateDynamicDescriptorSet(PipelineLayout.GetDynamicDescriptorSetVkLayout(), "Descriptor update template test");
+        ASSERT_TRUE(vkDynamicSet != VK_NULL_HANDLE);
+        Layout.CommitDynamicResources(ResourceCache, vkDynamicSet);
+    }
+
+    // Commit the resources through the regular path, which uses the template if it is supported
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->DispatchCompute(DispatchComputeAttribs{4, 4});
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+} // namespace
@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "vulkan/vulkan.h"
+
+#include "DeviceContextVk.h"
+#include "PipelineStateVkImpl.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// The dynamic uniform buffer prevents the dynamic set from being pushed,
+// so the set is allocated from the dynamic pool and goes through the cache
+constexpr char DynamicSetCS[] = R"(
+cbuffer Constants
+{
+    float4 g_Value;
+};
+RWTexture2D<float4> g_Output;
+
+[numthreads(1, 1, 1)]
+void main(uint3 ThreadId : SV_DispatchThreadID)
+{
+    g_Output[ThreadId.xy] = g_Value;
+}
+)";
+
+TEST(DynamicDescriptorSetCacheTest, HitsAndMisses)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (pDevice->GetDeviceCaps().DevType != RENDER_DEVICE_TYPE_VULKAN)
+        GTEST_SKIP() << "Dynamic descriptor set cache is only used by Vulkan backend";
+    if (!pDevice->GetDeviceCaps().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    auto*                           pContext = pEnv->GetDeviceContext();
+    RefCntAutoPtr<IDeviceContextVk> pContextVk{pContext, IID_DeviceContextVk};
+    ASSERT_NE(pContextVk, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Desc.Name       = "Dynamic descriptor set cache test";
+    ShaderCI.Source          = DynamicSetCS;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    PipelineStateDesc PSODesc;
+    PSODesc.Name                               = "Dynamic descriptor set cache test";
+    PSODesc.IsComputePipeline                  = true;
+    PSODesc.ComputePipeline.pCS                = pCS;
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreatePipelineState(PSODesc, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+    ASSERT_FALSE(ValidatedCast<PipelineStateVkImpl>(pPSO.RawPtr())->GetPipelineLayout().IsDynamicDescriptorSetPushed());
+
+    RefCntAutoPtr<IBuffer> pConstants;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Dynamic descriptor set cache test - constants";
+        BuffDesc.uiSizeInBytes  = 16;
+        BuffDesc.Usage          = USAGE_DYNAMIC;
+        BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pConstants);
+        ASSERT_NE(pConstants, nullptr);
+    }
+
+    RefCntAutoPtr<ITexture> pOutputs[2];
+    for (Uint32 i = 0; i < _countof(pOutputs); ++i)
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Dynamic descriptor set cache test - output";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 4;
+        TexDesc.Height    = 4;
+        TexDesc.Format    = TEX_FORMAT_RGBA32_FLOAT;
+        TexDesc.BindFlags = BIND_UNORDERED_ACCESS;
+        pDevice->CreateTexture(TexDesc, nullptr, &pOutputs[i]);
+        ASSERT_NE(pOutputs[i], nullptr);
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRBs[2];
+    for (Uint32 i = 0; i < _countof(pSRBs); ++i)
+    {
+        pPSO->CreateShaderResourceBinding(&pSRBs[i], true);
+        ASSERT_NE(pSRBs[i], nullptr);
+        pSRBs[i]->GetVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(pConstants);
+        pSRBs[i]->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutputs[i]->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+    }
+
+    auto UpdateConstants = [&](float Value) //
+    {
+        void* pData = nullptr;
+        pContext->MapBuffer(pConstants, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        ASSERT_NE(pData, nullptr);
+        const float Data[] = {Value, Value, Value, Value};
+        memcpy(pData, Data, sizeof(Data));
+        pContext->UnmapBuffer(pConstants, MAP_WRITE);
+    };
+
+    // Expects the commit to change the counters by the given amounts
+    auto CommitAndDispatch = [&](IShaderResourceBinding* pSRB, Uint64 ExpectedHits, Uint64 ExpectedMisses) //
+    {
+        const auto StatsBefore = pContextVk->GetDynamicDescriptorSetCacheStats();
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{4, 4});
+        const auto& Stats = pContextVk->GetDynamicDescriptorSetCacheStats();
+        EXPECT_EQ(Stats.Hits - StatsBefore.Hits, ExpectedHits);
+        EXPECT_EQ(Stats.Misses - StatsBefore.Misses, ExpectedMisses);
+    };
+
+    // Start with an empty cache
+    pContext->Flush();
+    UpdateConstants(0.25f);
+
+    // The first commit writes a new set, the second one reuses it
+    CommitAndDispatch(pSRBs[0], 0, 1);
+    CommitAndDispatch(pSRBs[0], 1, 0);
+
+    // The dynamic buffer offset is not part of the descriptor, so remapping the buffer does not invalidate the set
+    UpdateConstants(0.5f);
+    CommitAndDispatch(pSRBs[0], 1, 0);
+
+    // Different resources require a different set
+    CommitAndDispatch(pSRBs[1], 0, 1);
+    CommitAndDispatch(pSRBs[1], 1, 0);
+    CommitAndDispatch(pSRBs[0], 1, 0);
+
+    // Cached sets are discarded when the command buffer is submitted
+    pContext->Flush();
+    CommitAndDispatch(pSRBs[0], 0, 1);
+    CommitAndDispatch(pSRBs[0], 1, 0);
+
+    // Cached sets are discarded when the frame is finished and the dynamic descriptor pools are released.
+    // All commands must be submitted before the frame is finished. Dynamic buffers must be mapped again
+    // in the new frame.
+    pContext->Flush();
+    pContext->FinishFrame();
+    UpdateConstants(0.75f);
+    CommitAndDispatch(pSRBs[0], 0, 1);
+    CommitAndDispatch(pSRBs[0], 1, 0);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+} // namespace
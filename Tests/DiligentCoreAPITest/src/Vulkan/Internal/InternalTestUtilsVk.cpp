@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "Vulkan/InternalTestUtilsVk.hpp"
+
+#include <atomic>
+
+#if PLATFORM_WIN32
+#    include <direct.h>
+#    include <process.h>
+#else
+#    include <stdlib.h>
+#    include <unistd.h>
+#endif
+
+#include "FileSystem.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+void CreateTestDeviceVk(EngineVkCreateInfo             CreateInfo,
+                        RefCntAutoPtr<IRenderDevice>&  pDevice,
+                        RefCntAutoPtr<IDeviceContext>& pContext)
+{
+    // The debug message callback set by the testing environment is kept when the callback is null
+    CreateInfo.EnableValidation    = true;
+    CreateInfo.NumDeferredContexts = 0;
+
+    pDevice.Release();
+    pContext.Release();
+    GetEngineFactoryVk()->CreateDeviceAndContextsVk(CreateInfo, &pDevice, &pContext);
+}
+
+ScopedTempDirectory::ScopedTempDirectory(const char* Prefix)
+{
+#if PLATFORM_WIN32
+    static std::atomic_int DirCounter{0};
+
+    auto Path = std::string{Prefix} + "." + std::to_string(_getpid()) + "." + std::to_string(DirCounter++);
+    if (_mkdir(Path.c_str()) == 0)
+        m_Path = std::move(Path);
+#else
+    auto Template = std::string{Prefix} + ".XXXXXX";
+    if (mkdtemp(&Template[0]) != nullptr)
+        m_Path = std::move(Template);
+#endif
+}
+
+ScopedTempDirectory::~ScopedTempDirectory()
+{
+    if (m_Path.empty())
+        return;
+
+    auto SearchRes = FileSystem::Search(GetFilePath("*").c_str());
+    for (const auto& File : SearchRes)
+    {
+        if (!File->IsDirectory())
+            FileSystem::DeleteFile(GetFilePath(File->Name()).c_str());
+    }
+
+#if PLATFORM_WIN32
+    _rmdir(m_Path.c_str());
+#else
+    rmdir(m_Path.c_str());
+#endif
+}
+
+std::string ScopedTempDirectory::GetFilePath(const char* FileName) const
+{
+    std::string Path = m_Path;
+    Path += FileSystem::GetSlashSymbol();
+    Path += FileName;
+    return Path;
+}
+
+} // namespace Testing
+
+} // namespace Diligent
@@ -0,0 +1,245 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "TestingEnvironment.hpp"
+#include "Vulkan/InternalTestUtilsVk.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr char PipelineCacheTestCS[] = R"(
+RWStructuredBuffer<float4> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = float4(1.0, 2.0, 3.0, 4.0);
+}
+)";
+
+RenderDeviceVkImpl* GetDeviceVk()
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+    if (pDevice->GetDeviceCaps().DevType != RENDER_DEVICE_TYPE_VULKAN)
+        return nullptr;
+    return ValidatedCast<RenderDeviceVkImpl>(pDevice);
+}
+
+RefCntAutoPtr<IPipelineState> CreateComputePSO(IRenderDevice* pDevice)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Desc.Name       = "Pipeline cache test";
+    ShaderCI.Source          = PipelineCacheTestCS;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        return {};
+
+    PipelineStateDesc PSODesc;
+    PSODesc.Name                               = "Pipeline cache test";
+    PSODesc.IsComputePipeline                  = true;
+    PSODesc.ComputePipeline.pCS                = pCS;
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreatePipelineState(PSODesc, &pPSO);
+    return pPSO;
+}
+
+// Returns the header that IsPipelineCacheDataCompatible() accepts for the device, followed by some payload
+std::vector<Uint8> MakeValidCacheData(const VkPhysicalDeviceProperties& Props)
+{
+    constexpr size_t HeaderSize = 16 + VK_UUID_SIZE;
+
+    std::vector<Uint8> Data(HeaderSize + 64, Uint8{0xCD});
+
+    const Uint32 HeaderFields[] = {
+        static_cast<Uint32>(HeaderSize),
+        static_cast<Uint32>(VK_PIPELINE_CACHE_HEADER_VERSION_ONE),
+        Props.vendorID,
+        Props.deviceID //
+    };
+    memcpy(Data.data(), HeaderFields, sizeof(HeaderFields));
+    memcpy(Data.data() + sizeof(HeaderFields), Props.pipelineCacheUUID, VK_UUID_SIZE);
+    return Data;
+}
+
+void WriteHeaderField(std::vector<Uint8>& Data, size_t Offset, Uint32 Value)
+{
+    memcpy(Data.data() + Offset, &Value, sizeof(Value));
+}
+
+constexpr size_t HeaderSizeOffset    = 0;
+constexpr size_t HeaderVersionOffset = 4;
+constexpr size_t VendorIDOffset      = 8;
+constexpr size_t DeviceIDOffset      = 12;
+constexpr size_t UUIDOffset          = 16;
+
+TEST(PipelineCacheTest, RoundTrip)
+{
+    if (GetDeviceVk() == nullptr)
+        GTEST_SKIP() << "Pipeline cache data is only supported in Vulkan backend";
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    {
+        RefCntAutoPtr<IRenderDevice>  pDevice;
+        RefCntAutoPtr<IDeviceContext> pContext;
+        CreateTestDeviceVk(EngineVkCreateInfo{}, pDevice, pContext);
+        ASSERT_NE(pDevice, nullptr);
+
+        auto pPSO = CreateComputePSO(pDevice);
+        ASSERT_NE(pPSO, nullptr);
+
+        auto* pDeviceVk = pDevice.RawPtr<RenderDeviceVkImpl>();
+        pDeviceVk->GetPipelineCacheData(&pCacheData);
+        ASSERT_NE(pCacheData, nullptr);
+
+        // The data must pass the check that is performed when the blob is used to initialize a device
+        EXPECT_TRUE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(pCacheData->GetDataPtr(), pCacheData->GetSize(),
+                                                                      pDeviceVk->GetPhysicalDevice().GetProperties()));
+    }
+
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+
+    EngineVkCreateInfo EngineCI;
+    EngineCI.pPipelineCacheData = pCacheData;
+    CreateTestDeviceVk(EngineCI, pDevice, pContext);
+    ASSERT_NE(pDevice, nullptr);
+
+    auto* pDeviceVk = pDevice.RawPtr<RenderDeviceVkImpl>();
+    EXPECT_TRUE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(pCacheData->GetDataPtr(), pCacheData->GetSize(),
+                                                                  pDeviceVk->GetPhysicalDevice().GetProperties()));
+    EXPECT_NE(pDeviceVk->GetVkPipelineCache(), VkPipelineCache{VK_NULL_HANDLE});
+
+    auto pPSO = CreateComputePSO(pDevice);
+    ASSERT_NE(pPSO, nullptr);
+
+    // The cache seeded with the blob must still produce data that can be used to initialize the next device
+    RefCntAutoPtr<IDataBlob> pCacheData2;
+    pDeviceVk->GetPipelineCacheData(&pCacheData2);
+    ASSERT_NE(pCacheData2, nullptr);
+    EXPECT_TRUE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(pCacheData2->GetDataPtr(), pCacheData2->GetSize(),
+                                                                  pDeviceVk->GetPhysicalDevice().GetProperties()));
+}
+
+TEST(PipelineCacheTest, ValidHeader)
+{
+    auto* pDeviceVk = GetDeviceVk();
+    if (pDeviceVk == nullptr)
+        GTEST_SKIP() << "Pipeline cache data is only supported in Vulkan backend";
+
+    const auto& Props = pDeviceVk->GetPhysicalDevice().GetProperties();
+    const auto  Data  = MakeValidCacheData(Props);
+    EXPECT_TRUE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(Data.data(), Data.size(), Props));
+}
+
+TEST(PipelineCacheTest, RejectTruncatedData)
+{
+    auto* pDeviceVk = GetDeviceVk();
+    if (pDeviceVk == nullptr)
+        GTEST_SKIP() << "Pipeline cache data is only supported in Vulkan backend";
+
+    const auto& Props = pDeviceVk->GetPhysicalDevice().GetProperties();
+    const auto  Data  = MakeValidCacheData(Props);
+
+    // The data is shorter than the header
+    EXPECT_FALSE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(Data.data(), 0, Props));
+    EXPECT_FALSE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(Data.data(), VendorIDOffset, Props));
+    EXPECT_FALSE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(Data.data(), UUIDOffset + VK_UUID_SIZE - 1, Props));
+
+    // The header claims to be larger than the data
+    auto BadSize = Data;
+    WriteHeaderField(BadSize, HeaderSizeOffset, static_cast<Uint32>(BadSize.size() + 1));
+    EXPECT_FALSE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(BadSize.data(), BadSize.size(), Props));
+
+    // The header size is smaller than the header version one
+    WriteHeaderField(BadSize, HeaderSizeOffset, UUIDOffset);
+    EXPECT_FALSE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(BadSize.data(), BadSize.size(), Props));
+}
+
+TEST(PipelineCacheTest, RejectWrongVersion)
+{
+    auto* pDeviceVk = GetDeviceVk();
+    if (pDeviceVk == nullptr)
+        GTEST_SKIP() << "Pipeline cache data is only supported in Vulkan backend";
+
+    const auto& Props = pDeviceVk->GetPhysicalDevice().GetProperties();
+
+    auto Data = MakeValidCacheData(Props);
+    WriteHeaderField(Data, HeaderVersionOffset, VK_PIPELINE_CACHE_HEADER_VERSION_ONE + 1);
+    EXPECT_FALSE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(Data.data(), Data.size(), Props));
+}
+
+TEST(PipelineCacheTest, RejectWrongDevice)
+{
+    auto* pDeviceVk = GetDeviceVk();
+    if (pDeviceVk == nullptr)
+        GTEST_SKIP() << "Pipeline cache data is only supported in Vulkan backend";
+
+    const auto& Props = pDeviceVk->GetPhysicalDevice().GetProperties();
+
+    auto WrongVendor = MakeValidCacheData(Props);
+    WriteHeaderField(WrongVendor, VendorIDOffset, Props.vendorID ^ 0x1u);
+    EXPECT_FALSE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(WrongVendor.data(), WrongVendor.size(), Props));
+
+    auto WrongDevice = MakeValidCacheData(Props);
+    WriteHeaderField(WrongDevice, DeviceIDOffset, Props.deviceID ^ 0x1u);
+    EXPECT_FALSE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(WrongDevice.data(), WrongDevice.size(), Props));
+}
+
+TEST(PipelineCacheTest, RejectWrongUUID)
+{
+    auto* pDeviceVk = GetDeviceVk();
+    if (pDeviceVk == nullptr)
+        GTEST_SKIP() << "Pipeline cache data is only supported in Vulkan backend";
+
+    const auto& Props = pDeviceVk->GetPhysicalDevice().GetProperties();
+
+    // A driver update changes the UUID while the vendor and device IDs stay the same
+    for (size_t i : {size_t{0}, size_t{VK_UUID_SIZE - 1}})
+    {
+        auto Data = MakeValidCacheData(Props);
+        Data[UUIDOffset + i] ^= 0xFF;
+        EXPECT_FALSE(RenderDeviceVkImpl::IsPipelineCacheDataCompatible(Data.data(), Data.size(), Props)) << "Modified UUID byte " << i;
+    }
+}
+
+} // namespace
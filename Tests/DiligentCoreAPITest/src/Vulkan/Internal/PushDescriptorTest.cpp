@@ -0,0 +1,217 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "vulkan/vulkan.h"
+
+#include "PipelineStateVkImpl.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Set 0 holds the mutable texture and the output buffer. This layout is not compatible with set 0 of PushCS.
+constexpr char DisturbCS[] = R"(
+Texture2D<float4>           g_Texture;
+RWStructuredBuffer<float4>  g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = g_Texture.Load(int3(0, 0, 0)) * 0.0;
+}
+)";
+
+// The output buffer is a mutable resource bound with a dynamic offset, so set 0 is only bound by the
+// dispatch command. The texture is the only dynamic resource and is pushed into the command buffer.
+constexpr char PushCS[] = R"(
+Texture2D<float4>           g_Texture;
+RWStructuredBuffer<float4>  g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = g_Texture.Load(int3(0, 0, 0));
+}
+)";
+
+RefCntAutoPtr<IPipelineState> CreateComputePSO(IRenderDevice* pDevice, const char* Name, const char* Source, SHADER_RESOURCE_VARIABLE_TYPE TextureVarType)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Desc.Name       = Name;
+    ShaderCI.Source          = Source;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        return {};
+
+    ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_COMPUTE, "g_Texture", TextureVarType}};
+
+    PipelineStateDesc PSODesc;
+    PSODesc.Name                               = Name;
+    PSODesc.IsComputePipeline                  = true;
+    PSODesc.ComputePipeline.pCS                = pCS;
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    PSODesc.ResourceLayout.Variables           = Vars;
+    PSODesc.ResourceLayout.NumVariables        = _countof(Vars);
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreatePipelineState(PSODesc, &pPSO);
+    return pPSO;
+}
+
+// Dynamic descriptors must be pushed after the static/mutable set is bound. Binding set 0 with a layout
+// that is not compatible with the previously bound one disturbs the pushed set.
+TEST(PushDescriptorTest, PushAfterIncompatibleSetSwitch)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (pDevice->GetDeviceCaps().DevType != RENDER_DEVICE_TYPE_VULKAN)
+        GTEST_SKIP() << "Push descriptors are only used by Vulkan backend";
+    if (!pDevice->GetDeviceCaps().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    auto pDisturbPSO = CreateComputePSO(pDevice, "Push descriptor test - disturb", DisturbCS, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
+    ASSERT_NE(pDisturbPSO, nullptr);
+    auto pPushPSO = CreateComputePSO(pDevice, "Push descriptor test - push", PushCS, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    ASSERT_NE(pPushPSO, nullptr);
+
+    if (!ValidatedCast<PipelineStateVkImpl>(pPushPSO.RawPtr())->GetPipelineLayout().IsDynamicDescriptorSetPushed())
+        GTEST_SKIP() << "Push descriptors are not supported by this device";
+
+    const Uint32            Colors[] = {0xFF0000FFu, 0xFF00FF00u};
+    RefCntAutoPtr<ITexture> pTextures[_countof(Colors)];
+    for (Uint32 i = 0; i < _countof(Colors); ++i)
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Push descriptor test - texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 1;
+        TexDesc.Height    = 1;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+        TextureSubResData SubresData;
+        SubresData.pData  = &Colors[i];
+        SubresData.Stride = sizeof(Colors[i]);
+        TextureData InitData;
+        InitData.pSubResources   = &SubresData;
+        InitData.NumSubresources = 1;
+
+        pDevice->CreateTexture(TexDesc, &InitData, &pTextures[i]);
+        ASSERT_NE(pTextures[i], nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pOutput;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Push descriptor test - output";
+        BuffDesc.uiSizeInBytes     = sizeof(float) * 4;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(float) * 4;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pOutput);
+        ASSERT_NE(pOutput, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Push descriptor test - staging buffer";
+        BuffDesc.uiSizeInBytes  = sizeof(float) * 4;
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+        ASSERT_NE(pStagingBuffer, nullptr);
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> pDisturbSRB;
+    pDisturbPSO->CreateShaderResourceBinding(&pDisturbSRB, true);
+    ASSERT_NE(pDisturbSRB, nullptr);
+    pDisturbSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Texture")->Set(pTextures[0]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    pDisturbSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    RefCntAutoPtr<IShaderResourceBinding> pPushSRB;
+    pPushPSO->CreateShaderResourceBinding(&pPushSRB, true);
+    ASSERT_NE(pPushSRB, nullptr);
+    pPushSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    auto ReadOutput = [&](float Result[4]) //
+    {
+        pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pStagingBuffer, 0, sizeof(float) * 4, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->WaitForIdle();
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        memcpy(Result, pData, sizeof(float) * 4);
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    };
+
+    auto VerifyColor = [](const float Result[4], Uint32 Color) //
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            const float Expected = static_cast<float>((Color >> (c * 8)) & 0xFF) / 255.f;
+            EXPECT_EQ(Result[c], Expected) << "Component " << c;
+        }
+    };
+
+    for (Uint32 i = 0; i < _countof(Colors); ++i)
+    {
+        // Bind set 0 with an incompatible layout first
+        pContext->SetPipelineState(pDisturbPSO);
+        pContext->CommitShaderResources(pDisturbSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+        pPushSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Texture")->Set(pTextures[i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        pContext->SetPipelineState(pPushPSO);
+        pContext->CommitShaderResources(pPushSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+        // The second dispatch rebinds set 0 with the same layout, which must not disturb the pushed set
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+        float Result[4] = {};
+        ReadOutput(Result);
+        VerifyColor(Result, Colors[i]);
+    }
+}
+
+} // namespace
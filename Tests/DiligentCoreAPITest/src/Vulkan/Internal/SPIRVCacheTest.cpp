@@ -0,0 +1,222 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "SPIRVCache.hpp"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "TestingEnvironment.hpp"
+#include "Vulkan/InternalTestUtilsVk.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Cache entries and test sources are created in a temporary directory that is removed by every test
+constexpr char TempDirPrefix[]    = "SPIRVCacheTest";
+constexpr char CompilerVersion[]  = "SPIRVCacheTest";
+constexpr char IncludeFileName[]  = "SPIRVCacheTestInclude.h";
+constexpr char ShaderSourceHLSL[] = "#include \"SPIRVCacheTestInclude.h\"\nvoid main(){}\n";
+
+void WriteFile(const char* Path, const std::string& Data)
+{
+    FileWrapper File{Path, EFileAccessMode::Overwrite};
+    ASSERT_TRUE(File != nullptr);
+    ASSERT_TRUE(File->Write(Data.data(), Data.size()));
+}
+
+std::vector<uint32_t> GetTestSPIRV(uint32_t Seed)
+{
+    return std::vector<uint32_t>{0x07230203u, 0x00010000u, Seed, Seed + 1, Seed + 2};
+}
+
+TEST(SPIRVCacheTest, MemoryHit)
+{
+    ScopedTempDirectory TempDir{TempDirPrefix};
+    ASSERT_FALSE(TempDir.GetPath().empty());
+    const auto* CacheDirectory = TempDir.GetPath().c_str();
+
+    SPIRVCache Cache{CacheDirectory};
+    ASSERT_TRUE(Cache.IsEnabled());
+
+    const auto Key   = SPIRVCache::ComputeGLSLKey(SHADER_TYPE_VERTEX, "void main(){}", CompilerVersion);
+    const auto SPIRV = GetTestSPIRV(1);
+
+    std::vector<uint32_t> LoadedSPIRV;
+    std::vector<Uint8>    LoadedResources;
+    EXPECT_FALSE(Cache.Load(Key, LoadedSPIRV, LoadedResources));
+    EXPECT_EQ(Cache.GetStats().Misses, 1u);
+
+    const std::vector<Uint8> Resources{1, 2, 3, 4};
+    Cache.Store(Key, SPIRV, Resources);
+
+    EXPECT_TRUE(Cache.Load(Key, LoadedSPIRV, LoadedResources));
+    EXPECT_EQ(LoadedSPIRV, SPIRV);
+    EXPECT_EQ(LoadedResources, Resources);
+
+    const auto Stats = Cache.GetStats();
+    EXPECT_EQ(Stats.MemoryHits, 1u);
+    EXPECT_EQ(Stats.DiskHits, 0u);
+    EXPECT_EQ(Stats.Misses, 1u);
+}
+
+TEST(SPIRVCacheTest, DiskHit)
+{
+    ScopedTempDirectory TempDir{TempDirPrefix};
+    ASSERT_FALSE(TempDir.GetPath().empty());
+    const auto* CacheDirectory = TempDir.GetPath().c_str();
+
+    const auto Key       = SPIRVCache::ComputeGLSLKey(SHADER_TYPE_PIXEL, "void main(){}", CompilerVersion);
+    const auto SPIRV     = GetTestSPIRV(2);
+    const auto EntryPath = SPIRVCache{CacheDirectory}.GetEntryPath(Key);
+
+    {
+        SPIRVCache Cache{CacheDirectory};
+        Cache.Store(Key, SPIRV, {});
+    }
+    ASSERT_TRUE(FileSystem::FileExists(EntryPath.c_str()));
+
+    // New cache instance emulates the next run of the application
+    SPIRVCache Cache{CacheDirectory};
+
+    std::vector<uint32_t> LoadedSPIRV;
+    std::vector<Uint8>    LoadedResources;
+    EXPECT_TRUE(Cache.Load(Key, LoadedSPIRV, LoadedResources));
+    EXPECT_EQ(LoadedSPIRV, SPIRV);
+    EXPECT_TRUE(LoadedResources.empty());
+    EXPECT_EQ(Cache.GetStats().DiskHits, 1u);
+
+    // The entry loaded from disk is kept in memory
+    EXPECT_TRUE(Cache.Load(Key, LoadedSPIRV, LoadedResources));
+    EXPECT_EQ(Cache.GetStats().MemoryHits, 1u);
+
+    // Serialized resources added to the existing entry replace it on disk
+    const std::vector<Uint8> Resources{5, 6, 7};
+    Cache.Store(Key, SPIRV, Resources);
+    {
+        SPIRVCache Cache2{CacheDirectory};
+        EXPECT_TRUE(Cache2.Load(Key, LoadedSPIRV, LoadedResources));
+        EXPECT_EQ(LoadedResources, Resources);
+        EXPECT_EQ(Cache2.GetStats().DiskHits, 1u);
+    }
+}
+
+TEST(SPIRVCacheTest, DependencyChangeMiss)
+{
+    ScopedTempDirectory TempDir{TempDirPrefix};
+    ASSERT_FALSE(TempDir.GetPath().empty());
+    const auto* CacheDirectory = TempDir.GetPath().c_str();
+
+    auto* pEnv = TestingEnvironment::GetInstance();
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pEnv->GetDevice()->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(CacheDirectory, &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source                     = ShaderSourceHLSL;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+
+    WriteFile(TempDir.GetFilePath(IncludeFileName).c_str(), "#define VALUE 1\n");
+    const auto Key1 = SPIRVCache::ComputeHLSLKey(ShaderCI, CompilerVersion);
+    EXPECT_EQ(SPIRVCache::ComputeHLSLKey(ShaderCI, CompilerVersion), Key1);
+
+    SPIRVCache Cache{CacheDirectory};
+    Cache.Store(Key1, GetTestSPIRV(3), {});
+
+    // Changing the included file must change the key, so the stale entry is not found
+    WriteFile(TempDir.GetFilePath(IncludeFileName).c_str(), "#define VALUE 2\n");
+    const auto Key2 = SPIRVCache::ComputeHLSLKey(ShaderCI, CompilerVersion);
+    EXPECT_FALSE(Key2 == Key1);
+
+    std::vector<uint32_t> LoadedSPIRV;
+    std::vector<Uint8>    LoadedResources;
+    EXPECT_FALSE(Cache.Load(Key2, LoadedSPIRV, LoadedResources));
+    EXPECT_EQ(Cache.GetStats().Misses, 1u);
+
+    // Macros are also part of the key
+    ShaderMacro Macros[] = {{"MACRO", "1"}, {nullptr, nullptr}};
+    ShaderCI.Macros      = Macros;
+    EXPECT_FALSE(SPIRVCache::ComputeHLSLKey(ShaderCI, CompilerVersion) == Key2);
+}
+
+TEST(SPIRVCacheTest, CorruptFile)
+{
+    ScopedTempDirectory TempDir{TempDirPrefix};
+    ASSERT_FALSE(TempDir.GetPath().empty());
+    const auto* CacheDirectory = TempDir.GetPath().c_str();
+
+    const auto Key       = SPIRVCache::ComputeGLSLKey(SHADER_TYPE_GEOMETRY, "void main(){}", CompilerVersion);
+    const auto SPIRV     = GetTestSPIRV(4);
+    const auto EntryPath = SPIRVCache{CacheDirectory}.GetEntryPath(Key);
+
+    {
+        SPIRVCache Cache{CacheDirectory};
+        Cache.Store(Key, SPIRV, {});
+    }
+
+    // Flip one byte of the byte code
+    std::vector<Uint8> FileData;
+    {
+        FileWrapper File{EntryPath.c_str(), EFileAccessMode::Read};
+        ASSERT_TRUE(File != nullptr);
+        FileData.resize(File->GetSize());
+        ASSERT_TRUE(File->Read(FileData.data(), FileData.size()));
+    }
+    FileData.back() ^= 0xFF;
+    WriteFile(EntryPath.c_str(), std::string{FileData.begin(), FileData.end()});
+
+    SPIRVCache Cache{CacheDirectory};
+
+    std::vector<uint32_t> LoadedSPIRV;
+    std::vector<Uint8>    LoadedResources;
+    EXPECT_FALSE(Cache.Load(Key, LoadedSPIRV, LoadedResources));
+    EXPECT_TRUE(LoadedSPIRV.empty());
+    EXPECT_EQ(Cache.GetStats().Misses, 1u);
+    // Corrupted entry is removed
+    EXPECT_FALSE(FileSystem::FileExists(EntryPath.c_str()));
+
+    // Truncated entry is rejected as well
+    {
+        SPIRVCache Cache2{CacheDirectory};
+        Cache2.Store(Key, SPIRV, {});
+    }
+    WriteFile(EntryPath.c_str(), "DSPV");
+    EXPECT_FALSE(Cache.Load(Key, LoadedSPIRV, LoadedResources));
+    EXPECT_FALSE(FileSystem::FileExists(EntryPath.c_str()));
+}
+
+} // namespace
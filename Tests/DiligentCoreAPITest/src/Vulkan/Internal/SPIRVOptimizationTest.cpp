@@ -0,0 +1,222 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "SPIRVUtils.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "spirv-tools/libspirv.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// The shader is compiled without optimizations by glslang, so it contains a function call,
+// redundant local variables and an unused value that the optimizer can remove.
+constexpr char OptimizationTestCS[] = R"(
+#version 450
+layout(local_size_x = 1) in;
+layout(std430, binding = 0) buffer Data { float Values[]; } g_Data;
+
+float Scale(float Value, float Factor)
+{
+    float Result = Value;
+    Result = Result * Factor;
+    return Result;
+}
+
+void main()
+{
+    uint  Idx    = gl_GlobalInvocationID.x;
+    float A      = Scale(g_Data.Values[Idx], 2.0);
+    float B      = Scale(A, 0.5);
+    float Unused = B * 3.0;
+    g_Data.Values[Idx] = B;
+}
+)";
+
+// SPIR-V opcodes of the debug instructions
+constexpr Uint32 OpSource     = 3;
+constexpr Uint32 OpName       = 5;
+constexpr Uint32 OpMemberName = 6;
+constexpr Uint32 OpString     = 7;
+constexpr Uint32 OpLine       = 8;
+constexpr Uint32 OpLabel      = 248;
+
+constexpr size_t SPIRVHeaderSize = 5;
+constexpr size_t SPIRVBoundIndex = 3;
+
+bool IsGlslangAvailable()
+{
+    // glslang is initialized by the Vulkan instance
+    return TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().DevType == RENDER_DEVICE_TYPE_VULKAN;
+}
+
+std::vector<unsigned int> CompileTestShader(SPIRV_OPTIMIZATION_FLAGS OptimizationFlags)
+{
+    return GLSLtoSPIRV(SHADER_TYPE_COMPUTE, OptimizationTestCS, static_cast<int>(strlen(OptimizationTestCS)), nullptr, OptimizationFlags);
+}
+
+// Returns the offsets of all instructions with the given opcode
+std::vector<size_t> FindInstructions(const std::vector<unsigned int>& SPIRV, Uint32 Opcode)
+{
+    std::vector<size_t> Offsets;
+    for (size_t Offset = SPIRVHeaderSize; Offset < SPIRV.size();)
+    {
+        const auto WordCount = SPIRV[Offset] >> 16;
+        if (WordCount == 0)
+            break;
+        if ((SPIRV[Offset] & 0xFFFF) == Opcode)
+            Offsets.push_back(Offset);
+        Offset += WordCount;
+    }
+    return Offsets;
+}
+
+size_t CountInstructions(const std::vector<unsigned int>& SPIRV, Uint32 Opcode)
+{
+    return FindInstructions(SPIRV, Opcode).size();
+}
+
+// Runs SPIR-V validator and returns the error messages, or an empty string if the byte code is valid
+std::string ValidateSPIRV(const std::vector<unsigned int>& SPIRV)
+{
+    std::string Errors;
+
+    spvtools::SpirvTools Tools{SPV_ENV_VULKAN_1_0};
+    Tools.SetMessageConsumer([&Errors](spv_message_level_t, const char*, const spv_position_t&, const char* Message) {
+        Errors += Message;
+        Errors += '\n';
+    });
+    if (!Tools.Validate(SPIRV.data(), SPIRV.size()) && Errors.empty())
+        Errors = "Unknown validation error";
+
+    return Errors;
+}
+
+// glslang does not emit line information, so the test adds an OpString with the
+// file name and an OpLine at the beginning of the first block.
+void AddLineInfo(std::vector<unsigned int>& SPIRV)
+{
+    const auto FileId = SPIRV[SPIRVBoundIndex]++;
+
+    // The file name is a null-terminated string padded to the word boundary
+    constexpr char            FileName[] = "SPIRVOptimizationTest.glsl";
+    std::vector<unsigned int> StringInstr(2 + (sizeof(FileName) + 3) / 4);
+    StringInstr[0] = static_cast<unsigned int>(StringInstr.size() << 16) | OpString;
+    StringInstr[1] = FileId;
+    memcpy(&StringInstr[2], FileName, sizeof(FileName));
+
+    const unsigned int LineInstr[] = {(4u << 16) | OpLine, FileId, 10, 1};
+
+    // The line instruction is inserted first as inserting the string shifts the following offsets
+    const auto Labels = FindInstructions(SPIRV, OpLabel);
+    ASSERT_FALSE(Labels.empty());
+    const auto LabelEnd = Labels[0] + (SPIRV[Labels[0]] >> 16);
+    SPIRV.insert(SPIRV.begin() + LabelEnd, std::begin(LineInstr), std::end(LineInstr));
+
+    // OpString must precede OpName and OpMemberName in the debug section
+    const auto Names = FindInstructions(SPIRV, OpName);
+    ASSERT_FALSE(Names.empty());
+    SPIRV.insert(SPIRV.begin() + Names[0], StringInstr.begin(), StringInstr.end());
+}
+
+TEST(SPIRVOptimizationTest, InstructionCount)
+{
+    if (!IsGlslangAvailable())
+        GTEST_SKIP() << "glslang is only initialized by Vulkan backend";
+
+    const auto Unoptimized = CompileTestShader(SPIRV_OPTIMIZATION_FLAG_NONE);
+    ASSERT_FALSE(Unoptimized.empty());
+    EXPECT_EQ(ValidateSPIRV(Unoptimized), "");
+
+    const auto NumInstructions = GetSPIRVInstructionCount(Unoptimized);
+    EXPECT_GT(NumInstructions, size_t{0});
+
+    for (auto Flags : {SPIRV_OPTIMIZATION_FLAG_PERFORMANCE, SPIRV_OPTIMIZATION_FLAG_SIZE})
+    {
+        const auto Optimized = CompileTestShader(Flags);
+        ASSERT_FALSE(Optimized.empty()) << "Optimization flags: " << Uint32{Flags};
+        EXPECT_LT(GetSPIRVInstructionCount(Optimized), NumInstructions) << "Optimization flags: " << Uint32{Flags};
+        EXPECT_EQ(ValidateSPIRV(Optimized), "") << "Optimization flags: " << Uint32{Flags};
+    }
+}
+
+TEST(SPIRVOptimizationTest, CompilerOutput)
+{
+    if (!IsGlslangAvailable())
+        GTEST_SKIP() << "glslang is only initialized by Vulkan backend";
+
+    RefCntAutoPtr<IDataBlob> pOutput;
+    const auto               SPIRV = GLSLtoSPIRV(SHADER_TYPE_COMPUTE, OptimizationTestCS, static_cast<int>(strlen(OptimizationTestCS)), &pOutput, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    ASSERT_FALSE(SPIRV.empty());
+    ASSERT_NE(pOutput, nullptr);
+
+    const std::string Output{static_cast<const char*>(pOutput->GetDataPtr()), pOutput->GetSize()};
+    EXPECT_NE(Output.find("SPIR-V instruction count: "), std::string::npos) << Output;
+    EXPECT_NE(Output.find(std::to_string(GetSPIRVInstructionCount(SPIRV)) + " after optimization"), std::string::npos) << Output;
+}
+
+TEST(SPIRVOptimizationTest, StripDebugInfo)
+{
+    if (!IsGlslangAvailable())
+        GTEST_SKIP() << "glslang is only initialized by Vulkan backend";
+
+    auto SPIRV = CompileTestShader(SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    ASSERT_FALSE(SPIRV.empty());
+    AddLineInfo(SPIRV);
+    ASSERT_EQ(ValidateSPIRV(SPIRV), "");
+
+    const auto NumNames = CountInstructions(SPIRV, OpName);
+    EXPECT_GT(NumNames, size_t{0});
+    EXPECT_EQ(CountInstructions(SPIRV, OpLine), size_t{1});
+
+    // Names are required for reflection and must be kept unless requested otherwise
+    const auto Kept = StripReflection(SPIRV, false);
+    ASSERT_FALSE(Kept.empty());
+    EXPECT_EQ(CountInstructions(Kept, OpName), NumNames);
+    EXPECT_EQ(CountInstructions(Kept, OpLine), size_t{1});
+
+    const auto Stripped = StripReflection(SPIRV, true);
+    ASSERT_FALSE(Stripped.empty());
+    EXPECT_EQ(ValidateSPIRV(Stripped), "");
+    for (auto Opcode : {OpSource, OpName, OpMemberName, OpString, OpLine})
+        EXPECT_EQ(CountInstructions(Stripped, Opcode), size_t{0}) << "Opcode " << Opcode;
+    EXPECT_LT(Stripped.size(), SPIRV.size());
+}
+
+} // namespace
@@ -0,0 +1,237 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+#include <thread>
+
+#include "vulkan/vulkan.h"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "SPIRVUtils.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr char ComputeShader0[] = R"(
+#version 450
+layout(local_size_x = 1) in;
+layout(std430, binding = 0) buffer Data { uint Values[]; } g_Data;
+void main()
+{
+    g_Data.Values[gl_GlobalInvocationID.x] = 1u;
+}
+)";
+
+constexpr char ComputeShader1[] = R"(
+#version 450
+layout(local_size_x = 1) in;
+layout(std430, binding = 0) buffer Data { uint Values[]; } g_Data;
+void main()
+{
+    g_Data.Values[gl_GlobalInvocationID.x] = 2u;
+}
+)";
+
+constexpr char ComputeShaderHLSL0[] = R"(
+RWBuffer<uint> g_Data;
+[numthreads(1, 1, 1)]
+void main(uint3 ThreadId : SV_DispatchThreadID)
+{
+    g_Data[ThreadId.x] = 1;
+}
+)";
+
+constexpr char ComputeShaderHLSL1[] = R"(
+RWBuffer<uint> g_Data;
+[numthreads(1, 1, 1)]
+void main(uint3 ThreadId : SV_DispatchThreadID)
+{
+    g_Data[ThreadId.x] = 2;
+}
+)";
+
+RenderDeviceVkImpl* GetDeviceVk()
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+    if (pDevice->GetDeviceCaps().DevType != RENDER_DEVICE_TYPE_VULKAN)
+        return nullptr;
+    return ValidatedCast<RenderDeviceVkImpl>(pDevice);
+}
+
+TEST(ShaderModuleCacheTest, SharedModules)
+{
+    auto* pDeviceVk = GetDeviceVk();
+    if (pDeviceVk == nullptr)
+        GTEST_SKIP() << "Shader module cache is only used by Vulkan backend";
+
+    const auto SPIRV0 = GLSLtoSPIRV(SHADER_TYPE_COMPUTE, ComputeShader0, static_cast<int>(strlen(ComputeShader0)), nullptr);
+    const auto SPIRV1 = GLSLtoSPIRV(SHADER_TYPE_COMPUTE, ComputeShader1, static_cast<int>(strlen(ComputeShader1)), nullptr);
+    ASSERT_FALSE(SPIRV0.empty());
+    ASSERT_FALSE(SPIRV1.empty());
+    ASSERT_NE(SPIRV0, SPIRV1);
+
+    constexpr Uint64 CommandQueueMask = 1;
+
+    auto&      Cache       = pDeviceVk->GetShaderModuleCache();
+    const auto NumModules0 = Cache.GetNumModules();
+
+    auto vkModule0 = Cache.GetShaderModule(SPIRV0, "ShaderModuleCacheTest 0");
+    ASSERT_TRUE(vkModule0 != VK_NULL_HANDLE);
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 1);
+
+    // Same byte code in a different buffer must return the same module
+    const auto SPIRV0Copy = SPIRV0;
+    auto       vkModule1  = Cache.GetShaderModule(SPIRV0Copy, "ShaderModuleCacheTest 0 copy");
+    EXPECT_EQ(vkModule1, vkModule0);
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 1);
+
+    auto vkModule2 = Cache.GetShaderModule(SPIRV1, "ShaderModuleCacheTest 1");
+    ASSERT_TRUE(vkModule2 != VK_NULL_HANDLE);
+    EXPECT_NE(vkModule2, vkModule0);
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 2);
+
+    // The module is kept while it is referenced
+    Cache.Release(vkModule0, CommandQueueMask);
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 2);
+    EXPECT_EQ(Cache.GetShaderModule(SPIRV0, "ShaderModuleCacheTest 0"), vkModule1);
+    Cache.Release(vkModule1, CommandQueueMask);
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 2);
+
+    Cache.Release(vkModule1, CommandQueueMask);
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 1);
+    Cache.Release(vkModule2, CommandQueueMask);
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0);
+}
+
+// Modules are created outside of the cache lock. When several threads request the same byte code
+// at the same time, all of them must end up with the module that was inserted into the cache first.
+TEST(ShaderModuleCacheTest, ConcurrentRequests)
+{
+    auto* pDeviceVk = GetDeviceVk();
+    if (pDeviceVk == nullptr)
+        GTEST_SKIP() << "Shader module cache is only used by Vulkan backend";
+
+    const auto SPIRV = GLSLtoSPIRV(SHADER_TYPE_COMPUTE, ComputeShader0, static_cast<int>(strlen(ComputeShader0)), nullptr);
+    ASSERT_FALSE(SPIRV.empty());
+
+    constexpr Uint64 CommandQueueMask = 1;
+
+    auto&      Cache       = pDeviceVk->GetShaderModuleCache();
+    const auto NumModules0 = Cache.GetNumModules();
+
+    constexpr size_t            NumThreads = 8;
+    std::vector<VkShaderModule> Modules(NumThreads, VK_NULL_HANDLE);
+    std::vector<std::thread>    Threads;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&, t]() //
+            {
+                // Every thread uses its own copy of the byte code
+                const auto SPIRVCopy = SPIRV;
+                Modules[t]           = Cache.GetShaderModule(SPIRVCopy, "ShaderModuleCacheTest concurrent");
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 1);
+    for (auto vkModule : Modules)
+        EXPECT_EQ(vkModule, Modules[0]);
+
+    for (auto vkModule : Modules)
+        Cache.Release(vkModule, CommandQueueMask);
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0);
+}
+
+TEST(ShaderModuleCacheTest, SharedBetweenPipelines)
+{
+    auto* pDeviceVk = GetDeviceVk();
+    if (pDeviceVk == nullptr)
+        GTEST_SKIP() << "Shader module cache is only used by Vulkan backend";
+    if (!pDeviceVk->GetDeviceCaps().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    auto&      Cache       = pDeviceVk->GetShaderModuleCache();
+    const auto NumModules0 = Cache.GetNumModules();
+
+    auto CreateCS = [&](const char* Source) {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+        ShaderCI.EntryPoint                 = "main";
+        ShaderCI.Desc.Name                  = "Shader module cache test";
+        ShaderCI.Source                     = Source;
+        RefCntAutoPtr<IShader> pCS;
+        pDeviceVk->CreateShader(ShaderCI, &pCS);
+        return pCS;
+    };
+    auto pCS0 = CreateCS(ComputeShaderHLSL0);
+    auto pCS1 = CreateCS(ComputeShaderHLSL1);
+    ASSERT_NE(pCS0, nullptr);
+    ASSERT_NE(pCS1, nullptr);
+
+    auto CreatePSO = [&](const char* Name, IShader* pCS) {
+        PipelineStateDesc PSODesc;
+        PSODesc.Name                = Name;
+        PSODesc.IsComputePipeline   = true;
+        PSODesc.ComputePipeline.pCS = pCS;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDeviceVk->CreatePipelineState(PSODesc, &pPSO);
+        return pPSO;
+    };
+
+    {
+        // Pipelines with the same shader and resource layout share the module
+        auto pPSO0 = CreatePSO("Shader module cache test 0", pCS0);
+        auto pPSO1 = CreatePSO("Shader module cache test 1", pCS0);
+        ASSERT_NE(pPSO0, nullptr);
+        ASSERT_NE(pPSO1, nullptr);
+        EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 1);
+
+        auto pPSO2 = CreatePSO("Shader module cache test 2", pCS1);
+        ASSERT_NE(pPSO2, nullptr);
+        EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 2);
+
+        pPSO0.Release();
+        EXPECT_EQ(Cache.GetNumModules(), NumModules0 + 2);
+    }
+    EXPECT_EQ(Cache.GetNumModules(), NumModules0);
+}
+
+} // namespace
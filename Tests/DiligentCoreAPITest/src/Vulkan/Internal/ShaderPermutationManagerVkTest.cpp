@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "vulkan/vulkan.h"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "ShaderPermutationManager.hpp"
+#include "TestingEnvironment.hpp"
+#include "Vulkan/InternalTestUtilsVk.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr char ShaderSource[] = R"(
+float4 main() : SV_Target
+{
+    return float4(float(USE_FOG), float(LIGHT_MODEL), 0.0, 1.0);
+}
+)";
+
+// Permutations are compiled through IRenderDevice::CreateShader() and must
+// hit the device's SPIR-V cache when they are compiled again
+TEST(ShaderPermutationManagerVkTest, SPIRVCacheHit)
+{
+    if (TestingEnvironment::GetInstance()->GetDevice()->GetDeviceCaps().DevType != RENDER_DEVICE_TYPE_VULKAN)
+        GTEST_SKIP() << "SPIR-V cache is only used by Vulkan backend";
+
+    // The cache is disabled in the testing environment, so the test uses its own device
+    // that keeps the cache in a temporary directory
+    ScopedTempDirectory TempDir{"ShaderPermutationManagerVkTest"};
+    ASSERT_FALSE(TempDir.GetPath().empty());
+
+    EngineVkCreateInfo EngineCI;
+    EngineCI.SPIRVCacheDirectory = TempDir.GetPath().c_str();
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    CreateTestDeviceVk(EngineCI, pDevice, pContext);
+    ASSERT_NE(pDevice, nullptr);
+
+    auto& Cache = ValidatedCast<RenderDeviceVkImpl>(pDevice.RawPtr())->GetSPIRVCache();
+    ASSERT_TRUE(Cache.IsEnabled());
+
+    ShaderPermutationManager::CreateInfo CI;
+    CI.pDevice                             = pDevice;
+    CI.ShaderCI.Source                     = ShaderSource;
+    CI.ShaderCI.EntryPoint                 = "main";
+    CI.ShaderCI.Desc.ShaderType            = SHADER_TYPE_PIXEL;
+    CI.ShaderCI.Desc.Name                  = "Shader permutation manager cache test";
+    CI.ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    CI.ShaderCI.UseCombinedTextureSamplers = true;
+
+    auto GetPermutation = [&](Uint32 LightModel) {
+        ShaderPermutationManager Manager{CI};
+        const auto               UseFogKey     = Manager.AddBoolKey("USE_FOG");
+        const auto               LightModelKey = Manager.AddEnumKey("LIGHT_MODEL", 3);
+        const auto               Id            = Manager.SetKeyValue(Manager.SetKeyValue(0, UseFogKey, 1), LightModelKey, LightModel);
+        return Manager.GetPermutation(Id);
+    };
+
+    // The cache directory is empty, so the first permutation is compiled
+    ASSERT_NE(GetPermutation(2), nullptr);
+    const auto Stats0 = Cache.GetStats();
+    EXPECT_EQ(Stats0.Misses, 1u);
+
+    // A new manager compiles the same permutation again, which must be served by the cache
+    ASSERT_NE(GetPermutation(2), nullptr);
+    const auto Stats1 = Cache.GetStats();
+    EXPECT_EQ(Stats1.MemoryHits + Stats1.DiskHits, Stats0.MemoryHits + Stats0.DiskHits + 1);
+    EXPECT_EQ(Stats1.Misses, Stats0.Misses);
+
+    // A different permutation has a different key
+    ASSERT_NE(GetPermutation(1), nullptr);
+    const auto Stats2 = Cache.GetStats();
+    EXPECT_EQ(Stats2.MemoryHits + Stats2.DiskHits + Stats2.Misses, Stats1.MemoryHits + Stats1.DiskHits + Stats1.Misses + 1);
+}
+
+} // namespace
@@ -43,8 +43,12 @@ int TestPipelineStateCInterface(struct IPipelineState* pPSO)
     Uint32 StaticVarCount = 0;
     bool   IsComptible    = false;
 
-    IShaderResourceVariable* pVar = NULL;
-    IShaderResourceBinding*  pSRB = NULL;
+    IShaderResourceVariable* pVar     = NULL;
+    IShaderResourceBinding*  pSRB     = NULL;
+    IShaderResourceBinding*  pSRBs[2] = {NULL, NULL};
+    Uint32                   i        = 0;
+
+    PIPELINE_STATE_STATUS Status = PIPELINE_STATE_STATUS_FAILED;
 
     int num_errors =
         TestObjectCInterface((struct IObject*)pPSO) +
@@ -95,10 +99,23 @@ int TestPipelineStateCInterface(struct IPipelineState* pPSO)
     else
         ++num_errors;
 
+    IPipelineState_CreateShaderResourceBindings(pPSO, 2, pSRBs, false);
+    for (i = 0; i < 2; ++i)
+    {
+        if (pSRBs[i] != NULL)
+            IObject_Release(pSRBs[i]);
+        else
+            ++num_errors;
+    }
+
     IsComptible = IPipelineState_IsCompatibleWith(pPSO, pPSO);
     if (!IsComptible)
         ++num_errors;
 
+    Status = IPipelineState_GetStatus(pPSO);
+    if (Status != PIPELINE_STATE_STATUS_READY)
+        ++num_errors;
+
     return num_errors;
 }
 
@@ -116,7 +116,10 @@ int TestRenderDeviceCInterface_CreateShader(struct IRenderDevice* pRenderDevice)
 {
     static const char*      ShaderSource = "float4 main() : SV_Target {return float4(0.0, 0.0, 0.0, 0.0);}";
     struct ShaderCreateInfo ShaderCI;
-    struct IShader*         pShader = NULL;
+    struct ShaderCreateInfo ShaderCIs[2];
+    struct IShader*         pShader     = NULL;
+    struct IShader*         pShaders[2] = {NULL, NULL};
+    int                     i           = 0;
 
     int num_errors = 0;
 
@@ -135,6 +138,17 @@ int TestRenderDeviceCInterface_CreateShader(struct IRenderDevice* pRenderDevice)
     else
         ++num_errors;
 
+    ShaderCIs[0] = ShaderCI;
+    ShaderCIs[1] = ShaderCI;
+    IRenderDevice_CreateShaders(pRenderDevice, ShaderCIs, 2, pShaders);
+    for (i = 0; i < 2; ++i)
+    {
+        if (pShaders[i] != NULL)
+            IObject_Release(pShaders[i]);
+        else
+            ++num_errors;
+    }
+
     return num_errors;
 }
 
@@ -239,6 +253,13 @@ int TestRenderDeviceCInterface_CreatePipelineState(struct IRenderDevice* pRender
     else
         ++num_errors;
 
+    pPSO = NULL;
+    IRenderDevice_CreatePipelineStateAsync(pRenderDevice, pPSODesc, NULL, &pPSO);
+    if (pPSO != NULL)
+        IObject_Release(pPSO);
+    else
+        ++num_errors;
+
     return num_errors;
 }
 
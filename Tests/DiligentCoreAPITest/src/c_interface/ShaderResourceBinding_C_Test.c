@@ -63,6 +63,11 @@ int TestShaderResourceBindingCInterface(struct IShaderResourceBinding* pSRB)
     if (pVar == NULL)
         ++num_errors;
 
+    // Hash of a name that does not match any variable
+    pVar = IShaderResourceBinding_GetVariableByHash(pSRB, SHADER_TYPE_VERTEX, 0);
+    if (pVar != NULL)
+        ++num_errors;
+
     VarCount = IShaderResourceBinding_GetVariableCount(pSRB, SHADER_TYPE_VERTEX);
     if (VarCount == 0)
         ++num_errors;
@@ -80,4 +85,5 @@ void TestShaderResourceBindingC_API(struct IShaderResourceBinding* pSRB)
 {
     struct IResourceMapping* pResMapping = NULL;
     IShaderResourceBinding_BindResources(pSRB, SHADER_TYPE_VERTEX, pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
+    IShaderResourceBinding_SetVariables(pSRB, (const ResourceBindDesc*)NULL, 0);
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "HashUtils.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_HashUtils, ComputeFNV1aHash)
+{
+    // Reference values of the 64-bit FNV-1a hash
+    EXPECT_EQ(ComputeFNV1aHash("", 0), 0xcbf29ce484222325ull);
+    EXPECT_EQ(ComputeFNV1aHash("a", 1), 0xaf63dc4c8601ec8cull);
+    EXPECT_EQ(ComputeFNV1aHash("foobar", 6), 0x85944171f73967e8ull);
+
+    // Hashing in parts produces the same result
+    EXPECT_EQ(ComputeFNV1aHash("bar", 3, ComputeFNV1aHash("foo", 3)), ComputeFNV1aHash("foobar", 6));
+}
+
+TEST(Common_HashUtils, StableHasher)
+{
+    {
+        StableHasher Hasher;
+        Hasher.Update("foobar", 6);
+        // The first lane is plain FNV-1a
+        EXPECT_EQ(Hasher.GetHash0(), ComputeFNV1aHash("foobar", 6));
+        EXPECT_NE(Hasher.GetHash1(), Hasher.GetHash0());
+    }
+
+    {
+        // Strings are prefixed with their length
+        StableHasher Hasher0;
+        Hasher0.UpdateStr("ab");
+        Hasher0.UpdateStr("c");
+
+        StableHasher Hasher1;
+        Hasher1.UpdateStr("a");
+        Hasher1.UpdateStr("bc");
+
+        EXPECT_NE(Hasher0.GetHash0(), Hasher1.GetHash0());
+        EXPECT_NE(Hasher0.GetHash1(), Hasher1.GetHash1());
+    }
+
+    {
+        // Null string is hashed as an empty string
+        StableHasher Hasher0;
+        Hasher0.UpdateStr(nullptr);
+
+        StableHasher Hasher1;
+        Hasher1.UpdateStr("");
+
+        EXPECT_EQ(Hasher0.GetHash0(), Hasher1.GetHash0());
+        EXPECT_EQ(Hasher0.GetHash1(), Hasher1.GetHash1());
+    }
+}
+
+} // namespace
@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <string>
+#include <vector>
+
+#include "PerfectHashMap.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_PerfectHashMap, Empty)
+{
+    PerfectHashMap<int> Map;
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map.Find("abc"), nullptr);
+    EXPECT_EQ(Map.Find(""), nullptr);
+
+    PerfectHashMap<int> Map2{{}};
+    EXPECT_TRUE(Map2.empty());
+    EXPECT_EQ(Map2.Find("abc"), nullptr);
+}
+
+TEST(Common_PerfectHashMap, Find)
+{
+    std::vector<PerfectHashMap<int>::EntryType> Entries;
+    for (int i = 0; i < 1000; ++i)
+        Entries.emplace_back("Key" + std::to_string(i), i);
+    Entries.emplace_back("", -1);
+
+    PerfectHashMap<int> Map{Entries};
+    EXPECT_EQ(Map.size(), Entries.size());
+    EXPECT_GE(Map.GetSlotCount(), Map.size());
+
+    for (const auto& Entry : Entries)
+    {
+        const auto* pVal = Map.Find(Entry.first);
+        ASSERT_NE(pVal, nullptr) << Entry.first;
+        EXPECT_EQ(*pVal, Entry.second);
+    }
+
+    EXPECT_EQ(Map.Find("Key1000"), nullptr);
+    EXPECT_EQ(Map.Find("key1"), nullptr);
+    EXPECT_EQ(Map.Find("Key"), nullptr);
+    EXPECT_EQ(Map.Find("Key12345678"), nullptr);
+
+    // Substrings can be looked up without copying
+    const char* Text = "Key12;Key345";
+    ASSERT_NE(Map.Find(Text, 5), nullptr);
+    EXPECT_EQ(*Map.Find(Text, 5), 12);
+    ASSERT_NE(Map.Find(Text + 6, 6), nullptr);
+    EXPECT_EQ(*Map.Find(Text + 6, 6), 345);
+}
+
+TEST(Common_PerfectHashMap, FindByHash)
+{
+    std::vector<PerfectHashMap<int>::EntryType> Entries;
+    for (int i = 0; i < 100; ++i)
+        Entries.emplace_back("Var" + std::to_string(i), i);
+
+    PerfectHashMap<int> Map{Entries};
+    for (const auto& Entry : Entries)
+    {
+        const auto  Hash = PerfectHashMap<int>::ComputeKeyHash(Entry.first.c_str(), Entry.first.length());
+        const auto* pVal = Map.FindByHash(Hash);
+        ASSERT_NE(pVal, nullptr) << Entry.first;
+        EXPECT_EQ(*pVal, Entry.second);
+        EXPECT_EQ(pVal, Map.Find(Entry.first));
+    }
+
+    EXPECT_EQ(Map.FindByHash(PerfectHashMap<int>::ComputeKeyHash("Var100", 6)), nullptr);
+    EXPECT_EQ(PerfectHashMap<int>{}.FindByHash(0), nullptr);
+}
+
+TEST(Common_PerfectHashMap, DuplicateKeys)
+{
+    std::vector<PerfectHashMap<int>::EntryType> Entries{{"a", 0}, {"b", 1}, {"a", 2}};
+    EXPECT_THROW(PerfectHashMap<int>{Entries}, std::runtime_error);
+}
+
+TEST(Common_PerfectHashSet, Contains)
+{
+    PerfectHashSet Set{{"image1D", "image2D", "uimage2D"}};
+    EXPECT_EQ(Set.size(), size_t{3});
+    EXPECT_TRUE(Set.Contains("image1D"));
+    EXPECT_TRUE(Set.Contains(String{"uimage2D"}));
+    EXPECT_TRUE(Set.Contains("image2DArray", 7));
+    EXPECT_FALSE(Set.Contains("image2DArray"));
+    EXPECT_FALSE(Set.Contains(""));
+
+    PerfectHashSet EmptySet;
+    EXPECT_TRUE(EmptySet.empty());
+    EXPECT_FALSE(EmptySet.Contains("image1D"));
+}
+
+} // namespace
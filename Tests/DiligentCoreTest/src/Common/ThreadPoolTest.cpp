@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_ThreadPool, ExecuteTasks)
+{
+    ThreadPool Pool{4};
+    EXPECT_EQ(Pool.GetNumThreads(), size_t{4});
+
+    std::atomic_int Counter{0};
+
+    std::vector<std::future<void>> Futures;
+    for (int i = 0; i < 100; ++i)
+        Futures.emplace_back(Pool.EnqueueTask([&Counter]() { ++Counter; }));
+
+    for (auto& Future : Futures)
+        Future.wait();
+    EXPECT_EQ(Counter, 100);
+
+    for (int i = 0; i < 100; ++i)
+        Pool.EnqueueTask([&Counter]() { ++Counter; });
+    Pool.WaitForAllTasks();
+    EXPECT_EQ(Counter, 200);
+    EXPECT_EQ(Pool.GetNumPendingTasks(), size_t{0});
+}
+
+TEST(Common_ThreadPool, Exception)
+{
+    ThreadPool Pool{1};
+
+    auto Future = Pool.EnqueueTask([]() { throw std::runtime_error("Test"); });
+    EXPECT_THROW(Future.get(), std::runtime_error);
+
+    // The pool must still be operational
+    bool Executed = false;
+    Pool.EnqueueTask([&Executed]() { Executed = true; }).wait();
+    EXPECT_TRUE(Executed);
+}
+
+TEST(Common_ThreadPool, DestroyWithPendingTasks)
+{
+    std::atomic_int Counter{0};
+    {
+        ThreadPool Pool{2};
+        for (int i = 0; i < 50; ++i)
+            Pool.EnqueueTask([&Counter]() { ++Counter; });
+    }
+    // All tasks must be executed before the pool is destroyed
+    EXPECT_EQ(Counter, 50);
+}
+
+TEST(Common_ThreadPool, IsWorkerThread)
+{
+    ThreadPool Pool{2};
+    EXPECT_FALSE(Pool.IsWorkerThread());
+
+    bool IsWorkerThread = false;
+    Pool.EnqueueTask([&]() { IsWorkerThread = Pool.IsWorkerThread(); }).wait();
+    EXPECT_TRUE(IsWorkerThread);
+}
+
+TEST(Common_ThreadPool, DestroyFromTask)
+{
+    std::promise<void> PoolDestroyed;
+    std::promise<void> ReleasePool;
+
+    std::shared_ptr<ThreadPool> pPool{
+        new ThreadPool{2},
+        [&PoolDestroyed](ThreadPool* pPool) {
+            delete pPool;
+            PoolDestroyed.set_value();
+        } //
+    };
+
+    auto ReleaseFuture = ReleasePool.get_future().share();
+    pPool->EnqueueTask([pPool, ReleaseFuture]() { ReleaseFuture.wait(); });
+
+    // The task now holds the last reference to the pool and destroys it on the worker thread
+    pPool.reset();
+    ReleasePool.set_value();
+
+    EXPECT_EQ(PoolDestroyed.get_future().wait_for(std::chrono::seconds{10}), std::future_status::ready);
+}
+
+} // namespace
@@ -0,0 +1,257 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "SPIRVShaderResources.hpp"
+#include "SPIRVUtils.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class SPIRVShaderResourcesTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        InitializeGlslang();
+    }
+
+    static void TearDownTestSuite()
+    {
+        FinalizeGlslang();
+    }
+};
+
+// The shader declares every resource type that can be serialized, an array
+// of separate images with an assigned sampler and a separate sampler without a texture.
+static const char* const TestShaderSource = R"(
+cbuffer Constants
+{
+    float4 g_Scale;
+};
+
+struct BufferData
+{
+    float4 Value;
+};
+
+StructuredBuffer<BufferData>   g_ROBuffer;
+RWStructuredBuffer<BufferData> g_RWBuffers[2];
+
+Buffer<float4>   g_UniformTexelBuffer;
+RWBuffer<float4> g_StorageTexelBuffer;
+
+RWTexture2D<float4> g_RWTex;
+
+Texture2D    g_Tex;
+SamplerState g_Tex_sampler;
+
+Texture2D    g_TexArr[3];
+SamplerState g_TexArr_sampler;
+
+Texture2D    g_TexNoSampler;
+SamplerState g_StandaloneSampler;
+
+struct VSInput
+{
+    float4 Pos : ATTRIB0;
+    float2 UV  : ATTRIB1;
+};
+
+float4 main(in VSInput VSIn) : SV_Position
+{
+    float4 Val = g_Scale * VSIn.Pos;
+    Val += g_ROBuffer[0].Value;
+    Val += g_UniformTexelBuffer.Load(0);
+    Val += g_Tex.SampleLevel(g_Tex_sampler, VSIn.UV, 0.0);
+    Val += g_TexArr[0].SampleLevel(g_TexArr_sampler, VSIn.UV, 0.0);
+    Val += g_TexArr[2].SampleLevel(g_TexArr_sampler, VSIn.UV, 0.0);
+    Val += g_TexNoSampler.SampleLevel(g_StandaloneSampler, VSIn.UV, 0.0);
+    g_RWBuffers[1][0].Value = Val;
+    g_StorageTexelBuffer[0] = Val;
+    g_RWTex[uint2(0, 0)]    = Val;
+    return Val;
+}
+)";
+
+std::vector<uint32_t> CompileTestShader()
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source                     = TestShaderSource;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_VERTEX;
+    ShaderCI.Desc.Name                  = "SPIRVShaderResourcesTest";
+    return HLSLtoSPIRV(ShaderCI, nullptr);
+}
+
+ShaderDesc GetTestShaderDesc()
+{
+    ShaderDesc Desc;
+    Desc.ShaderType = SHADER_TYPE_VERTEX;
+    Desc.Name       = "SPIRVShaderResourcesTest";
+    return Desc;
+}
+
+void CompareResources(const SPIRVShaderResources& Ref, const SPIRVShaderResources& Res)
+{
+    EXPECT_EQ(Ref.GetShaderType(), Res.GetShaderType());
+    EXPECT_EQ(Ref.GetNumUBs(), Res.GetNumUBs());
+    EXPECT_EQ(Ref.GetNumSBs(), Res.GetNumSBs());
+    EXPECT_EQ(Ref.GetNumImgs(), Res.GetNumImgs());
+    EXPECT_EQ(Ref.GetNumSmpldImgs(), Res.GetNumSmpldImgs());
+    EXPECT_EQ(Ref.GetNumACs(), Res.GetNumACs());
+    EXPECT_EQ(Ref.GetNumSepSmplrs(), Res.GetNumSepSmplrs());
+    EXPECT_EQ(Ref.GetNumSepImgs(), Res.GetNumSepImgs());
+    ASSERT_EQ(Ref.GetTotalResources(), Res.GetTotalResources());
+    ASSERT_EQ(Ref.GetNumShaderStageInputs(), Res.GetNumShaderStageInputs());
+    EXPECT_STREQ(Ref.GetCombinedSamplerSuffix(), Res.GetCombinedSamplerSuffix());
+    EXPECT_STREQ(Ref.GetShaderName(), Res.GetShaderName());
+    EXPECT_TRUE(Ref.IsCompatibleWith(Res));
+
+    for (Uint32 r = 0; r < Ref.GetTotalResources(); ++r)
+    {
+        const auto& RefAttribs = Ref.GetResource(r);
+        const auto& Attribs    = Res.GetResource(r);
+        EXPECT_STREQ(RefAttribs.Name, Attribs.Name);
+        EXPECT_EQ(RefAttribs.ArraySize, Attribs.ArraySize) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.Type, Attribs.Type) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.BindingDecorationOffset, Attribs.BindingDecorationOffset) << RefAttribs.Name;
+        EXPECT_EQ(RefAttribs.DescriptorSetDecorationOffset, Attribs.DescriptorSetDecorationOffset) << RefAttribs.Name;
+        if (RefAttribs.Type == SPIRVShaderResourceAttribs::SeparateImage)
+            EXPECT_EQ(RefAttribs.GetAssignedSepSamplerInd(), Attribs.GetAssignedSepSamplerInd()) << RefAttribs.Name;
+        else if (RefAttribs.Type == SPIRVShaderResourceAttribs::SeparateSampler)
+            EXPECT_EQ(RefAttribs.GetAssignedSepImageInd(), Attribs.GetAssignedSepImageInd()) << RefAttribs.Name;
+    }
+
+    for (Uint32 i = 0; i < Ref.GetNumShaderStageInputs(); ++i)
+    {
+        const auto& RefInput = Ref.GetShaderStageInputAttribs(i);
+        const auto& Input    = Res.GetShaderStageInputAttribs(i);
+        EXPECT_STREQ(RefInput.Semantic, Input.Semantic);
+        EXPECT_EQ(RefInput.LocationDecorationOffset, Input.LocationDecorationOffset) << RefInput.Semantic;
+    }
+}
+
+TEST_F(SPIRVShaderResourcesTest, SerializationRoundTrip)
+{
+    auto SPIRV = CompileTestShader();
+    ASSERT_FALSE(SPIRV.empty());
+
+    auto&       Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    const auto  Desc      = GetTestShaderDesc();
+    std::string RefEntryPoint;
+
+    SPIRVShaderResources RefResources{Allocator, nullptr, SPIRV, Desc, "_sampler", true, RefEntryPoint};
+
+    // Make sure the shader exercises every resource category the format stores
+    EXPECT_GT(RefResources.GetNumUBs(), 0u);
+    EXPECT_GT(RefResources.GetNumSBs(), 0u);
+    EXPECT_GT(RefResources.GetNumImgs(), 0u);
+    EXPECT_GT(RefResources.GetNumSepSmplrs(), 0u);
+    EXPECT_GT(RefResources.GetNumSepImgs(), 0u);
+    EXPECT_EQ(RefResources.GetNumShaderStageInputs(), 2u);
+    EXPECT_TRUE(RefResources.IsUsingCombinedSamplers());
+
+    std::vector<Uint8> Data;
+    RefResources.Serialize(RefEntryPoint, Data);
+    ASSERT_FALSE(Data.empty());
+
+    std::string          EntryPoint;
+    SPIRVShaderResources Resources{Allocator, Data.data(), Data.size(), Desc, "_sampler", EntryPoint};
+    EXPECT_EQ(RefEntryPoint, EntryPoint);
+    CompareResources(RefResources, Resources);
+
+    // Serializing deserialized resources must produce identical data
+    std::vector<Uint8> Data2;
+    Resources.Serialize(EntryPoint, Data2);
+    EXPECT_EQ(Data, Data2);
+}
+
+TEST_F(SPIRVShaderResourcesTest, RejectMalformedData)
+{
+    auto SPIRV = CompileTestShader();
+    ASSERT_FALSE(SPIRV.empty());
+
+    auto&       Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    const auto  Desc      = GetTestShaderDesc();
+    std::string EntryPoint;
+
+    std::vector<Uint8> Data;
+    {
+        SPIRVShaderResources Resources{Allocator, nullptr, SPIRV, Desc, "_sampler", true, EntryPoint};
+        Resources.Serialize(EntryPoint, Data);
+    }
+    ASSERT_GT(Data.size(), 8u);
+
+    auto TryLoad = [&](const std::vector<Uint8>& Blob) {
+        std::string LoadedEntryPoint;
+        SPIRVShaderResources Resources{Allocator, Blob.data(), Blob.size(), Desc, "_sampler", LoadedEntryPoint};
+    };
+
+    EXPECT_NO_THROW(TryLoad(Data));
+
+    // Truncated data
+    EXPECT_THROW(TryLoad(std::vector<Uint8>{}), std::runtime_error);
+    EXPECT_THROW(TryLoad(std::vector<Uint8>(Data.begin(), Data.begin() + 8)), std::runtime_error);
+    EXPECT_THROW(TryLoad(std::vector<Uint8>(Data.begin(), Data.begin() + Data.size() / 2)), std::runtime_error);
+    EXPECT_THROW(TryLoad(std::vector<Uint8>(Data.begin(), Data.end() - 1)), std::runtime_error);
+
+    // Trailing garbage
+    {
+        auto Padded = Data;
+        Padded.push_back(0);
+        EXPECT_THROW(TryLoad(Padded), std::runtime_error);
+    }
+
+    // Wrong magic number (first 4 bytes of the header)
+    {
+        auto BadMagic = Data;
+        BadMagic[0] ^= 0xFF;
+        EXPECT_THROW(TryLoad(BadMagic), std::runtime_error);
+    }
+
+    // Format version mismatch (bytes 4..7 of the header)
+    {
+        auto BadVersion = Data;
+        Uint32 Version  = 0;
+        memcpy(&Version, &BadVersion[4], sizeof(Version));
+        ++Version;
+        memcpy(&BadVersion[4], &Version, sizeof(Version));
+        EXPECT_THROW(TryLoad(BadVersion), std::runtime_error);
+    }
+}
+
+} // namespace
@@ -0,0 +1,249 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "ConcurrentRingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, AllocDealloc)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    {
+        ConcurrentRingBuffer RB(1024, Allocator);
+
+        auto A0 = RB.Allocate(120, 16);
+        //
+        //  A0         h
+        //  |          |                                      |
+        //  0         128
+        ASSERT_TRUE(A0.IsValid());
+        EXPECT_EQ(A0.UnalignedOffset, 0u);
+        EXPECT_EQ(A0.Size, 128u);
+
+        auto A1 = RB.Allocate(10, 32);
+        //
+        //  t          A1  h
+        //  |          |   |                                  |
+        //  0         128 160
+        ASSERT_TRUE(A1.IsValid());
+        EXPECT_EQ(A1.UnalignedOffset, 128u);
+        EXPECT_EQ(RB.GetUsedSize(), 160u);
+
+        auto A2 = RB.Allocate(800, 1);
+        //
+        //  t                 A2                          h
+        //  |                 |                           |   |
+        //  0                160                         960
+        ASSERT_TRUE(A2.IsValid());
+        EXPECT_EQ(A2.UnalignedOffset, 160u);
+
+        EXPECT_FALSE(RB.Allocate(128, 1).IsValid());
+
+        // Releasing the allocation that is not at the tail does not free any space
+        RB.Free(A1);
+        EXPECT_EQ(RB.GetUsedSize(), 960u);
+
+        // Releasing the tail allocation also retires A1
+        RB.Free(A0);
+        EXPECT_EQ(RB.GetUsedSize(), 800u);
+
+        // The remaining 64 bytes at the end of the buffer are skipped
+        //
+        //  A3    h           t                               |   |
+        //  |     |           |                               |   |
+        //  0    128         160                             960 1024
+        auto A3 = RB.Allocate(128, 1);
+        ASSERT_TRUE(A3.IsValid());
+        EXPECT_EQ(A3.UnalignedOffset, 0u);
+        EXPECT_EQ(RB.GetUsedSize(), 800u + 64u + 128u);
+
+        EXPECT_FALSE(RB.Allocate(64, 1).IsValid());
+
+        // The skipped space is released together with A3
+        RB.Free(A2);
+        EXPECT_EQ(RB.GetUsedSize(), 64u + 128u);
+
+        RB.Free(A3);
+        EXPECT_TRUE(RB.IsEmpty());
+
+        // Unlike RingBuffer, empty concurrent ring buffer does not reset its head
+        auto A4 = RB.Allocate(1024 - 128, 1);
+        ASSERT_TRUE(A4.IsValid());
+        EXPECT_EQ(A4.UnalignedOffset, 128u);
+        EXPECT_EQ(RB.GetUsedSize(), 1024u - 128u);
+        RB.Free(A4);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, OutOfOrderFree)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    {
+        ConcurrentRingBuffer RB(1024, Allocator);
+
+        std::vector<ConcurrentRingBuffer::Allocation> Allocs;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            Allocs.emplace_back(RB.Allocate(128, 1));
+            ASSERT_TRUE(Allocs.back().IsValid());
+        }
+        EXPECT_TRUE(RB.IsFull());
+
+        // Release in reverse order: no space is freed until the first allocation is released
+        for (size_t i = Allocs.size() - 1; i > 0; --i)
+        {
+            RB.Free(Allocs[i]);
+            EXPECT_TRUE(RB.IsFull());
+        }
+        RB.Free(Allocs[0]);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, MultithreadedAllocation)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    {
+        constexpr size_t NumThreads          = 4;
+        constexpr size_t AllocationsPerFrame = 64;
+        constexpr size_t AllocationSize      = 16;
+        constexpr size_t NumFrames           = 16;
+
+        ConcurrentRingBuffer RB(NumThreads * AllocationsPerFrame * AllocationSize * 2, Allocator);
+
+        // Keep one frame in flight
+        std::vector<ConcurrentRingBuffer::Allocation> PrevFrameAllocs;
+        for (Uint64 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            std::vector<std::vector<ConcurrentRingBuffer::Allocation>> Allocs(NumThreads);
+
+            std::vector<std::thread> Threads;
+            for (size_t t = 0; t < NumThreads; ++t)
+            {
+                Threads.emplace_back(
+                    [&RB, &Allocs, t]() {
+                        for (size_t a = 0; a < AllocationsPerFrame; ++a)
+                            Allocs[t].push_back(RB.Allocate(AllocationSize, AllocationSize));
+                    });
+            }
+            for (auto& Thread : Threads)
+                Thread.join();
+
+            std::vector<ConcurrentRingBuffer::Allocation> AllAllocs;
+            for (const auto& ThreadAllocs : Allocs)
+                AllAllocs.insert(AllAllocs.end(), ThreadAllocs.begin(), ThreadAllocs.end());
+            std::sort(AllAllocs.begin(), AllAllocs.end(),
+                      [](const ConcurrentRingBuffer::Allocation& A0, const ConcurrentRingBuffer::Allocation& A1) {
+                          return A0.UnalignedOffset < A1.UnalignedOffset;
+                      });
+            for (size_t i = 0; i < AllAllocs.size(); ++i)
+            {
+                ASSERT_TRUE(AllAllocs[i].IsValid());
+                EXPECT_EQ(AllAllocs[i].UnalignedOffset % AllocationSize, 0u);
+                if (i > 0)
+                    EXPECT_GE(AllAllocs[i].UnalignedOffset, AllAllocs[i - 1].UnalignedOffset + AllocationSize) << "Overlapping allocations";
+            }
+
+            // Release the previous frame from multiple threads in arbitrary order
+            Threads.clear();
+            for (size_t t = 0; t < NumThreads; ++t)
+            {
+                Threads.emplace_back(
+                    [&RB, &PrevFrameAllocs, t]() {
+                        for (size_t a = t; a < PrevFrameAllocs.size(); a += NumThreads)
+                            RB.Free(PrevFrameAllocs[a]);
+                    });
+            }
+            for (auto& Thread : Threads)
+                Thread.join();
+
+            PrevFrameAllocs = std::move(AllAllocs);
+        }
+
+        for (const auto& Alloc : PrevFrameAllocs)
+            RB.Free(Alloc);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+}
+
+} // namespace
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, UsedSizeUnderContention)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    {
+        constexpr size_t NumThreads = 4;
+        constexpr size_t NumIters   = 4096;
+        constexpr size_t BufferSize = 1024;
+
+        ConcurrentRingBuffer RB(BufferSize, Allocator);
+
+        // Every thread allocates and immediately releases its block, so the head and the tail
+        // constantly move while the used size is being read
+        std::atomic_bool         Done{false};
+        std::vector<std::thread> Threads;
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back(
+                [&RB]() {
+                    for (size_t i = 0; i < NumIters; ++i)
+                    {
+                        auto Alloc = RB.Allocate(64, 16);
+                        if (Alloc.IsValid())
+                            RB.Free(Alloc);
+                    }
+                });
+        }
+
+        size_t MaxObservedSize = 0;
+        std::thread Reader{
+            [&]() {
+                while (!Done)
+                    MaxObservedSize = std::max(MaxObservedSize, RB.GetUsedSize());
+            }};
+
+        for (auto& Thread : Threads)
+            Thread.join();
+        Done = true;
+        Reader.join();
+
+        EXPECT_LE(MaxObservedSize, BufferSize);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+}
@@ -26,6 +26,10 @@
  */
 
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <set>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -128,4 +132,172 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+TEST(GraphicsAccessories_ResourceReleaseQueue, StaleResourceBlockPool)
+{
+    constexpr size_t BlockSize = 64;
+    using PoolType             = StaleResourceBlockPool<BlockSize>;
+
+    PoolType Pool;
+
+    const size_t NumBlocks = PoolType::NumBlocksInPage * 3 + 5;
+
+    std::vector<void*> Blocks;
+    std::set<void*>    UniqueBlocks;
+    for (size_t i = 0; i < NumBlocks; ++i)
+    {
+        auto* pBlock = Pool.Allocate();
+        ASSERT_NE(pBlock, nullptr);
+        EXPECT_EQ(reinterpret_cast<size_t>(pBlock) % alignof(std::max_align_t), size_t{0});
+        Blocks.push_back(pBlock);
+        UniqueBlocks.insert(pBlock);
+    }
+    EXPECT_EQ(UniqueBlocks.size(), NumBlocks);
+    EXPECT_EQ(Pool.GetAllocatedBlockCount(), NumBlocks);
+
+    for (auto* pBlock : Blocks)
+        Pool.Free(pBlock);
+    EXPECT_EQ(Pool.GetAllocatedBlockCount(), size_t{0});
+
+    // Freed blocks must be reused
+    for (size_t i = 0; i < NumBlocks; ++i)
+    {
+        auto* pBlock = Pool.Allocate();
+        EXPECT_TRUE(UniqueBlocks.find(pBlock) != UniqueBlocks.end());
+        Blocks[i] = pBlock;
+    }
+    for (auto* pBlock : Blocks)
+        Pool.Free(pBlock);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, PooledStaleResources)
+{
+    static int NumDestroyed = 0;
+    struct SmallResource
+    {
+        SmallResource() {}
+        SmallResource(SmallResource&& rhs) :
+            Valid{rhs.Valid}
+        {
+            rhs.Valid = false;
+        }
+        ~SmallResource()
+        {
+            if (Valid)
+                ++NumDestroyed;
+        }
+        bool Valid = true;
+    };
+    struct LargeResource
+    {
+        Uint8 Data[1024] = {};
+    };
+
+    {
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+        for (int i = 0; i < 100; ++i)
+            Queue.DiscardResource(SmallResource{}, 1);
+
+        // Resources that do not fit into the pool blocks are allocated from the heap
+        Queue.DiscardResource(LargeResource{}, 1);
+
+        auto Wrapper = DynamicStaleResourceWrapper::Create(SmallResource{}, 2);
+        Queue.SafeReleaseResource(Wrapper, 0);
+        Queue.SafeReleaseResource(Wrapper, 0);
+        Wrapper.GiveUpOwnership();
+        Queue.DiscardStaleResources(0, 1);
+
+        EXPECT_EQ(NumDestroyed, 0);
+        Queue.Purge(1);
+        EXPECT_EQ(NumDestroyed, 101);
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+    }
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, DestructionWorker)
+{
+    static std::atomic<int>             NumDestroyed{0};
+    static std::atomic<std::thread::id> DestroyingThreadId;
+    struct Resource
+    {
+        ~Resource()
+        {
+            DestroyingThreadId.store(std::this_thread::get_id());
+            ++NumDestroyed;
+        }
+    };
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    ResourceDestructionWorker<DynamicStaleResourceWrapper> Worker{Allocator, 0};
+    ResourceReleaseQueue<DynamicStaleResourceWrapper>      Queue{Allocator};
+    Queue.SetDestructionWorker(&Worker);
+
+    constexpr int NumResources = 16;
+    for (int i = 0; i < NumResources; ++i)
+    {
+        std::unique_ptr<Resource> res{new Resource};
+        Queue.DiscardResource(std::move(res), i < NumResources / 2 ? 1 : 2);
+    }
+
+    Queue.Purge(1);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{NumResources / 2});
+
+    // Wait until the worker destroys the first half of the resources
+    Worker.WaitIdle();
+    EXPECT_EQ(Worker.GetPendingResourceCount(), size_t{0});
+    EXPECT_EQ(NumDestroyed, NumResources / 2);
+    EXPECT_NE(DestroyingThreadId.load(), std::this_thread::get_id());
+
+    Queue.Purge(2);
+    Worker.Flush();
+    EXPECT_EQ(NumDestroyed, NumResources);
+    EXPECT_EQ(Worker.GetPendingResourceCount(), size_t{0});
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, DestructionWorkerBudget)
+{
+    static std::atomic<int> NumDestroyed{0};
+    struct Resource
+    {
+        ~Resource()
+        {
+            // Make sure that destroying a single resource exceeds the budget
+            const auto StartTime = std::chrono::high_resolution_clock::now();
+            while (std::chrono::high_resolution_clock::now() - StartTime < std::chrono::milliseconds{2})
+                continue;
+            ++NumDestroyed;
+        }
+    };
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    // The worker may destroy at most one resource per frame
+    ResourceDestructionWorker<DynamicStaleResourceWrapper> Worker{Allocator, 0.001};
+    ResourceReleaseQueue<DynamicStaleResourceWrapper>      Queue{Allocator};
+    Queue.SetDestructionWorker(&Worker);
+
+    constexpr int NumResources = 4;
+    for (int i = 0; i < NumResources; ++i)
+    {
+        std::unique_ptr<Resource> res{new Resource};
+        Queue.DiscardResource(std::move(res), 1);
+    }
+    Queue.Purge(1);
+
+    // The worker stops after the first resource exhausts the budget
+    Worker.WaitIdle();
+    EXPECT_EQ(NumDestroyed, 1);
+    EXPECT_EQ(Worker.GetPendingResourceCount(), size_t{NumResources - 1});
+
+    Worker.BeginFrame();
+    Worker.WaitIdle();
+    EXPECT_EQ(NumDestroyed, 2);
+
+    // Flush must destroy all remaining resources regardless of the budget
+    Worker.Flush();
+    EXPECT_EQ(NumDestroyed, NumResources);
+}
+
 } // namespace
@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019-2020 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstddef>
+#include <cstring>
+
+#include "ShaderArchive.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_ShaderArchive, WriteAndRead)
+{
+    const std::vector<uint32_t> SPIRV0     = {0x07230203, 0x00010000, 1, 2, 3};
+    const std::vector<uint32_t> SPIRV1     = {0x07230203, 0x00010000, 4, 5};
+    const std::vector<Uint8>    Resources0 = {1, 2, 3};
+
+    ShaderArchiveWriter Writer;
+    EXPECT_TRUE(Writer.AddEntry("VS", SHADER_TYPE_VERTEX, SPIRV0, "void main(){}", Resources0));
+    EXPECT_TRUE(Writer.AddEntry("PS|USE_FOG=1", SHADER_TYPE_PIXEL, SPIRV1, "", {}));
+    EXPECT_FALSE(Writer.AddEntry("VS", SHADER_TYPE_VERTEX, SPIRV1, "", {}));
+    EXPECT_EQ(Writer.GetNumEntries(), size_t{2});
+
+    std::vector<Uint8> Data;
+    Writer.Write(Data);
+
+    ShaderArchiveReader Reader{Data.data(), Data.size()};
+    ASSERT_TRUE(Reader.IsValid());
+    EXPECT_EQ(Reader.GetNumEntries(), Uint32{2});
+
+    ShaderArchiveReader::Entry Entry;
+    ASSERT_TRUE(Reader.FindEntry("VS", Entry));
+    EXPECT_STREQ(Entry.Name, "VS");
+    EXPECT_EQ(Entry.ShaderType, SHADER_TYPE_VERTEX);
+    ASSERT_EQ(Entry.SPIRVSize, SPIRV0.size() * sizeof(uint32_t));
+    EXPECT_EQ(memcmp(Entry.pSPIRV, SPIRV0.data(), Entry.SPIRVSize), 0);
+    EXPECT_STREQ(Entry.GLSL, "void main(){}");
+    EXPECT_EQ(Entry.GLSLLength, strlen("void main(){}"));
+    ASSERT_EQ(Entry.ResourcesSize, Resources0.size());
+    EXPECT_EQ(memcmp(Entry.pResources, Resources0.data(), Entry.ResourcesSize), 0);
+    // Entry data is used in place
+    EXPECT_GE(reinterpret_cast<const Uint8*>(Entry.pSPIRV), Data.data());
+    EXPECT_LT(reinterpret_cast<const Uint8*>(Entry.pSPIRV), Data.data() + Data.size());
+
+    ASSERT_TRUE(Reader.FindEntry("PS|USE_FOG=1", Entry));
+    EXPECT_EQ(Entry.ShaderType, SHADER_TYPE_PIXEL);
+    EXPECT_EQ(Entry.SPIRVSize, SPIRV1.size() * sizeof(uint32_t));
+    EXPECT_EQ(Entry.GLSL, nullptr);
+    EXPECT_EQ(Entry.pResources, nullptr);
+
+    EXPECT_FALSE(Reader.FindEntry("PS", Entry));
+}
+
+TEST(GraphicsAccessories_ShaderArchive, InvalidData)
+{
+    ShaderArchiveWriter Writer;
+    Writer.AddEntry("CS", SHADER_TYPE_COMPUTE, {0x07230203}, "", {});
+    std::vector<Uint8> Data;
+    Writer.Write(Data);
+
+    {
+        auto Truncated = Data;
+        Truncated.resize(Truncated.size() - 8);
+        ShaderArchiveReader Reader{Truncated.data(), Truncated.size()};
+        EXPECT_FALSE(Reader.IsValid());
+    }
+
+    {
+        auto BadMagic = Data;
+        BadMagic[0] ^= 0xFF;
+        ShaderArchiveReader Reader{BadMagic.data(), BadMagic.size()};
+        EXPECT_FALSE(Reader.IsValid());
+    }
+
+    // Entries with invalid shader type must be rejected
+    for (Uint32 ShaderType : {Uint32{SHADER_TYPE_UNKNOWN}, Uint32{SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL}, Uint32{SHADER_TYPE_COMPUTE << 1}, ~Uint32{0}})
+    {
+        auto BadType = Data;
+
+        ShaderArchiveHeader Header;
+        memcpy(&Header, BadType.data(), sizeof(Header));
+        memcpy(&BadType[static_cast<size_t>(Header.IndexOffset) + offsetof(ShaderArchiveIndexEntry, ShaderType)], &ShaderType, sizeof(ShaderType));
+
+        ShaderArchiveReader Reader{BadType.data(), BadType.size()};
+        ShaderArchiveReader::Entry Entry;
+        EXPECT_FALSE(Reader.FindEntry("CS", Entry)) << "ShaderType: " << ShaderType;
+    }
+
+    {
+        ShaderArchiveReader Reader{nullptr, 0};
+        EXPECT_FALSE(Reader.IsValid());
+
+        ShaderArchiveReader::Entry Entry;
+        EXPECT_FALSE(Reader.FindEntry("CS", Entry));
+    }
+}
+
+} // namespace
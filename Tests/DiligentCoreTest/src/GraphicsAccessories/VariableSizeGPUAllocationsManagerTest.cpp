@@ -158,6 +158,198 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
     }
 }
 
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FragmentationStats)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    {
+        VariableSizeAllocationsManager ListMgr(128, Allocator);
+
+        auto Stats = ListMgr.GetFragmentationStats();
+        EXPECT_EQ(Stats.FreeSize, 128);
+        EXPECT_EQ(Stats.LargestFreeBlock, 128);
+        EXPECT_EQ(Stats.NumFreeBlocks, 1);
+        EXPECT_EQ(Stats.ExternalFragmentation, 0);
+        EXPECT_EQ(Stats.FreeBlockHistogram[7], 1);
+
+        VariableSizeAllocationsManager::Allocation al[8];
+        for (size_t o = 0; o < _countof(al); ++o)
+            al[o] = ListMgr.Allocate(16, 1);
+        EXPECT_TRUE(ListMgr.IsFull());
+
+        Stats = ListMgr.GetFragmentationStats();
+        EXPECT_EQ(Stats.FreeSize, 0);
+        EXPECT_EQ(Stats.LargestFreeBlock, 0);
+        EXPECT_EQ(Stats.NumFreeBlocks, 0);
+        EXPECT_EQ(Stats.ExternalFragmentation, 0);
+
+        ListMgr.Free(std::move(al[1]));
+        ListMgr.Free(std::move(al[3]));
+        ListMgr.Free(std::move(al[4]));
+        ListMgr.Free(std::move(al[6]));
+
+        //  0       16      32      48      64      80      96      112
+        //  |  a0   |       |  a2   |               |  a5   |       |  a7   |
+        Stats = ListMgr.GetFragmentationStats();
+        EXPECT_EQ(Stats.FreeSize, 64);
+        EXPECT_EQ(Stats.LargestFreeBlock, 32);
+        EXPECT_EQ(ListMgr.GetLargestFreeBlockSize(), 32);
+        EXPECT_EQ(Stats.NumFreeBlocks, 3);
+        EXPECT_DOUBLE_EQ(Stats.ExternalFragmentation, 0.5);
+        EXPECT_EQ(Stats.FreeBlockHistogram[4], 2);
+        EXPECT_EQ(Stats.FreeBlockHistogram[5], 1);
+
+        ListMgr.Free(std::move(al[0]));
+        ListMgr.Free(std::move(al[2]));
+        ListMgr.Free(std::move(al[5]));
+        ListMgr.Free(std::move(al[7]));
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Defragmentation)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    {
+        VariableSizeAllocationsManager ListMgr(128, Allocator);
+
+        VariableSizeAllocationsManager::Allocation al[8];
+        for (size_t o = 0; o < _countof(al); ++o)
+            al[o] = ListMgr.Allocate(16, 16);
+        ListMgr.Free(std::move(al[1]));
+        ListMgr.Free(std::move(al[2]));
+        ListMgr.Free(std::move(al[4]));
+        ListMgr.Free(std::move(al[6]));
+
+        //  0       16      32      48      64      80      96      112
+        //  |  a0   |               |  a3   |       |  a5   |       |  a7   |
+        VariableSizeAllocationsManager::Allocation LiveAllocs[] = {al[7], al[0], al[5], al[3]};
+        VariableSizeAllocationsManager::OffsetType Alignments[] = {16, 16, 16, 16};
+
+        std::vector<VariableSizeAllocationsManager::DefragmentationMove> Moves;
+        ListMgr.PlanDefragmentation(LiveAllocs, Alignments, _countof(LiveAllocs), ~VariableSizeAllocationsManager::OffsetType{0}, Moves);
+
+        // a0 stays in place, a3, a5 and a7 slide down to offsets 16, 32 and 48
+        ASSERT_EQ(Moves.size(), 3);
+        EXPECT_EQ(Moves[0].AllocationIndex, 3);
+        EXPECT_EQ(Moves[0].DstAllocation.UnalignedOffset, 16);
+        EXPECT_EQ(Moves[0].DataSize, 16);
+        EXPECT_EQ(Moves[1].AllocationIndex, 2);
+        EXPECT_EQ(Moves[1].DstAllocation.UnalignedOffset, 32);
+        EXPECT_EQ(Moves[2].AllocationIndex, 0);
+        EXPECT_EQ(Moves[2].DstAllocation.UnalignedOffset, 48);
+
+        for (const auto& Move : Moves)
+        {
+            ListMgr.ApplyDefragmentationMove(Move);
+            LiveAllocs[Move.AllocationIndex] = Move.DstAllocation;
+        }
+
+        auto Stats = ListMgr.GetFragmentationStats();
+        EXPECT_EQ(Stats.NumFreeBlocks, 1);
+        EXPECT_EQ(Stats.LargestFreeBlock, 64);
+        EXPECT_EQ(Stats.ExternalFragmentation, 0);
+
+        // Test move budget
+        Moves.clear();
+        ListMgr.PlanDefragmentation(LiveAllocs, Alignments, _countof(LiveAllocs), 0, Moves);
+        EXPECT_TRUE(Moves.empty());
+
+        for (auto& Alloc : LiveAllocs)
+            ListMgr.Free(std::move(Alloc));
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, DefragmentationConstraints)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    {
+        using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+        VariableSizeAllocationsManager ListMgr(128, Allocator);
+
+        auto a0 = ListMgr.Allocate(16, 1);
+        auto a1 = ListMgr.Allocate(48, 1);
+        auto a2 = ListMgr.Allocate(16, 1);
+        auto a3 = ListMgr.Allocate(32, 1);
+        ListMgr.Free(std::move(a0));
+
+        //  0       16                      64      80              112
+        //  |       |          a1           |  a2   |      a3       |       |
+        {
+            VariableSizeAllocationsManager::Allocation LiveAllocs[] = {a1, a2, a3};
+            OffsetType                                 Alignments[] = {16, 16, 16};
+
+            // a1 can't be moved to offset 0 as the ranges would overlap; a2 and a3 are already in place
+            std::vector<VariableSizeAllocationsManager::DefragmentationMove> Moves;
+            ListMgr.PlanDefragmentation(LiveAllocs, Alignments, _countof(LiveAllocs), ~OffsetType{0}, Moves);
+            EXPECT_TRUE(Moves.empty());
+        }
+
+        ListMgr.Free(std::move(a1));
+
+        //  0                               64      80              112
+        //  |                               |  a2   |      a3       |       |
+        VariableSizeAllocationsManager::Allocation LiveAllocs[] = {a2, a3};
+        {
+            OffsetType Alignments[] = {16, 16};
+
+            // The budget only allows a2 to be moved. a3 stays in place.
+            std::vector<VariableSizeAllocationsManager::DefragmentationMove> Moves;
+            ListMgr.PlanDefragmentation(LiveAllocs, Alignments, _countof(LiveAllocs), 16, Moves);
+            ASSERT_EQ(Moves.size(), 1);
+            EXPECT_EQ(Moves[0].AllocationIndex, 0);
+            EXPECT_EQ(Moves[0].DstAllocation.UnalignedOffset, 0);
+            EXPECT_EQ(Moves[0].DstAllocation.Size, 16);
+            EXPECT_EQ(Moves[0].SrcDataOffset, 64);
+            EXPECT_EQ(Moves[0].DataSize, 16);
+
+            ListMgr.ApplyDefragmentationMove(Moves[0]);
+            LiveAllocs[0] = Moves[0].DstAllocation;
+        }
+
+        //  0       16                                      80              112
+        //  |  a2   |                                       |      a3       |       |
+        {
+            auto Stats = ListMgr.GetFragmentationStats();
+            EXPECT_EQ(Stats.FreeSize, 80);
+            EXPECT_EQ(Stats.NumFreeBlocks, 2);
+            EXPECT_EQ(Stats.LargestFreeBlock, 64);
+        }
+
+        {
+            // a3 requires 32-byte alignment, so its data starts at offset 96 and
+            // the destination is the first 32-byte aligned offset after a2
+            OffsetType Alignments[] = {1, 32};
+
+            std::vector<VariableSizeAllocationsManager::DefragmentationMove> Moves;
+            ListMgr.PlanDefragmentation(LiveAllocs, Alignments, _countof(LiveAllocs), ~OffsetType{0}, Moves);
+            ASSERT_EQ(Moves.size(), 1);
+            EXPECT_EQ(Moves[0].AllocationIndex, 1);
+            EXPECT_EQ(Moves[0].DstAllocation.UnalignedOffset, 32);
+            EXPECT_EQ(Moves[0].DstAllocation.Size, 32);
+            EXPECT_EQ(Moves[0].SrcDataOffset, 96);
+            EXPECT_EQ(Moves[0].DataSize, 16);
+
+            ListMgr.ApplyDefragmentationMove(Moves[0]);
+            LiveAllocs[1] = Moves[0].DstAllocation;
+        }
+
+        //  0       16      32              64
+        //  |  a2   |       |      a3       |                               |
+        {
+            auto Stats = ListMgr.GetFragmentationStats();
+            EXPECT_EQ(Stats.FreeSize, 80);
+            EXPECT_EQ(Stats.NumFreeBlocks, 2);
+            EXPECT_EQ(Stats.LargestFreeBlock, 64);
+        }
+
+        for (auto& Alloc : LiveAllocs)
+            ListMgr.Free(std::move(Alloc));
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    }
+}
+
 TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
 {
     auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
@@ -32,4 +32,6 @@ void TestBufferViewVk_CInterface(IBufferViewVk* pView)
 {
     VkBufferView vkView = IBufferViewVk_GetVkBufferView(pView);
     (void)vkView;
+    Uint32 BindlessIndex = IBufferViewVk_GetBindlessIndex(pView);
+    (void)BindlessIndex;
 }
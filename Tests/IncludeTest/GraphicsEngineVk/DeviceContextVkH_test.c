@@ -37,4 +37,7 @@ void TestDeviceContextVk_CInterface(IDeviceContextVk* pCtx)
     (void)pVkCmdQueue;
 
     IDeviceContextVk_UnlockCommandQueue(pCtx);
+
+    struct DynamicDescriptorSetCacheStatsVk Stats = *IDeviceContextVk_GetDynamicDescriptorSetCacheStats(pCtx);
+    (void)Stats;
 }
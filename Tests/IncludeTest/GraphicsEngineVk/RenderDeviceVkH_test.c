@@ -49,4 +49,5 @@ void TestRenderDeviceVkCInterface(IRenderDeviceVk* pDevice)
 
     IRenderDeviceVk_CreateTextureFromVulkanImage(pDevice, (VkImage)NULL, (TextureDesc*)NULL, RESOURCE_STATE_SHADER_RESOURCE, (ITexture**)NULL);
     IRenderDeviceVk_CreateBufferFromVulkanResource(pDevice, (VkBuffer)NULL, (BufferDesc*)NULL, RESOURCE_STATE_CONSTANT_BUFFER, (IBuffer**)NULL);
+    IRenderDeviceVk_GetPipelineCacheData(pDevice, (IDataBlob**)NULL);
 }
@@ -32,4 +32,6 @@ void TestSamplerVk_CInterface(ISamplerVk* pSampler)
 {
     VkSampler Handle = ISamplerVk_GetVkSampler(pSampler);
     (void)Handle;
+    Uint32 BindlessIndex = ISamplerVk_GetBindlessIndex(pSampler);
+    (void)BindlessIndex;
 }
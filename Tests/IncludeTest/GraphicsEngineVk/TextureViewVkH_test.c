@@ -32,4 +32,6 @@ void TestTextureViewVk_CInterface(ITextureViewVk* pView)
 {
     VkImageView vkView = ITextureViewVk_GetVulkanImageView(pView);
     (void)vkView;
+    Uint32 BindlessIndex = ITextureViewVk_GetBindlessIndex(pView);
+    (void)BindlessIndex;
 }